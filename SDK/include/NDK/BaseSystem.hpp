@@ -28,14 +28,20 @@ namespace Ndk
 
 			inline void Enable(bool enable = true);
 
+			bool ConflictsWith(const BaseSystem& system) const;
+
 			bool Filters(const Entity* entity) const;
 
 			inline const EntityList& GetEntities() const;
 			inline float GetFixedUpdateRate() const;
 			inline SystemIndex GetIndex() const;
 			inline float GetMaximumUpdateRate() const;
+			inline const Nz::Bitset<>& GetReadComponents() const;
 			inline int GetUpdateOrder() const;
 			inline World& GetWorld() const;
+			inline const Nz::Bitset<>& GetWrittenComponents() const;
+
+			inline bool HasDeclaredComponentAccess() const;
 
 			inline bool IsEnabled() const;
 
@@ -57,6 +63,13 @@ namespace Ndk
 
 			static SystemIndex GetNextIndex();
 
+			template<typename F> void ParallelForEachEntity(const F& iterationFunc, std::size_t blocksPerTask = 16) const;
+			template<typename F> static void ParallelForEachEntity(const EntityList& entities, const F& iterationFunc, std::size_t blocksPerTask = 16);
+
+			template<typename ComponentType> void Reads();
+			template<typename ComponentType1, typename ComponentType2, typename... Rest> void Reads();
+			inline void ReadsComponent(ComponentIndex index);
+
 			template<typename ComponentType> void Requires();
 			template<typename ComponentType1, typename ComponentType2, typename... Rest> void Requires();
 			inline void RequiresComponent(ComponentIndex index);
@@ -65,6 +78,10 @@ namespace Ndk
 			template<typename ComponentType1, typename ComponentType2, typename... Rest> void RequiresAny();
 			inline void RequiresAnyComponent(ComponentIndex index);
 
+			template<typename ComponentType> void Writes();
+			template<typename ComponentType1, typename ComponentType2, typename... Rest> void Writes();
+			inline void WritesComponent(ComponentIndex index);
+
 			virtual void OnUpdate(float elapsedTime) = 0;
 
 		private:
@@ -85,8 +102,10 @@ namespace Ndk
 
 			Nz::Bitset<> m_excludedComponents;
 			mutable Nz::Bitset<> m_filterResult;
+			Nz::Bitset<> m_readComponents;
 			Nz::Bitset<> m_requiredAnyComponents;
 			Nz::Bitset<> m_requiredComponents;
+			Nz::Bitset<> m_writtenComponents;
 			EntityList m_entities;
 			SystemIndex m_systemIndex;
 			World* m_world;
@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Prerequisites.hpp
 
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/ParallelAlgorithm.hpp>
 #include <type_traits>
 
 namespace Ndk
@@ -62,6 +63,17 @@ namespace Ndk
 		return (m_maxUpdateRate > 0.f) ? 1.f / m_maxUpdateRate : 0.f;
 	}
 
+	/*!
+	* \brief Gets the components read by the system during its update
+	* \return A constant reference to the set of read component's bits
+	*
+	* \see Reads
+	*/
+	inline const Nz::Bitset<>& BaseSystem::GetReadComponents() const
+	{
+		return m_readComponents;
+	}
+
 	/*!
 	* \brief Gets the index of the system
 	* \return Index of the system
@@ -93,6 +105,29 @@ namespace Ndk
 		return *m_world;
 	}
 
+	/*!
+	* \brief Gets the components written by the system during its update
+	* \return A constant reference to the set of written component's bits
+	*
+	* \see Writes
+	*/
+	inline const Nz::Bitset<>& BaseSystem::GetWrittenComponents() const
+	{
+		return m_writtenComponents;
+	}
+
+	/*!
+	* \brief Checks whether or not the system declared the components it accesses during its update
+	* \return true If it is the case, the system may then be updated at the same time as other systems
+	*
+	* \see Reads
+	* \see Writes
+	*/
+	inline bool BaseSystem::HasDeclaredComponentAccess() const
+	{
+		return m_readComponents.TestAny() || m_writtenComponents.TestAny();
+	}
+
 	/*!
 	* \brief Checks whether or not the system is enabled
 	* \return true If it is the case
@@ -230,6 +265,84 @@ namespace Ndk
 		return s_nextIndex++;
 	}
 
+	/*!
+	* \brief Executes a function on every entity of the system, using the TaskScheduler workers
+	*
+	* The entity list is split in chunks of whole blocks (see EntityList::ForEachInBlocks), each of them being processed by one thread.
+	*
+	* \param iterationFunc Function called with a const reference to the handle of every entity, from multiple threads
+	* \param blocksPerTask Number of blocks (of EntityList::EntitiesPerBlock entities) processed by each task
+	*
+	* \remark iterationFunc must only change the entity it is called for, structural changes (entity creation/destruction, component addition/removal) must go through the world command buffer
+	*
+	* \see World::GetCommandBuffer
+	*/
+	template<typename F>
+	void BaseSystem::ParallelForEachEntity(const F& iterationFunc, std::size_t blocksPerTask) const
+	{
+		ParallelForEachEntity(m_entities, iterationFunc, blocksPerTask);
+	}
+
+	/*!
+	* \brief Executes a function on every entity of a list, using the TaskScheduler workers
+	*
+	* \param entities List of entities, usually a subset of the entities of the system
+	* \param iterationFunc Function called with a const reference to the handle of every entity, from multiple threads
+	* \param blocksPerTask Number of blocks (of EntityList::EntitiesPerBlock entities) processed by each task
+	*
+	* \see ParallelForEachEntity
+	*/
+	template<typename F>
+	void BaseSystem::ParallelForEachEntity(const EntityList& entities, const F& iterationFunc, std::size_t blocksPerTask)
+	{
+		Nz::ParallelFor(std::size_t(0), entities.GetBlockCount(), blocksPerTask, [&](std::size_t firstBlock, std::size_t lastBlock)
+		{
+			entities.ForEachInBlocks(firstBlock, lastBlock, iterationFunc);
+		});
+	}
+
+	/*!
+	* \brief Declares a component read by the system during its update
+	*
+	* \see ReadsComponent
+	*/
+
+	template<typename ComponentType>
+	void BaseSystem::Reads()
+	{
+		static_assert(std::is_base_of<BaseComponent, ComponentType>::value, "ComponentType is not a component");
+
+		ReadsComponent(GetComponentIndex<ComponentType>());
+	}
+
+	/*!
+	* \brief Declares some components read by the system during its update
+	*
+	* \see ReadsComponent
+	*/
+
+	template<typename ComponentType1, typename ComponentType2, typename... Rest>
+	void BaseSystem::Reads()
+	{
+		Reads<ComponentType1>();
+		Reads<ComponentType2, Rest...>();
+	}
+
+	/*!
+	* \brief Declares a component read by the system during its update, by index
+	*
+	* Systems declaring every component they access may be updated by the world at the same time as systems they don't conflict with (see ConflictsWith).
+	*
+	* \param index Index of the component
+	*
+	* \remark Such a system may kill entities during its update, other structural changes must go through the world command buffer
+	*/
+
+	inline void BaseSystem::ReadsComponent(ComponentIndex index)
+	{
+		m_readComponents.UnboundedSet(index);
+	}
+
 	/*!
 	* \brief Requires some component from the system
 	*/
@@ -298,6 +411,46 @@ namespace Ndk
 		m_requiredAnyComponents.UnboundedSet(index);
 	}
 
+	/*!
+	* \brief Declares a component written by the system during its update
+	*
+	* \see WritesComponent
+	*/
+
+	template<typename ComponentType>
+	void BaseSystem::Writes()
+	{
+		static_assert(std::is_base_of<BaseComponent, ComponentType>::value, "ComponentType is not a component");
+
+		WritesComponent(GetComponentIndex<ComponentType>());
+	}
+
+	/*!
+	* \brief Declares some components written by the system during its update
+	*
+	* \see WritesComponent
+	*/
+
+	template<typename ComponentType1, typename ComponentType2, typename... Rest>
+	void BaseSystem::Writes()
+	{
+		Writes<ComponentType1>();
+		Writes<ComponentType2, Rest...>();
+	}
+
+	/*!
+	* \brief Declares a component written by the system during its update, by index
+	*
+	* \param index Index of the component
+	*
+	* \see ReadsComponent
+	*/
+
+	inline void BaseSystem::WritesComponent(ComponentIndex index)
+	{
+		m_writtenComponents.UnboundedSet(index);
+	}
+
 	/*!
 	* \brief Adds an entity to a system
 	*
@@ -0,0 +1,52 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequisites.hpp
+
+#pragma once
+
+#ifndef NDK_COMPONENTPOOL_HPP
+#define NDK_COMPONENTPOOL_HPP
+
+#include <NDK/Prerequisites.hpp>
+#include <vector>
+
+namespace Ndk
+{
+	class BaseComponent;
+
+	class ComponentPool
+	{
+		public:
+			ComponentPool() = default;
+			ComponentPool(const ComponentPool&) = delete;
+			ComponentPool(ComponentPool&&) noexcept = default;
+			~ComponentPool() = default;
+
+			inline void Clear();
+
+			inline BaseComponent* Get(EntityId entity) const;
+			inline BaseComponent* const* GetComponents() const;
+			inline const EntityId* GetEntities() const;
+			inline std::size_t GetSize() const;
+
+			inline bool Has(EntityId entity) const;
+
+			inline void Insert(EntityId entity, BaseComponent* component);
+
+			inline void Remove(EntityId entity);
+
+			ComponentPool& operator=(const ComponentPool&) = delete;
+			ComponentPool& operator=(ComponentPool&&) noexcept = default;
+
+		private:
+			static constexpr Nz::UInt32 InvalidIndex = 0xFFFFFFFF;
+
+			std::vector<BaseComponent*> m_components;
+			std::vector<EntityId> m_entities;
+			std::vector<Nz::UInt32> m_indices;
+	};
+}
+
+#include <NDK/ComponentPool.inl>
+
+#endif // NDK_COMPONENTPOOL_HPP
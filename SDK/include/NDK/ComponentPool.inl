@@ -0,0 +1,133 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequisites.hpp
+
+#include <Nazara/Core/Error.hpp>
+
+namespace Ndk
+{
+	/*!
+	* \ingroup NDK
+	* \class Ndk::ComponentPool
+	* \brief NDK class that stores the components of a single type owned by the entities of a world
+	*
+	* This is a sparse set: components and the identifier of their entities are packed in two parallel arrays, which makes iterating over them as fast as iterating over an array.
+	* Removing a component moves the last one in its place, the order of the arrays is therefore not stable.
+	*
+	* \remark The pool does not own the components, entities do
+	*/
+
+	/*!
+	* \brief Removes every component from the pool
+	*/
+	inline void ComponentPool::Clear()
+	{
+		m_components.clear();
+		m_entities.clear();
+		m_indices.clear();
+	}
+
+	/*!
+	* \brief Gets the component of an entity
+	* \return Pointer to the component, or nullptr if the entity has no component in this pool
+	*
+	* \param entity Identifier of the entity
+	*/
+	inline BaseComponent* ComponentPool::Get(EntityId entity) const
+	{
+		if (entity >= m_indices.size() || m_indices[entity] == InvalidIndex)
+			return nullptr;
+
+		return m_components[m_indices[entity]];
+	}
+
+	/*!
+	* \brief Gets the packed array of components
+	* \return Pointer to GetSize() components, matching the identifiers returned by GetEntities
+	*/
+	inline BaseComponent* const* ComponentPool::GetComponents() const
+	{
+		return m_components.data();
+	}
+
+	/*!
+	* \brief Gets the packed array of entity identifiers
+	* \return Pointer to GetSize() identifiers, matching the components returned by GetComponents
+	*/
+	inline const EntityId* ComponentPool::GetEntities() const
+	{
+		return m_entities.data();
+	}
+
+	/*!
+	* \brief Gets the number of components in the pool
+	* \return Component count
+	*/
+	inline std::size_t ComponentPool::GetSize() const
+	{
+		return m_components.size();
+	}
+
+	/*!
+	* \brief Checks whether or not an entity has a component in this pool
+	* \return true If it is the case
+	*
+	* \param entity Identifier of the entity
+	*/
+	inline bool ComponentPool::Has(EntityId entity) const
+	{
+		return entity < m_indices.size() && m_indices[entity] != InvalidIndex;
+	}
+
+	/*!
+	* \brief Inserts the component of an entity into the pool
+	*
+	* \param entity Identifier of the entity
+	* \param component Component of the entity, replaces the previous one if any
+	*/
+	inline void ComponentPool::Insert(EntityId entity, BaseComponent* component)
+	{
+		NazaraAssert(component, "Invalid component");
+
+		if (entity >= m_indices.size())
+			m_indices.resize(entity + 1, Nz::UInt32(InvalidIndex)); //< Copy to avoid odr-using InvalidIndex
+
+		Nz::UInt32& index = m_indices[entity];
+		if (index == InvalidIndex)
+		{
+			index = static_cast<Nz::UInt32>(m_components.size());
+
+			m_components.push_back(component);
+			m_entities.push_back(entity);
+		}
+		else
+			m_components[index] = component;
+	}
+
+	/*!
+	* \brief Removes the component of an entity from the pool
+	*
+	* \param entity Identifier of the entity
+	*
+	* \remark If the entity has no component in this pool, nothing is done
+	*/
+	inline void ComponentPool::Remove(EntityId entity)
+	{
+		if (!Has(entity))
+			return;
+
+		Nz::UInt32 index = m_indices[entity];
+		m_indices[entity] = InvalidIndex;
+
+		// Swap and pop idiom
+		if (index != m_components.size() - 1)
+		{
+			m_components[index] = m_components.back();
+			m_entities[index] = m_entities.back();
+			m_indices[m_entities[index]] = index;
+		}
+
+		m_components.pop_back();
+		m_entities.pop_back();
+	}
+}
@@ -13,6 +13,7 @@
 #include <Nazara/Math/Frustum.hpp>
 #include <Nazara/Utility/Node.hpp>
 #include <NDK/Component.hpp>
+#include <atomic>
 #include <unordered_map>
 
 namespace Ndk
@@ -40,6 +41,8 @@ namespace Ndk
 			inline void Attach(Nz::InstancedRenderableRef renderable, int renderOrder = 0);
 			void Attach(Nz::InstancedRenderableRef renderable, const Nz::Matrix4f& localMatrix, int renderOrder = 0);
 
+			inline bool CanBeQueuedConcurrently() const;
+
 			inline void Clear();
 
 			inline void Detach(const Nz::InstancedRenderable* renderable);
@@ -58,6 +61,7 @@ namespace Ndk
 
 			inline const Nz::BoundingVolumef& GetBoundingVolume(std::size_t renderableIndex) const;
 			inline const Nz::Matrix4f& GetLocalMatrix(std::size_t renderableIndex) const;
+			inline Nz::UInt64 GetRenderRevision() const;
 			inline const Nz::Matrix4f& GetTransformMatrix(std::size_t renderableIndex) const;
 
 			inline void RemoveFromCullingList(GraphicsComponentCullingList* cullingList) const;
@@ -79,6 +83,7 @@ namespace Ndk
 			void InvalidateRenderableData(const Nz::InstancedRenderable* renderable, Nz::UInt32 flags, std::size_t index);
 			void InvalidateRenderableMaterial(const Nz::InstancedRenderable* renderable, std::size_t skinIndex, std::size_t matIndex, const Nz::MaterialRef& newMat);
 			inline void InvalidateRenderables();
+			inline void InvalidateRenderRevision() const;
 			void InvalidateReflectionMap();
 			inline void InvalidateTransformMatrix();
 
@@ -156,11 +161,14 @@ namespace Ndk
 			std::unordered_map<const Nz::Material*, MaterialEntry> m_materialEntries;
 			mutable Nz::Boxf m_aabb;
 			mutable Nz::Matrix4f m_transformMatrix;
+			mutable Nz::UInt64 m_renderRevision;
 			Nz::Recti m_scissorRect;
 			Nz::TextureRef m_reflectionMap;
 			mutable bool m_boundingVolumesUpdated;
 			mutable bool m_transformMatrixUpdated;
 			unsigned int m_reflectionMapSize;
+
+			static std::atomic<Nz::UInt64> s_renderRevisionCounter;
 	};
 }
 
@@ -11,6 +11,7 @@ namespace Ndk
 {
 	inline GraphicsComponent::GraphicsComponent() :
 	m_reflectiveMaterialCount(0),
+	m_renderRevision(++s_renderRevisionCounter),
 	m_scissorRect(-1, -1)
 	{
 	}
@@ -25,6 +26,7 @@ namespace Ndk
 	m_reflectiveMaterialCount(0),
 	m_aabb(graphicsComponent.m_aabb),
 	m_transformMatrix(graphicsComponent.m_transformMatrix),
+	m_renderRevision(++s_renderRevisionCounter),
 	m_scissorRect(graphicsComponent.m_scissorRect),
 	m_boundingVolumesUpdated(graphicsComponent.m_boundingVolumesUpdated),
 	m_transformMatrixUpdated(graphicsComponent.m_transformMatrixUpdated)
@@ -55,6 +57,23 @@ namespace Ndk
 		return Attach(std::move(renderable), Nz::Matrix4f::Identity(), renderOrder);
 	}
 
+	/*!
+	* \brief Checks if this graphics component can be added to a render queue from another thread than the main one
+	* \return True if every attached renderable can be queued concurrently
+	*
+	* \see Nz::InstancedRenderable::CanBeQueuedConcurrently
+	*/
+	inline bool GraphicsComponent::CanBeQueuedConcurrently() const
+	{
+		for (const Renderable& r : m_renderables)
+		{
+			if (!r.renderable->CanBeQueuedConcurrently())
+				return false;
+		}
+
+		return true;
+	}
+
 	/*!
 	* \brief Clears every renderable elements
 	*/
@@ -183,6 +202,17 @@ namespace Ndk
 		return m_renderables[renderableIndex].data.localMatrix;
 	}
 
+	/*!
+	* \brief Gets the render revision of the component
+	* \return Revision number, changed every time something affecting what the component adds to a render queue changes
+	*
+	* Revisions are unique to a component (two components never share a revision), allowing render queues to keep the data of a component as long as its revision stays the same
+	*/
+	inline Nz::UInt64 GraphicsComponent::GetRenderRevision() const
+	{
+		return m_renderRevision;
+	}
+
 	inline const Nz::Matrix4f& GraphicsComponent::GetTransformMatrix(std::size_t renderableIndex) const
 	{
 		EnsureBoundingVolumesUpdate();
@@ -222,8 +252,7 @@ namespace Ndk
 	{
 		m_scissorRect = scissorRect;
 
-		for (CullingBoxEntry& entry : m_cullingBoxEntries)
-			entry.listEntry.ForceInvalidation(); //< Invalidate render queues
+		ForceCullingInvalidation();
 	}
 
 	inline void GraphicsComponent::UpdateLocalMatrix(const Nz::InstancedRenderable* instancedRenderable, const Nz::Matrix4f& localMatrix)
@@ -247,6 +276,8 @@ namespace Ndk
 			if (renderable.renderable == instancedRenderable)
 			{
 				renderable.data.renderOrder = renderOrder;
+
+				InvalidateRenderRevision();
 				break;
 			}
 		}
@@ -258,6 +289,8 @@ namespace Ndk
 
 	inline void GraphicsComponent::ForceCullingInvalidation()
 	{
+		InvalidateRenderRevision();
+
 		for (CullingBoxEntry& entry : m_cullingBoxEntries)
 			entry.listEntry.ForceInvalidation(); //< Invalidate render queues
 	}
@@ -265,6 +298,8 @@ namespace Ndk
 	inline void GraphicsComponent::InvalidateAABB() const
 	{
 		m_boundingVolumesUpdated = false;
+
+		InvalidateRenderRevision();
 	}
 
 	/*!
@@ -275,6 +310,17 @@ namespace Ndk
 	{
 		for (Renderable& r : m_renderables)
 			r.dataUpdated = false;
+
+		InvalidateRenderRevision();
+	}
+
+	/*!
+	* \brief Gives a new render revision to the component
+	*/
+
+	inline void GraphicsComponent::InvalidateRenderRevision() const
+	{
+		m_renderRevision = ++s_renderRevisionCounter;
 	}
 
 	/*!
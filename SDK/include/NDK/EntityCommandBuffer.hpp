@@ -0,0 +1,77 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequisites.hpp
+
+#pragma once
+
+#ifndef NDK_ENTITYCOMMANDBUFFER_HPP
+#define NDK_ENTITYCOMMANDBUFFER_HPP
+
+#include <Nazara/Core/Mutex.hpp>
+#include <NDK/Entity.hpp>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Ndk
+{
+	class NDK_API EntityCommandBuffer
+	{
+		public:
+			using EntityInitializer = std::function<void(const EntityHandle& entity)>;
+
+			EntityCommandBuffer() = default;
+			EntityCommandBuffer(const EntityCommandBuffer&) = delete;
+			EntityCommandBuffer(EntityCommandBuffer&&) noexcept;
+			~EntityCommandBuffer();
+
+			void AddComponent(EntityId entity, std::unique_ptr<BaseComponent>&& component);
+			template<typename ComponentType, typename... Args> void AddComponent(EntityId entity, Args&&... args);
+
+			void Clear();
+			void CreateEntity(EntityInitializer initializer = nullptr);
+
+			void EnableEntity(EntityId entity, bool enable = true);
+			void Execute(World& world);
+
+			std::size_t GetCommandCount() const;
+
+			void KillEntity(EntityId entity);
+
+			void RemoveComponent(EntityId entity, ComponentIndex index);
+			template<typename ComponentType> void RemoveComponent(EntityId entity);
+
+			EntityCommandBuffer& operator=(const EntityCommandBuffer&) = delete;
+			EntityCommandBuffer& operator=(EntityCommandBuffer&&) noexcept;
+
+		private:
+			enum class CommandType
+			{
+				AddComponent,
+				CreateEntity,
+				EnableEntity,
+				KillEntity,
+				RemoveComponent
+			};
+
+			struct Command
+			{
+				CommandType type;
+				EntityId entity;
+				ComponentIndex componentIndex;
+				EntityInitializer initializer;
+				std::unique_ptr<BaseComponent> component;
+				bool enable;
+			};
+
+			void PushCommand(Command&& command);
+
+			std::vector<Command> m_commands;
+			std::vector<Command> m_executedCommands;
+			mutable Nz::Mutex m_mutex;
+	};
+}
+
+#include <NDK/EntityCommandBuffer.inl>
+
+#endif // NDK_ENTITYCOMMANDBUFFER_HPP
@@ -0,0 +1,38 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequisites.hpp
+
+#include <NDK/Algorithm.hpp>
+#include <type_traits>
+
+namespace Ndk
+{
+	/*!
+	* \brief Records the addition of a component to an entity
+	*
+	* The component is built right away, by the calling thread
+	*
+	* \param entity Identifier of the entity
+	* \param args Arguments used to create the component
+	*/
+	template<typename ComponentType, typename... Args>
+	void EntityCommandBuffer::AddComponent(EntityId entity, Args&&... args)
+	{
+		static_assert(std::is_base_of<BaseComponent, ComponentType>::value, "ComponentType is not a component");
+
+		AddComponent(entity, std::make_unique<ComponentType>(std::forward<Args>(args)...));
+	}
+
+	/*!
+	* \brief Records the removal of a component from an entity
+	*
+	* \param entity Identifier of the entity
+	*/
+	template<typename ComponentType>
+	void EntityCommandBuffer::RemoveComponent(EntityId entity)
+	{
+		static_assert(std::is_base_of<BaseComponent, ComponentType>::value, "ComponentType is not a component");
+
+		RemoveComponent(entity, GetComponentIndex<ComponentType>());
+	}
+}
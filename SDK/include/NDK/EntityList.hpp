@@ -29,6 +29,10 @@ namespace Ndk
 
 			inline void Clear();
 
+			template<typename F> void ForEachInBlocks(std::size_t firstBlock, std::size_t lastBlock, const F& iterationFunc) const;
+
+			inline std::size_t GetBlockCount() const;
+
 			inline bool Has(const Entity* entity) const;
 			inline bool Has(EntityId entity) const;
 
@@ -37,6 +41,8 @@ namespace Ndk
 			inline void Remove(Entity* entity);
 			inline void Reserve(std::size_t entityCount);
 
+			static constexpr std::size_t EntitiesPerBlock = Nz::Bitset<Nz::UInt64>::bitsPerBlock;
+
 			// STL API
 			inline iterator begin() const;
 			inline bool empty() const;
@@ -67,6 +67,39 @@ namespace Ndk
 		m_world = nullptr;
 	}
 
+	/*!
+	* \brief Executes a function on the entities of a range of blocks
+	*
+	* Entities are stored in blocks of EntitiesPerBlock identifiers, different block ranges can be iterated over by different threads at the same time.
+	*
+	* \param firstBlock Index of the first block
+	* \param lastBlock Index of the block following the last one
+	* \param iterationFunc Function called with a const reference to the handle of every entity
+	*
+	* \see GetBlockCount
+	*/
+	template<typename F>
+	void EntityList::ForEachInBlocks(std::size_t firstBlock, std::size_t lastBlock, const F& iterationFunc) const
+	{
+		std::size_t firstId = firstBlock * EntitiesPerBlock;
+		std::size_t lastId = lastBlock * EntitiesPerBlock;
+
+		std::size_t id = (firstId > 0) ? m_entityBits.FindNext(firstId - 1) : m_entityBits.FindFirst();
+		for (; id != m_entityBits.npos && id < lastId; id = m_entityBits.FindNext(id))
+			iterationFunc(*iterator(this, id));
+	}
+
+	/*!
+	* \brief Gets the number of entity blocks of the list
+	* \return Block count
+	*
+	* \see ForEachInBlocks
+	*/
+	inline std::size_t EntityList::GetBlockCount() const
+	{
+		return m_entityBits.GetBlockCount();
+	}
+
 	/*!
 	* \brief Checks whether or not the EntityList contains the entity
 	* \return true If it is the case
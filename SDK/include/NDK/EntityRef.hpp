@@ -0,0 +1,58 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequisites.hpp
+
+#pragma once
+
+#ifndef NDK_ENTITYREF_HPP
+#define NDK_ENTITYREF_HPP
+
+#include <NDK/Prerequisites.hpp>
+#include <functional>
+
+namespace Ndk
+{
+	class Entity;
+	class World;
+
+	class EntityRef
+	{
+		public:
+			EntityRef() = default;
+			inline EntityRef(World* world, EntityId id, Nz::UInt32 generation);
+			EntityRef(const EntityRef&) = default;
+			~EntityRef() = default;
+
+			inline Entity* Get() const;
+			inline Nz::UInt32 GetGeneration() const;
+			inline EntityId GetId() const;
+			inline World* GetWorld() const;
+
+			inline bool IsValid() const;
+
+			inline void Reset();
+
+			inline explicit operator bool() const;
+			inline Entity* operator->() const;
+
+			EntityRef& operator=(const EntityRef&) = default;
+
+			inline bool operator==(const EntityRef& ref) const;
+			inline bool operator!=(const EntityRef& ref) const;
+
+		private:
+			World* m_world = nullptr;
+			EntityId m_id = 0;
+			Nz::UInt32 m_generation = 0;
+	};
+}
+
+namespace std
+{
+	template<>
+	struct hash<Ndk::EntityRef>;
+}
+
+#include <NDK/EntityRef.inl>
+
+#endif // NDK_ENTITYREF_HPP
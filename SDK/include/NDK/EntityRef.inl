@@ -0,0 +1,169 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequisites.hpp
+
+#include <Nazara/Core/Algorithm.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <NDK/World.hpp>
+#include <type_traits>
+
+namespace Ndk
+{
+	/*!
+	* \ingroup NDK
+	* \class Ndk::EntityRef
+	* \brief NDK class that represents a lightweight reference to an entity, made of its identifier and generation
+	*
+	* Unlike EntityHandle, copying an EntityRef is a plain copy (no reference counting nor allocation).
+	* The world increments the generation of an identifier each time the entity using it is destroyed, which allows references to detect that their entity is gone even if its identifier has been reused.
+	*
+	* \remark The world must outlive its references and must not be moved while they are in use
+	*
+	* \see World::GetEntityRef
+	*/
+
+	static_assert(std::is_trivially_copyable<EntityRef>::value, "EntityRef must be trivially copyable");
+
+	/*!
+	* \brief Constructs a EntityRef object
+	*
+	* \param world World owning the entity
+	* \param id Identifier of the entity
+	* \param generation Generation of the identifier
+	*/
+	inline EntityRef::EntityRef(World* world, EntityId id, Nz::UInt32 generation) :
+	m_world(world),
+	m_id(id),
+	m_generation(generation)
+	{
+	}
+
+	/*!
+	* \brief Gets the referenced entity
+	* \return Pointer to the entity, or nullptr if the reference is no longer valid
+	*/
+	inline Entity* EntityRef::Get() const
+	{
+		if (!IsValid())
+			return nullptr;
+
+		return m_world->GetEntity(m_id).GetObject();
+	}
+
+	/*!
+	* \brief Gets the generation of the entity identifier when the reference was made
+	* \return Generation of the identifier
+	*/
+	inline Nz::UInt32 EntityRef::GetGeneration() const
+	{
+		return m_generation;
+	}
+
+	/*!
+	* \brief Gets the identifier of the referenced entity
+	* \return Identifier of the entity
+	*/
+	inline EntityId EntityRef::GetId() const
+	{
+		return m_id;
+	}
+
+	/*!
+	* \brief Gets the world owning the referenced entity
+	* \return Pointer to the world, or nullptr if the reference was default-constructed
+	*/
+	inline World* EntityRef::GetWorld() const
+	{
+		return m_world;
+	}
+
+	/*!
+	* \brief Checks whether the referenced entity is still alive
+	* \return true If the entity has not been destroyed since the reference was made
+	*
+	* \remark A dying entity (killed but not destroyed yet by World::Refresh) is still valid
+	*/
+	inline bool EntityRef::IsValid() const
+	{
+		return m_world && m_world->IsEntityIdValid(m_id) && m_world->GetEntityGeneration(m_id) == m_generation;
+	}
+
+	/*!
+	* \brief Resets the reference, making it invalid
+	*/
+	inline void EntityRef::Reset()
+	{
+		m_world = nullptr;
+		m_id = 0;
+		m_generation = 0;
+	}
+
+	/*!
+	* \brief Checks whether the referenced entity is still alive
+	* \return true If the entity has not been destroyed since the reference was made
+	*
+	* \see IsValid
+	*/
+	inline EntityRef::operator bool() const
+	{
+		return IsValid();
+	}
+
+	/*!
+	* \brief Dereferences the reference
+	* \return Pointer to the entity
+	*
+	* \remark Produces a NazaraAssert if the reference is not valid
+	*/
+	inline Entity* EntityRef::operator->() const
+	{
+		NazaraAssert(IsValid(), "Invalid entity reference");
+
+		return m_world->GetEntity(m_id).GetObject();
+	}
+
+	/*!
+	* \brief Compares two references
+	* \return true If both references were made to the same entity, regardless of their validity
+	*
+	* \param ref Other reference
+	*/
+	inline bool EntityRef::operator==(const EntityRef& ref) const
+	{
+		return m_world == ref.m_world && m_id == ref.m_id && m_generation == ref.m_generation;
+	}
+
+	/*!
+	* \brief Compares two references
+	* \return false If both references were made to the same entity, regardless of their validity
+	*
+	* \param ref Other reference
+	*/
+	inline bool EntityRef::operator!=(const EntityRef& ref) const
+	{
+		return !operator==(ref);
+	}
+}
+
+namespace std
+{
+	template<>
+	struct hash<Ndk::EntityRef>
+	{
+		/*!
+		* \brief Specialisation of std to hash
+		* \return Result of the hash
+		*
+		* \param ref Entity reference to hash
+		*/
+		std::size_t operator()(const Ndk::EntityRef& ref) const
+		{
+			std::size_t seed = 0;
+			Nz::HashCombine(seed, ref.GetWorld());
+			Nz::HashCombine(seed, ref.GetId());
+			Nz::HashCombine(seed, ref.GetGeneration());
+
+			return seed;
+		}
+	};
+}
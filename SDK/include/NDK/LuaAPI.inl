@@ -152,12 +152,14 @@ namespace Nz
 	{
 		state.CheckType(index, Nz::LuaType_Table);
 
-		params->animated             = state.CheckField<bool>("Animated", params->animated);
-		params->center               = state.CheckField<bool>("Center", params->center);
-		params->matrix               = state.CheckField<Matrix4f>("Matrix", params->matrix);
-		params->optimizeIndexBuffers = state.CheckField<bool>("OptimizeIndexBuffers", params->optimizeIndexBuffers);
-		params->texCoordOffset       = state.CheckField<Vector2f>("TexCoordOffset", params->texCoordOffset);
-		params->texCoordScale        = state.CheckField<Vector2f>("TexCoordScale", params->texCoordScale);
+		params->animated              = state.CheckField<bool>("Animated", params->animated);
+		params->center                = state.CheckField<bool>("Center", params->center);
+		params->matrix                = state.CheckField<Matrix4f>("Matrix", params->matrix);
+		params->optimizeIndexBuffers  = state.CheckField<bool>("OptimizeIndexBuffers", params->optimizeIndexBuffers);
+		params->optimizeOverdraw      = state.CheckField<bool>("OptimizeOverdraw", params->optimizeOverdraw);
+		params->optimizeVertexBuffers = state.CheckField<bool>("OptimizeVertexBuffers", params->optimizeVertexBuffers);
+		params->texCoordOffset        = state.CheckField<Vector2f>("TexCoordOffset", params->texCoordOffset);
+		params->texCoordScale         = state.CheckField<Vector2f>("TexCoordScale", params->texCoordScale);
 
 		return 1;
 	}
@@ -7,10 +7,12 @@
 #ifndef NDK_SYSTEMS_PHYSICSSYSTEM3D_HPP
 #define NDK_SYSTEMS_PHYSICSSYSTEM3D_HPP
 
+#include <Nazara/Core/Mutex.hpp>
 #include <Nazara/Physics3D/PhysWorld3D.hpp>
 #include <NDK/EntityList.hpp>
 #include <NDK/System.hpp>
 #include <memory>
+#include <vector>
 
 namespace Ndk
 {
@@ -30,9 +32,11 @@ namespace Ndk
 			void OnEntityValidation(Entity* entity, bool justAdded) override;
 			void OnUpdate(float elapsedTime) override;
 
+			std::vector<EntityId> m_hierarchyEntities;
 			EntityList m_dynamicObjects;
 			EntityList m_staticObjects;
 			mutable std::unique_ptr<Nz::PhysWorld3D> m_world; ///TODO: std::optional (Should I make a Nz::Optional class?)
+			Nz::Mutex m_hierarchyMutex;
 	};
 }
 
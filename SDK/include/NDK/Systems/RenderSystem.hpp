@@ -8,13 +8,19 @@
 #ifndef NDK_SYSTEMS_RENDERSYSTEM_HPP
 #define NDK_SYSTEMS_RENDERSYSTEM_HPP
 
+#include <Nazara/Core/FrameArena.hpp>
 #include <Nazara/Graphics/AbstractBackground.hpp>
+#include <Nazara/Graphics/BasicRenderQueue.hpp>
 #include <Nazara/Graphics/CullingList.hpp>
+#include <Nazara/Graphics/DepthRenderQueue.hpp>
 #include <Nazara/Graphics/DepthRenderTechnique.hpp>
+#include <Nazara/Math/Frustum.hpp>
 #include <Nazara/Renderer/RenderTexture.hpp>
 #include <NDK/EntityList.hpp>
 #include <NDK/System.hpp>
 #include <NDK/Components/GraphicsComponent.hpp>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace Ndk
@@ -32,15 +38,19 @@ namespace Ndk
 
 			inline void EnableCulling(bool enable);
 
+			inline Nz::CullingMode GetCullingMode() const;
 			inline const Nz::BackgroundRef& GetDefaultBackground() const;
 			inline const Nz::Matrix4f& GetCoordinateSystemMatrix() const;
 			inline Nz::Vector3f GetGlobalForward() const;
 			inline Nz::Vector3f GetGlobalRight() const;
 			inline Nz::Vector3f GetGlobalUp() const;
+			inline std::size_t GetRebuiltDrawableCount() const;
 			inline Nz::AbstractRenderTechnique& GetRenderTechnique() const;
+			inline std::size_t GetReusedDrawableCount() const;
 
 			inline bool IsCullingEnabled() const;
 
+			inline void SetCullingMode(Nz::CullingMode mode);
 			inline void SetDefaultBackground(Nz::BackgroundRef background);
 			inline void SetGlobalForward(const Nz::Vector3f& direction);
 			inline void SetGlobalRight(const Nz::Vector3f& direction);
@@ -55,12 +65,38 @@ namespace Ndk
 			void OnEntityValidation(Entity* entity, bool justAdded) override;
 			void OnUpdate(float elapsedTime) override;
 
+			void UpdateDrawableEntries(Nz::BasicRenderQueue* renderQueue, const Nz::Frustumf& frustum);
 			void UpdateDynamicReflections();
 			void UpdateDirectionalShadowMaps(const Nz::AbstractViewer& viewer);
 			void UpdatePointSpotShadowMaps();
 
+			struct PointSpotShadowCache
+			{
+				GraphicsComponentCullingList culling;
+				Nz::DepthRenderQueue renderQueues[6]; //< One per cubemap face for point lights, only the first one is used by spot lights
+				Nz::Frustumf cullingFrustum;
+				Nz::Frustumf frustums[6];
+				Nz::Matrix4f projectionMatrix;
+				Nz::Matrix4f viewMatrices[6];
+				Nz::LightType lightType;
+				Nz::Quaternionf rotation;
+				Nz::Vector3f position;
+				float outerAngle;
+				float radius;
+				std::size_t visibilityHash;
+				bool invalidated;
+			};
+
+			struct DrawableUpdate
+			{
+				const GraphicsComponent* gfxComponent;
+				Nz::BasicRenderQueue* renderQueue;
+				bool frustumDependent;
+			};
+
 			std::unique_ptr<Nz::AbstractRenderTechnique> m_renderTechnique;
 			std::vector<GraphicsComponentCullingList::VolumeEntry> m_volumeEntries;
+			std::unordered_map<EntityId, std::unique_ptr<PointSpotShadowCache>> m_pointSpotShadowCaches;
 			std::vector<EntityHandle> m_cameras;
 			EntityList m_drawables;
 			EntityList m_directionalLights;
@@ -71,8 +107,11 @@ namespace Ndk
 			GraphicsComponentCullingList m_drawableCulling;
 			Nz::BackgroundRef m_background;
 			Nz::DepthRenderTechnique m_shadowTechnique;
+			Nz::FrameArena m_frameArena; //< Memory of the data only needed during an update, reset by every OnUpdate call
 			Nz::Matrix4f m_coordinateSystemMatrix;
 			Nz::RenderTexture m_shadowRT;
+			std::size_t m_rebuiltDrawableCount;
+			std::size_t m_reusedDrawableCount;
 			bool m_coordinateSystemInvalidated;
 			bool m_forceRenderQueueInvalidation;
 			bool m_isCullingEnabled;
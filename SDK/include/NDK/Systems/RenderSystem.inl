@@ -48,6 +48,17 @@ namespace Ndk
 		m_isCullingEnabled = enable;
 	}
 
+	/*!
+	* \brief Gets the way drawables are culled
+	* \return Culling mode (linear by default)
+	*
+	* \see SetCullingMode
+	*/
+	inline Nz::CullingMode RenderSystem::GetCullingMode() const
+	{
+		return m_drawableCulling.GetCullingMode();
+	}
+
 	/*!
 	* \brief Gets the background used for rendering
 	* \return A reference to the background
@@ -98,6 +109,20 @@ namespace Ndk
 		return Nz::Vector3f(m_coordinateSystemMatrix.m12, m_coordinateSystemMatrix.m22, m_coordinateSystemMatrix.m32);
 	}
 
+	/*!
+	* \brief Gets the number of drawables which were added again to the render queue during the last update
+	* \return Number of rebuilt render queue entries, summed over every camera
+	*
+	* \remark Drawables are only kept between frames with the basic forward render technique, other techniques rebuild their render queue entirely
+	*
+	* \see GetReusedDrawableCount
+	*/
+
+	inline std::size_t RenderSystem::GetRebuiltDrawableCount() const
+	{
+		return m_rebuiltDrawableCount;
+	}
+
 	/*!
 	* \brief Gets the render technique used for rendering
 	* \return A reference to the abstract render technique being used
@@ -108,6 +133,18 @@ namespace Ndk
 		return *m_renderTechnique.get();
 	}
 
+	/*!
+	* \brief Gets the number of visible drawables whose render queue data was kept from the previous frames during the last update
+	* \return Number of reused render queue entries, summed over every camera
+	*
+	* \see GetRebuiltDrawableCount
+	*/
+
+	inline std::size_t RenderSystem::GetReusedDrawableCount() const
+	{
+		return m_reusedDrawableCount;
+	}
+
 	/*!
 	* \brief Query if culling is enabled (enabled by default)
 	* \return True if culling is enabled, false otherwise
@@ -119,6 +156,23 @@ namespace Ndk
 		return m_isCullingEnabled;
 	}
 
+	/*!
+	* \brief Sets the way drawables are culled
+	*
+	* The hierarchical mode stores the drawables in a bounding volume tree, which is faster for scenes with a lot of static drawables.
+	*
+	* \param mode Culling mode used for the cameras and the shadow casting lights
+	*
+	* \see GetCullingMode
+	*/
+	inline void RenderSystem::SetCullingMode(Nz::CullingMode mode)
+	{
+		m_drawableCulling.SetCullingMode(mode);
+
+		for (auto& pair : m_pointSpotShadowCaches)
+			pair.second->culling.SetCullingMode(mode);
+	}
+
 	/*!
 	* \brief Sets the background used for rendering
 	*
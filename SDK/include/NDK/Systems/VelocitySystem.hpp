@@ -7,7 +7,9 @@
 #ifndef NDK_SYSTEMS_VELOCITYSYSTEM_HPP
 #define NDK_SYSTEMS_VELOCITYSYSTEM_HPP
 
+#include <Nazara/Core/Mutex.hpp>
 #include <NDK/System.hpp>
+#include <vector>
 
 namespace Ndk
 {
@@ -21,6 +23,9 @@ namespace Ndk
 
 		private:
 			void OnUpdate(float elapsedTime) override;
+
+			std::vector<EntityId> m_hierarchyEntities;
+			Nz::Mutex m_hierarchyMutex;
 	};
 }
 
@@ -9,15 +9,23 @@
 
 #include <Nazara/Core/Bitset.hpp>
 #include <Nazara/Core/HandledObject.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <NDK/BaseComponent.hpp>
+#include <NDK/ComponentPool.hpp>
+#include <NDK/EntityCommandBuffer.hpp>
 #include <NDK/Entity.hpp>
 #include <NDK/EntityList.hpp>
 #include <NDK/System.hpp>
 #include <algorithm>
+#include <atomic>
 #include <memory>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace Ndk
 {
+	class EntityRef;
 	class World;
 
 	using WorldHandle = Nz::ObjectHandle<World>;
@@ -51,10 +59,17 @@ namespace Ndk
 			inline void DisableProfiler();
 			inline void EnableProfiler(bool enable = true);
 
+			template<typename... ComponentTypes, typename F> void ForEachComponent(const F& iterationFunc);
 			template<typename F> void ForEachSystem(const F& iterationFunc);
 			template<typename F> void ForEachSystem(const F& iterationFunc) const;
 
+			inline EntityCommandBuffer& GetCommandBuffer();
+			inline ComponentPool& GetComponentPool(ComponentIndex index);
+			template<typename ComponentType> ComponentPool& GetComponentPool();
 			inline const EntityHandle& GetEntity(EntityId id);
+			inline Nz::UInt32 GetEntityGeneration(EntityId id) const;
+			inline EntityRef GetEntityRef(EntityId id);
+			inline EntityRef GetEntityRef(const Entity* entity);
 			inline const EntityList& GetEntities() const;
 			inline const ProfilerData& GetProfilerData() const;
 			inline BaseSystem& GetSystem(SystemIndex index);
@@ -74,6 +89,8 @@ namespace Ndk
 			inline bool IsEntityIdValid(EntityId id) const;
 			inline bool IsProfilerEnabled() const;
 
+			template<typename... ComponentTypes, typename F> void ParallelForEachComponent(const F& iterationFunc, std::size_t componentsPerTask = 1024);
+
 			void Refresh();
 
 			inline void RemoveAllSystems();
@@ -88,16 +105,24 @@ namespace Ndk
 
 			struct ProfilerData
 			{
+				Nz::UInt64 criticalPathTime = 0;
 				Nz::UInt64 refreshTime = 0;
 				std::vector<Nz::UInt64> updateTime;
 				std::size_t updateCount = 0;
 			};
 
 		private:
+			inline void AttachComponent(EntityId id, BaseComponent* component);
+			inline void DetachComponent(EntityId id, ComponentIndex index);
+			template<typename... ComponentTypes, typename F, std::size_t... Indices> static void ForEachComponentImpl(ComponentPool* const* pools, std::size_t smallestPoolIndex, std::size_t firstComponent, std::size_t lastComponent, const F& iterationFunc, std::index_sequence<Indices...>);
+			static inline std::size_t GetSmallestPoolIndex(ComponentPool* const* pools, std::size_t poolCount);
 			inline void Invalidate();
 			inline void Invalidate(EntityId id);
 			inline void InvalidateSystemOrder();
 			void ReorderSystems();
+			void ReserveEntityBlocks(std::size_t count);
+			void UpdateSystem(std::size_t orderedIndex, float elapsedTime);
+			void UpdateSystemsConcurrently(float elapsedTime);
 
 			struct DoubleBitset
 			{
@@ -105,6 +130,14 @@ namespace Ndk
 				Nz::Bitset<Nz::UInt64> back;
 			};
 
+			struct SystemNode
+			{
+				std::vector<std::size_t> dependencies;
+				std::vector<std::size_t> dependents;
+				Nz::UInt64 pathTime;
+				Nz::UInt64 updateTime;
+			};
+
 			struct EntityBlock
 			{
 				EntityBlock(Entity&& e) :
@@ -119,16 +152,24 @@ namespace Ndk
 				EntityHandle handle;
 			};
 
+			std::vector<ComponentPool> m_componentPools;
 			std::vector<std::unique_ptr<BaseSystem>> m_systems;
 			std::vector<BaseSystem*> m_orderedSystems;
+			std::vector<SystemNode> m_systemGraph;
 			std::vector<EntityBlock> m_entities;
 			std::vector<EntityBlock*> m_entityBlocks;
-			std::vector<std::unique_ptr<EntityBlock>> m_waitingEntities;
+			std::vector<Nz::UInt32> m_entityGenerations;
+			std::vector<std::vector<EntityBlock>> m_waitingEntities;
+			std::unique_ptr<std::atomic_size_t[]> m_remainingSystemDependencies;
+			std::unordered_map<Nz::Bitset<>, Nz::Bitset<>> m_systemFilterCache;
+			EntityCommandBuffer m_commandBuffer;
 			EntityList m_aliveEntities;
 			ProfilerData m_profilerData;
 			DoubleBitset m_dirtyEntities;
 			Nz::Bitset<Nz::UInt64> m_freeEntityIds;
 			DoubleBitset m_killedEntities;
+			mutable Nz::Mutex m_entityStateMutex;
+			bool m_hasConcurrentSystems;
 			bool m_orderedSystemsUpdated;
 			bool m_isProfilerEnabled;
 	};
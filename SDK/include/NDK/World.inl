@@ -4,6 +4,9 @@
 
 #include <NDK/World.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/ParallelAlgorithm.hpp>
+#include <NDK/EntityRef.hpp>
 #include <type_traits>
 
 namespace Ndk
@@ -15,6 +18,7 @@ namespace Ndk
 	*/
 
 	inline World::World(bool addDefaultSystems) :
+	m_hasConcurrentSystems(false),
 	m_orderedSystemsUpdated(false),
 	m_isProfilerEnabled(false)
 	{
@@ -85,10 +89,14 @@ namespace Ndk
 	* \brief Creates multiple entities in the world
 	* \return The set of entities created
 	*
+	* Memory for every entity is allocated at once.
+	*
 	* \param count Number of entities to create
 	*/
 	inline World::EntityVector World::CreateEntities(unsigned int count)
 	{
+		ReserveEntityBlocks(count);
+
 		EntityVector list;
 		list.reserve(count);
 
@@ -133,6 +141,31 @@ namespace Ndk
 		}
 	}
 
+	/*!
+	* \brief Executes a function on every entity having all the given component types
+	*
+	* Calls iterationFunc(EntityId, ComponentTypes&...) for every entity having all of them, walking the packed pool of the rarest component type and looking the others up by identifier.
+	* Unlike iterating over entities, this never touches the entities themselves.
+	*
+	* \param iterationFunc Function to be called
+	*
+	* \remark Components being removed are still iterated over until the next Refresh
+	* \remark iterationFunc may add components but must not drop components of the iterated types
+	*
+	* \see GetComponentPool
+	*/
+	template<typename... ComponentTypes, typename F>
+	void World::ForEachComponent(const F& iterationFunc)
+	{
+		static_assert(sizeof...(ComponentTypes) > 0, "At least one component type is required");
+
+		ComponentPool* pools[] = { &GetComponentPool<ComponentTypes>()... };
+		std::size_t smallestPoolIndex = GetSmallestPoolIndex(pools, sizeof...(ComponentTypes));
+
+		// Components added during the iteration are not visited (and may reallocate the pool arrays)
+		ForEachComponentImpl<ComponentTypes...>(pools, smallestPoolIndex, 0, pools[smallestPoolIndex]->GetSize(), iterationFunc, std::index_sequence_for<ComponentTypes...>());
+	}
+
 	/*!
 	* \brief Executes a function on every present system
 	*
@@ -167,6 +200,45 @@ namespace Ndk
 		}
 	}
 
+	/*!
+	* \brief Gets the command buffer of the world, executed at the beginning of each Refresh
+	* \return A reference to the command buffer
+	*
+	* This allows to create entities and to add or remove components from multiple threads, like systems updated concurrently.
+	*/
+	inline EntityCommandBuffer& World::GetCommandBuffer()
+	{
+		return m_commandBuffer;
+	}
+
+	/*!
+	* \brief Gets the pool holding every component of a type in this world
+	* \return A reference to the pool
+	*
+	* \param index Index of the component type
+	*/
+	inline ComponentPool& World::GetComponentPool(ComponentIndex index)
+	{
+		// Make room for every registered component type at once, so that pool references stay valid
+		if (index >= m_componentPools.size())
+			m_componentPools.resize(std::max<std::size_t>(index + 1, BaseComponent::GetMaxComponentIndex()));
+
+		return m_componentPools[index];
+	}
+
+	/*!
+	* \brief Gets the pool holding every component of a type in this world
+	* \return A reference to the pool
+	*/
+	template<typename ComponentType>
+	ComponentPool& World::GetComponentPool()
+	{
+		using Type = std::remove_const_t<ComponentType>;
+		static_assert(std::is_base_of<BaseComponent, Type>::value, "ComponentType is not a component");
+
+		return GetComponentPool(GetComponentIndex<Type>());
+	}
+
 	/*!
 	* \brief Gets an entity
 	* \return A constant reference to a handle of the entity
@@ -187,6 +259,51 @@ namespace Ndk
 		}
 	}
 
+	/*!
+	* \brief Gets the generation of an entity identifier
+	* \return Number of entities which were destroyed while using this identifier
+	*
+	* \param id Identifier of the entity
+	*
+	* \see EntityRef
+	*/
+	inline Nz::UInt32 World::GetEntityGeneration(EntityId id) const
+	{
+		return (id < m_entityGenerations.size()) ? m_entityGenerations[id] : 0;
+	}
+
+	/*!
+	* \brief Gets a lightweight reference to an entity
+	* \return Reference to the entity, or an invalid reference if the identifier is not valid
+	*
+	* \param id Identifier of the entity
+	*
+	* \see EntityRef
+	*/
+	inline EntityRef World::GetEntityRef(EntityId id)
+	{
+		if (!IsEntityIdValid(id))
+			return EntityRef();
+
+		return EntityRef(this, id, GetEntityGeneration(id));
+	}
+
+	/*!
+	* \brief Gets a lightweight reference to an entity
+	* \return Reference to the entity, or an invalid reference if the entity is not valid
+	*
+	* \param entity Pointer to the entity
+	*
+	* \see EntityRef
+	*/
+	inline EntityRef World::GetEntityRef(const Entity* entity)
+	{
+		if (!IsEntityValid(entity))
+			return EntityRef();
+
+		return EntityRef(this, entity->GetId(), GetEntityGeneration(entity->GetId()));
+	}
+
 	/*!
 	* \brief Gets every entities in the world
 	* \return A constant reference to the entities
@@ -304,24 +421,33 @@ namespace Ndk
 	*
 	* \remark If the entity pointer is invalid, nothing is done
 	* \remark For safety, entities are not killed until the next world update
+	* \remark This can be called by systems updated concurrently
 	*/
 	inline void World::KillEntity(Entity* entity)
 	{
 		if (IsEntityValid(entity))
+		{
+			Nz::LockGuard lock(m_entityStateMutex);
 			m_killedEntities.front.UnboundedSet(entity->GetId(), true);
+		}
 	}
 
 	/*!
 	* \brief Kills a set of entities
 	*
-	* This function has the same effect as calling KillEntity for every entity contained in the vector
+	* This function has the same effect as calling KillEntity for every entity contained in the vector, but locks the world only once
 	*
 	* \param list Set of entities to kill
 	*/
 	inline void World::KillEntities(const EntityVector& list)
 	{
+		Nz::LockGuard lock(m_entityStateMutex);
+
 		for (const EntityHandle& entity : list)
-			KillEntity(entity);
+		{
+			if (IsEntityValid(entity))
+				m_killedEntities.front.UnboundedSet(entity->GetId(), true);
+		}
 	}
 
 	/*!
@@ -343,6 +469,7 @@ namespace Ndk
 	*/
 	inline bool World::IsEntityDying(EntityId id) const
 	{
+		Nz::LockGuard lock(m_entityStateMutex);
 		return m_killedEntities.front.UnboundedTest(id);
 	}
 
@@ -379,6 +506,33 @@ namespace Ndk
 		return m_isProfilerEnabled;
 	}
 
+	/*!
+	* \brief Executes a function on every entity having all the given component types, using the TaskScheduler workers
+	*
+	* Works like ForEachComponent, except the packed pool of the rarest component type is split in chunks of componentsPerTask components, each of them being processed by one thread.
+	*
+	* \param iterationFunc Function called with the identifier of every entity and its components, from multiple threads
+	* \param componentsPerTask Number of components of the rarest type processed by each task
+	*
+	* \remark iterationFunc must only change the components it is called with, structural changes (entity creation/destruction, component addition/removal) must go through the world command buffer
+	*
+	* \see ForEachComponent
+	* \see GetCommandBuffer
+	*/
+	template<typename... ComponentTypes, typename F>
+	void World::ParallelForEachComponent(const F& iterationFunc, std::size_t componentsPerTask)
+	{
+		static_assert(sizeof...(ComponentTypes) > 0, "At least one component type is required");
+
+		ComponentPool* pools[] = { &GetComponentPool<ComponentTypes>()... };
+		std::size_t smallestPoolIndex = GetSmallestPoolIndex(pools, sizeof...(ComponentTypes));
+
+		Nz::ParallelFor(std::size_t(0), pools[smallestPoolIndex]->GetSize(), componentsPerTask, [&](std::size_t firstComponent, std::size_t lastComponent)
+		{
+			ForEachComponentImpl<ComponentTypes...>(pools, smallestPoolIndex, firstComponent, lastComponent, iterationFunc, std::index_sequence_for<ComponentTypes...>());
+		});
+	}
+
 	/*!
 	* \brief Removes each system from the world
 	*/
@@ -415,6 +569,7 @@ namespace Ndk
 	*/
 	inline void World::ResetProfiler()
 	{
+		m_profilerData.criticalPathTime = 0;
 		m_profilerData.refreshTime = 0;
 		m_profilerData.updateCount = 0;
 		std::fill(m_profilerData.updateTime.begin(), m_profilerData.updateTime.end(), 0);
@@ -439,23 +594,32 @@ namespace Ndk
 
 	inline World& World::operator=(World&& world) noexcept
 	{
-		m_aliveEntities         = std::move(world.m_aliveEntities);
-		m_dirtyEntities         = std::move(world.m_dirtyEntities);
-		m_entityBlocks          = std::move(world.m_entityBlocks);
-		m_freeEntityIds         = std::move(world.m_freeEntityIds);
-		m_killedEntities        = std::move(world.m_killedEntities);
-		m_orderedSystems        = std::move(world.m_orderedSystems);
-		m_orderedSystemsUpdated = world.m_orderedSystemsUpdated;
-		m_profilerData          = std::move(world.m_profilerData);
-		m_isProfilerEnabled     = world.m_isProfilerEnabled;
+		m_aliveEntities               = std::move(world.m_aliveEntities);
+		m_commandBuffer               = std::move(world.m_commandBuffer);
+		m_componentPools              = std::move(world.m_componentPools);
+		m_dirtyEntities               = std::move(world.m_dirtyEntities);
+		m_entityBlocks                = std::move(world.m_entityBlocks);
+		m_entityGenerations           = std::move(world.m_entityGenerations);
+		m_freeEntityIds               = std::move(world.m_freeEntityIds);
+		m_hasConcurrentSystems        = world.m_hasConcurrentSystems;
+		m_killedEntities              = std::move(world.m_killedEntities);
+		m_orderedSystems              = std::move(world.m_orderedSystems);
+		m_orderedSystemsUpdated       = world.m_orderedSystemsUpdated;
+		m_profilerData                = std::move(world.m_profilerData);
+		m_isProfilerEnabled           = world.m_isProfilerEnabled;
+		m_remainingSystemDependencies = std::move(world.m_remainingSystemDependencies);
+		m_systemGraph                 = std::move(world.m_systemGraph);
 
 		m_entities = std::move(world.m_entities);
 		for (EntityBlock& block : m_entities)
 			block.entity.SetWorld(this);
 
 		m_waitingEntities = std::move(world.m_waitingEntities);
-		for (auto& blockPtr : m_waitingEntities)
-			blockPtr->entity.SetWorld(this);
+		for (auto& blocks : m_waitingEntities)
+		{
+			for (EntityBlock& block : blocks)
+				block.entity.SetWorld(this);
+		}
 
 		m_systems = std::move(world.m_systems);
 		for (const auto& systemPtr : m_systems)
@@ -465,6 +629,51 @@ namespace Ndk
 		return *this;
 	}
 
+	inline void World::AttachComponent(EntityId id, BaseComponent* component)
+	{
+		GetComponentPool(component->GetIndex()).Insert(id, component);
+	}
+
+	inline void World::DetachComponent(EntityId id, ComponentIndex index)
+	{
+		GetComponentPool(index).Remove(id);
+	}
+
+	template<typename... ComponentTypes, typename F, std::size_t... Indices>
+	void World::ForEachComponentImpl(ComponentPool* const* pools, std::size_t smallestPoolIndex, std::size_t firstComponent, std::size_t lastComponent, const F& iterationFunc, std::index_sequence<Indices...>)
+	{
+		constexpr std::size_t PoolCount = sizeof...(ComponentTypes);
+
+		const ComponentPool& smallestPool = *pools[smallestPoolIndex];
+		for (std::size_t i = firstComponent; i < lastComponent; ++i)
+		{
+			EntityId id = smallestPool.GetEntities()[i];
+
+			BaseComponent* components[PoolCount];
+			bool hasComponents = true;
+			for (std::size_t j = 0; j < PoolCount && hasComponents; ++j)
+			{
+				components[j] = (j == smallestPoolIndex) ? smallestPool.GetComponents()[i] : pools[j]->Get(id);
+				hasComponents = (components[j] != nullptr);
+			}
+
+			if (hasComponents)
+				iterationFunc(id, static_cast<ComponentTypes&>(*components[Indices])...);
+		}
+	}
+
+	inline std::size_t World::GetSmallestPoolIndex(ComponentPool* const* pools, std::size_t poolCount)
+	{
+		std::size_t smallestPoolIndex = 0;
+		for (std::size_t i = 1; i < poolCount; ++i)
+		{
+			if (pools[i]->GetSize() < pools[smallestPoolIndex]->GetSize())
+				smallestPoolIndex = i;
+		}
+
+		return smallestPoolIndex;
+	}
+
 	inline void World::Invalidate()
 	{
 		m_dirtyEntities.front.Resize(m_entityBlocks.size(), false);
@@ -473,6 +682,7 @@ namespace Ndk
 
 	inline void World::Invalidate(EntityId id)
 	{
+		Nz::LockGuard lock(m_entityStateMutex);
 		m_dirtyEntities.front.UnboundedSet(id, true);
 	}
 
@@ -25,6 +25,26 @@ namespace Ndk
 			entity->UnregisterSystem(m_systemIndex);
 	}
 
+	/*!
+	* \brief Checks whether or not this system and another one must not be updated at the same time
+	* \return true If one of them writes a component accessed by the other, or if one of them did not declare its component accesses
+	*
+	* \param system Other system
+	*
+	* \see Reads
+	* \see Writes
+	*/
+
+	bool BaseSystem::ConflictsWith(const BaseSystem& system) const
+	{
+		if (!HasDeclaredComponentAccess() || !system.HasDeclaredComponentAccess())
+			return true;
+
+		return m_writtenComponents.Intersects(system.m_readComponents) ||
+		       m_writtenComponents.Intersects(system.m_writtenComponents) ||
+		       m_readComponents.Intersects(system.m_writtenComponents);
+	}
+
 	/*!
 	* \brief Checks whether the key of the entity matches the lock of the system
 	* \return true If it is the case
@@ -62,6 +82,7 @@ namespace Ndk
 	*
 	* The system update order is used by the world it belongs to in order to know in which order they should be updated, as some application logic may rely a specific update order.
 	* A system with a greater update order (ex: 1) is guaranteed to be updated after a system with a lesser update order (ex: -1), otherwise the order is unspecified (and is not guaranteed to be stable).
+	* This only holds for conflicting systems: systems which don't conflict (see ConflictsWith) may be updated at the same time.
 	*
 	* \param updateOrder The relative update order of the system
 	*
@@ -345,4 +345,5 @@ namespace Ndk
 	}
 
 	ComponentIndex GraphicsComponent::componentIndex;
+	std::atomic<Nz::UInt64> GraphicsComponent::s_renderRevisionCounter(0);
 }
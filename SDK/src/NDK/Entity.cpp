@@ -70,6 +70,8 @@ namespace Ndk
 		BaseComponent& component = *m_components[index].get();
 		component.SetEntity(this);
 
+		m_world->AttachComponent(m_id, &component);
+
 		for (std::size_t i = m_componentBits.FindFirst(); i != m_componentBits.npos; i = m_componentBits.FindNext(i))
 		{
 			if (i != index)
@@ -122,6 +124,8 @@ namespace Ndk
 		m_componentBits.Reset(index);
 		m_removedComponentBits.UnboundedReset(index);
 
+		m_world->DetachComponent(m_id, index);
+
 		component->SetEntity(nullptr);
 
 		return component;
@@ -224,6 +228,9 @@ namespace Ndk
 		m_systemBits.Clear();
 
 		// Destroy components
+		for (std::size_t i = m_componentBits.FindFirst(); i != m_componentBits.npos; i = m_componentBits.FindNext(i))
+			m_world->DetachComponent(m_id, static_cast<ComponentIndex>(i));
+
 		m_components.clear();
 		m_componentBits.Reset();
 
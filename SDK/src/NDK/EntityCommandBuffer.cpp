@@ -0,0 +1,210 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequisites.hpp
+
+#include <NDK/EntityCommandBuffer.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <NDK/BaseComponent.hpp>
+#include <NDK/World.hpp>
+
+namespace Ndk
+{
+	/*!
+	* \ingroup NDK
+	* \class Ndk::EntityCommandBuffer
+	* \brief NDK class that records structural changes (entity creation, component addition, ...) to apply them later
+	*
+	* Recording is thread-safe, which allows code running on multiple threads (like BaseSystem::ParallelForEachEntity) to change entities.
+	* Each world has one, which is executed at the beginning of World::Refresh.
+	*
+	* \remark Commands targeting an entity which is no longer valid when the buffer is executed are ignored
+	*
+	* \see World::GetCommandBuffer
+	*/
+
+	// Must exist in .cpp file because of BaseComponent unique_ptr
+	EntityCommandBuffer::EntityCommandBuffer(EntityCommandBuffer&& commandBuffer) noexcept :
+	m_commands(std::move(commandBuffer.m_commands))
+	{
+	}
+
+	EntityCommandBuffer::~EntityCommandBuffer() = default;
+
+	/*!
+	* \brief Records the addition of a component to an entity
+	*
+	* \param entity Identifier of the entity
+	* \param component Component to add to the entity
+	*
+	* \remark Produces a NazaraAssert if component is invalid
+	*/
+	void EntityCommandBuffer::AddComponent(EntityId entity, std::unique_ptr<BaseComponent>&& component)
+	{
+		NazaraAssert(component, "Invalid component");
+
+		Command command;
+		command.type = CommandType::AddComponent;
+		command.entity = entity;
+		command.component = std::move(component);
+
+		PushCommand(std::move(command));
+	}
+
+	/*!
+	* \brief Removes every recorded command without executing them
+	*/
+	void EntityCommandBuffer::Clear()
+	{
+		Nz::LockGuard lock(m_mutex);
+		m_commands.clear();
+	}
+
+	/*!
+	* \brief Records the creation of an entity
+	*
+	* \param initializer Optional function called with the new entity, to add its components
+	*/
+	void EntityCommandBuffer::CreateEntity(EntityInitializer initializer)
+	{
+		Command command;
+		command.type = CommandType::CreateEntity;
+		command.initializer = std::move(initializer);
+
+		PushCommand(std::move(command));
+	}
+
+	/*!
+	* \brief Records the activation or deactivation of an entity
+	*
+	* \param entity Identifier of the entity
+	* \param enable Should the entity be enabled
+	*/
+	void EntityCommandBuffer::EnableEntity(EntityId entity, bool enable)
+	{
+		Command command;
+		command.type = CommandType::EnableEntity;
+		command.entity = entity;
+		command.enable = enable;
+
+		PushCommand(std::move(command));
+	}
+
+	/*!
+	* \brief Applies every recorded command to a world, in the order they were recorded
+	*
+	* Commands recorded while executing are kept for the next execution.
+	*
+	* \param world World containing the entities
+	*/
+	void EntityCommandBuffer::Execute(World& world)
+	{
+		{
+			Nz::LockGuard lock(m_mutex);
+			std::swap(m_commands, m_executedCommands);
+		}
+
+		for (Command& command : m_executedCommands)
+		{
+			if (command.type == CommandType::CreateEntity)
+			{
+				const EntityHandle& entity = world.CreateEntity();
+				if (command.initializer)
+					command.initializer(entity);
+
+				continue;
+			}
+
+			if (!world.IsEntityIdValid(command.entity))
+				continue;
+
+			const EntityHandle& entity = world.GetEntity(command.entity);
+			switch (command.type)
+			{
+				case CommandType::AddComponent:
+					entity->AddComponent(std::move(command.component));
+					break;
+
+				case CommandType::EnableEntity:
+					entity->Enable(command.enable);
+					break;
+
+				case CommandType::KillEntity:
+					entity->Kill();
+					break;
+
+				case CommandType::RemoveComponent:
+					entity->RemoveComponent(command.componentIndex);
+					break;
+
+				case CommandType::CreateEntity:
+					break;
+			}
+		}
+
+		// Keep the memory for the next time
+		m_executedCommands.clear();
+	}
+
+	/*!
+	* \brief Gets the number of commands waiting for execution
+	* \return Command count
+	*/
+	std::size_t EntityCommandBuffer::GetCommandCount() const
+	{
+		Nz::LockGuard lock(m_mutex);
+		return m_commands.size();
+	}
+
+	/*!
+	* \brief Records the death of an entity
+	*
+	* \param entity Identifier of the entity
+	*
+	* \remark World::KillEntity is already thread-safe, this is only useful to order the death with other commands
+	*/
+	void EntityCommandBuffer::KillEntity(EntityId entity)
+	{
+		Command command;
+		command.type = CommandType::KillEntity;
+		command.entity = entity;
+
+		PushCommand(std::move(command));
+	}
+
+	/*!
+	* \brief Records the removal of a component from an entity
+	*
+	* \param entity Identifier of the entity
+	* \param index Index of the component
+	*/
+	void EntityCommandBuffer::RemoveComponent(EntityId entity, ComponentIndex index)
+	{
+		Command command;
+		command.type = CommandType::RemoveComponent;
+		command.entity = entity;
+		command.componentIndex = index;
+
+		PushCommand(std::move(command));
+	}
+
+	/*!
+	* \brief Moves a command buffer into this one
+	* \return A reference to this
+	*
+	* \param commandBuffer Command buffer to move
+	*/
+	EntityCommandBuffer& EntityCommandBuffer::operator=(EntityCommandBuffer&& commandBuffer) noexcept
+	{
+		m_commands = std::move(commandBuffer.m_commands);
+		m_executedCommands.clear();
+
+		return *this;
+	}
+
+	void EntityCommandBuffer::PushCommand(Command&& command)
+	{
+		Nz::LockGuard lock(m_mutex);
+		m_commands.emplace_back(std::move(command));
+	}
+}
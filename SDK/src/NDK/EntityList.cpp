@@ -7,6 +7,8 @@
 
 namespace Ndk
 {
+	constexpr std::size_t EntityList::EntitiesPerBlock;
+
 	const EntityHandle& EntityList::iterator::operator*() const
 	{
 		return m_list->GetWorld()->GetEntity(static_cast<EntityId>(m_nextEntityId));
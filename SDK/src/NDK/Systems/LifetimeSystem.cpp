@@ -10,6 +10,7 @@ namespace Ndk
 	LifetimeSystem::LifetimeSystem()
 	{
 		Requires<LifetimeComponent>();
+		Writes<LifetimeComponent>(); //< Killing entities is allowed concurrently
 	}
 
 	void LifetimeSystem::OnUpdate(float elapsedTime)
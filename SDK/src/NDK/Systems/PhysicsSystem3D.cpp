@@ -3,11 +3,17 @@
 // For conditions of distribution and use, see copyright notice in Prerequisites.hpp
 
 #include <NDK/Systems/PhysicsSystem3D.hpp>
+#include <Nazara/Core/FrameArena.hpp>
+#include <Nazara/Core/FrameArenaAllocator.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/ParallelAlgorithm.hpp>
 #include <Nazara/Physics3D/RigidBody3D.hpp>
 #include <NDK/Components/CollisionComponent3D.hpp>
 #include <NDK/Components/NodeComponent.hpp>
 #include <NDK/Components/PhysicsComponent2D.hpp>
 #include <NDK/Components/PhysicsComponent3D.hpp>
+#include <NDK/World.hpp>
+#include <algorithm>
 
 namespace Ndk
 {
@@ -18,6 +24,7 @@ namespace Ndk
 	*
 	* \remark This system is enabled if the entity has the trait: NodeComponent and any of these two: CollisionComponent3D or PhysicsComponent3D
 	* \remark Static objects do not have a velocity specified by the physical engine
+	* \remark Nodes of dynamic objects are synchronized by multiple threads, except those having a parent or children
 	*/
 
 	/*!
@@ -91,7 +98,7 @@ namespace Ndk
 
 		m_world->Step(elapsedTime);
 
-		for (const Ndk::EntityHandle& entity : m_dynamicObjects)
+		auto SynchronizeNode = [](const EntityHandle& entity)
 		{
 			NodeComponent& node = entity->GetComponent<NodeComponent>();
 			PhysicsComponent3D& phys = entity->GetComponent<PhysicsComponent3D>();
@@ -99,7 +106,41 @@ namespace Ndk
 			Nz::RigidBody3D* physObj = phys.GetRigidBody();
 			node.SetRotation(physObj->GetRotation(), Nz::CoordSys_Global);
 			node.SetPosition(physObj->GetPosition(), Nz::CoordSys_Global);
-		}
+		};
+
+		// Same split as ParallelForEachEntity, each task collecting the entities it defers in the arena of its thread
+		Nz::ParallelFor(std::size_t(0), m_dynamicObjects.GetBlockCount(), 16, [&](std::size_t firstBlock, std::size_t lastBlock)
+		{
+			std::vector<EntityId, Nz::FrameArenaAllocator<EntityId>> hierarchyEntities(Nz::FrameArena::GetThreadArena());
+
+			m_dynamicObjects.ForEachInBlocks(firstBlock, lastBlock, [&](const EntityHandle& entity)
+			{
+				// Global transformations depend on the parent, and invalidate the children, which may be handled by another thread
+				NodeComponent& node = entity->GetComponent<NodeComponent>();
+				if (node.GetParent() || node.HasChilds())
+				{
+					hierarchyEntities.push_back(entity->GetId());
+					return;
+				}
+
+				SynchronizeNode(entity);
+			});
+
+			if (!hierarchyEntities.empty())
+			{
+				Nz::LockGuard lock(m_hierarchyMutex);
+				m_hierarchyEntities.insert(m_hierarchyEntities.end(), hierarchyEntities.begin(), hierarchyEntities.end());
+			}
+		});
+
+		// Keep the same order from one update to another
+		std::sort(m_hierarchyEntities.begin(), m_hierarchyEntities.end());
+
+		World& world = BaseSystem::GetWorld(); //< GetWorld returns the physical world
+		for (EntityId entityId : m_hierarchyEntities)
+			SynchronizeNode(world.GetEntity(entityId));
+
+		m_hierarchyEntities.clear();
 
 		float invElapsedTime = 1.f / elapsedTime;
 		for (const Ndk::EntityHandle& entity : m_staticObjects)
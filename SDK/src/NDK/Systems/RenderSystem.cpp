@@ -3,6 +3,8 @@
 // For conditions of distribution and use, see copyright notice in Prerequisites.hpp
 
 #include <NDK/Systems/RenderSystem.hpp>
+#include <Nazara/Core/FrameArenaAllocator.hpp>
+#include <Nazara/Core/ParallelAlgorithm.hpp>
 #include <Nazara/Graphics/ColorBackground.hpp>
 #include <Nazara/Graphics/ForwardRenderTechnique.hpp>
 #include <Nazara/Graphics/SceneData.hpp>
@@ -34,6 +36,8 @@ namespace Ndk
 	*/
 	RenderSystem::RenderSystem() :
 	m_coordinateSystemMatrix(Nz::Matrix4f::Identity()),
+	m_rebuiltDrawableCount(0),
+	m_reusedDrawableCount(0),
 	m_coordinateSystemInvalidated(true),
 	m_forceRenderQueueInvalidation(false),
 	m_isCullingEnabled(true)
@@ -62,10 +66,15 @@ namespace Ndk
 			}
 		}
 
+		m_pointSpotShadowCaches.erase(entity->GetId());
+
 		if (entity->HasComponent<GraphicsComponent>())
 		{
 			GraphicsComponent& gfxComponent = entity->GetComponent<GraphicsComponent>();
 			gfxComponent.RemoveFromCullingList(&m_drawableCulling);
+
+			for (auto& pair : m_pointSpotShadowCaches)
+				gfxComponent.RemoveFromCullingList(&pair.second->culling);
 		}
 	}
 
@@ -105,8 +114,13 @@ namespace Ndk
 
 			GraphicsComponent& gfxComponent = entity->GetComponent<GraphicsComponent>();
 			if (justAdded)
+			{
 				gfxComponent.AddToCullingList(&m_drawableCulling);
 
+				for (auto& pair : m_pointSpotShadowCaches)
+					gfxComponent.AddToCullingList(&pair.second->culling);
+			}
+
 			if (gfxComponent.DoesRequireRealTimeReflections())
 				m_realtimeReflected.Insert(entity);
 			else
@@ -121,6 +135,9 @@ namespace Ndk
 			{
 				GraphicsComponent& gfxComponent = entity->GetComponent<GraphicsComponent>();
 				gfxComponent.RemoveFromCullingList(&m_drawableCulling);
+
+				for (auto& pair : m_pointSpotShadowCaches)
+					gfxComponent.RemoveFromCullingList(&pair.second->culling);
 			}
 		}
 
@@ -133,6 +150,7 @@ namespace Ndk
 			{
 				m_directionalLights.Insert(entity);
 				m_pointSpotLights.Remove(entity);
+				m_pointSpotShadowCaches.erase(entity->GetId());
 			}
 			else
 			{
@@ -149,6 +167,7 @@ namespace Ndk
 			m_directionalLights.Remove(entity);
 			m_lights.Remove(entity);
 			m_pointSpotLights.Remove(entity);
+			m_pointSpotShadowCaches.erase(entity->GetId());
 		}
 
 		if (entity->HasComponent<ParticleGroupComponent>())
@@ -173,6 +192,11 @@ namespace Ndk
 
 	void RenderSystem::OnUpdate(float /*elapsedTime*/)
 	{
+		m_frameArena.Reset();
+
+		m_rebuiltDrawableCount = 0;
+		m_reusedDrawableCount = 0;
+
 		// Invalidate every renderable if the coordinate system changed
 		if (m_coordinateSystemInvalidated)
 		{
@@ -187,6 +211,13 @@ namespace Ndk
 
 		Nz::SkinningManager::Skin();
 
+		// To make sure the bounding volumes used by the culling lists (cameras and shadow casting lights) are updated
+		for (const Ndk::EntityHandle& drawable : m_drawables)
+		{
+			GraphicsComponent& graphicsComponent = drawable->GetComponent<GraphicsComponent>();
+			graphicsComponent.EnsureBoundingVolumesUpdate();
+		}
+
 		UpdateDynamicReflections();
 		UpdatePointSpotShadowMaps();
 
@@ -198,13 +229,6 @@ namespace Ndk
 
 			Nz::AbstractRenderQueue* renderQueue = m_renderTechnique->GetRenderQueue();
 
-			// To make sure the bounding volumes used by the culling list is updated
-			for (const Ndk::EntityHandle& drawable : m_drawables)
-			{
-				GraphicsComponent& graphicsComponent = drawable->GetComponent<GraphicsComponent>();
-				graphicsComponent.EnsureBoundingVolumesUpdate();
-			}
-
 			bool forceInvalidation = false;
 
 			const Nz::Frustumf& frustum = camComponent.GetFrustum();
@@ -215,19 +239,8 @@ namespace Ndk
 			else
 				visibilityHash = m_drawableCulling.FillWithAllEntries(&forceInvalidation);
 
-			// Always regenerate renderqueue if particle groups are present for now (FIXME)
-			if (!m_lights.empty() || !m_particleGroups.empty())
-				forceInvalidation = true;
-
-			if (camComponent.UpdateVisibility(visibilityHash) || m_forceRenderQueueInvalidation || forceInvalidation)
+			auto AddLightsAndParticleGroups = [&]()
 			{
-				renderQueue->Clear();
-				for (const GraphicsComponent* gfxComponent : m_drawableCulling.GetFullyVisibleResults())
-					gfxComponent->AddToRenderQueue(renderQueue);
-
-				for (const GraphicsComponent* gfxComponent : m_drawableCulling.GetPartiallyVisibleResults())
-					gfxComponent->AddToRenderQueueByCulling(frustum, renderQueue);
-
 				for (const Ndk::EntityHandle& light : m_lights)
 				{
 					LightComponent& lightComponent = light->GetComponent<LightComponent>();
@@ -243,9 +256,40 @@ namespace Ndk
 
 					groupComponent.AddToRenderQueue(renderQueue, Nz::Matrix4f::Identity()); //< ParticleGroup doesn't use any transform matrix (yet)
 				}
+			};
+
+			if (m_renderTechnique->GetType() == Nz::RenderTechniqueType_BasicForward)
+			{
+				// Drawables are kept in entries of the render queue and only added again when they change, lights and particles are transient
+				Nz::BasicRenderQueue* basicRenderQueue = static_cast<Nz::BasicRenderQueue*>(renderQueue);
+				basicRenderQueue->ClearUnkeyedData();
 
+				UpdateDrawableEntries(basicRenderQueue, frustum);
+				AddLightsAndParticleGroups();
+
+				camComponent.UpdateVisibility(visibilityHash);
 				m_forceRenderQueueInvalidation = false;
 			}
+			else
+			{
+				// Always regenerate renderqueue if particle groups are present for now (FIXME)
+				if (!m_lights.empty() || !m_particleGroups.empty())
+					forceInvalidation = true;
+
+				if (camComponent.UpdateVisibility(visibilityHash) || m_forceRenderQueueInvalidation || forceInvalidation)
+				{
+					renderQueue->Clear();
+					for (const GraphicsComponent* gfxComponent : m_drawableCulling.GetFullyVisibleResults())
+						gfxComponent->AddToRenderQueue(renderQueue);
+
+					for (const GraphicsComponent* gfxComponent : m_drawableCulling.GetPartiallyVisibleResults())
+						gfxComponent->AddToRenderQueueByCulling(frustum, renderQueue);
+
+					AddLightsAndParticleGroups();
+
+					m_forceRenderQueueInvalidation = false;
+				}
+			}
 
 			camComponent.ApplyView();
 
@@ -263,6 +307,68 @@ namespace Ndk
 		}
 	}
 
+	/*!
+	* \brief Updates the render queue entries of the visible drawables of the last culling
+	*
+	* Only drawables which were not visible, or whose render revision changed, are added again to the render queue.
+	* Those are filled in parallel by the TaskScheduler workers (each one in its own entry queue), except for drawables which cannot be queued concurrently.
+	*
+	* \param renderQueue Queue whose entries are updated
+	* \param frustum Frustum used to cull the renderables of partially visible drawables
+	*/
+	void RenderSystem::UpdateDrawableEntries(Nz::BasicRenderQueue* renderQueue, const Nz::Frustumf& frustum)
+	{
+		const auto& fullyVisibleResults = m_drawableCulling.GetFullyVisibleResults();
+		const auto& partiallyVisibleResults = m_drawableCulling.GetPartiallyVisibleResults();
+
+		std::vector<DrawableUpdate, Nz::FrameArenaAllocator<DrawableUpdate>> drawableUpdates(m_frameArena);
+		drawableUpdates.reserve(fullyVisibleResults.size() + partiallyVisibleResults.size());
+
+		auto UpdateEntry = [&](const GraphicsComponent* gfxComponent, bool fullyVisible)
+		{
+			// Partially visible drawables only add their visible renderables, which depends on the frustum
+			bool frustumDependent = !fullyVisible && gfxComponent->GetAttachedRenderableCount() > 1;
+
+			Nz::UInt64 revision = (frustumDependent) ? Nz::BasicRenderQueue::VolatileRevision : gfxComponent->GetRenderRevision();
+			if (Nz::BasicRenderQueue* entryQueue = renderQueue->UpdateEntry(gfxComponent, revision))
+				drawableUpdates.push_back({gfxComponent, entryQueue, frustumDependent});
+		};
+
+		for (const GraphicsComponent* gfxComponent : fullyVisibleResults)
+			UpdateEntry(gfxComponent, true);
+
+		for (const GraphicsComponent* gfxComponent : partiallyVisibleResults)
+			UpdateEntry(gfxComponent, false);
+
+		auto FillEntry = [&](const DrawableUpdate& drawableUpdate)
+		{
+			if (drawableUpdate.frustumDependent)
+				drawableUpdate.gfxComponent->AddToRenderQueueByCulling(frustum, drawableUpdate.renderQueue);
+			else
+				drawableUpdate.gfxComponent->AddToRenderQueue(drawableUpdate.renderQueue);
+		};
+
+		Nz::ParallelFor(std::size_t(0), drawableUpdates.size(), 64, [&](std::size_t first, std::size_t last)
+		{
+			for (std::size_t i = first; i < last; ++i)
+			{
+				if (drawableUpdates[i].gfxComponent->CanBeQueuedConcurrently())
+					FillEntry(drawableUpdates[i]);
+			}
+		});
+
+		for (const DrawableUpdate& drawableUpdate : drawableUpdates)
+		{
+			if (!drawableUpdate.gfxComponent->CanBeQueuedConcurrently())
+				FillEntry(drawableUpdate);
+		}
+
+		renderQueue->RemoveUnusedEntries();
+
+		m_rebuiltDrawableCount += renderQueue->GetRebuiltEntryCount();
+		m_reusedDrawableCount += renderQueue->GetReusedEntryCount();
+	}
+
 	/*!
 	* \brief Updates the directional shadow maps according to the position of the viewer
 	*
@@ -328,10 +434,23 @@ namespace Ndk
 
 	/*!
 	* \brief Updates the point spot shadow maps
+	*
+	* Each shadow casting light keeps its own culling list and depth render queues (one per face for point lights),
+	* which are only rebuilt when the light or a drawable inside its range changed.
 	*/
 
 	void RenderSystem::UpdatePointSpotShadowMaps()
 	{
+		static Nz::Quaternionf rotations[6] =
+		{
+			Nz::Quaternionf::RotationBetween(Nz::Vector3f::Forward(),  Nz::Vector3f::UnitX()), // CubemapFace_PositiveX
+			Nz::Quaternionf::RotationBetween(Nz::Vector3f::Forward(), -Nz::Vector3f::UnitX()), // CubemapFace_NegativeX
+			Nz::Quaternionf::RotationBetween(Nz::Vector3f::Forward(), -Nz::Vector3f::UnitY()), // CubemapFace_PositiveY
+			Nz::Quaternionf::RotationBetween(Nz::Vector3f::Forward(),  Nz::Vector3f::UnitY()), // CubemapFace_NegativeY
+			Nz::Quaternionf::RotationBetween(Nz::Vector3f::Forward(), -Nz::Vector3f::UnitZ()), // CubemapFace_PositiveZ
+			Nz::Quaternionf::RotationBetween(Nz::Vector3f::Forward(),  Nz::Vector3f::UnitZ())  // CubemapFace_NegativeZ
+		};
+
 		if (!m_shadowRT.IsValid())
 			m_shadowRT.Create();
 
@@ -346,80 +465,150 @@ namespace Ndk
 			NodeComponent& lightNode = light->GetComponent<NodeComponent>();
 
 			if (!lightComponent.IsShadowCastingEnabled())
+			{
+				// Don't keep every drawable registered in the culling list of a light which doesn't cast shadows anymore
+				m_pointSpotShadowCaches.erase(light->GetId());
 				continue;
+			}
 
-			Nz::Vector2ui shadowMapSize(lightComponent.GetShadowMap()->GetSize());
+			Nz::LightType lightType = lightComponent.GetLightType();
+			if (lightType == Nz::LightType_Directional)
+			{
+				NazaraInternalError("Directional lights included in point/spot light list");
+				continue;
+			}
 
-			switch (lightComponent.GetLightType())
+			auto it = m_pointSpotShadowCaches.find(light->GetId());
+			if (it == m_pointSpotShadowCaches.end())
 			{
-				case Nz::LightType_Directional:
-					NazaraInternalError("Directional lights included in point/spot light list");
-					break;
+				it = m_pointSpotShadowCaches.emplace(light->GetId(), std::make_unique<PointSpotShadowCache>()).first;
+
+				PointSpotShadowCache& newCache = *it->second;
+				newCache.culling.SetCullingMode(m_drawableCulling.GetCullingMode());
+				newCache.invalidated = true;
+				newCache.visibilityHash = 0;
 
-				case Nz::LightType_Point:
+				for (const Ndk::EntityHandle& drawable : m_drawables)
 				{
-					static Nz::Quaternionf rotations[6] =
-					{
-						Nz::Quaternionf::RotationBetween(Nz::Vector3f::Forward(),  Nz::Vector3f::UnitX()), // CubemapFace_PositiveX
-						Nz::Quaternionf::RotationBetween(Nz::Vector3f::Forward(), -Nz::Vector3f::UnitX()), // CubemapFace_NegativeX
-						Nz::Quaternionf::RotationBetween(Nz::Vector3f::Forward(), -Nz::Vector3f::UnitY()), // CubemapFace_PositiveY
-						Nz::Quaternionf::RotationBetween(Nz::Vector3f::Forward(),  Nz::Vector3f::UnitY()), // CubemapFace_NegativeY
-						Nz::Quaternionf::RotationBetween(Nz::Vector3f::Forward(), -Nz::Vector3f::UnitZ()), // CubemapFace_PositiveZ
-						Nz::Quaternionf::RotationBetween(Nz::Vector3f::Forward(),  Nz::Vector3f::UnitZ())  // CubemapFace_NegativeZ
-					};
+					GraphicsComponent& graphicsComponent = drawable->GetComponent<GraphicsComponent>();
+					graphicsComponent.AddToCullingList(&newCache.culling);
+				}
+			}
+
+			PointSpotShadowCache& shadowCache = *it->second;
+
+			Nz::Vector3f position = lightNode.GetPosition();
+			Nz::Quaternionf rotation = lightNode.GetRotation();
+			float outerAngle = lightComponent.GetOuterAngle();
+			float radius = lightComponent.GetRadius();
+
+			// Point light shadows don't depend on the light rotation
+			bool lightChanged = shadowCache.invalidated || shadowCache.lightType != lightType || shadowCache.position != position || shadowCache.radius != radius ||
+			                    (lightType == Nz::LightType_Spot && (shadowCache.rotation != rotation || shadowCache.outerAngle != outerAngle));
+
+			unsigned int faceCount = (lightType == Nz::LightType_Point) ? 6 : 1;
 
+			if (lightChanged)
+			{
+				shadowCache.lightType = lightType;
+				shadowCache.outerAngle = outerAngle;
+				shadowCache.position = position;
+				shadowCache.radius = radius;
+				shadowCache.rotation = rotation;
+
+				if (lightType == Nz::LightType_Point)
+				{
+					shadowCache.projectionMatrix = Nz::Matrix4f::Perspective(Nz::FromDegrees(90.f), 1.f, 0.1f, radius);
 					for (unsigned int face = 0; face < 6; ++face)
-					{
-						m_shadowRT.AttachTexture(Nz::AttachmentPoint_Depth, 0, lightComponent.GetShadowMap(), face);
-						Nz::Renderer::SetTarget(&m_shadowRT);
-						Nz::Renderer::SetViewport(Nz::Recti(0, 0, shadowMapSize.x, shadowMapSize.y));
+						shadowCache.viewMatrices[face] = Nz::Matrix4f::ViewMatrix(position, rotations[face]);
 
-						///TODO: Cache the matrices in the light?
-						Nz::Renderer::SetMatrix(Nz::MatrixType_Projection, Nz::Matrix4f::Perspective(Nz::FromDegrees(90.f), 1.f, 0.1f, lightComponent.GetRadius()));
-						Nz::Renderer::SetMatrix(Nz::MatrixType_View, Nz::Matrix4f::ViewMatrix(lightNode.GetPosition(), rotations[face]));
+					// The six faces are contained by the box of the light range, which is used to cull the drawables once for all faces
+					shadowCache.cullingFrustum.Extract(Nz::Matrix4f::ViewMatrix(position, Nz::Quaternionf::Identity()), Nz::Matrix4f::Ortho(-radius, radius, radius, -radius, -radius, radius));
+				}
+				else
+				{
+					shadowCache.projectionMatrix = Nz::Matrix4f::Perspective(outerAngle * 2.f, 1.f, 0.1f, radius);
+					shadowCache.viewMatrices[0] = Nz::Matrix4f::ViewMatrix(position, rotation);
+				}
 
-						Nz::AbstractRenderQueue* renderQueue = m_shadowTechnique.GetRenderQueue();
-						renderQueue->Clear();
+				for (unsigned int face = 0; face < faceCount; ++face)
+					shadowCache.frustums[face].Extract(shadowCache.viewMatrices[face], shadowCache.projectionMatrix);
 
-						///TODO: Culling
-						for (const Ndk::EntityHandle& drawable : m_drawables)
+				if (lightType == Nz::LightType_Spot)
+					shadowCache.cullingFrustum = shadowCache.frustums[0];
+			}
+
+			bool forceInvalidation = false;
+
+			std::size_t visibilityHash;
+			if (m_isCullingEnabled)
+				visibilityHash = shadowCache.culling.Cull(shadowCache.cullingFrustum, &forceInvalidation);
+			else
+				visibilityHash = shadowCache.culling.FillWithAllEntries(&forceInvalidation);
+
+			if (lightChanged || forceInvalidation || visibilityHash != shadowCache.visibilityHash)
+			{
+				// Point light faces still have to be tested, spot lights are already culled by their own frustum
+				bool testFaces = (m_isCullingEnabled && lightType == Nz::LightType_Point);
+
+				for (unsigned int face = 0; face < faceCount; ++face)
+				{
+					const Nz::Frustumf& frustum = shadowCache.frustums[face];
+					Nz::DepthRenderQueue& renderQueue = shadowCache.renderQueues[face];
+
+					auto AddToRenderQueue = [&](const GraphicsComponent* gfxComponent, Nz::IntersectionSide side)
+					{
+						if (testFaces)
+							side = frustum.Intersect(gfxComponent->GetAABB());
+
+						switch (side)
 						{
-							GraphicsComponent& graphicsComponent = drawable->GetComponent<GraphicsComponent>();
+							case Nz::IntersectionSide_Inside:
+								gfxComponent->AddToRenderQueue(&renderQueue);
+								break;
 
-							graphicsComponent.AddToRenderQueue(renderQueue);
+							case Nz::IntersectionSide_Intersecting:
+								gfxComponent->AddToRenderQueueByCulling(frustum, &renderQueue);
+								break;
+
+							case Nz::IntersectionSide_Outside:
+								break;
 						}
+					};
 
-						m_shadowTechnique.Clear(dummySceneData);
-						m_shadowTechnique.Draw(dummySceneData);
-					}
-					break;
+					renderQueue.Clear();
+
+					for (const GraphicsComponent* gfxComponent : shadowCache.culling.GetFullyVisibleResults())
+						AddToRenderQueue(gfxComponent, Nz::IntersectionSide_Inside);
+
+					for (const GraphicsComponent* gfxComponent : shadowCache.culling.GetPartiallyVisibleResults())
+						AddToRenderQueue(gfxComponent, Nz::IntersectionSide_Intersecting);
+
+					renderQueue.Sort(nullptr);
 				}
 
-				case Nz::LightType_Spot:
-				{
-					m_shadowRT.AttachTexture(Nz::AttachmentPoint_Depth, 0, lightComponent.GetShadowMap());
-					Nz::Renderer::SetTarget(&m_shadowRT);
-					Nz::Renderer::SetViewport(Nz::Recti(0, 0, shadowMapSize.x, shadowMapSize.y));
+				shadowCache.invalidated = false;
+				shadowCache.visibilityHash = visibilityHash;
+			}
 
-					///TODO: Cache the matrices in the light?
-					Nz::Renderer::SetMatrix(Nz::MatrixType_Projection, Nz::Matrix4f::Perspective(lightComponent.GetOuterAngle()*2.f, 1.f, 0.1f, lightComponent.GetRadius()));
-					Nz::Renderer::SetMatrix(Nz::MatrixType_View, Nz::Matrix4f::ViewMatrix(lightNode.GetPosition(), lightNode.GetRotation()));
+			Nz::TextureRef shadowMap = lightComponent.GetShadowMap();
+			Nz::Vector2ui shadowMapSize(shadowMap->GetSize());
 
-					Nz::AbstractRenderQueue* renderQueue = m_shadowTechnique.GetRenderQueue();
-					renderQueue->Clear();
+			Nz::Renderer::SetMatrix(Nz::MatrixType_Projection, shadowCache.projectionMatrix);
 
-					///TODO: Culling
-					for (const Ndk::EntityHandle& drawable : m_drawables)
-					{
-						GraphicsComponent& graphicsComponent = drawable->GetComponent<GraphicsComponent>();
+			for (unsigned int face = 0; face < faceCount; ++face)
+			{
+				if (lightType == Nz::LightType_Point)
+					m_shadowRT.AttachTexture(Nz::AttachmentPoint_Depth, 0, shadowMap, face);
+				else
+					m_shadowRT.AttachTexture(Nz::AttachmentPoint_Depth, 0, shadowMap);
 
-						graphicsComponent.AddToRenderQueue(renderQueue);
-					}
+				Nz::Renderer::SetTarget(&m_shadowRT);
+				Nz::Renderer::SetViewport(Nz::Recti(0, 0, shadowMapSize.x, shadowMapSize.y));
+				Nz::Renderer::SetMatrix(Nz::MatrixType_View, shadowCache.viewMatrices[face]);
 
-					m_shadowTechnique.Clear(dummySceneData);
-					m_shadowTechnique.Draw(dummySceneData);
-					break;
-				}
+				m_shadowTechnique.Clear(dummySceneData);
+				m_shadowTechnique.Draw(dummySceneData, shadowCache.renderQueues[face]);
 			}
 		}
 	}
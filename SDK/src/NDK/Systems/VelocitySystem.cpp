@@ -3,10 +3,13 @@
 // For conditions of distribution and use, see copyright notice in Prerequisites.hpp
 
 #include <NDK/Systems/VelocitySystem.hpp>
+#include <Nazara/Core/LockGuard.hpp>
 #include <NDK/Components/NodeComponent.hpp>
 #include <NDK/Components/PhysicsComponent2D.hpp>
 #include <NDK/Components/PhysicsComponent3D.hpp>
 #include <NDK/Components/VelocityComponent.hpp>
+#include <NDK/World.hpp>
+#include <algorithm>
 
 namespace Ndk
 {
@@ -17,6 +20,7 @@ namespace Ndk
 	*
 	* \remark This system is enabled if the entity owns the traits NodeComponent and VelocityComponent
 	* but it's disabled with the traits: PhysicsComponent2D, PhysicsComponent3D
+	* \remark Entities are moved by multiple threads, except those whose node has a parent or children
 	*/
 
 	/*!
@@ -27,6 +31,8 @@ namespace Ndk
 	{
 		Excludes<PhysicsComponent2D, PhysicsComponent3D>();
 		Requires<NodeComponent, VelocityComponent>();
+		Reads<VelocityComponent>();
+		Writes<NodeComponent>();
 		SetUpdateOrder(10); //< Since some systems may want to stop us
 	}
 
@@ -38,13 +44,41 @@ namespace Ndk
 
 	void VelocitySystem::OnUpdate(float elapsedTime)
 	{
-		for (const Ndk::EntityHandle& entity : GetEntities())
-		{
-			NodeComponent& node = entity->GetComponent<NodeComponent>();
-			const VelocityComponent& velocity = entity->GetComponent<VelocityComponent>();
+		World& world = GetWorld();
+		const EntityList& entities = GetEntities();
 
+		auto MoveEntity = [&](NodeComponent& node, const VelocityComponent& velocity)
+		{
 			node.Move(velocity.linearVelocity * elapsedTime, velocity.coordSys);
-		}
+		};
+
+		// Split the packed component pools between threads instead of dereferencing every entity
+		world.ParallelForEachComponent<NodeComponent, const VelocityComponent>([&](EntityId entityId, NodeComponent& node, const VelocityComponent& velocity)
+		{
+			// Filters out disabled entities and entities handled by physics
+			if (!entities.Has(entityId))
+				return;
+
+			// Moving a node reads its parent and invalidates its children, which may be moved by another thread at the same time
+			if (node.GetParent() || node.HasChilds())
+			{
+				Nz::LockGuard lock(m_hierarchyMutex);
+				m_hierarchyEntities.push_back(entityId);
+				return;
+			}
+
+			MoveEntity(node, velocity);
+		});
+
+		// Keep the same order from one update to another
+		std::sort(m_hierarchyEntities.begin(), m_hierarchyEntities.end());
+
+		const ComponentPool& nodePool = world.GetComponentPool<NodeComponent>();
+		const ComponentPool& velocityPool = world.GetComponentPool<VelocityComponent>();
+		for (EntityId entityId : m_hierarchyEntities)
+			MoveEntity(static_cast<NodeComponent&>(*nodePool.Get(entityId)), static_cast<const VelocityComponent&>(*velocityPool.Get(entityId)));
+
+		m_hierarchyEntities.clear();
 	}
 
 	SystemIndex VelocitySystem::systemIndex;
@@ -5,11 +5,13 @@
 #include <NDK/World.hpp>
 #include <Nazara/Core/Clock.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/TaskGroup.hpp>
 #include <NDK/BaseComponent.hpp>
 #include <NDK/Systems/LifetimeSystem.hpp>
 #include <NDK/Systems/PhysicsSystem2D.hpp>
 #include <NDK/Systems/PhysicsSystem3D.hpp>
 #include <NDK/Systems/VelocitySystem.hpp>
+#include <functional>
 
 #ifndef NDK_SERVER
 #include <NDK/Systems/DebugSystem.hpp>
@@ -24,6 +26,8 @@ namespace Ndk
 	* \ingroup NDK
 	* \class Ndk::World
 	* \brief NDK class that represents a world
+	*
+	* Systems declaring the components they access (see BaseSystem::Reads and BaseSystem::Writes) are updated at the same time as the systems they don't conflict with, using the TaskScheduler.
 	*/
 
 	/*!
@@ -85,25 +89,30 @@ namespace Ndk
 			// We allocate a new entity
 			id = static_cast<Ndk::EntityId>(m_entityBlocks.size());
 
-			if (m_entities.capacity() > m_entities.size())
+			// Entities must be created in identifier order, once some are waiting the main container can't be used until the next refresh
+			if (m_waitingEntities.empty() && m_entities.capacity() > m_entities.size())
 			{
-				NazaraAssert(m_waitingEntities.empty(), "There should be no waiting entities if space is available in main container");
-
 				m_entities.emplace_back(Entity(this, id)); //< We can't make our vector create the entity due to the scope
 				entBlock = &m_entities.back();
 			}
 			else
 			{
 				// Pushing to entities would reallocate vector and thus, invalidate EntityHandles (which we don't want until world update)
-				// To prevent this, allocate them into a separate vector and move them at update
-				// For now, we are counting on m_entities grow strategy to keep allocation frequency low
-				m_waitingEntities.emplace_back(std::make_unique<EntityBlock>(Entity(this, id)));
-				entBlock = m_waitingEntities.back().get();
+				// To prevent this, allocate them into separate chunks (which never grow past their capacity) and move them at update
+				if (m_waitingEntities.empty() || m_waitingEntities.back().size() == m_waitingEntities.back().capacity())
+					ReserveEntityBlocks(1);
+
+				std::vector<EntityBlock>& blocks = m_waitingEntities.back();
+				blocks.emplace_back(Entity(this, id));
+				entBlock = &blocks.back();
 			}
 
 			if (id >= m_entityBlocks.size())
 				m_entityBlocks.resize(id + 1);
 
+			if (id >= m_entityGenerations.size())
+				m_entityGenerations.resize(id + 1, 0);
+
 			m_entityBlocks[id] = entBlock;
 		}
 
@@ -127,7 +136,13 @@ namespace Ndk
 		for (EntityBlock* entBlock : m_entityBlocks)
 		{
 			if (entBlock->entity.IsValid())
+			{
+				EntityId id = entBlock->entity.GetId();
 				entBlock->entity.Destroy();
+
+				// Generations are kept, so references stay invalid once the identifier gets reused
+				m_entityGenerations[id]++;
+			}
 		}
 		m_entityBlocks.clear();
 
@@ -188,6 +203,7 @@ namespace Ndk
 	*
 	* This function will perform all pending operations in the following order:
 	* - Reorder systems according to their update order if needed
+	* - Execute the commands recorded in the command buffer
 	* - Moving newly created entities (whose which allocate never-used id) data and handles to normal entity list, this will invalidate references to world EntityHandle
 	* - Destroying dead entities and allowing their ids to be used by newly created entities
 	* - Update dirty entities, destroying their removed components and filtering them along systems
@@ -203,14 +219,23 @@ namespace Ndk
 		if (!m_orderedSystemsUpdated)
 			ReorderSystems();
 
+		m_commandBuffer.Execute(*this);
+
 		// Move waiting entities to entity list
 		if (!m_waitingEntities.empty())
 		{
 			constexpr std::size_t MinEntityCapacity = 10; //< We want to be able to grow maximum entity count by at least ten without going to the waiting list
 
-			m_entities.reserve(m_entities.size() + m_waitingEntities.size() + MinEntityCapacity);
-			for (auto& blockPtr : m_waitingEntities)
-				m_entities.push_back(std::move(*blockPtr));
+			std::size_t waitingEntityCount = 0;
+			for (auto& blocks : m_waitingEntities)
+				waitingEntityCount += blocks.size();
+
+			m_entities.reserve(m_entities.size() + waitingEntityCount + MinEntityCapacity);
+			for (auto& blocks : m_waitingEntities)
+			{
+				for (EntityBlock& block : blocks)
+					m_entities.push_back(std::move(block));
+			}
 
 			m_waitingEntities.clear();
 
@@ -230,12 +255,18 @@ namespace Ndk
 			// Destruction of the entity (invalidation of handle by the same way)
 			entity->Destroy();
 
+			// Invalidate references to the entity
+			m_entityGenerations[i]++;
+
 			// Send back the identifier of the entity to the free queue
 			m_freeEntityIds.UnboundedSet(i);
 		}
 		m_killedEntities.back.Clear();
 
 		// Handle of entities which need an update from the systems
+		// Systems filter entities on their components only, entities sharing the same components are thus filtered once per refresh
+		m_systemFilterCache.clear();
+
 		std::swap(m_dirtyEntities.front, m_dirtyEntities.back);
 		for (std::size_t i = m_dirtyEntities.back.FindFirst(); i != m_dirtyEntities.back.npos; i = m_dirtyEntities.back.FindNext(i))
 		{
@@ -251,13 +282,31 @@ namespace Ndk
 			for (std::size_t j = removedComponents.FindFirst(); j != m_dirtyEntities.back.npos; j = removedComponents.FindNext(j))
 				entity->DropComponent(static_cast<Ndk::ComponentIndex>(j));
 
-			for (auto& system : m_orderedSystems)
+			const Nz::Bitset<>* filteringSystems = nullptr;
+			if (entity->IsEnabled())
+			{
+				auto it = m_systemFilterCache.find(entity->GetComponentBits());
+				if (it == m_systemFilterCache.end())
+				{
+					Nz::Bitset<> systemBits(m_orderedSystems.size(), false);
+					for (std::size_t j = 0; j < m_orderedSystems.size(); ++j)
+						systemBits.Set(j, m_orderedSystems[j]->Filters(entity));
+
+					it = m_systemFilterCache.emplace(entity->GetComponentBits(), std::move(systemBits)).first;
+				}
+
+				filteringSystems = &it->second;
+			}
+
+			for (std::size_t j = 0; j < m_orderedSystems.size(); ++j)
 			{
+				BaseSystem* system = m_orderedSystems[j];
+
 				// Is our entity already part of this system?
 				bool partOfSystem = system->HasEntity(entity);
 
 				// Should it be part of it?
-				if (entity->IsEnabled() && system->Filters(entity))
+				if (filteringSystems && filteringSystems->Test(j))
 				{
 					// Yes it should, add it to the system if not already done and validate it (again)
 					if (!partOfSystem)
@@ -281,7 +330,8 @@ namespace Ndk
 	* \param elapsedTime Delta time used for the update
 	*
 	* This function Refreshes the world and calls the Update function of every active system part of it with the elapsedTime value.
-	* It also increase the profiler data with the elapsed time passed in Refresh and every system update.
+	* Conflicting systems are updated according to their update order, others may be updated at the same time (see BaseSystem::ConflictsWith).
+	* It also increase the profiler data with the elapsed time passed in Refresh and every system update, along with the critical path (the longest chain of system updates which had to wait for each other).
 	*/
 	void World::Update(float elapsedTime)
 	{
@@ -292,25 +342,35 @@ namespace Ndk
 			Nz::UInt64 t2 = Nz::GetElapsedMicroseconds();
 
 			m_profilerData.refreshTime += t2 - t1;
+		}
+		else
+			Refresh();
+
+		if (m_hasConcurrentSystems)
+			UpdateSystemsConcurrently(elapsedTime);
+		else
+		{
+			for (std::size_t i = 0; i < m_orderedSystems.size(); ++i)
+				UpdateSystem(i, elapsedTime);
+		}
 
-			for (auto& systemPtr : m_orderedSystems)
+		if (m_isProfilerEnabled)
+		{
+			// Systems are ordered so that dependencies always come first
+			Nz::UInt64 criticalPathTime = 0;
+			for (SystemNode& node : m_systemGraph)
 			{
-				systemPtr->Update(elapsedTime);
+				Nz::UInt64 startTime = 0;
+				for (std::size_t dependency : node.dependencies)
+					startTime = std::max(startTime, m_systemGraph[dependency].pathTime);
 
-				Nz::UInt64 t3 = Nz::GetElapsedMicroseconds();
-				m_profilerData.updateTime[systemPtr->GetIndex()] += t3 - t2;
-				t2 = t3;
+				node.pathTime = startTime + node.updateTime;
+				criticalPathTime = std::max(criticalPathTime, node.pathTime);
 			}
 
+			m_profilerData.criticalPathTime += criticalPathTime;
 			m_profilerData.updateCount++;
 		}
-		else
-		{
-			Refresh();
-
-			for (auto& systemPtr : m_orderedSystems)
-				systemPtr->Update(elapsedTime);
-		}
 	}
 
 	void World::ReorderSystems()
@@ -328,6 +388,114 @@ namespace Ndk
 			return first->GetUpdateOrder() < second->GetUpdateOrder();
 		});
 
+		// Build the dependency graph, a system waits for every previous system it conflicts with
+		std::size_t systemCount = m_orderedSystems.size();
+
+		m_hasConcurrentSystems = false;
+		m_remainingSystemDependencies.reset(new std::atomic_size_t[systemCount]);
+		m_systemGraph.clear();
+		m_systemGraph.resize(systemCount);
+
+		std::vector<Nz::Bitset<>> predecessors(systemCount, Nz::Bitset<>(systemCount, false));
+		for (std::size_t i = 0; i < systemCount; ++i)
+		{
+			SystemNode& node = m_systemGraph[i];
+			node.pathTime = 0;
+			node.updateTime = 0;
+
+			for (std::size_t j = 0; j < i; ++j)
+			{
+				if (m_orderedSystems[j]->ConflictsWith(*m_orderedSystems[i]))
+				{
+					node.dependencies.push_back(j);
+					m_systemGraph[j].dependents.push_back(i);
+
+					predecessors[i] |= predecessors[j];
+					predecessors[i].Set(j);
+				}
+			}
+
+			// Systems can only run at the same time if some previous system isn't (even indirectly) waited for
+			if (predecessors[i].Count() < i)
+				m_hasConcurrentSystems = true;
+		}
+
 		m_orderedSystemsUpdated = true;
 	}
+
+	void World::ReserveEntityBlocks(std::size_t count)
+	{
+		constexpr std::size_t MinChunkSize = 64;
+
+		// Free identifiers reuse the blocks of dead entities
+		std::size_t freeIdCount = m_freeEntityIds.Count();
+		if (count <= freeIdCount)
+			return;
+
+		count -= freeIdCount;
+
+		std::size_t availableBlocks;
+		if (m_waitingEntities.empty())
+			availableBlocks = m_entities.capacity() - m_entities.size();
+		else
+			availableBlocks = m_waitingEntities.back().capacity() - m_waitingEntities.back().size();
+
+		if (count <= availableBlocks)
+			return;
+
+		// Growing chunks keep the number of allocations low when entities are created one by one
+		std::size_t chunkSize = std::max({ count, MinChunkSize, m_entityBlocks.size() / 2 });
+
+		m_waitingEntities.emplace_back();
+		m_waitingEntities.back().reserve(chunkSize);
+	}
+
+	void World::UpdateSystem(std::size_t orderedIndex, float elapsedTime)
+	{
+		BaseSystem* system = m_orderedSystems[orderedIndex];
+
+		if (m_isProfilerEnabled)
+		{
+			Nz::UInt64 t1 = Nz::GetElapsedMicroseconds();
+			system->Update(elapsedTime);
+			Nz::UInt64 updateTime = Nz::GetElapsedMicroseconds() - t1;
+
+			m_systemGraph[orderedIndex].updateTime = updateTime;
+			m_profilerData.updateTime[system->GetIndex()] += updateTime;
+		}
+		else
+			system->Update(elapsedTime);
+	}
+
+	void World::UpdateSystemsConcurrently(float elapsedTime)
+	{
+		// Systems may access component pools concurrently, they must not be created during the update
+		if (m_componentPools.size() < BaseComponent::GetMaxComponentIndex())
+			m_componentPools.resize(BaseComponent::GetMaxComponentIndex());
+
+		Nz::TaskGroup taskGroup;
+
+		std::function<void(std::size_t)> runSystem = [&](std::size_t orderedIndex)
+		{
+			UpdateSystem(orderedIndex, elapsedTime);
+
+			// Start systems which were only waiting for this one
+			for (std::size_t dependent : m_systemGraph[orderedIndex].dependents)
+			{
+				if (--m_remainingSystemDependencies[dependent] == 0)
+					taskGroup.AddTask([&runSystem, dependent]() { runSystem(dependent); });
+			}
+		};
+
+		for (std::size_t i = 0; i < m_systemGraph.size(); ++i)
+			m_remainingSystemDependencies[i] = m_systemGraph[i].dependencies.size();
+
+		for (std::size_t i = 0; i < m_systemGraph.size(); ++i)
+		{
+			if (m_systemGraph[i].dependencies.empty())
+				taskGroup.AddTask([&runSystem, i]() { runSystem(i); });
+		}
+
+		taskGroup.Wait();
+	}
 }
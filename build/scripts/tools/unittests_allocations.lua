@@ -0,0 +1,27 @@
+TOOL.Name = "UnitTestsAllocations"
+
+TOOL.Category = "Test"
+TOOL.Directory = "../tests"
+TOOL.EnableConsole = true
+TOOL.Kind = "Application"
+TOOL.TargetDirectory = TOOL.Directory
+
+TOOL.Defines = {
+}
+
+TOOL.Includes = {
+	"../include",
+	"../tests/Allocations"
+}
+
+-- Those tests replace the global allocation functions, they live in their own executable to leave the other tests untouched
+TOOL.Files = {
+	"../tests/Allocations/**.hpp",
+	"../tests/Allocations/**.cpp"
+}
+
+TOOL.Libraries = {
+	"NazaraCore",
+	"NazaraUtility",
+	"NazaraGraphics"
+}
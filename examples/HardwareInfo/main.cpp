@@ -80,6 +80,8 @@ int main()
 		// Ainsi qu'un report des capacités de la carte graphique (avec le driver actuel)
 		oss << "Rapport des capacites: " << std::endl; // Pas d'accent car écriture dans un fichier (et on ne va pas s'embêter avec ça)
 		printCap(oss, "-Calculs 64bits", Nz::OpenGL::IsSupported(Nz::OpenGLExtension_FP64));
+		printCap(oss, "-Compression de textures (bptc)", Nz::OpenGL::IsSupported(Nz::OpenGLExtension_TextureCompression_bptc));
+		printCap(oss, "-Compression de textures (rgtc)", Nz::OpenGL::IsSupported(Nz::OpenGLExtension_TextureCompression_rgtc));
 		printCap(oss, "-Compression de textures (s3tc)", Nz::OpenGL::IsSupported(Nz::OpenGLExtension_TextureCompression_s3tc));
 		printCap(oss, "-Filtrage anisotrope", Nz::OpenGL::IsSupported(Nz::OpenGLExtension_AnisotropicFilter));
 		printCap(oss, "-Mode debug", Nz::OpenGL::IsSupported(Nz::OpenGLExtension_DebugOutput));
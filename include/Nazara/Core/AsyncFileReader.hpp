@@ -0,0 +1,59 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_ASYNCFILEREADER_HPP
+#define NAZARA_ASYNCFILEREADER_HPP
+
+#include <Nazara/Prerequisites.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/String.hpp>
+#include <functional>
+#include <future>
+#include <limits>
+
+namespace Nz
+{
+	class TaskGroup;
+
+	class NAZARA_CORE_API AsyncFileReader
+	{
+		public:
+			struct Result;
+
+			using Callback = std::function<void(Result& result)>;
+
+			AsyncFileReader() = delete;
+			~AsyncFileReader() = delete;
+
+			static unsigned int GetThreadCount();
+
+			static bool Initialize();
+			static bool IsInitialized();
+
+			static std::future<Result> Read(const String& filePath, UInt64 offset = 0, UInt64 size = WholeFile);
+			static void Read(const String& filePath, Callback callback, TaskGroup* callbackGroup = nullptr);
+			static void Read(const String& filePath, UInt64 offset, UInt64 size, Callback callback, TaskGroup* callbackGroup = nullptr);
+
+			static void SetThreadCount(unsigned int threadCount);
+
+			static void Uninitialize();
+
+			static void WaitForRequests();
+
+			struct Result
+			{
+				ByteArray data;
+				String filePath;
+				UInt64 offset = 0;
+				bool succeeded = false;
+			};
+
+			static constexpr unsigned int DefaultThreadCount = 2;
+			static constexpr UInt64 WholeFile = std::numeric_limits<UInt64>::max();
+	};
+}
+
+#endif // NAZARA_ASYNCFILEREADER_HPP
@@ -10,6 +10,7 @@
 #include <Nazara/Prerequisites.hpp>
 #include <Nazara/Core/Algorithm.hpp>
 #include <Nazara/Core/String.hpp>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <type_traits>
@@ -198,6 +199,8 @@ namespace Nz
 
 namespace std
 {
+	template<typename Block, class Allocator> struct hash<Nz::Bitset<Block, Allocator>>;
+
 	template<typename Block, class Allocator>
 	void swap(Nz::Bitset<Block, Allocator>& lhs, Nz::Bitset<Block, Allocator>& rhs) noexcept;
 }
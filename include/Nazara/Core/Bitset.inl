@@ -1639,6 +1639,31 @@ namespace Nz
 
 namespace std
 {
+	template<typename Block, class Allocator>
+	struct hash<Nz::Bitset<Block, Allocator>>
+	{
+		/*!
+		* \brief Specialisation of std to hash
+		* \return Result of the hash
+		*
+		* \param bitset Bitset to hash
+		*
+		* \remark Trailing empty blocks are ignored, to stay consistent with operator==
+		*/
+		std::size_t operator()(const Nz::Bitset<Block, Allocator>& bitset) const
+		{
+			std::size_t blockCount = bitset.GetBlockCount();
+			while (blockCount > 0 && bitset.GetBlock(blockCount - 1) == 0)
+				blockCount--;
+
+			std::size_t seed = 0;
+			for (std::size_t i = 0; i < blockCount; ++i)
+				Nz::HashCombine(seed, bitset.GetBlock(i));
+
+			return seed;
+		}
+	};
+
 	/*!
 	* \brief Swaps two bitsets, specialisation of std
 	*
@@ -0,0 +1,65 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_CONCURRENTMEMORYPOOL_HPP
+#define NAZARA_CONCURRENTMEMORYPOOL_HPP
+
+#include <Nazara/Prerequisites.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <memory>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_CORE_API ConcurrentMemoryPool
+	{
+		public:
+			ConcurrentMemoryPool(std::size_t blockSize, std::size_t slabSize = 1024);
+			ConcurrentMemoryPool(const ConcurrentMemoryPool&) = delete;
+			ConcurrentMemoryPool(ConcurrentMemoryPool&&) = delete;
+			~ConcurrentMemoryPool();
+
+			void* Allocate();
+
+			template<typename T> void Delete(T* ptr);
+
+			void Free(void* ptr);
+
+			inline std::size_t GetBlockSize() const;
+			std::size_t GetGrowthCount() const;
+			std::size_t GetHighWaterMark() const;
+			std::size_t GetSize() const;
+			std::size_t GetUsedBlockCount() const;
+
+			template<typename T, typename... Args> T* New(Args&&... args);
+
+			ConcurrentMemoryPool& operator=(const ConcurrentMemoryPool&) = delete;
+			ConcurrentMemoryPool& operator=(ConcurrentMemoryPool&&) = delete;
+
+			static constexpr std::size_t ThreadCacheSize = 32;
+
+		private:
+			struct ThreadCache;
+			struct ThreadCacheList;
+
+			void Grow();
+			ThreadCache& GetThreadCache();
+			void ReturnBlocks(void* const* blocks, std::size_t blockCount);
+			void TakeBlocks(ThreadCache& cache);
+
+			mutable Mutex m_mutex;
+			std::size_t m_blockSize;
+			std::size_t m_highWaterMark;
+			std::size_t m_slabSize;
+			std::vector<std::unique_ptr<UInt8[]>> m_slabs;
+			std::vector<void*> m_freeBlocks;
+			UInt64 m_id;
+	};
+}
+
+#include <Nazara/Core/ConcurrentMemoryPool.inl>
+
+#endif // NAZARA_CONCURRENTMEMORYPOOL_HPP
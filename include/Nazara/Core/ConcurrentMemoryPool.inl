@@ -0,0 +1,59 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/ConcurrentMemoryPool.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/MemoryHelper.hpp>
+#include <cstddef>
+#include <utility>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Destroys an object and gives its block back to the pool
+	*
+	* \param ptr Object allocated with New
+	*
+	* \remark If ptr is null, nothing is done
+	*/
+	template<typename T>
+	void ConcurrentMemoryPool::Delete(T* ptr)
+	{
+		if (ptr)
+		{
+			ptr->~T();
+			Free(ptr);
+		}
+	}
+
+	/*!
+	* \brief Gets the size of the blocks
+	* \return Block size in bytes, rounded up to the fundamental alignment
+	*/
+	inline std::size_t ConcurrentMemoryPool::GetBlockSize() const
+	{
+		return m_blockSize;
+	}
+
+	/*!
+	* \brief Constructs an object in a block of the pool
+	* \return Pointer to the object
+	*
+	* \param args Arguments for the object constructor
+	*/
+	template<typename T, typename... Args>
+	T* ConcurrentMemoryPool::New(Args&&... args)
+	{
+		static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types are not supported");
+		NazaraAssert(sizeof(T) <= m_blockSize, "Type is too big for the pool blocks");
+
+		T* object = static_cast<T*>(Allocate());
+		PlacementNew(object, std::forward<Args>(args)...);
+
+		return object;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
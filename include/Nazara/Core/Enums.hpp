@@ -188,6 +188,7 @@ namespace Nz
 	{
 		StreamOption_None,
 
+		StreamOption_MemoryMapped,
 		StreamOption_Sequential,
 		StreamOption_Text,
 
@@ -0,0 +1,60 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_FRAMEARENA_HPP
+#define NAZARA_FRAMEARENA_HPP
+
+#include <Nazara/Prerequisites.hpp>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_CORE_API FrameArena
+	{
+		public:
+			FrameArena(std::size_t blockSize = DefaultBlockSize);
+			FrameArena(const FrameArena&) = delete;
+			FrameArena(FrameArena&&) noexcept = default;
+			~FrameArena() = default;
+
+			void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+			void Deallocate(void* pointer, std::size_t size);
+
+			inline std::size_t GetBlockCount() const;
+			inline std::size_t GetBlockSize() const;
+			std::size_t GetCapacity() const;
+			std::size_t GetUsedSize() const;
+
+			void Reset();
+
+			FrameArena& operator=(const FrameArena&) = delete;
+			FrameArena& operator=(FrameArena&&) noexcept = default;
+
+			static FrameArena& GetThreadArena();
+
+			static constexpr std::size_t DefaultBlockSize = 64 * 1024;
+
+		private:
+			struct Block
+			{
+				std::unique_ptr<UInt8[]> memory;
+				std::size_t size;
+			};
+
+			std::vector<Block> m_blocks;
+			std::size_t m_allocationCount;
+			std::size_t m_blockSize;
+			std::size_t m_currentBlock;
+			std::size_t m_offset;
+	};
+}
+
+#include <Nazara/Core/FrameArena.inl>
+
+#endif // NAZARA_FRAMEARENA_HPP
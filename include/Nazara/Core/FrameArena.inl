@@ -0,0 +1,29 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/FrameArena.hpp>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Gets the number of memory blocks owned by the arena
+	* \return Block count
+	*/
+	inline std::size_t FrameArena::GetBlockCount() const
+	{
+		return m_blocks.size();
+	}
+
+	/*!
+	* \brief Gets the minimal size of the blocks allocated by the arena
+	* \return Block size in bytes
+	*/
+	inline std::size_t FrameArena::GetBlockSize() const
+	{
+		return m_blockSize;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -0,0 +1,98 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/FrameArenaAllocator.hpp>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::FrameArenaAllocator
+	* \brief Core class that represents a STL allocator taking its memory from a FrameArena
+	*
+	* Containers using it must be destroyed (or emptied, for node-based containers) before the arena is reset.
+	*
+	* \see FrameArena
+	*/
+
+	/*!
+	* \brief Constructs a FrameArenaAllocator object
+	*
+	* \param arena Arena to allocate from, must outlive the allocator
+	*/
+	template<typename T>
+	inline FrameArenaAllocator<T>::FrameArenaAllocator(FrameArena& arena) :
+	m_arena(&arena)
+	{
+	}
+
+	/*!
+	* \brief Constructs a FrameArenaAllocator object from an allocator of another type, using the same arena
+	*
+	* \param allocator Allocator to get the arena from
+	*/
+	template<typename T>
+	template<typename U>
+	FrameArenaAllocator<T>::FrameArenaAllocator(const FrameArenaAllocator<U>& allocator) :
+	m_arena(allocator.m_arena)
+	{
+	}
+
+	/*!
+	* \brief Allocates uninitialized storage for count objects
+	* \return Pointer to the storage
+	*
+	* \param count Number of objects
+	*/
+	template<typename T>
+	T* FrameArenaAllocator<T>::allocate(std::size_t count)
+	{
+		return static_cast<T*>(m_arena->Allocate(count * sizeof(T), alignof(T)));
+	}
+
+	/*!
+	* \brief Gives storage back to the arena, which only reclaims it if it was the latest allocation
+	*
+	* \param pointer Pointer returned by allocate
+	* \param count Number of objects passed to allocate
+	*/
+	template<typename T>
+	void FrameArenaAllocator<T>::deallocate(T* pointer, std::size_t count)
+	{
+		m_arena->Deallocate(pointer, count * sizeof(T));
+	}
+
+	/*!
+	* \brief Gets the arena used by this allocator
+	* \return Arena reference
+	*/
+	template<typename T>
+	inline FrameArena& FrameArenaAllocator<T>::GetArena() const
+	{
+		return *m_arena;
+	}
+
+	/*!
+	* \brief Checks whether two allocators use the same arena
+	* \return true if memory allocated by one can be deallocated by the other
+	*/
+	template<typename T, typename U>
+	bool operator==(const FrameArenaAllocator<T>& lhs, const FrameArenaAllocator<U>& rhs)
+	{
+		return &lhs.GetArena() == &rhs.GetArena();
+	}
+
+	/*!
+	* \brief Checks whether two allocators use different arenas
+	* \return false if memory allocated by one can be deallocated by the other
+	*/
+	template<typename T, typename U>
+	bool operator!=(const FrameArenaAllocator<T>& lhs, const FrameArenaAllocator<U>& rhs)
+	{
+		return !operator==(lhs, rhs);
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
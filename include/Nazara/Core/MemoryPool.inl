@@ -14,6 +14,8 @@ namespace Nz
 	* \ingroup core
 	* \class Nz::MemoryPool
 	* \brief Core class that represents a memory pool
+	*
+	* \remark This class is not thread-safe, see ConcurrentMemoryPool
 	*/
 
 	/*!
@@ -24,6 +24,7 @@ namespace Nz
 			bool EndOfStream() const override;
 
 			UInt64 GetCursorPos() const override;
+			const void* GetMappedPointer() const override;
 			UInt64 GetSize() const override;
 
 			bool SetCursorPos(UInt64 offset) override;
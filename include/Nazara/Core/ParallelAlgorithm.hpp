@@ -0,0 +1,21 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_PARALLELALGORITHM_HPP
+#define NAZARA_PARALLELALGORITHM_HPP
+
+#include <Nazara/Prerequisites.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+
+namespace Nz
+{
+	template<typename T, typename F> void ParallelFor(T begin, T end, std::size_t grainSize, F&& func);
+	template<typename T, typename V, typename F, typename R> V ParallelReduce(T begin, T end, std::size_t grainSize, const V& identity, F&& func, R&& reduce);
+}
+
+#include <Nazara/Core/ParallelAlgorithm.inl>
+
+#endif // NAZARA_PARALLELALGORITHM_HPP
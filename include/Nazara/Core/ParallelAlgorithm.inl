@@ -0,0 +1,122 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/ParallelAlgorithm.hpp>
+#include <Nazara/Core/TaskGroup.hpp>
+#include <algorithm>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace Detail
+	{
+		template<typename T, typename F>
+		void ParallelForSplit(TaskGroup& group, T begin, T end, std::size_t grainSize, F& func)
+		{
+			// Keep the first half for ourselves and give away the second, the biggest ranges are the first ones to be stolen
+			while (static_cast<std::size_t>(end - begin) > grainSize)
+			{
+				T middle = begin + (end - begin) / 2;
+				group.AddTask([&group, &func, middle, end, grainSize]()
+				{
+					ParallelForSplit(group, middle, end, grainSize, func);
+				});
+
+				end = middle;
+			}
+
+			func(begin, end);
+		}
+
+		template<typename T, typename V, typename F, typename R>
+		V ParallelReduceSplit(T begin, T end, std::size_t grainSize, const V& identity, F& func, R& reduce)
+		{
+			if (static_cast<std::size_t>(end - begin) <= grainSize)
+				return func(begin, end);
+
+			T middle = begin + (end - begin) / 2;
+
+			V right = identity;
+			TaskGroup group;
+			group.AddTask([&]()
+			{
+				right = ParallelReduceSplit(middle, end, grainSize, identity, func, reduce);
+			});
+
+			V left = ParallelReduceSplit(begin, middle, grainSize, identity, func, reduce);
+			group.Wait();
+
+			return reduce(left, right);
+		}
+	}
+
+	/*!
+	* \ingroup core
+	* \brief Calls a function on every sub-range of [begin, end) using the TaskScheduler workers
+	*
+	* The range is recursively split in halves until sub-ranges are no bigger than grainSize, idle workers steal the biggest remaining ranges.
+	* The function is called inline (on the calling thread) if the range is not bigger than grainSize or if there is only one worker.
+	*
+	* \param begin First index of the range
+	* \param end Index following the last index of the range
+	* \param grainSize Maximum size of a sub-range processed by a single call, should be big enough to amortize task overhead
+	* \param func Function called with the bounds of each sub-range, as func(first, last) with last excluded
+	*
+	* \remark func may be called concurrently from multiple threads
+	*
+	* \see ParallelReduce
+	*/
+	template<typename T, typename F>
+	void ParallelFor(T begin, T end, std::size_t grainSize, F&& func)
+	{
+		if (begin >= end)
+			return;
+
+		grainSize = std::max<std::size_t>(grainSize, 1);
+
+		if (static_cast<std::size_t>(end - begin) <= grainSize || TaskScheduler::GetWorkerCount() <= 1)
+		{
+			func(begin, end);
+			return;
+		}
+
+		TaskGroup group;
+		Detail::ParallelForSplit(group, begin, end, grainSize, func);
+		group.Wait();
+	}
+
+	/*!
+	* \ingroup core
+	* \brief Computes a value from every sub-range of [begin, end) using the TaskScheduler workers and combines them
+	* \return Result of the reduction, identity if the range is empty
+	*
+	* The range is split like ParallelFor does, and partial results are combined in the order of the range (reduce only has to be associative).
+	*
+	* \param begin First index of the range
+	* \param end Index following the last index of the range
+	* \param grainSize Maximum size of a sub-range processed by a single call
+	* \param identity Neutral value of the reduction
+	* \param func Function computing the value of a sub-range, as func(first, last) with last excluded
+	* \param reduce Function combining two values, as reduce(left, right)
+	*
+	* \remark func and reduce may be called concurrently from multiple threads
+	*
+	* \see ParallelFor
+	*/
+	template<typename T, typename V, typename F, typename R>
+	V ParallelReduce(T begin, T end, std::size_t grainSize, const V& identity, F&& func, R&& reduce)
+	{
+		if (begin >= end)
+			return identity;
+
+		grainSize = std::max<std::size_t>(grainSize, 1);
+
+		if (static_cast<std::size_t>(end - begin) <= grainSize || TaskScheduler::GetWorkerCount() <= 1)
+			return func(begin, end);
+
+		return Detail::ParallelReduceSplit(begin, end, grainSize, identity, func, reduce);
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -0,0 +1,75 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_READAHEADFILE_HPP
+#define NAZARA_READAHEADFILE_HPP
+
+#include <Nazara/Prerequisites.hpp>
+#include <Nazara/Core/AsyncFileReader.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/Stream.hpp>
+#include <Nazara/Core/String.hpp>
+#include <future>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_CORE_API ReadAheadFile : public Stream
+	{
+		public:
+			ReadAheadFile(std::size_t chunkSize = DefaultChunkSize, unsigned int chunkCount = DefaultChunkCount);
+			ReadAheadFile(const String& filePath, std::size_t chunkSize = DefaultChunkSize, unsigned int chunkCount = DefaultChunkCount);
+			ReadAheadFile(const ReadAheadFile&) = delete;
+			ReadAheadFile(ReadAheadFile&&) = default;
+			~ReadAheadFile();
+
+			void Close();
+
+			bool EndOfStream() const override;
+
+			UInt64 GetCursorPos() const override;
+			String GetDirectory() const override;
+			String GetPath() const override;
+			UInt64 GetSize() const override;
+
+			bool IsOpen() const;
+
+			bool Open(const String& filePath);
+
+			bool SetCursorPos(UInt64 offset) override;
+
+			ReadAheadFile& operator=(const ReadAheadFile&) = delete;
+			ReadAheadFile& operator=(ReadAheadFile&&) = default;
+
+			static constexpr unsigned int DefaultChunkCount = 2;
+			static constexpr std::size_t DefaultChunkSize = 64 * 1024;
+
+		private:
+			bool FetchChunk();
+			void FlushStream() override;
+			std::size_t ReadBlock(void* buffer, std::size_t size) override;
+			void RequestChunks();
+			std::size_t WriteBlock(const void* buffer, std::size_t size) override;
+
+			struct PendingChunk
+			{
+				std::future<AsyncFileReader::Result> result;
+				UInt64 offset;
+			};
+
+			std::size_t m_chunkSize;
+			std::vector<PendingChunk> m_pendingChunks;
+			ByteArray m_chunk;
+			String m_filePath;
+			UInt64 m_chunkOffset;
+			UInt64 m_cursorPos;
+			UInt64 m_fileSize;
+			UInt64 m_nextChunkOffset;
+			unsigned int m_chunkCount;
+	};
+}
+
+#endif // NAZARA_READAHEADFILE_HPP
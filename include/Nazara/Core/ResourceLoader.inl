@@ -5,6 +5,7 @@
 #include <Nazara/Core/Config.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/File.hpp>
+#include <Nazara/Core/MappedFile.hpp>
 #include <Nazara/Core/MemoryView.hpp>
 #include <Nazara/Core/Stream.hpp>
 #include <Nazara/Core/Debug.hpp>
@@ -65,7 +66,10 @@ namespace Nz
 			return nullptr;
 		}
 
-		File file(path); // Open only if needed
+		// Open only if needed
+		File file;
+		MappedFile mappedFile;
+		Stream* stream = nullptr;
 
 		bool found = false;
 		for (Loader& loader : Type::s_loaders)
@@ -78,9 +82,14 @@ namespace Nz
 			StreamLoader streamLoader = std::get<2>(loader);
 			FileLoader fileLoader = std::get<3>(loader);
 
-			if (checkFunc && !file.IsOpen())
+			if (checkFunc && !stream)
 			{
-				if (!file.Open(OpenMode_ReadOnly))
+				// Mapping the file saves a system call per read and lets loaders parse it in place, fall back on regular reads if it cannot be mapped
+				if (mappedFile.Open(path))
+					stream = &mappedFile;
+				else if (file.Open(path, OpenMode_ReadOnly))
+					stream = &file;
+				else
 				{
 					NazaraError("Failed to load file: unable to open \"" + filePath + '"');
 					return nullptr;
@@ -92,9 +101,9 @@ namespace Nz
 			{
 				if (checkFunc)
 				{
-					file.SetCursorPos(0);
+					stream->SetCursorPos(0);
 
-					recognized = checkFunc(file, parameters);
+					recognized = checkFunc(*stream, parameters);
 					if (recognized == Ternary_False)
 						continue;
 					else
@@ -115,17 +124,17 @@ namespace Nz
 			}
 			else
 			{
-				file.SetCursorPos(0);
+				stream->SetCursorPos(0);
 
-				recognized = checkFunc(file, parameters);
+				recognized = checkFunc(*stream, parameters);
 				if (recognized == Ternary_False)
 					continue;
 				else if (recognized == Ternary_True)
 					found = true;
 
-				file.SetCursorPos(0);
+				stream->SetCursorPos(0);
 
-				ObjectRef<Type> resource = streamLoader(file, parameters);
+				ObjectRef<Type> resource = streamLoader(*stream, parameters);
 				if (resource)
 				{
 					resource->SetFilePath(filePath);
@@ -7,37 +7,84 @@
 #ifndef NAZARA_RESOURCEMANAGER_HPP
 #define NAZARA_RESOURCEMANAGER_HPP
 
+#include <Nazara/Core/Mutex.hpp>
 #include <Nazara/Core/ObjectRef.hpp>
 #include <Nazara/Core/ResourceParameters.hpp>
 #include <Nazara/Core/String.hpp>
+#include <array>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 
 namespace Nz
 {
+	class TaskGroup;
+
 	template<typename Type, typename Parameters>
 	class ResourceManager
 	{
 		friend Type;
 
 		public:
+			struct LoadStats;
+
 			ResourceManager() = delete;
 			~ResourceManager() = delete;
 
 			static void Clear();
 
 			static ObjectRef<Type> Get(const String& filePath);
+			static std::shared_future<ObjectRef<Type>> GetAsync(const String& filePath);
 			static const Parameters& GetDefaultParameters();
+			static bool GetLoadStats(const String& filePath, LoadStats* stats);
 
 			static void Purge();
 			static void Register(const String& filePath, ObjectRef<Type> resource);
 			static void SetDefaultParameters(const Parameters& params);
 			static void Unregister(const String& filePath);
 
+			struct LoadStats
+			{
+				UInt64 fileSize = 0;
+				UInt64 loadTime = 0; //< In microseconds
+			};
+
 		private:
+			struct PendingLoad;
+			struct Shard;
+
 			static bool Initialize();
+			static ObjectRef<Type> Load(const std::shared_ptr<PendingLoad>& pendingLoad);
+			static TaskGroup& GetLoadingGroup();
+			static Shard& GetShard(const String& absolutePath);
+			static std::shared_ptr<PendingLoad> RequestLoad(const String& absolutePath, ObjectRef<Type>* resource, bool* newRequest);
 			static void Uninitialize();
 
-			using ManagerMap = std::unordered_map<String, ObjectRef<Type>>;
+			struct Entry
+			{
+				ObjectRef<Type> resource;
+				std::shared_ptr<PendingLoad> pendingLoad;
+				LoadStats stats;
+			};
+
+			struct PendingLoad
+			{
+				String filePath;
+				std::once_flag loadFlag;
+				std::promise<ObjectRef<Type>> promise;
+				std::shared_future<ObjectRef<Type>> result;
+			};
+
+			struct Shard
+			{
+				Mutex mutex;
+				std::unordered_map<String, Entry> entries;
+			};
+
+			static constexpr std::size_t ShardCount = 16;
+
+			using ManagerMap = std::array<Shard, ShardCount>;
 			using ManagerParams = Parameters;
 	};
 }
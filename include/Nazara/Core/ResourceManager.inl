@@ -2,9 +2,13 @@
 // This file is part of the "Nazara Engine - Core module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
+#include <Nazara/Core/Clock.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/File.hpp>
+#include <Nazara/Core/LockGuard.hpp>
 #include <Nazara/Core/Log.hpp>
+#include <Nazara/Core/TaskGroup.hpp>
+#include <functional>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -13,43 +17,86 @@ namespace Nz
 	* \ingroup core
 	* \class Nz::ResourceManager
 	* \brief Core class that represents a resource manager
+	*
+	* Resources are stored in shards (selected by a hash of their path), each one having its own lock, which makes the manager usable from multiple threads.
+	* Concurrent requests for the same path are merged, the resource being loaded only once.
+	*
+	* \remark Default parameters must not be changed while resources are being loaded
 	*/
 
 	/*!
 	* \brief Clears the content of the manager
+	*
+	* \remark Resources being loaded are not affected, they will be stored once loaded
 	*/
 	template<typename Type, typename Parameters>
 	void ResourceManager<Type, Parameters>::Clear()
 	{
-		Type::s_managerMap.clear();
+		for (Shard& shard : Type::s_managerMap)
+		{
+			LockGuard lock(shard.mutex);
+
+			auto it = shard.entries.begin();
+			while (it != shard.entries.end())
+			{
+				if (!it->second.pendingLoad)
+					it = shard.entries.erase(it);
+				else
+					++it;
+			}
+		}
 	}
 
 	/*!
 	* \brief Gets a reference to the object loaded from file
 	* \return Reference to the object
 	*
+	* If the resource is already being loaded (see GetAsync), this waits for the load to complete, or performs it if it has not started yet.
+	*
 	* \param filePath Path to the asset that will be loaded
 	*/
 	template<typename Type, typename Parameters>
 	ObjectRef<Type> ResourceManager<Type, Parameters>::Get(const String& filePath)
 	{
 		String absolutePath = File::AbsolutePath(filePath);
-		auto it = Type::s_managerMap.find(absolutePath);
-		if (it == Type::s_managerMap.end())
-		{
-			ObjectRef<Type> resource = Type::LoadFromFile(absolutePath, GetDefaultParameters());
-			if (!resource)
-			{
-				NazaraError("Failed to load resource from file: " + absolutePath);
-				return ObjectRef<Type>();
-			}
 
-			NazaraDebug("Loaded resource from file " + absolutePath);
+		ObjectRef<Type> resource;
+		bool newRequest;
+		std::shared_ptr<PendingLoad> pendingLoad = RequestLoad(absolutePath, &resource, &newRequest);
+		if (!pendingLoad)
+			return resource;
+
+		return Load(pendingLoad);
+	}
+
+	/*!
+	* \brief Gets a reference to the object loaded from file, loading it on the TaskScheduler if required
+	* \return Future holding the reference to the object, which will be invalid if loading failed
+	*
+	* \param filePath Path to the asset that will be loaded
+	*
+	* \remark The resource type must support being loaded from another thread
+	*/
+	template<typename Type, typename Parameters>
+	std::shared_future<ObjectRef<Type>> ResourceManager<Type, Parameters>::GetAsync(const String& filePath)
+	{
+		String absolutePath = File::AbsolutePath(filePath);
 
-			it = Type::s_managerMap.insert(std::make_pair(absolutePath, resource)).first;
+		ObjectRef<Type> resource;
+		bool newRequest;
+		std::shared_ptr<PendingLoad> pendingLoad = RequestLoad(absolutePath, &resource, &newRequest);
+		if (!pendingLoad)
+		{
+			std::promise<ObjectRef<Type>> promise;
+			promise.set_value(std::move(resource));
+
+			return promise.get_future().share();
 		}
 
-		return it->second;
+		if (newRequest)
+			GetLoadingGroup().AddTask([pendingLoad]() { Load(pendingLoad); });
+
+		return pendingLoad->result;
 	}
 
 	/*!
@@ -62,23 +109,53 @@ namespace Nz
 		return Type::s_managerParameters;
 	}
 
+	/*!
+	* \brief Gets the loading statistics of a resource
+	* \return true If the resource was loaded by the manager and is still stored in it
+	*
+	* \param filePath Path of the resource
+	* \param stats Output statistics, must be valid
+	*/
+	template<typename Type, typename Parameters>
+	bool ResourceManager<Type, Parameters>::GetLoadStats(const String& filePath, LoadStats* stats)
+	{
+		NazaraAssert(stats, "Invalid stats");
+
+		String absolutePath = File::AbsolutePath(filePath);
+
+		Shard& shard = GetShard(absolutePath);
+		LockGuard lock(shard.mutex);
+
+		auto it = shard.entries.find(absolutePath);
+		if (it == shard.entries.end() || !it->second.resource)
+			return false;
+
+		*stats = it->second.stats;
+		return true;
+	}
+
 	/*!
 	* \brief Purges the resource manager from every asset whose it is the only owner
 	*/
 	template<typename Type, typename Parameters>
 	void ResourceManager<Type, Parameters>::Purge()
 	{
-		auto it = Type::s_managerMap.begin();
-		while (it != Type::s_managerMap.end())
+		for (Shard& shard : Type::s_managerMap)
 		{
-			const ObjectRef<Type>& ref = it->second;
-			if (ref->GetReferenceCount() == 1) // Are we the only ones to own the resource ?
+			LockGuard lock(shard.mutex);
+
+			auto it = shard.entries.begin();
+			while (it != shard.entries.end())
 			{
-				NazaraDebug("Purging resource from file " + ref->GetFilePath());
-				Type::s_managerMap.erase(it++); // Then we erase it
+				const ObjectRef<Type>& ref = it->second.resource;
+				if (ref && ref->GetReferenceCount() == 1) // Are we the only ones to own the resource ?
+				{
+					NazaraDebug("Purging resource from file " + ref->GetFilePath());
+					it = shard.entries.erase(it); // Then we erase it
+				}
+				else
+					++it;
 			}
-			else
-				++it;
 		}
 	}
 
@@ -93,7 +170,13 @@ namespace Nz
 	{
 		String absolutePath = File::AbsolutePath(filePath);
 
-		Type::s_managerMap[absolutePath] = resource;
+		Shard& shard = GetShard(absolutePath);
+		LockGuard lock(shard.mutex);
+
+		Entry& entry = shard.entries[absolutePath];
+		entry.pendingLoad.reset(); //< A pending load won't replace the registered resource
+		entry.resource = std::move(resource);
+		entry.stats = LoadStats();
 	}
 
 	/*!
@@ -117,7 +200,10 @@ namespace Nz
 	{
 		String absolutePath = File::AbsolutePath(filePath);
 
-		Type::s_managerMap.erase(absolutePath);
+		Shard& shard = GetShard(absolutePath);
+		LockGuard lock(shard.mutex);
+
+		shard.entries.erase(absolutePath);
 	}
 
 	/*!
@@ -130,12 +216,124 @@ namespace Nz
 		return true;
 	}
 
+	/*!
+	* \brief Loads a requested resource, or waits for the thread loading it
+	* \return Reference to the object, invalid if loading failed
+	*
+	* \param pendingLoad Load request
+	*/
+	template<typename Type, typename Parameters>
+	ObjectRef<Type> ResourceManager<Type, Parameters>::Load(const std::shared_ptr<PendingLoad>& pendingLoad)
+	{
+		// Whoever comes first loads the resource, others wait for it (this prevents a synchronous Get from waiting for a task which has not started yet)
+		std::call_once(pendingLoad->loadFlag, [&pendingLoad]()
+		{
+			const String& filePath = pendingLoad->filePath;
+
+			UInt64 startTime = GetElapsedMicroseconds();
+			ObjectRef<Type> resource = Type::LoadFromFile(filePath, GetDefaultParameters());
+
+			LoadStats stats;
+			stats.loadTime = GetElapsedMicroseconds() - startTime;
+			if (resource)
+				stats.fileSize = File::GetSize(filePath);
+
+			{
+				Shard& shard = GetShard(filePath);
+				LockGuard lock(shard.mutex);
+
+				// The entry may have been cleared or replaced in the meantime
+				auto it = shard.entries.find(filePath);
+				if (it != shard.entries.end() && it->second.pendingLoad == pendingLoad)
+				{
+					if (resource)
+					{
+						it->second.pendingLoad.reset();
+						it->second.resource = resource;
+						it->second.stats = stats;
+					}
+					else
+						shard.entries.erase(it);
+				}
+			}
+
+			if (resource)
+				NazaraDebug("Loaded resource from file " + filePath);
+			else
+				NazaraError("Failed to load resource from file: " + filePath);
+
+			pendingLoad->promise.set_value(std::move(resource));
+		});
+
+		return pendingLoad->result.get();
+	}
+
+	/*!
+	* \brief Gets the task group running asynchronous loads
+	* \return Task group shared by every resource of this type
+	*/
+	template<typename Type, typename Parameters>
+	TaskGroup& ResourceManager<Type, Parameters>::GetLoadingGroup()
+	{
+		static TaskGroup loadingGroup;
+		return loadingGroup;
+	}
+
+	/*!
+	* \brief Gets the shard storing a resource
+	* \return Reference to the shard
+	*
+	* \param absolutePath Absolute path of the resource
+	*/
+	template<typename Type, typename Parameters>
+	typename ResourceManager<Type, Parameters>::Shard& ResourceManager<Type, Parameters>::GetShard(const String& absolutePath)
+	{
+		return Type::s_managerMap[std::hash<String>()(absolutePath) % ShardCount];
+	}
+
+	/*!
+	* \brief Gets a resource, or the request loading it
+	* \return Load request of the resource, or nullptr if it is already loaded
+	*
+	* \param absolutePath Absolute path of the resource
+	* \param resource Output reference to the resource, if it is already loaded
+	* \param newRequest Output boolean, set to true if the request has been created by this call
+	*/
+	template<typename Type, typename Parameters>
+	std::shared_ptr<typename ResourceManager<Type, Parameters>::PendingLoad> ResourceManager<Type, Parameters>::RequestLoad(const String& absolutePath, ObjectRef<Type>* resource, bool* newRequest)
+	{
+		Shard& shard = GetShard(absolutePath);
+		LockGuard lock(shard.mutex);
+
+		Entry& entry = shard.entries[absolutePath];
+		if (entry.resource)
+		{
+			*resource = entry.resource;
+			*newRequest = false;
+			return nullptr;
+		}
+
+		*newRequest = !entry.pendingLoad;
+		if (*newRequest)
+		{
+			entry.pendingLoad = std::make_shared<PendingLoad>();
+			entry.pendingLoad->filePath = absolutePath;
+			entry.pendingLoad->result = entry.pendingLoad->promise.get_future().share();
+		}
+
+		return entry.pendingLoad;
+	}
+
 	/*!
 	* \brief Uninitialize the resource manager
 	*/
 	template<typename Type, typename Parameters>
 	void ResourceManager<Type, Parameters>::Uninitialize()
 	{
+		TaskGroup& loadingGroup = GetLoadingGroup();
+		if (!loadingGroup.IsFinished())
+			loadingGroup.Wait();
+
 		Clear();
 	}
 }
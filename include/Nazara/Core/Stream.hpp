@@ -31,6 +31,7 @@ namespace Nz
 
 			virtual UInt64 GetCursorPos() const = 0;
 			virtual String GetDirectory() const;
+			virtual const void* GetMappedPointer() const;
 			virtual String GetPath() const;
 			inline OpenModeFlags GetOpenMode() const;
 			inline StreamOptionFlags GetStreamOptions() const;
@@ -40,6 +41,7 @@ namespace Nz
 			inline std::size_t Read(void* buffer, std::size_t size);
 			virtual String ReadLine(unsigned int lineSize = 0);
 
+			inline bool IsMemoryMapped() const;
 			inline bool IsReadable() const;
 			inline bool IsSequential() const;
 			inline bool IsTextModeEnabled() const;
@@ -67,6 +67,18 @@ namespace Nz
 		return m_streamOptions;
 	}
 
+	/*!
+	* \brief Checks whether the whole stream content is accessible through memory
+	* \return true if it is the case
+	*
+	* \see GetMappedPointer
+	*/
+
+	inline bool Stream::IsMemoryMapped() const
+	{
+		return (m_streamOptions & StreamOption_MemoryMapped) != 0;
+	}
+
 	/*!
 	* \brief Checks whether the stream is readable
 	* \return true if it is the case
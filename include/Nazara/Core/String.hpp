@@ -41,9 +41,9 @@ namespace Nz
 			String(const char* string);
 			String(const char* string, std::size_t length);
 			String(const std::string& string);
-			String(const String& string) = default;
+			String(const String& string);
 			inline String(String&& string) noexcept;
-			~String() = default;
+			inline ~String();
 
 			String& Append(char character);
 			String& Append(const char* string);
@@ -303,26 +303,20 @@ namespace Nz
 			static const std::size_t npos;
 
 		private:
-			struct SharedString;
-
-			String(std::shared_ptr<SharedString>&& sharedString);
-
-			void EnsureOwnership(bool discardContent = false);
+			void Allocate(std::size_t size, std::size_t capacity = 0);
+			inline bool IsSmall() const;
+			inline void MoveBuffer(String& string) noexcept;
 			inline void ReleaseString();
 
-			static const std::shared_ptr<SharedString>& GetEmptyString();
+			static constexpr std::size_t SmallStringCapacity = 23;
 
-			std::shared_ptr<SharedString> m_sharedString;
+			char* m_string;
+			std::size_t m_size;
 
-			struct SharedString
+			union
 			{
-				inline SharedString();
-				inline SharedString(std::size_t strSize);
-				inline SharedString(std::size_t strSize, std::size_t strCapacity);
-
-				std::size_t capacity;
-				std::size_t size;
-				std::unique_ptr<char[]> string;
+				std::size_t m_capacity;
+				char m_smallString[SmallStringCapacity + 1]; //< Short strings are stored inline, without allocation
 			};
 	};
 
@@ -3,19 +3,32 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Core/AbstractHash.hpp>
+#include <cstring>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
 {
-	inline Nz::String::String(String&& string) noexcept :
-	m_sharedString(std::move(string.m_sharedString))
+	/*!
+	* \brief Constructs a String object by moving another one
+	*
+	* \param string String to move into this
+	*
+	* \remark The moved string is left empty
+	*/
+
+	inline String::String(String&& string) noexcept
 	{
-		string.m_sharedString = GetEmptyString();
+		MoveBuffer(string);
 	}
 
-	inline String::String(std::shared_ptr<SharedString>&& sharedString) :
-	m_sharedString(std::move(sharedString))
+	/*!
+	* \brief Destructs the object
+	*/
+
+	inline String::~String()
 	{
+		if (!IsSmall())
+			delete[] m_string;
 	}
 
 	/*!
@@ -36,51 +49,57 @@ namespace Nz
 	}
 
 	/*!
-	* \brief Releases the content to the string
+	* \brief Checks whether the string is stored inline
+	* \return true if the string doesn't own a heap buffer
 	*/
 
-	inline void String::ReleaseString()
+	inline bool String::IsSmall() const
 	{
-		m_sharedString = GetEmptyString();
+		return m_string == m_smallString;
 	}
 
 	/*!
-	* \brief Constructs a SharedString object by default
+	* \brief Takes the buffer of another string, leaving it empty
+	*
+	* \param string String to take the buffer from
+	*
+	* \remark The current buffer must have been released before
 	*/
 
-	inline String::SharedString::SharedString() : // Special case: empty string
-	capacity(0),
-	size(0)
+	inline void String::MoveBuffer(String& string) noexcept
 	{
-	}
+		m_size = string.m_size;
+		if (string.IsSmall())
+		{
+			m_string = m_smallString;
+			std::memcpy(m_smallString, string.m_smallString, m_size + 1);
+		}
+		else
+		{
+			m_string = string.m_string;
+			m_capacity = string.m_capacity;
 
-	/*!
-	* \brief Constructs a SharedString object with a size
-	*
-	* \param strSize Number of characters in the string
-	*/
+			string.m_string = string.m_smallString;
+		}
 
-	inline String::SharedString::SharedString(std::size_t strSize) :
-	capacity(strSize),
-	size(strSize),
-	string(new char[strSize + 1])
-	{
-		string[strSize] = '\0';
+		string.m_size = 0;
+		string.m_smallString[0] = '\0';
 	}
 
 	/*!
-	* \brief Constructs a SharedString object with a size and a capacity
-	*
-	* \param strSize Number of characters in the string
-	* \param strCapacity Capacity in characters in the string
+	* \brief Releases the content to the string
 	*/
 
-	inline String::SharedString::SharedString(std::size_t strSize, std::size_t strCapacity) :
-	capacity(strCapacity),
-	size(strSize),
-	string(new char[strCapacity + 1])
+	inline void String::ReleaseString()
 	{
-		string[strSize] = '\0';
+		if (!IsSmall())
+		{
+			delete[] m_string;
+			m_string = m_smallString;
+		}
+
+		m_size = 0;
+		m_smallString[0] = '\0';
 	}
 
 	/*!
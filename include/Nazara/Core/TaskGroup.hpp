@@ -0,0 +1,71 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_TASKGROUP_HPP
+#define NAZARA_TASKGROUP_HPP
+
+#include <Nazara/Prerequisites.hpp>
+#include <Nazara/Core/Functor.hpp>
+#include <atomic>
+
+namespace Nz
+{
+	class ConcurrentMemoryPool;
+
+	class NAZARA_CORE_API TaskGroup
+	{
+		friend class TaskScheduler;
+
+		public:
+			inline TaskGroup();
+			TaskGroup(const TaskGroup&) = delete;
+			TaskGroup(TaskGroup&&) = delete;
+			inline ~TaskGroup();
+
+			template<typename F> void AddTask(F function);
+			template<typename F, typename... Args> void AddTask(F function, Args&&... args);
+			template<typename C> void AddTask(void (C::*function)(), C* object);
+
+			inline std::size_t GetPendingTaskCount() const;
+
+			inline bool IsFinished() const;
+
+			void Wait();
+
+			TaskGroup& operator=(const TaskGroup&) = delete;
+			TaskGroup& operator=(TaskGroup&&) = delete;
+
+		private:
+			template<typename Base>
+			struct Task : Base
+			{
+				template<typename... Args> Task(TaskGroup* group, Args&&... args);
+
+				void Run() override;
+
+				static void* operator new(std::size_t size);
+				static void operator delete(void* ptr, std::size_t size);
+
+				private:
+					TaskGroup* m_group;
+			};
+
+			void AddTaskFunctor(Functor* taskFunctor);
+			void AddTaskFunctors(Functor** taskFunctors, std::size_t count);
+			inline void NotifyTaskCompletion();
+
+			static ConcurrentMemoryPool& GetTaskPool();
+			static void NotifyCompletion();
+
+			static constexpr std::size_t TaskBlockSize = 128;
+
+			std::atomic_size_t m_pendingTaskCount;
+	};
+}
+
+#include <Nazara/Core/TaskGroup.inl>
+
+#endif // NAZARA_TASKGROUP_HPP
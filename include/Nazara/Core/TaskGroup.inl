@@ -0,0 +1,142 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/ConcurrentMemoryPool.hpp>
+#include <utility>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::TaskGroup
+	* \brief Core class that represents a set of tasks which can be waited on, independently of the other tasks of the TaskScheduler
+	*
+	* Tasks are started as soon as they are added, and can themselves add tasks to any group (including their own).
+	*/
+
+	/*!
+	* \brief Constructs an empty TaskGroup object
+	*/
+	inline TaskGroup::TaskGroup() :
+	m_pendingTaskCount(0)
+	{
+	}
+
+	/*!
+	* \brief Destructs the object and waits for its remaining tasks
+	*/
+	inline TaskGroup::~TaskGroup()
+	{
+		if (!IsFinished())
+			Wait();
+	}
+
+	/*!
+	* \brief Adds a task to the group and starts it
+	*
+	* \param function Task that the pool will execute
+	*/
+	template<typename F>
+	void TaskGroup::AddTask(F function)
+	{
+		AddTaskFunctor(new Task<FunctorWithoutArgs<F>>(this, function));
+	}
+
+	/*!
+	* \brief Adds a task to the group and starts it
+	*
+	* \param function Task that the pool will execute
+	* \param args Arguments of the function
+	*/
+	template<typename F, typename... Args>
+	void TaskGroup::AddTask(F function, Args&&... args)
+	{
+		AddTaskFunctor(new Task<FunctorWithArgs<F, Args...>>(this, function, std::forward<Args>(args)...));
+	}
+
+	/*!
+	* \brief Adds a task to the group and starts it
+	*
+	* \param function Task that the pool will execute
+	* \param object Object on which the method will be called
+	*/
+	template<typename C>
+	void TaskGroup::AddTask(void (C::*function)(), C* object)
+	{
+		AddTaskFunctor(new Task<MemberWithoutArgs<C>>(this, function, object));
+	}
+
+	/*!
+	* \brief Gets the number of tasks of this group which are not finished yet
+	* \return Number of pending tasks
+	*/
+	inline std::size_t TaskGroup::GetPendingTaskCount() const
+	{
+		return m_pendingTaskCount.load(std::memory_order_acquire);
+	}
+
+	/*!
+	* \brief Checks whether all the tasks of the group are finished
+	* \return true if no task of this group is pending
+	*/
+	inline bool TaskGroup::IsFinished() const
+	{
+		return GetPendingTaskCount() == 0;
+	}
+
+	inline void TaskGroup::NotifyTaskCompletion()
+	{
+		// The group may be destroyed by a waiting thread as soon as the counter reaches zero, don't touch it afterwards
+		if (m_pendingTaskCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			NotifyCompletion();
+	}
+
+	template<typename Base>
+	template<typename... Args>
+	TaskGroup::Task<Base>::Task(TaskGroup* group, Args&&... args) :
+	Base(std::forward<Args>(args)...),
+	m_group(group)
+	{
+	}
+
+	template<typename Base>
+	void TaskGroup::Task<Base>::Run()
+	{
+		Base::Run();
+
+		m_group->NotifyTaskCompletion();
+	}
+
+	/*!
+	* \brief Allocates a task from the task pool, which can be done and released from any thread
+	*
+	* \param size Size of the task, tasks bigger than TaskBlockSize are allocated on the heap
+	*/
+	template<typename Base>
+	void* TaskGroup::Task<Base>::operator new(std::size_t size)
+	{
+		if (size <= TaskBlockSize)
+			return GetTaskPool().Allocate();
+		else
+			return ::operator new(size);
+	}
+
+	/*!
+	* \brief Releases a task allocated by operator new
+	*
+	* \param ptr Task memory
+	* \param size Size of the task (the dynamic type size, as Functor has a virtual destructor)
+	*/
+	template<typename Base>
+	void TaskGroup::Task<Base>::operator delete(void* ptr, std::size_t size)
+	{
+		if (size <= TaskBlockSize)
+			GetTaskPool().Free(ptr);
+		else
+			::operator delete(ptr);
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
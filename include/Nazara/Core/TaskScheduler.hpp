@@ -9,6 +9,7 @@
 
 #include <Nazara/Prerequisites.hpp>
 #include <Nazara/Core/Functor.hpp>
+#include <Nazara/Core/TaskGroup.hpp>
 
 namespace Nz
 {
@@ -30,6 +31,7 @@ namespace Nz
 
 		private:
 			static void AddTaskFunctor(Functor* taskFunctor);
+			static TaskGroup& GetDefaultGroup();
 	};
 }
 
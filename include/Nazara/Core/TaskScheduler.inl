@@ -10,6 +10,8 @@ namespace Nz
 	* \ingroup core
 	* \class Nz::TaskScheduler
 	* \brief Core class that represents a thread pool
+	*
+	* Tasks added through this class are only started by Run() and waited on by WaitForTasks(), see TaskGroup for independent sets of tasks.
 	*/
 
 	/*!
@@ -21,7 +23,7 @@ namespace Nz
 	template<typename F>
 	void TaskScheduler::AddTask(F function)
 	{
-		AddTaskFunctor(new FunctorWithoutArgs<F>(function));
+		AddTaskFunctor(new TaskGroup::Task<FunctorWithoutArgs<F>>(&GetDefaultGroup(), function));
 	}
 
 	/*!
@@ -34,7 +36,7 @@ namespace Nz
 	template<typename F, typename... Args>
 	void TaskScheduler::AddTask(F function, Args&&... args)
 	{
-		AddTaskFunctor(new FunctorWithArgs<F, Args...>(function, std::forward<Args>(args)...));
+		AddTaskFunctor(new TaskGroup::Task<FunctorWithArgs<F, Args...>>(&GetDefaultGroup(), function, std::forward<Args>(args)...));
 	}
 
 	/*!
@@ -47,7 +49,7 @@ namespace Nz
 	template<typename C>
 	void TaskScheduler::AddTask(void (C::*function)(), C* object)
 	{
-		AddTaskFunctor(new MemberWithoutArgs<C>(function, object));
+		AddTaskFunctor(new TaskGroup::Task<MemberWithoutArgs<C>>(&GetDefaultGroup(), function, object));
 	}
 }
 
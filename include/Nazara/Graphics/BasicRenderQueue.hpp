@@ -9,6 +9,7 @@
 
 #include <Nazara/Prerequisites.hpp>
 #include <Nazara/Core/Color.hpp>
+#include <Nazara/Core/FrameArena.hpp>
 #include <Nazara/Core/MovablePtr.hpp>
 #include <Nazara/Graphics/AbstractRenderQueue.hpp>
 #include <Nazara/Graphics/Material.hpp>
@@ -19,7 +20,9 @@
 #include <Nazara/Utility/IndexBuffer.hpp>
 #include <Nazara/Utility/MeshData.hpp>
 #include <Nazara/Utility/VertexBuffer.hpp>
+#include <limits>
 #include <map>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -50,11 +53,22 @@ namespace Nz
 			void AddSprites(int renderOrder, const Material* material, const VertexStruct_XYZ_Color_UV* vertices, std::size_t spriteCount, const Recti& scissorRect, const Texture* overlay = nullptr) override;
 
 			void Clear(bool fully = false) override;
+			void ClearUnkeyedData();
 
 			inline const BillboardData* GetBillboardData(std::size_t billboardIndex) const;
+			inline std::size_t GetEntryCount() const;
+			inline std::size_t GetRebuiltEntryCount() const;
+			inline std::size_t GetReusedEntryCount() const;
+
+			void RemoveEntry(const void* key);
+			std::size_t RemoveUnusedEntries();
 
 			void Sort(const AbstractViewer* viewer);
 
+			BasicRenderQueue* UpdateEntry(const void* key, UInt64 revision);
+
+			static constexpr UInt64 VolatileRevision = std::numeric_limits<UInt64>::max();
+
 			struct BillboardData
 			{
 				Color color;
@@ -118,22 +132,89 @@ namespace Nz
 			RenderQueue<SpriteChain> depthSortedSprites;
 
 		private:
+			void AppendRenderData(const BasicRenderQueue& renderQueue);
 			inline Color ComputeColor(float alpha);
 			inline Vector2f ComputeSinCos(float angle);
 			inline Vector2f ComputeSize(float size);
 
+			inline std::size_t GetLayerId(int layerIndex) const;
+			void RebuildKeyedData();
 			inline void RegisterLayer(int layerIndex);
+			void RemoveEntryAt(std::size_t entryIndex);
+
+			template<typename T> static void MoveRenderData(RenderQueue<T>& source, std::size_t first, RenderQueue<T>& destination);
+			template<typename T> static void TruncateRenderData(RenderQueue<T>& renderQueue, std::size_t size);
+
+			// Gives dense ids (0, 1, 2, ...) to pointers in the order they're first seen, reset at every sort
+			template<typename T>
+			class DenseIdCache
+			{
+				public:
+					DenseIdCache() = default;
+					~DenseIdCache() = default;
+
+					inline std::size_t GetId(const T* pointer);
+
+					inline void Reset();
+
+				private:
+					inline void Grow();
 
-			std::unordered_map<const MaterialPipeline*, std::size_t> m_pipelineCache;
-			std::unordered_map<const Material*, std::size_t> m_materialCache;
-			std::unordered_map<const Texture*, std::size_t> m_overlayCache;
-			std::unordered_map<const UberShader*, std::size_t> m_shaderCache;
-			std::unordered_map<const Texture*, std::size_t> m_textureCache;
-			std::unordered_map<const VertexBuffer*, std::size_t> m_vertexBufferCache;
-			std::unordered_map<int, std::size_t> m_layerCache;
+					struct Slot
+					{
+						const T* pointer;
+						UInt32 generation;
+						UInt32 id;
+					};
+
+					std::vector<Slot> m_slots;
+					UInt32 m_generation = 0;
+					UInt32 m_idCount = 0;
+			};
+
+			DenseIdCache<MaterialPipeline> m_pipelineCache;
+			DenseIdCache<Material> m_materialCache;
+			DenseIdCache<Texture> m_overlayCache;
+			DenseIdCache<UberShader> m_shaderCache;
+			DenseIdCache<Texture> m_textureCache;
+			DenseIdCache<VertexBuffer> m_vertexBufferCache;
+
+			struct Entry
+			{
+				std::unique_ptr<BasicRenderQueue> renderQueue;
+				const void* key;
+				UInt64 revision;
+				UInt64 updateGeneration;
+			};
+
+			// Size of the keyed render data, placed before the unkeyed one
+			struct KeyedDataSizes
+			{
+				std::size_t basicSprites = 0;
+				std::size_t billboards = 0;
+				std::size_t billboardData = 0;
+				std::size_t customDrawables = 0;
+				std::size_t depthSortedBillboards = 0;
+				std::size_t depthSortedModels = 0;
+				std::size_t depthSortedSprites = 0;
+				std::size_t models = 0;
+			};
 
+			std::unique_ptr<BasicRenderQueue> m_unkeyedData;
+			std::unordered_map<const void*, std::size_t> m_entryIndices;
 			std::vector<BillboardData> m_billboards;
+			std::vector<Entry> m_entries;
+			std::vector<std::unique_ptr<BasicRenderQueue>> m_freeEntryQueues;
+			std::vector<int> m_keyedLayers;
 			std::vector<int> m_renderLayers;
+			FrameArena m_sortArena; //< Scratch memory of the sorts, reset by every Sort call
+			KeyedDataSizes m_keyedDataSizes;
+			UInt64 m_entryGeneration = 0;
+			std::size_t m_rebuiltEntryCount = 0;
+			std::size_t m_rebuiltEntryCounter = 0;
+			std::size_t m_reusedEntryCount = 0;
+			std::size_t m_reusedEntryCounter = 0;
+			bool m_keyedDataInvalidated = false;
 	};
 }
 
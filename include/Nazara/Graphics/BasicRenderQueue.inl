@@ -3,7 +3,10 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Graphics/BasicRenderQueue.hpp>
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <iterator>
 
 namespace Nz
 {
@@ -13,6 +16,37 @@ namespace Nz
 		return &m_billboards[billboardIndex];
 	}
 
+	/*!
+	* \brief Gets the number of keyed entries of the queue
+	* \return Entry count
+	*/
+	inline std::size_t BasicRenderQueue::GetEntryCount() const
+	{
+		return m_entries.size();
+	}
+
+	/*!
+	* \brief Gets the number of entries which had to be rebuilt between the two last calls to RemoveUnusedEntries
+	* \return Rebuilt entry count
+	*
+	* \see GetReusedEntryCount
+	*/
+	inline std::size_t BasicRenderQueue::GetRebuiltEntryCount() const
+	{
+		return m_rebuiltEntryCount;
+	}
+
+	/*!
+	* \brief Gets the number of entries whose data was reused between the two last calls to RemoveUnusedEntries
+	* \return Reused entry count
+	*
+	* \see GetRebuiltEntryCount
+	*/
+	inline std::size_t BasicRenderQueue::GetReusedEntryCount() const
+	{
+		return m_reusedEntryCount;
+	}
+
 	inline Color BasicRenderQueue::ComputeColor(float alpha)
 	{
 		return Color(255, 255, 255, static_cast<UInt8>(255.f * alpha));
@@ -29,10 +63,99 @@ namespace Nz
 		return Vector2f(size, size);
 	}
 
+	inline std::size_t BasicRenderQueue::GetLayerId(int layerIndex) const
+	{
+		auto it = std::lower_bound(m_renderLayers.begin(), m_renderLayers.end(), layerIndex);
+		assert(it != m_renderLayers.end() && *it == layerIndex);
+
+		return static_cast<std::size_t>(it - m_renderLayers.begin());
+	}
+
 	inline void BasicRenderQueue::RegisterLayer(int layerIndex)
 	{
 		auto it = std::lower_bound(m_renderLayers.begin(), m_renderLayers.end(), layerIndex);
 		if (it == m_renderLayers.end() || *it != layerIndex)
 			m_renderLayers.insert(it, layerIndex);
 	}
+
+	template<typename T>
+	void BasicRenderQueue::MoveRenderData(RenderQueue<T>& source, std::size_t first, RenderQueue<T>& destination)
+	{
+		destination.m_orderedRenderQueue.clear();
+		destination.m_data.assign(std::make_move_iterator(source.m_data.begin() + first), std::make_move_iterator(source.m_data.end()));
+
+		TruncateRenderData(source, first);
+	}
+
+	template<typename T>
+	void BasicRenderQueue::TruncateRenderData(RenderQueue<T>& renderQueue, std::size_t size)
+	{
+		renderQueue.m_orderedRenderQueue.clear();
+		renderQueue.m_data.erase(renderQueue.m_data.begin() + size, renderQueue.m_data.end());
+	}
+
+	template<typename T>
+	std::size_t BasicRenderQueue::DenseIdCache<T>::GetId(const T* pointer)
+	{
+		// Keep the load factor under 50%
+		if ((m_idCount + 1) * 2 > m_slots.size())
+			Grow();
+
+		std::size_t mask = m_slots.size() - 1;
+		std::size_t slotIndex = (reinterpret_cast<std::uintptr_t>(pointer) >> 4) * 0x9E3779B1U & mask;
+		for (;;)
+		{
+			Slot& slot = m_slots[slotIndex];
+			if (slot.generation != m_generation)
+			{
+				slot.pointer = pointer;
+				slot.generation = m_generation;
+				slot.id = m_idCount++;
+
+				return slot.id;
+			}
+			else if (slot.pointer == pointer)
+				return slot.id;
+
+			slotIndex = (slotIndex + 1) & mask;
+		}
+	}
+
+	template<typename T>
+	void BasicRenderQueue::DenseIdCache<T>::Reset()
+	{
+		m_idCount = 0;
+
+		// Slots from previous generations are considered empty, only clear them once every 2^32 resets
+		if (++m_generation == 0)
+		{
+			for (Slot& slot : m_slots)
+				slot.generation = 0;
+
+			m_generation = 1;
+		}
+	}
+
+	template<typename T>
+	void BasicRenderQueue::DenseIdCache<T>::Grow()
+	{
+		std::vector<Slot> oldSlots(std::max<std::size_t>(m_slots.size() * 2, 64), Slot{nullptr, 0, 0});
+		std::swap(oldSlots, m_slots);
+
+		if (m_generation == 0)
+			m_generation = 1;
+
+		std::size_t mask = m_slots.size() - 1;
+		for (const Slot& oldSlot : oldSlots)
+		{
+			if (oldSlot.generation != m_generation)
+				continue;
+
+			std::size_t slotIndex = (reinterpret_cast<std::uintptr_t>(oldSlot.pointer) >> 4) * 0x9E3779B1U & mask;
+			while (m_slots[slotIndex].generation == m_generation)
+				slotIndex = (slotIndex + 1) & mask;
+
+			m_slots[slotIndex] = oldSlot;
+		}
+	}
 }
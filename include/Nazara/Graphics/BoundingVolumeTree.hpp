@@ -0,0 +1,83 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_BOUNDINGVOLUMETREE_HPP
+#define NAZARA_BOUNDINGVOLUMETREE_HPP
+
+#include <Nazara/Prerequisites.hpp>
+#include <Nazara/Math/Box.hpp>
+#include <Nazara/Math/Frustum.hpp>
+#include <limits>
+#include <vector>
+
+namespace Nz
+{
+	template<typename T>
+	class BoundingVolumeTree
+	{
+		public:
+			BoundingVolumeTree(float margin = 0.1f);
+			BoundingVolumeTree(const BoundingVolumeTree&) = default;
+			BoundingVolumeTree(BoundingVolumeTree&&) = default;
+			~BoundingVolumeTree() = default;
+
+			void Clear();
+
+			template<typename F1, typename F2> void Cull(const Frustumf& frustum, F1&& insideCallback, F2&& intersectingCallback) const;
+
+			const Boxf& GetFatBox(std::size_t leafIndex) const;
+			std::size_t GetHeight() const;
+			std::size_t GetLeafCount() const;
+			float GetMargin() const;
+			T& GetUserData(std::size_t leafIndex);
+			const T& GetUserData(std::size_t leafIndex) const;
+
+			std::size_t Insert(const Boxf& box, T userData);
+
+			void Remove(std::size_t leafIndex);
+
+			bool Update(std::size_t leafIndex, const Boxf& box);
+
+			BoundingVolumeTree& operator=(const BoundingVolumeTree&) = default;
+			BoundingVolumeTree& operator=(BoundingVolumeTree&&) = default;
+
+			static constexpr std::size_t InvalidIndex = std::numeric_limits<std::size_t>::max();
+
+		private:
+			std::size_t AllocateNode();
+			std::size_t Balance(std::size_t index);
+			template<typename F1, typename F2> void CullNode(std::size_t index, const Frustumf& frustum, F1& insideCallback, F2& intersectingCallback) const;
+			Boxf Fatten(const Boxf& box) const;
+			void FreeNode(std::size_t index);
+			void InsertLeaf(std::size_t leafIndex);
+			bool IsLeaf(std::size_t index) const;
+			void RefitAncestors(std::size_t index);
+			void RemoveLeaf(std::size_t leafIndex);
+			template<typename F> void ReportSubtree(std::size_t index, F& callback) const;
+
+			static float ComputeCost(const Boxf& box);
+			static Boxf Merge(const Boxf& box1, const Boxf& box2);
+
+			struct Node
+			{
+				Boxf box;
+				T userData;
+				std::size_t children[2];
+				std::size_t parent; //< Next free node when the node is not used
+				int height; //< Zero for leaves, -1 for free nodes
+			};
+
+			std::vector<Node> m_nodes;
+			std::size_t m_freeList;
+			std::size_t m_leafCount;
+			std::size_t m_root;
+			float m_margin;
+	};
+}
+
+#include <Nazara/Graphics/BoundingVolumeTree.inl>
+
+#endif // NAZARA_BOUNDINGVOLUMETREE_HPP
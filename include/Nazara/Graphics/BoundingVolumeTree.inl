@@ -0,0 +1,543 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/BoundingVolumeTree.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup graphics
+	* \class Nz::BoundingVolumeTree
+	* \brief Graphics class that represents a dynamic bounding volume hierarchy of axis-aligned boxes
+	*
+	* Leaves are stored with a box enlarged by a margin, moving a leaf only updates the tree when its new box leaves the enlarged one.
+	* The tree is kept balanced by rotations, which allows to cull whole subtrees at once.
+	*
+	* \remark Leaf indices stay valid until the leaf is removed
+	*/
+
+	/*!
+	* \brief Constructs a BoundingVolumeTree object
+	*
+	* \param margin Margin added on each side of the leaf boxes
+	*/
+	template<typename T>
+	BoundingVolumeTree<T>::BoundingVolumeTree(float margin) :
+	m_freeList(InvalidIndex),
+	m_leafCount(0),
+	m_root(InvalidIndex),
+	m_margin(margin)
+	{
+	}
+
+	/*!
+	* \brief Removes every leaf of the tree
+	*/
+	template<typename T>
+	void BoundingVolumeTree<T>::Clear()
+	{
+		m_nodes.clear();
+		m_freeList = InvalidIndex;
+		m_leafCount = 0;
+		m_root = InvalidIndex;
+	}
+
+	/*!
+	* \brief Finds the leaves intersecting a frustum
+	*
+	* \param frustum Frustum to test the leaves against
+	* \param insideCallback Callback called with the user data of every leaf whose subtree is fully inside the frustum
+	* \param intersectingCallback Callback called with the user data of every leaf whose box is intersecting the frustum
+	*
+	* \remark As the boxes are enlarged, a leaf reported as intersecting may in fact be outside of the frustum
+	*/
+	template<typename T>
+	template<typename F1, typename F2>
+	void BoundingVolumeTree<T>::Cull(const Frustumf& frustum, F1&& insideCallback, F2&& intersectingCallback) const
+	{
+		if (m_root != InvalidIndex)
+			CullNode(m_root, frustum, insideCallback, intersectingCallback);
+	}
+
+	/*!
+	* \brief Gets the enlarged box of a leaf
+	* \return Box stored in the tree for this leaf
+	*
+	* \param leafIndex Index of the leaf
+	*/
+	template<typename T>
+	const Boxf& BoundingVolumeTree<T>::GetFatBox(std::size_t leafIndex) const
+	{
+		NazaraAssert(leafIndex < m_nodes.size() && IsLeaf(leafIndex), "Invalid leaf index");
+
+		return m_nodes[leafIndex].box;
+	}
+
+	/*!
+	* \brief Gets the height of the tree
+	* \return Height of the root node, zero if the tree is empty or only has one leaf
+	*/
+	template<typename T>
+	std::size_t BoundingVolumeTree<T>::GetHeight() const
+	{
+		return (m_root != InvalidIndex) ? static_cast<std::size_t>(m_nodes[m_root].height) : 0;
+	}
+
+	/*!
+	* \brief Gets the number of leaves in the tree
+	* \return Leaf count
+	*/
+	template<typename T>
+	std::size_t BoundingVolumeTree<T>::GetLeafCount() const
+	{
+		return m_leafCount;
+	}
+
+	/*!
+	* \brief Gets the margin added to the leaf boxes
+	* \return Margin
+	*/
+	template<typename T>
+	float BoundingVolumeTree<T>::GetMargin() const
+	{
+		return m_margin;
+	}
+
+	/*!
+	* \brief Gets the user data associated with a leaf
+	* \return Reference to the user data
+	*
+	* \param leafIndex Index of the leaf
+	*/
+	template<typename T>
+	T& BoundingVolumeTree<T>::GetUserData(std::size_t leafIndex)
+	{
+		NazaraAssert(leafIndex < m_nodes.size() && IsLeaf(leafIndex), "Invalid leaf index");
+
+		return m_nodes[leafIndex].userData;
+	}
+
+	/*!
+	* \brief Gets the user data associated with a leaf
+	* \return Constant reference to the user data
+	*
+	* \param leafIndex Index of the leaf
+	*/
+	template<typename T>
+	const T& BoundingVolumeTree<T>::GetUserData(std::size_t leafIndex) const
+	{
+		NazaraAssert(leafIndex < m_nodes.size() && IsLeaf(leafIndex), "Invalid leaf index");
+
+		return m_nodes[leafIndex].userData;
+	}
+
+	/*!
+	* \brief Inserts a new leaf in the tree
+	* \return Index of the new leaf
+	*
+	* \param box Box of the leaf
+	* \param userData Data associated with the leaf
+	*/
+	template<typename T>
+	std::size_t BoundingVolumeTree<T>::Insert(const Boxf& box, T userData)
+	{
+		std::size_t leafIndex = AllocateNode();
+
+		Node& leaf = m_nodes[leafIndex];
+		leaf.box = Fatten(box);
+		leaf.height = 0;
+		leaf.userData = std::move(userData);
+
+		InsertLeaf(leafIndex);
+		m_leafCount++;
+
+		return leafIndex;
+	}
+
+	/*!
+	* \brief Removes a leaf from the tree
+	*
+	* \param leafIndex Index of the leaf
+	*/
+	template<typename T>
+	void BoundingVolumeTree<T>::Remove(std::size_t leafIndex)
+	{
+		NazaraAssert(leafIndex < m_nodes.size() && IsLeaf(leafIndex), "Invalid leaf index");
+
+		RemoveLeaf(leafIndex);
+		FreeNode(leafIndex);
+		m_leafCount--;
+	}
+
+	/*!
+	* \brief Updates the box of a leaf
+	* \return true if the tree had to be updated, false if the new box is still contained in the enlarged box of the leaf
+	*
+	* \param leafIndex Index of the leaf
+	* \param box New box of the leaf
+	*/
+	template<typename T>
+	bool BoundingVolumeTree<T>::Update(std::size_t leafIndex, const Boxf& box)
+	{
+		NazaraAssert(leafIndex < m_nodes.size() && IsLeaf(leafIndex), "Invalid leaf index");
+
+		if (m_nodes[leafIndex].box.Contains(box))
+			return false;
+
+		RemoveLeaf(leafIndex);
+		m_nodes[leafIndex].box = Fatten(box);
+		InsertLeaf(leafIndex);
+
+		return true;
+	}
+
+	template<typename T>
+	std::size_t BoundingVolumeTree<T>::AllocateNode()
+	{
+		std::size_t index;
+		if (m_freeList != InvalidIndex)
+		{
+			index = m_freeList;
+			m_freeList = m_nodes[index].parent;
+		}
+		else
+		{
+			index = m_nodes.size();
+			m_nodes.emplace_back();
+		}
+
+		Node& node = m_nodes[index];
+		node.children[0] = InvalidIndex;
+		node.children[1] = InvalidIndex;
+		node.height = 0;
+		node.parent = InvalidIndex;
+
+		return index;
+	}
+
+	template<typename T>
+	std::size_t BoundingVolumeTree<T>::Balance(std::size_t indexA)
+	{
+		// Performs a left or right rotation if the subtree of A is imbalanced, returns the index of the new subtree root
+		Node& a = m_nodes[indexA];
+		if (IsLeaf(indexA) || a.height < 2)
+			return indexA;
+
+		std::size_t indexB = a.children[0];
+		std::size_t indexC = a.children[1];
+		Node& b = m_nodes[indexB];
+		Node& c = m_nodes[indexC];
+
+		int balance = c.height - b.height;
+
+		auto ReplaceChild = [&](std::size_t parentIndex, std::size_t oldChild, std::size_t newChild)
+		{
+			if (parentIndex == InvalidIndex)
+			{
+				m_root = newChild;
+				return;
+			}
+
+			Node& parent = m_nodes[parentIndex];
+			if (parent.children[0] == oldChild)
+				parent.children[0] = newChild;
+			else
+				parent.children[1] = newChild;
+		};
+
+		if (balance > 1)
+		{
+			// Rotate C up
+			std::size_t indexF = c.children[0];
+			std::size_t indexG = c.children[1];
+			Node& f = m_nodes[indexF];
+			Node& g = m_nodes[indexG];
+
+			c.children[0] = indexA;
+			c.parent = a.parent;
+			a.parent = indexC;
+			ReplaceChild(c.parent, indexA, indexC);
+
+			if (f.height > g.height)
+			{
+				c.children[1] = indexF;
+				a.children[1] = indexG;
+				g.parent = indexA;
+
+				a.box = Merge(b.box, g.box);
+				c.box = Merge(a.box, f.box);
+				a.height = 1 + std::max(b.height, g.height);
+				c.height = 1 + std::max(a.height, f.height);
+			}
+			else
+			{
+				c.children[1] = indexG;
+				a.children[1] = indexF;
+				f.parent = indexA;
+
+				a.box = Merge(b.box, f.box);
+				c.box = Merge(a.box, g.box);
+				a.height = 1 + std::max(b.height, f.height);
+				c.height = 1 + std::max(a.height, g.height);
+			}
+
+			return indexC;
+		}
+
+		if (balance < -1)
+		{
+			// Rotate B up
+			std::size_t indexD = b.children[0];
+			std::size_t indexE = b.children[1];
+			Node& d = m_nodes[indexD];
+			Node& e = m_nodes[indexE];
+
+			b.children[0] = indexA;
+			b.parent = a.parent;
+			a.parent = indexB;
+			ReplaceChild(b.parent, indexA, indexB);
+
+			if (d.height > e.height)
+			{
+				b.children[1] = indexD;
+				a.children[0] = indexE;
+				e.parent = indexA;
+
+				a.box = Merge(c.box, e.box);
+				b.box = Merge(a.box, d.box);
+				a.height = 1 + std::max(c.height, e.height);
+				b.height = 1 + std::max(a.height, d.height);
+			}
+			else
+			{
+				b.children[1] = indexE;
+				a.children[0] = indexD;
+				d.parent = indexA;
+
+				a.box = Merge(c.box, d.box);
+				b.box = Merge(a.box, e.box);
+				a.height = 1 + std::max(c.height, d.height);
+				b.height = 1 + std::max(a.height, e.height);
+			}
+
+			return indexB;
+		}
+
+		return indexA;
+	}
+
+	template<typename T>
+	template<typename F1, typename F2>
+	void BoundingVolumeTree<T>::CullNode(std::size_t index, const Frustumf& frustum, F1& insideCallback, F2& intersectingCallback) const
+	{
+		const Node& node = m_nodes[index];
+		switch (frustum.Intersect(node.box))
+		{
+			case IntersectionSide_Inside:
+				ReportSubtree(index, insideCallback);
+				break;
+
+			case IntersectionSide_Intersecting:
+				if (IsLeaf(index))
+					intersectingCallback(node.userData);
+				else
+				{
+					CullNode(node.children[0], frustum, insideCallback, intersectingCallback);
+					CullNode(node.children[1], frustum, insideCallback, intersectingCallback);
+				}
+				break;
+
+			case IntersectionSide_Outside:
+				break;
+		}
+	}
+
+	template<typename T>
+	Boxf BoundingVolumeTree<T>::Fatten(const Boxf& box) const
+	{
+		return Boxf(box.x - m_margin, box.y - m_margin, box.z - m_margin, box.width + 2.f * m_margin, box.height + 2.f * m_margin, box.depth + 2.f * m_margin);
+	}
+
+	template<typename T>
+	void BoundingVolumeTree<T>::FreeNode(std::size_t index)
+	{
+		Node& node = m_nodes[index];
+		node.height = -1;
+		node.parent = m_freeList;
+
+		m_freeList = index;
+	}
+
+	template<typename T>
+	void BoundingVolumeTree<T>::InsertLeaf(std::size_t leafIndex)
+	{
+		if (m_root == InvalidIndex)
+		{
+			m_root = leafIndex;
+			m_nodes[leafIndex].parent = InvalidIndex;
+			return;
+		}
+
+		// Find the best sibling for the new leaf, using the surface area heuristic
+		Boxf leafBox = m_nodes[leafIndex].box;
+
+		std::size_t index = m_root;
+		while (!IsLeaf(index))
+		{
+			const Node& node = m_nodes[index];
+
+			float area = ComputeCost(node.box);
+			float combinedArea = ComputeCost(Merge(node.box, leafBox));
+
+			// Cost of creating a new parent for this node and the new leaf
+			float cost = 2.f * combinedArea;
+
+			// Minimum cost of pushing the leaf further down the tree
+			float inheritanceCost = 2.f * (combinedArea - area);
+
+			auto ChildCost = [&](std::size_t childIndex)
+			{
+				const Node& child = m_nodes[childIndex];
+
+				float childCost = ComputeCost(Merge(leafBox, child.box));
+				if (!IsLeaf(childIndex))
+					childCost -= ComputeCost(child.box);
+
+				return childCost + inheritanceCost;
+			};
+
+			float cost0 = ChildCost(node.children[0]);
+			float cost1 = ChildCost(node.children[1]);
+
+			if (cost < cost0 && cost < cost1)
+				break;
+
+			index = (cost0 < cost1) ? node.children[0] : node.children[1];
+		}
+
+		std::size_t siblingIndex = index;
+
+		// Create a new parent, the node array may be reallocated
+		std::size_t oldParentIndex = m_nodes[siblingIndex].parent;
+		std::size_t newParentIndex = AllocateNode();
+
+		Node& newParent = m_nodes[newParentIndex];
+		newParent.parent = oldParentIndex;
+		newParent.box = Merge(leafBox, m_nodes[siblingIndex].box);
+		newParent.height = m_nodes[siblingIndex].height + 1;
+		newParent.children[0] = siblingIndex;
+		newParent.children[1] = leafIndex;
+
+		if (oldParentIndex != InvalidIndex)
+		{
+			Node& oldParent = m_nodes[oldParentIndex];
+			if (oldParent.children[0] == siblingIndex)
+				oldParent.children[0] = newParentIndex;
+			else
+				oldParent.children[1] = newParentIndex;
+		}
+		else
+			m_root = newParentIndex;
+
+		m_nodes[siblingIndex].parent = newParentIndex;
+		m_nodes[leafIndex].parent = newParentIndex;
+
+		RefitAncestors(m_nodes[leafIndex].parent);
+	}
+
+	template<typename T>
+	bool BoundingVolumeTree<T>::IsLeaf(std::size_t index) const
+	{
+		return m_nodes[index].children[0] == InvalidIndex;
+	}
+
+	template<typename T>
+	void BoundingVolumeTree<T>::RefitAncestors(std::size_t index)
+	{
+		while (index != InvalidIndex)
+		{
+			index = Balance(index);
+
+			Node& node = m_nodes[index];
+			const Node& child0 = m_nodes[node.children[0]];
+			const Node& child1 = m_nodes[node.children[1]];
+
+			node.box = Merge(child0.box, child1.box);
+			node.height = 1 + std::max(child0.height, child1.height);
+
+			index = node.parent;
+		}
+	}
+
+	template<typename T>
+	void BoundingVolumeTree<T>::RemoveLeaf(std::size_t leafIndex)
+	{
+		if (leafIndex == m_root)
+		{
+			m_root = InvalidIndex;
+			return;
+		}
+
+		std::size_t parentIndex = m_nodes[leafIndex].parent;
+		std::size_t grandParentIndex = m_nodes[parentIndex].parent;
+
+		const Node& parent = m_nodes[parentIndex];
+		std::size_t siblingIndex = (parent.children[0] == leafIndex) ? parent.children[1] : parent.children[0];
+
+		// The sibling takes the place of the parent
+		m_nodes[siblingIndex].parent = grandParentIndex;
+		FreeNode(parentIndex);
+
+		if (grandParentIndex != InvalidIndex)
+		{
+			Node& grandParent = m_nodes[grandParentIndex];
+			if (grandParent.children[0] == parentIndex)
+				grandParent.children[0] = siblingIndex;
+			else
+				grandParent.children[1] = siblingIndex;
+
+			RefitAncestors(grandParentIndex);
+		}
+		else
+			m_root = siblingIndex;
+	}
+
+	template<typename T>
+	template<typename F>
+	void BoundingVolumeTree<T>::ReportSubtree(std::size_t index, F& callback) const
+	{
+		const Node& node = m_nodes[index];
+		if (IsLeaf(index))
+			callback(node.userData);
+		else
+		{
+			ReportSubtree(node.children[0], callback);
+			ReportSubtree(node.children[1], callback);
+		}
+	}
+
+	template<typename T>
+	float BoundingVolumeTree<T>::ComputeCost(const Boxf& box)
+	{
+		// Surface area of the box
+		return 2.f * (box.width * box.height + box.height * box.depth + box.depth * box.width);
+	}
+
+	template<typename T>
+	Boxf BoundingVolumeTree<T>::Merge(const Boxf& box1, const Boxf& box2)
+	{
+		Boxf merged(box1);
+		merged.ExtendTo(box2);
+
+		return merged;
+	}
+
+	template<typename T>
+	constexpr std::size_t BoundingVolumeTree<T>::InvalidIndex;
+}
+
+#include <Nazara/Graphics/DebugOff.hpp>
@@ -9,8 +9,10 @@
 
 #include <Nazara/Prerequisites.hpp>
 #include <Nazara/Core/Signal.hpp>
+#include <Nazara/Graphics/BoundingVolumeTree.hpp>
 #include <Nazara/Graphics/Config.hpp>
 #include <Nazara/Graphics/Enums.hpp>
+#include <Nazara/Graphics/FrustumCulling.hpp>
 #include <Nazara/Math/BoundingVolume.hpp>
 #include <Nazara/Math/Frustum.hpp>
 #include <Nazara/Math/Sphere.hpp>
@@ -36,7 +38,7 @@ namespace Nz
 
 			using ResultContainer = std::vector<const T*>;
 
-			CullingList() = default;
+			explicit CullingList(CullingMode mode = CullingMode::Linear);
 			CullingList(const CullingList& renderable) = delete;
 			CullingList(CullingList&& renderable) = delete;
 			~CullingList();
@@ -45,6 +47,7 @@ namespace Nz
 
 			std::size_t FillWithAllEntries(bool* forceInvalidation = nullptr);
 
+			CullingMode GetCullingMode() const;
 			const ResultContainer& GetFullyVisibleResults() const;
 			const ResultContainer& GetPartiallyVisibleResults() const;
 
@@ -53,6 +56,8 @@ namespace Nz
 			SphereEntry RegisterSphereTest(const T* renderable);
 			VolumeEntry RegisterVolumeTest(const T* renderable);
 
+			void SetCullingMode(CullingMode mode);
+
 			CullingList& operator=(const CullingList& renderable) = delete;
 			CullingList& operator=(CullingList&& renderable) = delete;
 
@@ -66,11 +71,35 @@ namespace Nz
 			inline void NotifySphereUpdate(std::size_t index, const Spheref& sphere);
 			inline void NotifyVolumeUpdate(std::size_t index, const BoundingVolumef& boundingVolume);
 
+			Boxf GetBox(std::size_t index) const;
+			Spheref GetSphere(std::size_t index) const;
+
+			static Boxf GetBoundingBox(const Spheref& sphere);
+
+			// Volumes of the box and sphere entries are stored separately as structures of arrays, to be culled using SIMD
+			struct BoxVolumes
+			{
+				std::vector<float> minX;
+				std::vector<float> minY;
+				std::vector<float> minZ;
+				std::vector<float> maxX;
+				std::vector<float> maxY;
+				std::vector<float> maxZ;
+			};
+
+			struct SphereVolumes
+			{
+				std::vector<float> x;
+				std::vector<float> y;
+				std::vector<float> z;
+				std::vector<float> radius;
+			};
+
 			struct BoxVisibilityEntry
 			{
-				Boxf box;
 				BoxEntry* entry;
 				const T* renderable;
+				std::size_t treeIndex;
 				bool forceInvalidation;
 			};
 
@@ -83,9 +112,9 @@ namespace Nz
 
 			struct SphereVisibilityEntry
 			{
-				Spheref sphere;
 				SphereEntry* entry;
 				const T* renderable;
+				std::size_t treeIndex;
 				bool forceInvalidation;
 			};
 
@@ -94,15 +123,29 @@ namespace Nz
 				BoundingVolumef volume;
 				VolumeEntry* entry;
 				const T* renderable;
+				std::size_t treeIndex; //< Only finite volumes are stored in the tree
 				bool forceInvalidation;
 			};
 
+			struct TreeEntry
+			{
+				CullTest type;
+				std::size_t index;
+			};
+
+			using Tree = BoundingVolumeTree<TreeEntry>;
+
 			std::vector<BoxVisibilityEntry> m_boxTestList;
 			std::vector<NoTestVisibilityEntry> m_noTestList;
 			std::vector<SphereVisibilityEntry> m_sphereTestList;
 			std::vector<VolumeVisibilityEntry> m_volumeTestList;
+			std::vector<IntersectionSide> m_intersectionSides;
+			BoxVolumes m_boxVolumes;
+			CullingMode m_cullingMode;
 			ResultContainer m_fullyVisibleResults;
 			ResultContainer m_partiallyVisibleResults;
+			SphereVolumes m_sphereVolumes;
+			Tree m_tree;
 	};
 
 	template<typename T>
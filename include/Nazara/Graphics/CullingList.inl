@@ -3,10 +3,33 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Graphics/CullingList.hpp>
+#include <algorithm>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
 {
+	/*!
+	* \ingroup graphics
+	* \class Nz::CullingList
+	* \brief Graphics class that represents a list of renderables to cull against frustums
+	*
+	* Box and sphere volumes are stored as structures of arrays, allowing the linear mode to test several of them at once using SIMD.
+	* In hierarchical mode, box, sphere and finite volume entries are kept in a BoundingVolumeTree updated as they move,
+	* allowing to cull whole groups of entries at once, which is faster for big scenes with mostly static entries.
+	*/
+
+	/*!
+	* \brief Constructs a CullingList object
+	*
+	* \param mode Culling mode to use
+	*/
+	template<typename T>
+	CullingList<T>::CullingList(CullingMode mode) :
+	m_cullingMode(CullingMode::Linear)
+	{
+		SetCullingMode(mode);
+	}
+
 	template<typename T>
 	CullingList<T>::~CullingList()
 	{
@@ -29,9 +52,9 @@ namespace Nz
 			return currentHash * 23 + newHash;
 		};
 
-		for (BoxVisibilityEntry& entry : m_boxTestList)
+		auto AddResult = [&](auto& entry, IntersectionSide side)
 		{
-			switch (frustum.Intersect(entry.box))
+			switch (side)
 			{
 				case IntersectionSide_Inside:
 					m_fullyVisibleResults.push_back(entry.renderable);
@@ -52,6 +75,80 @@ namespace Nz
 				case IntersectionSide_Outside:
 					break;
 			}
+		};
+
+		if (m_cullingMode == CullingMode::Hierarchical)
+		{
+			// Leaves of subtrees fully inside the frustum don't need to be tested, others are tested using their real volume
+			m_tree.Cull(frustum, [&](const TreeEntry& treeEntry)
+			{
+				switch (treeEntry.type)
+				{
+					case CullTest::Box:
+						AddResult(m_boxTestList[treeEntry.index], IntersectionSide_Inside);
+						break;
+
+					case CullTest::Sphere:
+						AddResult(m_sphereTestList[treeEntry.index], IntersectionSide_Inside);
+						break;
+
+					case CullTest::Volume:
+						AddResult(m_volumeTestList[treeEntry.index], IntersectionSide_Inside);
+						break;
+
+					default:
+						NazaraInternalError("Unhandled culltype");
+						break;
+				}
+			},
+			[&](const TreeEntry& treeEntry)
+			{
+				switch (treeEntry.type)
+				{
+					case CullTest::Box:
+					{
+						std::size_t i = treeEntry.index;
+
+						IntersectionSide side;
+						CullBoxes(frustum, &m_boxVolumes.minX[i], &m_boxVolumes.minY[i], &m_boxVolumes.minZ[i], &m_boxVolumes.maxX[i], &m_boxVolumes.maxY[i], &m_boxVolumes.maxZ[i], 1, &side);
+
+						AddResult(m_boxTestList[i], side);
+						break;
+					}
+
+					case CullTest::Sphere:
+					{
+						std::size_t i = treeEntry.index;
+
+						IntersectionSide side;
+						CullSpheres(frustum, &m_sphereVolumes.x[i], &m_sphereVolumes.y[i], &m_sphereVolumes.z[i], &m_sphereVolumes.radius[i], 1, &side);
+
+						AddResult(m_sphereTestList[i], side);
+						break;
+					}
+
+					case CullTest::Volume:
+					{
+						VolumeVisibilityEntry& entry = m_volumeTestList[treeEntry.index];
+						AddResult(entry, frustum.Intersect(entry.volume));
+						break;
+					}
+
+					default:
+						NazaraInternalError("Unhandled culltype");
+						break;
+				}
+			});
+		}
+		else
+		{
+			std::size_t boxCount = m_boxTestList.size();
+			m_intersectionSides.resize(std::max(boxCount, m_sphereTestList.size()));
+
+			CullBoxes(frustum, m_boxVolumes.minX.data(), m_boxVolumes.minY.data(), m_boxVolumes.minZ.data(), m_boxVolumes.maxX.data(), m_boxVolumes.maxY.data(), m_boxVolumes.maxZ.data(), boxCount, m_intersectionSides.data());
+
+			for (std::size_t i = 0; i < boxCount; ++i)
+				AddResult(m_boxTestList[i], m_intersectionSides[i]);
 		}
 
 		for (NoTestVisibilityEntry& entry : m_noTestList)
@@ -66,54 +163,21 @@ namespace Nz
 			}
 		}
 
-		for (SphereVisibilityEntry& entry : m_sphereTestList)
+		if (m_cullingMode == CullingMode::Linear)
 		{
-			switch (frustum.Intersect(entry.sphere))
-			{
-				case IntersectionSide_Inside:
-					m_fullyVisibleResults.push_back(entry.renderable);
-					fullyVisibleHash = CombineHash(fullyVisibleHash, std::hash<const T*>()(entry.renderable));
-
-					forcedInvalidation = forcedInvalidation | entry.forceInvalidation;
-					entry.forceInvalidation = false;
-					break;
+			std::size_t sphereCount = m_sphereTestList.size();
 
-				case IntersectionSide_Intersecting:
-					m_partiallyVisibleResults.push_back(entry.renderable);
-					partiallyVisibleHash = CombineHash(partiallyVisibleHash, std::hash<const T*>()(entry.renderable));
-
-					forcedInvalidation = forcedInvalidation | entry.forceInvalidation;
-					entry.forceInvalidation = false;
-					break;
+			CullSpheres(frustum, m_sphereVolumes.x.data(), m_sphereVolumes.y.data(), m_sphereVolumes.z.data(), m_sphereVolumes.radius.data(), sphereCount, m_intersectionSides.data());
 
-				case IntersectionSide_Outside:
-					break;
-			}
+			for (std::size_t i = 0; i < sphereCount; ++i)
+				AddResult(m_sphereTestList[i], m_intersectionSides[i]);
 		}
-		
+
 		for (VolumeVisibilityEntry& entry : m_volumeTestList)
 		{
-			switch (frustum.Intersect(entry.volume))
-			{
-				case IntersectionSide_Inside:
-					m_fullyVisibleResults.push_back(entry.renderable);
-					fullyVisibleHash = CombineHash(fullyVisibleHash, std::hash<const T*>()(entry.renderable));
-
-					forcedInvalidation = forcedInvalidation | entry.forceInvalidation;
-					entry.forceInvalidation = false;
-					break;
-
-				case IntersectionSide_Intersecting:
-					m_partiallyVisibleResults.push_back(entry.renderable);
-					partiallyVisibleHash = CombineHash(partiallyVisibleHash, std::hash<const T*>()(entry.renderable));
-
-					forcedInvalidation = forcedInvalidation | entry.forceInvalidation;
-					entry.forceInvalidation = false;
-					break;
-
-				case IntersectionSide_Outside:
-					break;
-			}
+			// Infinite and null volumes are never stored in the tree
+			if (entry.treeIndex == Tree::InvalidIndex)
+				AddResult(entry, frustum.Intersect(entry.volume));
 		}
 
 		if (forceInvalidation)
@@ -155,6 +219,12 @@ namespace Nz
 		return visibleHash;
 	}
 
+	template<typename T>
+	CullingMode CullingList<T>::GetCullingMode() const
+	{
+		return m_cullingMode;
+	}
+
 	template<typename T>
 	auto CullingList<T>::GetFullyVisibleResults() const -> const ResultContainer&
 	{
@@ -170,8 +240,14 @@ namespace Nz
 	template<typename T>
 	auto CullingList<T>::RegisterBoxTest(const T* renderable) -> BoxEntry
 	{
-		BoxEntry newEntry(this, m_boxTestList.size());
-		m_boxTestList.emplace_back(BoxVisibilityEntry{ Nz::Boxf(), &newEntry, renderable, false }); //< Address of entry will be updated when moving
+		std::size_t index = m_boxTestList.size();
+		std::size_t treeIndex = (m_cullingMode == CullingMode::Hierarchical) ? m_tree.Insert(Boxf::Zero(), TreeEntry{CullTest::Box, index}) : Tree::InvalidIndex;
+
+		BoxEntry newEntry(this, index);
+		m_boxTestList.emplace_back(BoxVisibilityEntry{&newEntry, renderable, treeIndex, false}); //< Address of entry will be updated when moving
+
+		for (std::vector<float>* component : {&m_boxVolumes.minX, &m_boxVolumes.minY, &m_boxVolumes.minZ, &m_boxVolumes.maxX, &m_boxVolumes.maxY, &m_boxVolumes.maxZ})
+			component->push_back(0.f);
 
 		return newEntry;
 	}
@@ -188,8 +264,14 @@ namespace Nz
 	template<typename T>
 	auto CullingList<T>::RegisterSphereTest(const T* renderable) -> SphereEntry
 	{
-		SphereEntry newEntry(this, m_sphereTestList.size());
-		m_sphereTestList.emplace_back(SphereVisibilityEntry{Nz::Spheref(), &newEntry, renderable, false}); //< Address of entry will be updated when moving
+		std::size_t index = m_sphereTestList.size();
+		std::size_t treeIndex = (m_cullingMode == CullingMode::Hierarchical) ? m_tree.Insert(Boxf::Zero(), TreeEntry{CullTest::Sphere, index}) : Tree::InvalidIndex;
+
+		SphereEntry newEntry(this, index);
+		m_sphereTestList.emplace_back(SphereVisibilityEntry{&newEntry, renderable, treeIndex, false}); //< Address of entry will be updated when moving
+
+		for (std::vector<float>* component : {&m_sphereVolumes.x, &m_sphereVolumes.y, &m_sphereVolumes.z, &m_sphereVolumes.radius})
+			component->push_back(0.f);
 
 		return newEntry;
 	}
@@ -198,15 +280,69 @@ namespace Nz
 	auto CullingList<T>::RegisterVolumeTest(const T* renderable) -> VolumeEntry
 	{
 		VolumeEntry newEntry(this, m_volumeTestList.size());
-		m_volumeTestList.emplace_back(VolumeVisibilityEntry{Nz::BoundingVolumef(), &newEntry, renderable, false}); //< Address of entry will be updated when moving
+		m_volumeTestList.emplace_back(VolumeVisibilityEntry{Nz::BoundingVolumef(), &newEntry, renderable, Tree::InvalidIndex, false}); //< Address of entry will be updated when moving
 
 		return newEntry;
 	}
 
+	/*!
+	* \brief Changes the way entries are culled
+	*
+	* \param mode New culling mode
+	*
+	* \remark Switching to the hierarchical mode builds the tree from every entry, which takes some time for big lists
+	*/
+	template<typename T>
+	void CullingList<T>::SetCullingMode(CullingMode mode)
+	{
+		if (m_cullingMode == mode)
+			return;
+
+		m_cullingMode = mode;
+
+		if (m_cullingMode == CullingMode::Hierarchical)
+		{
+			for (std::size_t i = 0; i < m_boxTestList.size(); ++i)
+				m_boxTestList[i].treeIndex = m_tree.Insert(GetBox(i), TreeEntry{CullTest::Box, i});
+
+			for (std::size_t i = 0; i < m_sphereTestList.size(); ++i)
+				m_sphereTestList[i].treeIndex = m_tree.Insert(GetBoundingBox(GetSphere(i)), TreeEntry{CullTest::Sphere, i});
+
+			for (std::size_t i = 0; i < m_volumeTestList.size(); ++i)
+			{
+				VolumeVisibilityEntry& entry = m_volumeTestList[i];
+				if (entry.volume.IsFinite())
+					entry.treeIndex = m_tree.Insert(entry.volume.aabb, TreeEntry{CullTest::Volume, i});
+			}
+		}
+		else
+		{
+			m_tree.Clear();
+
+			for (BoxVisibilityEntry& entry : m_boxTestList)
+				entry.treeIndex = Tree::InvalidIndex;
+
+			for (SphereVisibilityEntry& entry : m_sphereTestList)
+				entry.treeIndex = Tree::InvalidIndex;
+
+			for (VolumeVisibilityEntry& entry : m_volumeTestList)
+				entry.treeIndex = Tree::InvalidIndex;
+		}
+	}
+
 	template<typename T>
 	inline void CullingList<T>::NotifyBoxUpdate(std::size_t index, const Boxf& box)
 	{
-		m_boxTestList[index].box = box;
+		m_boxVolumes.minX[index] = box.x;
+		m_boxVolumes.minY[index] = box.y;
+		m_boxVolumes.minZ[index] = box.z;
+		m_boxVolumes.maxX[index] = box.x + box.width;
+		m_boxVolumes.maxY[index] = box.y + box.height;
+		m_boxVolumes.maxZ[index] = box.z + box.depth;
+
+		BoxVisibilityEntry& entry = m_boxTestList[index];
+		if (entry.treeIndex != Tree::InvalidIndex)
+			m_tree.Update(entry.treeIndex, box);
 	}
 
 	template<typename T>
@@ -296,15 +432,34 @@ namespace Nz
 	template<typename T>
 	void CullingList<T>::NotifyRelease(CullTest type, std::size_t index)
 	{
+		auto RemoveVolume = [&](std::vector<float>& component)
+		{
+			component[index] = component.back();
+			component.pop_back();
+		};
+
+		// Removes the entry from the tree and moves the last entry in its place
+		auto RemoveEntry = [&](auto& testList)
+		{
+			if (testList[index].treeIndex != Tree::InvalidIndex)
+				m_tree.Remove(testList[index].treeIndex);
+
+			testList[index] = std::move(testList.back());
+			testList[index].entry->UpdateIndex(index);
+			testList.pop_back();
+
+			if (index < testList.size() && testList[index].treeIndex != Tree::InvalidIndex)
+				m_tree.GetUserData(testList[index].treeIndex).index = index;
+		};
+
 		switch (type)
 		{
 			case CullTest::Box:
-			{
-				m_boxTestList[index] = std::move(m_boxTestList.back());
-				m_boxTestList[index].entry->UpdateIndex(index);
-				m_boxTestList.pop_back();
+				RemoveEntry(m_boxTestList);
+
+				for (std::vector<float>* component : {&m_boxVolumes.minX, &m_boxVolumes.minY, &m_boxVolumes.minZ, &m_boxVolumes.maxX, &m_boxVolumes.maxY, &m_boxVolumes.maxZ})
+					RemoveVolume(*component);
 				break;
-			}
 
 			case CullTest::NoTest:
 			{
@@ -315,20 +470,15 @@ namespace Nz
 			}
 
 			case CullTest::Sphere:
-			{
-				m_sphereTestList[index] = std::move(m_sphereTestList.back());
-				m_sphereTestList[index].entry->UpdateIndex(index);
-				m_sphereTestList.pop_back();
+				RemoveEntry(m_sphereTestList);
+
+				for (std::vector<float>* component : {&m_sphereVolumes.x, &m_sphereVolumes.y, &m_sphereVolumes.z, &m_sphereVolumes.radius})
+					RemoveVolume(*component);
 				break;
-			}
 
 			case CullTest::Volume:
-			{
-				m_volumeTestList[index] = std::move(m_volumeTestList.back());
-				m_volumeTestList[index].entry->UpdateIndex(index);
-				m_volumeTestList.pop_back();
+				RemoveEntry(m_volumeTestList);
 				break;
-			}
 
 			default:
 				NazaraInternalError("Unhandled culltype");
@@ -339,13 +489,60 @@ namespace Nz
 	template<typename T>
 	void CullingList<T>::NotifySphereUpdate(std::size_t index, const Spheref& sphere)
 	{
-		m_sphereTestList[index].sphere = sphere;
+		m_sphereVolumes.x[index] = sphere.x;
+		m_sphereVolumes.y[index] = sphere.y;
+		m_sphereVolumes.z[index] = sphere.z;
+		m_sphereVolumes.radius[index] = sphere.radius;
+
+		SphereVisibilityEntry& entry = m_sphereTestList[index];
+		if (entry.treeIndex != Tree::InvalidIndex)
+			m_tree.Update(entry.treeIndex, GetBoundingBox(sphere));
 	}
 
 	template<typename T>
 	void CullingList<T>::NotifyVolumeUpdate(std::size_t index, const BoundingVolumef& boundingVolume)
 	{
-		m_volumeTestList[index].volume = boundingVolume;
+		VolumeVisibilityEntry& entry = m_volumeTestList[index];
+		entry.volume = boundingVolume;
+
+		if (m_cullingMode != CullingMode::Hierarchical)
+			return;
+
+		// Only finite volumes can be stored in the tree
+		if (boundingVolume.IsFinite())
+		{
+			if (entry.treeIndex != Tree::InvalidIndex)
+				m_tree.Update(entry.treeIndex, boundingVolume.aabb);
+			else
+				entry.treeIndex = m_tree.Insert(boundingVolume.aabb, TreeEntry{CullTest::Volume, index});
+		}
+		else if (entry.treeIndex != Tree::InvalidIndex)
+		{
+			m_tree.Remove(entry.treeIndex);
+			entry.treeIndex = Tree::InvalidIndex;
+		}
+	}
+
+	template<typename T>
+	Boxf CullingList<T>::GetBox(std::size_t index) const
+	{
+		float x = m_boxVolumes.minX[index];
+		float y = m_boxVolumes.minY[index];
+		float z = m_boxVolumes.minZ[index];
+
+		return Boxf(x, y, z, m_boxVolumes.maxX[index] - x, m_boxVolumes.maxY[index] - y, m_boxVolumes.maxZ[index] - z);
+	}
+
+	template<typename T>
+	Spheref CullingList<T>::GetSphere(std::size_t index) const
+	{
+		return Spheref(m_sphereVolumes.x[index], m_sphereVolumes.y[index], m_sphereVolumes.z[index], m_sphereVolumes.radius[index]);
+	}
+
+	template<typename T>
+	Boxf CullingList<T>::GetBoundingBox(const Spheref& sphere)
+	{
+		return Boxf(sphere.x - sphere.radius, sphere.y - sphere.radius, sphere.z - sphere.radius, 2.f * sphere.radius, 2.f * sphere.radius, 2.f * sphere.radius);
 	}
 
 	//////////////////////////////////////////////////////////////////////////
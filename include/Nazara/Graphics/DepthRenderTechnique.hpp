@@ -25,6 +25,7 @@ namespace Nz
 
 			void Clear(const SceneData& sceneData) const override;
 			bool Draw(const SceneData& sceneData) const override;
+			bool Draw(const SceneData& sceneData, const BasicRenderQueue& renderQueue) const;
 
 			AbstractRenderQueue* GetRenderQueue() override;
 			RenderTechniqueType GetType() const override;
@@ -44,6 +45,8 @@ namespace Nz
 			const ShaderUniforms* GetShaderUniforms(const Shader* shader) const;
 			void OnShaderInvalidated(const Shader* shader) const;
 
+			static const RenderTarget* GetRenderTarget(const SceneData& sceneData);
+
 			struct LightIndex
 			{
 				LightType type;
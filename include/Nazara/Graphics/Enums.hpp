@@ -27,6 +27,12 @@ namespace Nz
 		Volume
 	};
 
+	enum class CullingMode
+	{
+		Hierarchical, // Entries are stored in a BoundingVolumeTree
+		Linear        // Every entry is tested against the frustum
+	};
+
 	enum ProjectionType
 	{
 		ProjectionType_Orthogonal,
@@ -0,0 +1,30 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_FRUSTUMCULLING_HPP
+#define NAZARA_FRUSTUMCULLING_HPP
+
+#include <Nazara/Prerequisites.hpp>
+#include <Nazara/Math/Enums.hpp>
+#include <Nazara/Math/Frustum.hpp>
+
+#if defined(__AVX__)
+	#define NAZARA_FRUSTUMCULLING_AVX
+	#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define NAZARA_FRUSTUMCULLING_SSE
+	#include <emmintrin.h>
+#endif
+
+namespace Nz
+{
+	inline void CullBoxes(const Frustumf& frustum, const float* minX, const float* minY, const float* minZ, const float* maxX, const float* maxY, const float* maxZ, std::size_t count, IntersectionSide* results);
+	inline void CullSpheres(const Frustumf& frustum, const float* x, const float* y, const float* z, const float* radius, std::size_t count, IntersectionSide* results);
+}
+
+#include <Nazara/Graphics/FrustumCulling.inl>
+
+#endif // NAZARA_FRUSTUMCULLING_HPP
@@ -0,0 +1,268 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/FrustumCulling.hpp>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	namespace Detail
+	{
+		struct BoxCullingPlane
+		{
+			const float* negativeX;
+			const float* negativeY;
+			const float* negativeZ;
+			const float* positiveX;
+			const float* positiveY;
+			const float* positiveZ;
+			float distance;
+			float normalX;
+			float normalY;
+			float normalZ;
+		};
+
+		inline IntersectionSide GetIntersectionSide(bool outside, bool intersecting)
+		{
+			if (outside)
+				return IntersectionSide_Outside;
+			else if (intersecting)
+				return IntersectionSide_Intersecting;
+			else
+				return IntersectionSide_Inside;
+		}
+	}
+
+	/*!
+	* \ingroup graphics
+	* \brief Tests a structure-of-arrays set of boxes against a frustum
+	*
+	* Boxes are tested four (SSE2) or eight (AVX) at a time against each plane, the remaining boxes are tested one at a time.
+	* Results are the same as the ones of Frustum::Intersect.
+	*
+	* \param frustum Frustum to test the boxes against
+	* \param minX Minimum X coordinates of the boxes
+	* \param minY Minimum Y coordinates of the boxes
+	* \param minZ Minimum Z coordinates of the boxes
+	* \param maxX Maximum X coordinates of the boxes
+	* \param maxY Maximum Y coordinates of the boxes
+	* \param maxZ Maximum Z coordinates of the boxes
+	* \param count Number of boxes
+	* \param results Array of count elements receiving the intersection side of each box
+	*/
+	inline void CullBoxes(const Frustumf& frustum, const float* minX, const float* minY, const float* minZ, const float* maxX, const float* maxY, const float* maxZ, std::size_t count, IntersectionSide* results)
+	{
+		// The positive (and negative) vertex of a box only depends on the plane normal, select the arrays once per plane
+		Detail::BoxCullingPlane planes[FrustumPlane_Max + 1];
+		for (unsigned int i = 0; i <= FrustumPlane_Max; ++i)
+		{
+			const Planef& plane = frustum.GetPlane(static_cast<FrustumPlane>(i));
+
+			Detail::BoxCullingPlane& cullingPlane = planes[i];
+			cullingPlane.distance = plane.distance;
+			cullingPlane.normalX = plane.normal.x;
+			cullingPlane.normalY = plane.normal.y;
+			cullingPlane.normalZ = plane.normal.z;
+			cullingPlane.negativeX = (plane.normal.x < 0.f) ? maxX : minX;
+			cullingPlane.negativeY = (plane.normal.y < 0.f) ? maxY : minY;
+			cullingPlane.negativeZ = (plane.normal.z < 0.f) ? maxZ : minZ;
+			cullingPlane.positiveX = (plane.normal.x > 0.f) ? maxX : minX;
+			cullingPlane.positiveY = (plane.normal.y > 0.f) ? maxY : minY;
+			cullingPlane.positiveZ = (plane.normal.z > 0.f) ? maxZ : minZ;
+		}
+
+		std::size_t i = 0;
+
+		#if defined(NAZARA_FRUSTUMCULLING_AVX)
+		const __m256 zero = _mm256_setzero_ps();
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 outside = zero;
+			__m256 intersecting = zero;
+
+			for (const Detail::BoxCullingPlane& plane : planes)
+			{
+				__m256 normalX = _mm256_set1_ps(plane.normalX);
+				__m256 normalY = _mm256_set1_ps(plane.normalY);
+				__m256 normalZ = _mm256_set1_ps(plane.normalZ);
+				__m256 distance = _mm256_set1_ps(plane.distance);
+
+				__m256 positiveDistance = _mm256_mul_ps(normalX, _mm256_loadu_ps(plane.positiveX + i));
+				positiveDistance = _mm256_add_ps(positiveDistance, _mm256_mul_ps(normalY, _mm256_loadu_ps(plane.positiveY + i)));
+				positiveDistance = _mm256_add_ps(positiveDistance, _mm256_mul_ps(normalZ, _mm256_loadu_ps(plane.positiveZ + i)));
+				positiveDistance = _mm256_sub_ps(positiveDistance, distance);
+
+				__m256 negativeDistance = _mm256_mul_ps(normalX, _mm256_loadu_ps(plane.negativeX + i));
+				negativeDistance = _mm256_add_ps(negativeDistance, _mm256_mul_ps(normalY, _mm256_loadu_ps(plane.negativeY + i)));
+				negativeDistance = _mm256_add_ps(negativeDistance, _mm256_mul_ps(normalZ, _mm256_loadu_ps(plane.negativeZ + i)));
+				negativeDistance = _mm256_sub_ps(negativeDistance, distance);
+
+				outside = _mm256_or_ps(outside, _mm256_cmp_ps(positiveDistance, zero, _CMP_LT_OQ));
+				intersecting = _mm256_or_ps(intersecting, _mm256_cmp_ps(negativeDistance, zero, _CMP_LT_OQ));
+			}
+
+			int outsideMask = _mm256_movemask_ps(outside);
+			int intersectingMask = _mm256_movemask_ps(intersecting);
+			for (unsigned int j = 0; j < 8; ++j)
+				results[i + j] = Detail::GetIntersectionSide((outsideMask & (1 << j)) != 0, (intersectingMask & (1 << j)) != 0);
+		}
+		#elif defined(NAZARA_FRUSTUMCULLING_SSE)
+		const __m128 zero = _mm_setzero_ps();
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 outside = zero;
+			__m128 intersecting = zero;
+
+			for (const Detail::BoxCullingPlane& plane : planes)
+			{
+				__m128 normalX = _mm_set1_ps(plane.normalX);
+				__m128 normalY = _mm_set1_ps(plane.normalY);
+				__m128 normalZ = _mm_set1_ps(plane.normalZ);
+				__m128 distance = _mm_set1_ps(plane.distance);
+
+				__m128 positiveDistance = _mm_mul_ps(normalX, _mm_loadu_ps(plane.positiveX + i));
+				positiveDistance = _mm_add_ps(positiveDistance, _mm_mul_ps(normalY, _mm_loadu_ps(plane.positiveY + i)));
+				positiveDistance = _mm_add_ps(positiveDistance, _mm_mul_ps(normalZ, _mm_loadu_ps(plane.positiveZ + i)));
+				positiveDistance = _mm_sub_ps(positiveDistance, distance);
+
+				__m128 negativeDistance = _mm_mul_ps(normalX, _mm_loadu_ps(plane.negativeX + i));
+				negativeDistance = _mm_add_ps(negativeDistance, _mm_mul_ps(normalY, _mm_loadu_ps(plane.negativeY + i)));
+				negativeDistance = _mm_add_ps(negativeDistance, _mm_mul_ps(normalZ, _mm_loadu_ps(plane.negativeZ + i)));
+				negativeDistance = _mm_sub_ps(negativeDistance, distance);
+
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(positiveDistance, zero));
+				intersecting = _mm_or_ps(intersecting, _mm_cmplt_ps(negativeDistance, zero));
+			}
+
+			int outsideMask = _mm_movemask_ps(outside);
+			int intersectingMask = _mm_movemask_ps(intersecting);
+			for (unsigned int j = 0; j < 4; ++j)
+				results[i + j] = Detail::GetIntersectionSide((outsideMask & (1 << j)) != 0, (intersectingMask & (1 << j)) != 0);
+		}
+		#endif
+
+		// Scalar fallback, also handles the remaining boxes
+		for (; i < count; ++i)
+		{
+			bool outside = false;
+			bool intersecting = false;
+
+			for (const Detail::BoxCullingPlane& plane : planes)
+			{
+				float positiveDistance = plane.normalX * plane.positiveX[i] + plane.normalY * plane.positiveY[i] + plane.normalZ * plane.positiveZ[i] - plane.distance;
+				float negativeDistance = plane.normalX * plane.negativeX[i] + plane.normalY * plane.negativeY[i] + plane.normalZ * plane.negativeZ[i] - plane.distance;
+
+				outside = outside || (positiveDistance < 0.f);
+				intersecting = intersecting || (negativeDistance < 0.f);
+			}
+
+			results[i] = Detail::GetIntersectionSide(outside, intersecting);
+		}
+	}
+
+	/*!
+	* \ingroup graphics
+	* \brief Tests a structure-of-arrays set of spheres against a frustum
+	*
+	* Spheres are tested four (SSE2) or eight (AVX) at a time against each plane, the remaining spheres are tested one at a time.
+	* Results are the same as the ones of Frustum::Intersect.
+	*
+	* \param frustum Frustum to test the spheres against
+	* \param x X coordinates of the sphere centers
+	* \param y Y coordinates of the sphere centers
+	* \param z Z coordinates of the sphere centers
+	* \param radius Radii of the spheres
+	* \param count Number of spheres
+	* \param results Array of count elements receiving the intersection side of each sphere
+	*/
+	inline void CullSpheres(const Frustumf& frustum, const float* x, const float* y, const float* z, const float* radius, std::size_t count, IntersectionSide* results)
+	{
+		std::size_t i = 0;
+
+		#if defined(NAZARA_FRUSTUMCULLING_AVX)
+		const __m256 zero = _mm256_setzero_ps();
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 centerX = _mm256_loadu_ps(x + i);
+			__m256 centerY = _mm256_loadu_ps(y + i);
+			__m256 centerZ = _mm256_loadu_ps(z + i);
+			__m256 positiveRadius = _mm256_loadu_ps(radius + i);
+			__m256 negativeRadius = _mm256_sub_ps(zero, positiveRadius);
+
+			__m256 outside = zero;
+			__m256 intersecting = zero;
+
+			for (unsigned int j = 0; j <= FrustumPlane_Max; ++j)
+			{
+				const Planef& plane = frustum.GetPlane(static_cast<FrustumPlane>(j));
+
+				__m256 distance = _mm256_mul_ps(_mm256_set1_ps(plane.normal.x), centerX);
+				distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(plane.normal.y), centerY));
+				distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(plane.normal.z), centerZ));
+				distance = _mm256_sub_ps(distance, _mm256_set1_ps(plane.distance));
+
+				outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, negativeRadius, _CMP_LT_OQ));
+				intersecting = _mm256_or_ps(intersecting, _mm256_cmp_ps(distance, positiveRadius, _CMP_LT_OQ));
+			}
+
+			int outsideMask = _mm256_movemask_ps(outside);
+			int intersectingMask = _mm256_movemask_ps(intersecting);
+			for (unsigned int j = 0; j < 8; ++j)
+				results[i + j] = Detail::GetIntersectionSide((outsideMask & (1 << j)) != 0, (intersectingMask & (1 << j)) != 0);
+		}
+		#elif defined(NAZARA_FRUSTUMCULLING_SSE)
+		const __m128 zero = _mm_setzero_ps();
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 centerX = _mm_loadu_ps(x + i);
+			__m128 centerY = _mm_loadu_ps(y + i);
+			__m128 centerZ = _mm_loadu_ps(z + i);
+			__m128 positiveRadius = _mm_loadu_ps(radius + i);
+			__m128 negativeRadius = _mm_sub_ps(zero, positiveRadius);
+
+			__m128 outside = zero;
+			__m128 intersecting = zero;
+
+			for (unsigned int j = 0; j <= FrustumPlane_Max; ++j)
+			{
+				const Planef& plane = frustum.GetPlane(static_cast<FrustumPlane>(j));
+
+				__m128 distance = _mm_mul_ps(_mm_set1_ps(plane.normal.x), centerX);
+				distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.normal.y), centerY));
+				distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.normal.z), centerZ));
+				distance = _mm_sub_ps(distance, _mm_set1_ps(plane.distance));
+
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, negativeRadius));
+				intersecting = _mm_or_ps(intersecting, _mm_cmplt_ps(distance, positiveRadius));
+			}
+
+			int outsideMask = _mm_movemask_ps(outside);
+			int intersectingMask = _mm_movemask_ps(intersecting);
+			for (unsigned int j = 0; j < 4; ++j)
+				results[i + j] = Detail::GetIntersectionSide((outsideMask & (1 << j)) != 0, (intersectingMask & (1 << j)) != 0);
+		}
+		#endif
+
+		// Scalar fallback, also handles the remaining spheres
+		for (; i < count; ++i)
+		{
+			bool outside = false;
+			bool intersecting = false;
+
+			for (unsigned int j = 0; j <= FrustumPlane_Max; ++j)
+			{
+				const Planef& plane = frustum.GetPlane(static_cast<FrustumPlane>(j));
+
+				float distance = plane.normal.x * x[i] + plane.normal.y * y[i] + plane.normal.z * z[i] - plane.distance;
+
+				outside = outside || (distance < -radius[i]);
+				intersecting = intersecting || (distance < radius[i]);
+			}
+
+			results[i] = Detail::GetIntersectionSide(outside, intersecting);
+		}
+	}
+}
+
+#include <Nazara/Graphics/DebugOff.hpp>
@@ -13,6 +13,9 @@
 
 namespace Nz
 {
+	class BasicRenderQueue;
+	class FrameArena;
+
 	class RenderQueueInternal
 	{
 		public:
@@ -29,7 +32,7 @@ namespace Nz
 		protected:
 			using RenderDataPair = std::pair<Index, std::size_t>;
 
-			void Sort();
+			void Sort(FrameArena& scratchArena);
 
 			std::vector<RenderDataPair> m_orderedRenderQueue;
 	};
@@ -37,6 +40,8 @@ namespace Nz
 	template<typename RenderData>
 	class RenderQueue : public RenderQueueInternal
 	{
+		friend BasicRenderQueue;
+
 		public:
 			class const_iterator;
 			friend const_iterator;
@@ -47,11 +52,14 @@ namespace Nz
 			RenderQueue(RenderQueue&&) noexcept = default;
 			~RenderQueue() = default;
 
+			void Append(const RenderQueue& renderQueue);
+			template<typename TransformFunc> void Append(const RenderQueue& renderQueue, TransformFunc&& transform);
+
 			void Clear();
 
 			void Insert(RenderData&& data);
 
-			template<typename IndexFunc> void Sort(IndexFunc&& func);
+			template<typename IndexFunc> void Sort(IndexFunc&& func, FrameArena& scratchArena);
 
 			// STL API
 			inline const_iterator begin() const;
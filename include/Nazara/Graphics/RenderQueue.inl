@@ -7,6 +7,38 @@
 
 namespace Nz
 {
+	/*!
+	* \brief Appends the (unsorted) render data of another queue to this one
+	*
+	* \param renderQueue Queue whose data will be copied at the end of this one
+	*
+	* \remark The queue has to be sorted again before being iterated
+	*/
+	template<typename RenderData>
+	void RenderQueue<RenderData>::Append(const RenderQueue& renderQueue)
+	{
+		m_data.insert(m_data.end(), renderQueue.m_data.begin(), renderQueue.m_data.end());
+	}
+
+	/*!
+	* \brief Appends the (unsorted) render data of another queue to this one, applying a function on every copied element
+	*
+	* \param renderQueue Queue whose data will be copied at the end of this one
+	* \param transform Function called with a reference to every copied element, as transform(RenderData&)
+	*
+	* \remark The queue has to be sorted again before being iterated
+	*/
+	template<typename RenderData>
+	template<typename TransformFunc>
+	void RenderQueue<RenderData>::Append(const RenderQueue& renderQueue, TransformFunc&& transform)
+	{
+		std::size_t firstIndex = m_data.size();
+		Append(renderQueue);
+
+		for (std::size_t i = firstIndex; i < m_data.size(); ++i)
+			transform(m_data[i]);
+	}
+
 	template<typename RenderData>
 	void RenderQueue<RenderData>::Clear()
 	{
@@ -20,9 +52,15 @@ namespace Nz
 		m_data.emplace_back(std::move(data));
 	}
 
+	/*!
+	* \brief Sorts the render data by the index computed for each of them, keeping the insertion order of equal indices
+	*
+	* \param func Function computing the index of render data, as func(const RenderData&) -> UInt64
+	* \param scratchArena Arena providing the temporary memory of the sort, which is given back to it before returning
+	*/
 	template<typename RenderData>
 	template<typename IndexFunc>
-	void RenderQueue<RenderData>::Sort(IndexFunc&& func)
+	void RenderQueue<RenderData>::Sort(IndexFunc&& func, FrameArena& scratchArena)
 	{
 		m_orderedRenderQueue.clear();
 		m_orderedRenderQueue.reserve(m_data.size());
@@ -31,7 +69,7 @@ namespace Nz
 		for (const RenderData& renderData : m_data)
 			m_orderedRenderQueue.emplace_back(func(renderData), dataIndex++);
 
-		RenderQueueInternal::Sort();
+		RenderQueueInternal::Sort(scratchArena);
 	}
 
 	template<typename RenderData>
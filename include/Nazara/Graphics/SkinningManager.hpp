@@ -21,8 +21,6 @@ namespace Nz
 		friend class Graphics;
 
 		public:
-			using SkinFunction = void (*)(const SkeletalMesh* mesh, const Skeleton* skeleton, VertexBuffer* buffer);
-
 			SkinningManager() = delete;
 			~SkinningManager() = delete;
 
@@ -35,8 +33,6 @@ namespace Nz
 			static void OnSkeletonInvalidated(const Skeleton* skeleton);
 			static void OnSkeletonRelease(const Skeleton* skeleton);
 			static void Uninitialize();
-
-			static SkinFunction s_skinFunc;
 	};
 }
 
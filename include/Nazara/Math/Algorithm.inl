@@ -595,20 +595,21 @@ namespace Nz
 		else
 			negative = false;
 
-		String str;
-		str.Reserve(GetNumberLength(number)); // Prends en compte le signe négatif
+		// Digits are written backwards, 64 binary digits and the sign at most
+		char buffer[65];
+		char* ptr = &buffer[65];
 
 		do
 		{
-			str.Append(symbols[number % radix]);
+			*--ptr = symbols[number % radix];
 			number /= radix;
 		}
 		while (number > 0);
 
 		if (negative)
-			str.Append('-');
+			*--ptr = '-';
 
-		return str.Reverse();
+		return String(ptr, &buffer[65] - ptr);
 	}
 
 	/*!
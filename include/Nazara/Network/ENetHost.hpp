@@ -20,7 +20,7 @@
 #include <Nazara/Prerequisites.hpp>
 #include <Nazara/Core/Bitset.hpp>
 #include <Nazara/Core/Clock.hpp>
-#include <Nazara/Core/MemoryPool.hpp>
+#include <Nazara/Core/ConcurrentMemoryPool.hpp>
 #include <Nazara/Network/ENetCompressor.hpp>
 #include <Nazara/Network/ENetPeer.hpp>
 #include <Nazara/Network/ENetProtocol.hpp>
@@ -29,6 +29,7 @@
 #include <Nazara/Network/NetPacket.hpp>
 #include <Nazara/Network/SocketPoller.hpp>
 #include <Nazara/Network/UdpSocket.hpp>
+#include <memory>
 #include <random>
 
 namespace Nz
@@ -145,7 +146,7 @@ namespace Nz
 			std::vector<PendingOutgoingPacket> m_pendingOutgoingPackets;
 			MovablePtr<UInt8> m_receivedData;
 			Bitset<UInt64> m_dispatchQueue;
-			MemoryPool m_packetPool;
+			std::unique_ptr<ConcurrentMemoryPool> m_packetPool; //< Behind a pointer so packets keep a valid owner when the host is moved
 			IpAddress m_address;
 			IpAddress m_receivedAddress;
 			SocketPoller m_poller;
@@ -9,7 +9,7 @@
 namespace Nz
 {
 	inline ENetHost::ENetHost() :
-	m_packetPool(sizeof(ENetPacket)),
+	m_packetPool(std::make_unique<ConcurrentMemoryPool>(sizeof(ENetPacket))),
 	m_isUsingDualStack(false),
 	m_isSimulationEnabled(false)
 	{
@@ -43,6 +43,8 @@ namespace Nz
 		OpenGLExtension_SeparateShaderObjects,
 		OpenGLExtension_SeamlessCubeMap,
 		OpenGLExtension_Shader_ImageLoadStore,
+		OpenGLExtension_TextureCompression_bptc,
+		OpenGLExtension_TextureCompression_rgtc,
 		OpenGLExtension_TextureCompression_s3tc,
 		OpenGLExtension_TextureStorage,
 
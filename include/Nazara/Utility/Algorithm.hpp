@@ -34,6 +34,13 @@ namespace Nz
 		MeshVertex* outputVertex;
 	};
 
+	struct SkinningPaletteData
+	{
+		const Vector4f* palette; //< Three rows per joint, as computed by ComputeSkinningPalette
+		const SkeletalMeshVertex* inputVertex;
+		MeshVertex* outputVertex;
+	};
+
 	struct VertexPointers
 	{
 		SparsePtr<Vector3f> normalPtr;
@@ -44,11 +51,12 @@ namespace Nz
 
 	NAZARA_UTILITY_API Boxf ComputeAABB(SparsePtr<const Vector3f> positionPtr, unsigned int vertexCount);
 	NAZARA_UTILITY_API void ComputeBoxIndexVertexCount(const Vector3ui& subdivision, unsigned int* indexCount, unsigned int* vertexCount);
-	NAZARA_UTILITY_API unsigned int ComputeCacheMissCount(IndexIterator indices, unsigned int indexCount);
+	NAZARA_UTILITY_API unsigned int ComputeCacheMissCount(IndexIterator indices, unsigned int indexCount, unsigned int cacheSize = 16);
 	NAZARA_UTILITY_API void ComputeConeIndexVertexCount(unsigned int subdivision, unsigned int* indexCount, unsigned int* vertexCount);
 	NAZARA_UTILITY_API void ComputeCubicSphereIndexVertexCount(unsigned int subdivision, unsigned int* indexCount, unsigned int* vertexCount);
 	NAZARA_UTILITY_API void ComputeIcoSphereIndexVertexCount(unsigned int recursionLevel, unsigned int* indexCount, unsigned int* vertexCount);
 	NAZARA_UTILITY_API void ComputePlaneIndexVertexCount(const Vector2ui& subdivision, unsigned int* indexCount, unsigned int* vertexCount);
+	NAZARA_UTILITY_API void ComputeSkinningPalette(const Joint* joints, unsigned int jointCount, Vector4f* palette);
 	NAZARA_UTILITY_API void ComputeUvSphereIndexVertexCount(unsigned int sliceCount, unsigned int stackCount, unsigned int* indexCount, unsigned int* vertexCount);
 
 	NAZARA_UTILITY_API void GenerateBox(const Vector3f& lengths, const Vector3ui& subdivision, const Matrix4f& matrix, const Rectf& textureCoords, VertexPointers vertexPointers, IndexIterator indices, Boxf* aabb = nullptr, unsigned int indexOffset = 0);
@@ -58,11 +66,14 @@ namespace Nz
 	NAZARA_UTILITY_API void GeneratePlane(const Vector2ui& subdivision, const Vector2f& size, const Matrix4f& matrix, const Rectf& textureCoords, VertexPointers vertexPointers, IndexIterator indices, Boxf* aabb = nullptr, unsigned int indexOffset = 0);
 	NAZARA_UTILITY_API void GenerateUvSphere(float size, unsigned int sliceCount, unsigned int stackCount, const Matrix4f& matrix, const Rectf& textureCoords, VertexPointers vertexPointers, IndexIterator indices, Boxf* aabb = nullptr, unsigned int indexOffset = 0);
 
-	NAZARA_UTILITY_API void OptimizeIndices(IndexIterator indices, unsigned int indexCount);
+	NAZARA_UTILITY_API void OptimizeIndices(IndexIterator indices, unsigned int indexCount, unsigned int cacheSize = 16);
+	NAZARA_UTILITY_API void OptimizeOverdraw(IndexIterator indices, unsigned int indexCount, SparsePtr<const Vector3f> positionPtr, unsigned int cacheSize = 16, float threshold = 1.05f);
+	NAZARA_UTILITY_API void OptimizeVertexFetch(IndexIterator indices, unsigned int indexCount, void* vertices, std::size_t vertexStride, unsigned int vertexCount);
 
 	NAZARA_UTILITY_API void SkinPosition(const SkinningData& data, unsigned int startVertex, unsigned int vertexCount);
 	NAZARA_UTILITY_API void SkinPositionNormal(const SkinningData& data, unsigned int startVertex, unsigned int vertexCount);
 	NAZARA_UTILITY_API void SkinPositionNormalTangent(const SkinningData& data, unsigned int startVertex, unsigned int vertexCount);
+	NAZARA_UTILITY_API void SkinPositionNormalTangent(const SkinningPaletteData& data, unsigned int startVertex, unsigned int vertexCount);
 
 	NAZARA_UTILITY_API void TransformVertices(VertexPointers vertexPointers, unsigned int vertexCount, const Matrix4f& matrix);
 
@@ -89,6 +89,15 @@ namespace Nz
 		ComponentType_Max = ComponentType_Quaternion
 	};
 
+	enum CompressionQuality
+	{
+		CompressionQuality_Fast,   // Endpoints from the principal axis only
+		CompressionQuality_Normal, // One least-squares refinement of the endpoints
+		CompressionQuality_High,   // Refinement until the error stops decreasing
+
+		CompressionQuality_Max = CompressionQuality_High
+	};
+
 	enum CubemapFace
 	{
 		// This enumeration is intended to replace the "z" argument of Image's methods containing cubemap
@@ -141,6 +150,14 @@ namespace Nz
 		ImageType_Max = ImageType_Cubemap
 	};
 
+	enum MipmapFilter
+	{
+		MipmapFilter_Box,    // Average of the covered pixels, fast
+		MipmapFilter_Kaiser, // Kaiser-windowed sinc, sharper
+
+		MipmapFilter_Max = MipmapFilter_Kaiser
+	};
+
 	enum NodeType
 	{
 		NodeType_Default,  // Node
@@ -166,6 +183,9 @@ namespace Nz
 		PixelFormatType_Undefined = -1,
 
 		PixelFormatType_A8,              // 1*uint8
+		PixelFormatType_BC4,             // Red channel, 4x4 blocks of 8 bytes
+		PixelFormatType_BC5,             // Red and green channels, 4x4 blocks of 16 bytes
+		PixelFormatType_BC7,             // RGBA, 4x4 blocks of 16 bytes
 		PixelFormatType_BGR8,            // 3*uint8
 		PixelFormatType_BGRA8,           // 4*uint8
 		PixelFormatType_DXT1,
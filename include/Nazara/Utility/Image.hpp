@@ -32,6 +32,9 @@ namespace Nz
 		// Le nombre de niveaux de mipmaps maximum devant être créé
 		UInt8 levelCount = 0;
 
+		// La qualité de compression, si loadFormat est un format compressé
+		CompressionQuality compressionQuality = CompressionQuality_Normal;
+
 		bool IsValid() const;
 	};
 
@@ -61,7 +64,7 @@ namespace Nz
 			Image(SharedImage* sharedImage);
 			~Image();
 
-			bool Convert(PixelFormatType format);
+			bool Convert(PixelFormatType format, CompressionQuality quality = CompressionQuality_Normal);
 
 			void Copy(const Image* source, const Boxui& srcBox, const Vector3ui& dstPos);
 
@@ -75,6 +78,8 @@ namespace Nz
 			bool FlipHorizontally();
 			bool FlipVertically();
 
+			bool GenerateMipmaps(MipmapFilter filter = MipmapFilter_Box, bool sRGB = false);
+
 			const UInt8* GetConstPixels(unsigned int x = 0, unsigned int y = 0, unsigned int z = 0, UInt8 level = 0) const;
 			unsigned int GetDepth(UInt8 level = 0) const override;
 			PixelFormatType GetFormat() const override;
@@ -15,6 +15,7 @@
 namespace Nz
 {
 	class IndexBuffer;
+	class VertexBuffer;
 
 	using IndexBufferConstRef = ObjectRef<const IndexBuffer>;
 	using IndexBufferRef = ObjectRef<IndexBuffer>;
@@ -52,6 +53,8 @@ namespace Nz
 			void* MapRaw(BufferAccess access, UInt32 offset = 0, UInt32 size = 0) const;
 
 			void Optimize();
+			void OptimizeOverdraw(const VertexBuffer* vertexBuffer);
+			void OptimizeVertexFetch(VertexBuffer* vertexBuffer);
 
 			void Reset();
 			void Reset(bool largeIndices, BufferRef buffer);
@@ -39,13 +39,12 @@ namespace Nz
 		DataStorage storage = DataStorage_Hardware; ///< The place where the buffers will be allocated
 		Vector2f texCoordOffset = {0.f, 0.f};       ///< Offset to apply on the texture coordinates (not scaled)
 		Vector2f texCoordScale  = {1.f, 1.f};       ///< Scale to apply on the texture coordinates
+		String cacheDirectory;                      ///< If not empty, meshes loaded from files are saved in this directory as .nmesh files, and loaded from there as long as the file and these parameters don't change (other files used by the loader, such as .mtl material libraries, are not checked)
 		bool animated = true;                       ///< If true, will load an animated version of the model if possible
 		bool center = false;                        ///< If true, will center the mesh vertices around the origin
-		#ifndef NAZARA_DEBUG
 		bool optimizeIndexBuffers = true;           ///< Optimize the index buffers after loading, improve cache locality (and thus rendering speed) but increase loading time.
-		#else
-		bool optimizeIndexBuffers = false;          ///< Since this optimization take a lot of time, especially in debug mode, don't enable it by default in debug.
-		#endif
+		bool optimizeOverdraw = false;              ///< Reorder the triangles so the ones most likely to occlude others are drawn first, reduce overdraw at the cost of a slightly worse cache locality
+		bool optimizeVertexBuffers = true;          ///< Reorder the vertices in the order the index buffers use them, improve memory access locality when fetching vertices
 
 		/* The declaration must have a Vector3f position component enabled
 		 * If the declaration has a Vector2f UV component enabled, UV are generated
@@ -116,6 +115,7 @@ namespace Nz
 			const SubMesh* GetSubMesh(const String& identifier) const;
 			const SubMesh* GetSubMesh(UInt32 index) const;
 			UInt32 GetSubMeshCount() const;
+			String GetSubMeshIdentifier(UInt32 index) const;
 			UInt32 GetSubMeshIndex(const String& identifier) const;
 			UInt32 GetTriangleCount() const;
 			UInt32 GetVertexCount() const;
@@ -60,6 +60,7 @@ namespace Nz
 			using ConvertFunction = std::function<UInt8*(const UInt8* start, const UInt8* end, UInt8* dst)>;
 			using FlipFunction = std::function<void(unsigned int width, unsigned int height, unsigned int depth, const UInt8* src, UInt8* dst)>;
 
+			static bool Compress(PixelFormatType srcFormat, PixelFormatType dstFormat, unsigned int width, unsigned int height, const void* src, void* dst, CompressionQuality quality = CompressionQuality_Normal);
 			static inline std::size_t ComputeSize(PixelFormatType format, unsigned int width, unsigned int height, unsigned int depth);
 
 			static inline bool Convert(PixelFormatType srcFormat, PixelFormatType dstFormat, const void* src, void* dst);
@@ -78,6 +79,7 @@ namespace Nz
 			static PixelFormatType IdentifyFormat(const PixelFormatInfo& info);
 
 			static inline bool IsCompressed(PixelFormatType format);
+			static inline bool IsCompressionSupported(PixelFormatType srcFormat, PixelFormatType dstFormat);
 			static inline bool IsConversionSupported(PixelFormatType srcFormat, PixelFormatType dstFormat);
 			static inline bool IsValid(PixelFormatType format);
 
@@ -149,10 +149,15 @@ namespace Nz
 		{
 			switch (format)
 			{
+				case PixelFormatType_BC4:
 				case PixelFormatType_DXT1:
+					return ((width + 3) / 4) * ((height + 3) / 4) * 8 * depth;
+
+				case PixelFormatType_BC5:
+				case PixelFormatType_BC7:
 				case PixelFormatType_DXT3:
 				case PixelFormatType_DXT5:
-					return (((width + 3) / 4) * ((height + 3) / 4) * ((format == PixelFormatType_DXT1) ? 8 : 16)) * depth;
+					return ((width + 3) / 4) * ((height + 3) / 4) * 16 * depth;
 
 				default:
 					NazaraError("Unsupported format");
@@ -185,7 +190,7 @@ namespace Nz
 		}
 		#endif
 
-		ConvertFunction func = s_convertFunctions[srcFormat][dstFormat];
+		const ConvertFunction& func = s_convertFunctions[srcFormat][dstFormat];
 		if (!func)
 		{
 			NazaraError("Pixel format conversion from " + GetName(srcFormat) + " to " + GetName(dstFormat) + " is not supported");
@@ -209,7 +214,7 @@ namespace Nz
 			return true;
 		}
 
-		ConvertFunction func = s_convertFunctions[srcFormat][dstFormat];
+		const ConvertFunction& func = s_convertFunctions[srcFormat][dstFormat];
 		if (!func)
 		{
 			NazaraError("Pixel format conversion from " + GetName(srcFormat) + " to " + GetName(dstFormat) + " is not supported");
@@ -260,6 +265,27 @@ namespace Nz
 		return s_pixelFormatInfos[format].IsCompressed();
 	}
 
+	inline bool PixelFormat::IsCompressionSupported(PixelFormatType srcFormat, PixelFormatType dstFormat)
+	{
+		if (IsCompressed(srcFormat))
+			return false;
+
+		switch (dstFormat)
+		{
+			case PixelFormatType_BC4:
+			case PixelFormatType_BC5:
+			case PixelFormatType_BC7:
+			case PixelFormatType_DXT1:
+			case PixelFormatType_DXT3:
+			case PixelFormatType_DXT5:
+				// Blocks are encoded from RGBA8 pixels
+				return IsConversionSupported(srcFormat, PixelFormatType_RGBA8);
+
+			default:
+				return false;
+		}
+	}
+
 	inline bool PixelFormat::IsConversionSupported(PixelFormatType srcFormat, PixelFormatType dstFormat)
 	{
 		if (srcFormat == dstFormat)
@@ -352,6 +352,14 @@ MeshRef LoadMesh(Stream& stream, const MeshParams& parameters)
 				}
 			}
 
+			vertexMapper.Unmap();
+
+			if (parameters.optimizeOverdraw)
+				indexBuffer->OptimizeOverdraw(vertexBuffer);
+
+			if (parameters.optimizeVertexBuffers)
+				indexBuffer->OptimizeVertexFetch(vertexBuffer);
+
 			// Submesh
 			SkeletalMeshRef subMesh = SkeletalMesh::New(vertexBuffer, indexBuffer);
 			subMesh->SetMaterialIndex(iMesh->mMaterialIndex);
@@ -534,6 +542,12 @@ MeshRef LoadMesh(Stream& stream, const MeshParams& parameters)
 
 				vertexMapper.Unmap();
 
+				if (parameters.optimizeOverdraw)
+					indexBuffer->OptimizeOverdraw(vertexBuffer);
+
+				if (parameters.optimizeVertexBuffers)
+					indexBuffer->OptimizeVertexFetch(vertexBuffer);
+
 				// Submesh
 				StaticMeshRef subMesh = StaticMesh::New(vertexBuffer, indexBuffer);
 				subMesh->GenerateAABB();
@@ -0,0 +1,358 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/AsyncFileReader.hpp>
+#include <Nazara/Core/ConditionVariable.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Core/TaskGroup.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <vector>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		struct Request
+		{
+			std::unique_ptr<std::promise<AsyncFileReader::Result>> promise;
+			AsyncFileReader::Callback callback;
+			String filePath;
+			TaskGroup* callbackGroup;
+			UInt64 offset;
+			UInt64 size;
+		};
+
+		constexpr std::size_t MaxBatchSize = 32;
+
+		ConditionVariable s_idleCondition;
+		ConditionVariable s_requestCondition;
+		Mutex s_mutex;
+		TaskGroup s_callbackGroup;
+		std::deque<Request> s_requests;
+		std::size_t s_pendingRequestCount = 0;
+		std::vector<Thread> s_workers;
+		unsigned int s_threadCount = 0;
+		bool s_running = false;
+
+		void Complete(Request& request, AsyncFileReader::Result&& result)
+		{
+			if (request.promise)
+				request.promise->set_value(std::move(result));
+
+			if (request.callback)
+			{
+				TaskGroup* callbackGroup = (request.callbackGroup) ? request.callbackGroup : &s_callbackGroup;
+
+				std::shared_ptr<AsyncFileReader::Result> sharedResult = std::make_shared<AsyncFileReader::Result>(std::move(result));
+				AsyncFileReader::Callback callback = std::move(request.callback);
+				callbackGroup->AddTask([callback, sharedResult]()
+				{
+					callback(*sharedResult);
+				});
+			}
+		}
+
+		void Submit(Request&& request)
+		{
+			if (!AsyncFileReader::Initialize())
+			{
+				NazaraError("Failed to initialize asynchronous file reader");
+
+				// The request fails right away, instead of never completing
+				AsyncFileReader::Result result;
+				result.filePath = request.filePath;
+				result.offset = request.offset;
+
+				Complete(request, std::move(result));
+				return;
+			}
+
+			LockGuard lock(s_mutex);
+
+			s_requests.emplace_back(std::move(request));
+			s_pendingRequestCount++;
+
+			s_requestCondition.Signal();
+		}
+
+		void WorkerProc()
+		{
+			std::vector<Request> batch;
+
+			for (;;)
+			{
+				{
+					LockGuard lock(s_mutex);
+					while (s_running && s_requests.empty())
+						s_requestCondition.Wait(&s_mutex);
+
+					// Pending requests are still served when stopping
+					if (s_requests.empty())
+						return;
+
+					// Leave some requests to the other threads
+					std::size_t batchSize = std::min(MaxBatchSize, (s_requests.size() + s_workers.size() - 1) / s_workers.size());
+					for (std::size_t i = 0; i < batchSize; ++i)
+					{
+						batch.emplace_back(std::move(s_requests.front()));
+						s_requests.pop_front();
+					}
+
+					if (!s_requests.empty())
+						s_requestCondition.Signal();
+				}
+
+				std::stable_sort(batch.begin(), batch.end(), [](const Request& lhs, const Request& rhs)
+				{
+					int comparison = String::Compare(lhs.filePath, rhs.filePath);
+					return comparison < 0 || (comparison == 0 && lhs.offset < rhs.offset);
+				});
+
+				File file;
+				for (Request& request : batch)
+				{
+					AsyncFileReader::Result result;
+					result.filePath = request.filePath;
+					result.offset = request.offset;
+
+					if (!file.IsOpen() || file.GetPath() != request.filePath)
+						file.Open(request.filePath, OpenMode_ReadOnly);
+
+					if (file.IsOpen())
+					{
+						UInt64 fileSize = file.GetSize();
+						if (request.offset <= fileSize && file.SetCursorPos(request.offset))
+						{
+							UInt64 size = std::min(request.size, fileSize - request.offset);
+							result.data.Resize(static_cast<std::size_t>(size));
+							result.data.Resize(file.Read(result.data.GetBuffer(), result.data.GetSize()));
+
+							result.succeeded = true;
+						}
+					}
+
+					Complete(request, std::move(result));
+				}
+
+				LockGuard lock(s_mutex);
+
+				s_pendingRequestCount -= batch.size();
+				if (s_pendingRequestCount == 0)
+					s_idleCondition.SignalAll();
+
+				batch.clear();
+			}
+		}
+	}
+
+	/*!
+	* \ingroup core
+	* \class Nz::AsyncFileReader
+	* \brief Core class that reads files on a pool of I/O threads, without blocking the caller
+	*
+	* Results are delivered through a future, or through a callback running as a task of the TaskScheduler.
+	*
+	* Each I/O thread takes pending requests by batches, sorted by file and offset:
+	* requests on the same file share a single open handle and are read in order, which keeps disk accesses sequential.
+	*
+	* \remark The reader is initialized on first use
+	* \see ReadAheadFile
+	*/
+
+	/*!
+	* \brief Gets the number of I/O threads
+	* \return Number of I/O threads
+	*/
+
+	unsigned int AsyncFileReader::GetThreadCount()
+	{
+		return (s_threadCount > 0) ? s_threadCount : DefaultThreadCount;
+	}
+
+	/*!
+	* \brief Starts the I/O threads
+	* \return true if at least one I/O thread could be started
+	*/
+
+	bool AsyncFileReader::Initialize()
+	{
+		LockGuard lock(s_mutex);
+
+		if (s_running)
+			return true;
+
+		s_running = true;
+
+		unsigned int threadCount = GetThreadCount();
+		s_workers.reserve(threadCount);
+		try
+		{
+			ErrorFlags flags(ErrorFlag_ThrowException, true); //< Thread creation failures only trigger an error
+
+			for (unsigned int i = 0; i < threadCount; ++i)
+			{
+				s_workers.emplace_back(WorkerProc);
+				s_workers.back().SetName("NzIO #" + String::Number(i));
+			}
+		}
+		catch (const std::exception& e)
+		{
+			// The threads which could be started are enough to serve the requests
+			NazaraWarning("Only " + String::Number(s_workers.size()) + " I/O thread(s) out of " + String::Number(threadCount) + " could be started: " + e.what());
+		}
+
+		if (s_workers.empty())
+		{
+			s_running = false;
+			return false;
+		}
+
+		return true;
+	}
+
+	/*!
+	* \brief Checks whether the I/O threads are running
+	* \return true if it is the case
+	*/
+
+	bool AsyncFileReader::IsInitialized()
+	{
+		LockGuard lock(s_mutex);
+
+		return s_running;
+	}
+
+	/*!
+	* \brief Reads a part of a file
+	* \return Future result of the read, which fails if the file could not be opened or is smaller than offset
+	*
+	* \param filePath Path to the file
+	* \param offset Position of the first byte to read
+	* \param size Number of bytes to read, the result may hold less if the end of the file is reached
+	*/
+
+	std::future<AsyncFileReader::Result> AsyncFileReader::Read(const String& filePath, UInt64 offset, UInt64 size)
+	{
+		Request request;
+		request.callbackGroup = nullptr;
+		request.filePath = File::NormalizePath(filePath);
+		request.offset = offset;
+		request.promise = std::make_unique<std::promise<Result>>();
+		request.size = size;
+
+		std::future<Result> result = request.promise->get_future();
+		Submit(std::move(request));
+
+		return result;
+	}
+
+	/*!
+	* \brief Reads a whole file
+	*
+	* \param filePath Path to the file
+	* \param callback Function called with the result, as a task of the TaskScheduler
+	* \param callbackGroup Group of the task running the callback, the reader uses its own group if nullptr
+	*/
+
+	void AsyncFileReader::Read(const String& filePath, Callback callback, TaskGroup* callbackGroup)
+	{
+		Read(filePath, 0, WholeFile, std::move(callback), callbackGroup);
+	}
+
+	/*!
+	* \brief Reads a part of a file
+	*
+	* \param filePath Path to the file
+	* \param offset Position of the first byte to read
+	* \param size Number of bytes to read, the result may hold less if the end of the file is reached
+	* \param callback Function called with the result, as a task of the TaskScheduler
+	* \param callbackGroup Group of the task running the callback, the reader uses its own group if nullptr
+	*/
+
+	void AsyncFileReader::Read(const String& filePath, UInt64 offset, UInt64 size, Callback callback, TaskGroup* callbackGroup)
+	{
+		NazaraAssert(callback, "Invalid callback");
+
+		Request request;
+		request.callback = std::move(callback);
+		request.callbackGroup = callbackGroup;
+		request.filePath = File::NormalizePath(filePath);
+		request.offset = offset;
+		request.size = size;
+
+		Submit(std::move(request));
+	}
+
+	/*!
+	* \brief Sets the number of I/O threads
+	*
+	* \param threadCount Number of I/O threads, zero to use the default
+	*
+	* \remark Produce a NazaraError if the reader is initialized and NAZARA_CORE_SAFE is defined
+	*/
+
+	void AsyncFileReader::SetThreadCount(unsigned int threadCount)
+	{
+		#ifdef NAZARA_CORE_SAFE
+		if (IsInitialized())
+		{
+			NazaraError("Thread count cannot be set while initialized");
+			return;
+		}
+		#endif
+
+		s_threadCount = threadCount;
+	}
+
+	/*!
+	* \brief Stops the I/O threads, once every pending request is done
+	*/
+
+	void AsyncFileReader::Uninitialize()
+	{
+		{
+			LockGuard lock(s_mutex);
+			if (!s_running)
+				return;
+
+			s_running = false;
+			s_requestCondition.SignalAll();
+		}
+
+		for (Thread& worker : s_workers)
+			worker.Join();
+
+		s_workers.clear();
+
+		s_callbackGroup.Wait();
+	}
+
+	/*!
+	* \brief Waits for every pending request to be done, including the callbacks running in the group of the reader
+	*
+	* \remark Calling this from a callback will never return
+	*/
+
+	void AsyncFileReader::WaitForRequests()
+	{
+		{
+			LockGuard lock(s_mutex);
+			while (s_pendingRequestCount > 0)
+				s_idleCondition.Wait(&s_mutex);
+		}
+
+		s_callbackGroup.Wait();
+	}
+
+	constexpr unsigned int AsyncFileReader::DefaultThreadCount;
+	constexpr UInt64 AsyncFileReader::WholeFile;
+}
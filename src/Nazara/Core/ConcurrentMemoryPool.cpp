@@ -0,0 +1,250 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/ConcurrentMemoryPool.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <unordered_map>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		// Pools ids are never reused, so thread caches of destroyed pools can be recognized
+		std::atomic<UInt64> s_nextPoolId(1);
+
+		Mutex& GetRegistryMutex()
+		{
+			static Mutex registryMutex;
+			return registryMutex;
+		}
+
+		std::unordered_map<UInt64, ConcurrentMemoryPool*>& GetRegistry()
+		{
+			static std::unordered_map<UInt64, ConcurrentMemoryPool*> registry;
+			return registry;
+		}
+	}
+
+	struct ConcurrentMemoryPool::ThreadCache
+	{
+		UInt64 poolId;
+		std::size_t blockCount = 0;
+		void* blocks[2 * ThreadCacheSize];
+	};
+
+	struct ConcurrentMemoryPool::ThreadCacheList
+	{
+		~ThreadCacheList()
+		{
+			// Gives the cached blocks back to their pools when the thread exits
+			LockGuard lock(GetRegistryMutex());
+
+			auto& registry = GetRegistry();
+			for (const auto& cache : caches)
+			{
+				auto it = registry.find(cache->poolId);
+				if (it != registry.end())
+					it->second->ReturnBlocks(cache->blocks, cache->blockCount);
+			}
+		}
+
+		std::vector<std::unique_ptr<ThreadCache>> caches;
+		ThreadCache* lastCache = nullptr;
+	};
+
+	/*!
+	* \ingroup core
+	* \class Nz::ConcurrentMemoryPool
+	* \brief Core class that represents a thread-safe pool of fixed-size blocks
+	*
+	* Every thread keeps a cache of up to 2 * ThreadCacheSize free blocks, so allocations and releases usually don't synchronize at all.
+	* Blocks move between thread caches and the shared depot ThreadCacheSize at a time, under a lock.
+	* Blocks can be released by any thread, the cache of a thread is given back to the pool when the thread exits.
+	*
+	* \remark Blocks held by thread caches are counted as used by the statistics
+	* \see MemoryPool
+	*/
+
+	/*!
+	* \brief Constructs a ConcurrentMemoryPool object and allocates its first slab
+	*
+	* \param blockSize Size of the blocks, rounded up to the fundamental alignment
+	* \param slabSize Number of blocks allocated each time the pool grows
+	*/
+	ConcurrentMemoryPool::ConcurrentMemoryPool(std::size_t blockSize, std::size_t slabSize) :
+	m_highWaterMark(0),
+	m_slabSize(std::max<std::size_t>(slabSize, 1)),
+	m_id(s_nextPoolId++)
+	{
+		constexpr std::size_t alignment = alignof(std::max_align_t);
+		m_blockSize = std::max<std::size_t>((blockSize + alignment - 1) / alignment * alignment, alignment);
+
+		Grow();
+
+		LockGuard lock(GetRegistryMutex());
+		GetRegistry()[m_id] = this;
+	}
+
+	/*!
+	* \brief Destructs the object and releases every block, even if they are still used
+	*/
+	ConcurrentMemoryPool::~ConcurrentMemoryPool()
+	{
+		LockGuard lock(GetRegistryMutex());
+		GetRegistry().erase(m_id);
+	}
+
+	/*!
+	* \brief Allocates a block
+	* \return Pointer to a block of GetBlockSize() bytes
+	*/
+	void* ConcurrentMemoryPool::Allocate()
+	{
+		ThreadCache& cache = GetThreadCache();
+		if (cache.blockCount == 0)
+			TakeBlocks(cache);
+
+		return cache.blocks[--cache.blockCount];
+	}
+
+	/*!
+	* \brief Gives a block back to the pool
+	*
+	* \param ptr Block returned by Allocate, from any thread
+	*
+	* \remark If ptr is null, nothing is done
+	*/
+	void ConcurrentMemoryPool::Free(void* ptr)
+	{
+		if (!ptr)
+			return;
+
+		ThreadCache& cache = GetThreadCache();
+		if (cache.blockCount == 2 * ThreadCacheSize)
+		{
+			// Keeps the most recently released blocks, which are more likely to be in the CPU cache
+			ReturnBlocks(cache.blocks, ThreadCacheSize);
+
+			std::copy(cache.blocks + ThreadCacheSize, cache.blocks + 2 * ThreadCacheSize, cache.blocks);
+			cache.blockCount = ThreadCacheSize;
+		}
+
+		cache.blocks[cache.blockCount++] = ptr;
+	}
+
+	/*!
+	* \brief Gets the number of times the pool had to allocate a new slab after its creation
+	* \return Growth count
+	*/
+	std::size_t ConcurrentMemoryPool::GetGrowthCount() const
+	{
+		LockGuard lock(m_mutex);
+		return m_slabs.size() - 1;
+	}
+
+	/*!
+	* \brief Gets the maximum number of blocks which were used at the same time
+	* \return High-water mark in blocks
+	*/
+	std::size_t ConcurrentMemoryPool::GetHighWaterMark() const
+	{
+		LockGuard lock(m_mutex);
+		return m_highWaterMark;
+	}
+
+	/*!
+	* \brief Gets the number of blocks owned by the pool
+	* \return Block count
+	*/
+	std::size_t ConcurrentMemoryPool::GetSize() const
+	{
+		LockGuard lock(m_mutex);
+		return m_slabs.size() * m_slabSize;
+	}
+
+	/*!
+	* \brief Gets the number of blocks which are not in the shared depot
+	* \return Used block count
+	*/
+	std::size_t ConcurrentMemoryPool::GetUsedBlockCount() const
+	{
+		LockGuard lock(m_mutex);
+		return m_slabs.size() * m_slabSize - m_freeBlocks.size();
+	}
+
+	void ConcurrentMemoryPool::Grow()
+	{
+		std::unique_ptr<UInt8[]> slab(new UInt8[m_blockSize * m_slabSize]);
+
+		// Reversed so blocks are allocated in memory order
+		for (std::size_t i = m_slabSize; i > 0; --i)
+			m_freeBlocks.push_back(&slab[(i - 1) * m_blockSize]);
+
+		m_slabs.emplace_back(std::move(slab));
+	}
+
+	auto ConcurrentMemoryPool::GetThreadCache() -> ThreadCache&
+	{
+		thread_local ThreadCacheList threadCaches;
+
+		if (threadCaches.lastCache && threadCaches.lastCache->poolId == m_id)
+			return *threadCaches.lastCache;
+
+		for (const auto& cache : threadCaches.caches)
+		{
+			if (cache->poolId == m_id)
+			{
+				threadCaches.lastCache = cache.get();
+				return *cache;
+			}
+		}
+
+		// First use of this pool by the thread, take the opportunity to drop the caches of destroyed pools
+		{
+			LockGuard lock(GetRegistryMutex());
+
+			auto& registry = GetRegistry();
+			threadCaches.caches.erase(std::remove_if(threadCaches.caches.begin(), threadCaches.caches.end(), [&](const std::unique_ptr<ThreadCache>& cache)
+			{
+				return registry.find(cache->poolId) == registry.end();
+			}), threadCaches.caches.end());
+		}
+
+		std::unique_ptr<ThreadCache> cache(new ThreadCache);
+		cache->poolId = m_id;
+
+		threadCaches.lastCache = cache.get();
+		threadCaches.caches.emplace_back(std::move(cache));
+
+		return *threadCaches.lastCache;
+	}
+
+	void ConcurrentMemoryPool::ReturnBlocks(void* const* blocks, std::size_t blockCount)
+	{
+		LockGuard lock(m_mutex);
+		m_freeBlocks.insert(m_freeBlocks.end(), blocks, blocks + blockCount);
+	}
+
+	void ConcurrentMemoryPool::TakeBlocks(ThreadCache& cache)
+	{
+		LockGuard lock(m_mutex);
+
+		if (m_freeBlocks.empty())
+			Grow();
+
+		std::size_t blockCount = std::min(ThreadCacheSize, m_freeBlocks.size());
+		std::copy(m_freeBlocks.end() - blockCount, m_freeBlocks.end(), cache.blocks);
+		m_freeBlocks.resize(m_freeBlocks.size() - blockCount);
+
+		cache.blockCount = blockCount;
+
+		m_highWaterMark = std::max(m_highWaterMark, m_slabs.size() * m_slabSize - m_freeBlocks.size());
+	}
+
+	constexpr std::size_t ConcurrentMemoryPool::ThreadCacheSize;
+}
@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Core/Core.hpp>
+#include <Nazara/Core/AsyncFileReader.hpp>
 #include <Nazara/Core/Config.hpp>
 #include <Nazara/Core/HardwareInfo.hpp>
 #include <Nazara/Core/Log.hpp>
@@ -71,6 +72,7 @@ namespace Nz
 		// Free of module
 		s_moduleReferenceCounter = 0;
 
+		AsyncFileReader::Uninitialize();
 		HardwareInfo::Uninitialize();
 		Log::Uninitialize();
 		PluginManager::Uninitialize();
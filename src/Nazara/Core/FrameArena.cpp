@@ -0,0 +1,172 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/FrameArena.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::FrameArena
+	* \brief Core class that represents a linear allocator for transient (typically per-frame) memory
+	*
+	* Allocations only move a pointer forward, and all of them are released at once by Reset.
+	* When a frame needed more than one block, Reset merges them so the next frames fit in a single block, which makes steady-state frames free of system allocations.
+	* An arena also resets itself once every allocation has been given back, which lets code running in tasks share the arena of their thread (see GetThreadArena).
+	*
+	* \remark A FrameArena is not thread-safe
+	* \see FrameArenaAllocator
+	*/
+
+	/*!
+	* \brief Constructs a FrameArena object
+	*
+	* No memory is allocated until the first allocation
+	*
+	* \param blockSize Minimal size of the blocks allocated by the arena
+	*/
+	FrameArena::FrameArena(std::size_t blockSize) :
+	m_allocationCount(0),
+	m_blockSize(blockSize),
+	m_currentBlock(0),
+	m_offset(0)
+	{
+	}
+
+	/*!
+	* \brief Allocates memory from the arena
+	* \return Pointer to the allocated memory, valid until the next Reset
+	*
+	* \param size Size of the allocation in bytes
+	* \param alignment Alignment of the allocation, must be a power of two
+	*/
+	void* FrameArena::Allocate(std::size_t size, std::size_t alignment)
+	{
+		NazaraAssert(alignment > 0 && (alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+
+		for (;;)
+		{
+			for (; m_currentBlock < m_blocks.size(); ++m_currentBlock)
+			{
+				Block& block = m_blocks[m_currentBlock];
+
+				std::uintptr_t top = reinterpret_cast<std::uintptr_t>(block.memory.get()) + m_offset;
+				std::size_t padding = static_cast<std::size_t>(-top & (alignment - 1));
+				if (padding + size <= block.size - m_offset)
+				{
+					m_allocationCount++;
+					m_offset += padding + size;
+					return reinterpret_cast<void*>(top + padding);
+				}
+
+				// The end of this block is lost until the next reset
+				m_offset = 0;
+			}
+
+			Block block;
+			block.size = std::max(m_blockSize, size + alignment);
+			block.memory.reset(new UInt8[block.size]);
+
+			m_currentBlock = m_blocks.size();
+			m_offset = 0;
+			m_blocks.emplace_back(std::move(block));
+		}
+	}
+
+	/*!
+	* \brief Gives memory back to the arena
+	*
+	* Only the latest allocation can be reclaimed before the next reset, other calls only mark the allocation as given back.
+	* Once every allocation has been given back, the arena is reset.
+	*
+	* \param pointer Pointer returned by Allocate
+	* \param size Size which was passed to Allocate
+	*/
+	void FrameArena::Deallocate(void* pointer, std::size_t size)
+	{
+		NazaraAssert(m_allocationCount > 0, "Every allocation has already been given back");
+
+		if (--m_allocationCount == 0)
+		{
+			Reset();
+			return;
+		}
+
+		UInt8* blockMemory = m_blocks[m_currentBlock].memory.get();
+		UInt8* memory = static_cast<UInt8*>(pointer);
+		if (memory >= blockMemory && memory + size == blockMemory + m_offset)
+			m_offset = static_cast<std::size_t>(memory - blockMemory);
+	}
+
+	/*!
+	* \brief Gets the total size of the blocks owned by the arena
+	* \return Capacity in bytes
+	*/
+	std::size_t FrameArena::GetCapacity() const
+	{
+		std::size_t capacity = 0;
+		for (const Block& block : m_blocks)
+			capacity += block.size;
+
+		return capacity;
+	}
+
+	/*!
+	* \brief Gets the memory consumed since the last reset, including alignment padding and the unused end of full blocks
+	* \return Used size in bytes
+	*/
+	std::size_t FrameArena::GetUsedSize() const
+	{
+		std::size_t usedSize = 0;
+		for (std::size_t i = 0; i < m_currentBlock && i < m_blocks.size(); ++i)
+			usedSize += m_blocks[i].size;
+
+		return usedSize + m_offset;
+	}
+
+	/*!
+	* \brief Releases every allocation at once
+	*
+	* If more than one block was allocated, they are replaced by a single block big enough for all of them.
+	*
+	* \remark Every pointer allocated from the arena becomes dangling, containers using a FrameArenaAllocator must have been destroyed or emptied
+	*/
+	void FrameArena::Reset()
+	{
+		if (m_blocks.size() > 1)
+		{
+			Block block;
+			block.size = GetCapacity();
+			block.memory.reset(new UInt8[block.size]);
+
+			m_blocks.clear();
+			m_blocks.emplace_back(std::move(block));
+		}
+
+		m_allocationCount = 0;
+		m_currentBlock = 0;
+		m_offset = 0;
+	}
+
+	/*!
+	* \brief Gets the arena of the calling thread
+	* \return Arena owned by the calling thread
+	*
+	* This allows tasks to allocate transient memory without synchronization.
+	* As a task waiting for other tasks may run some of them on its thread, the memory must be given back before the task returns (which containers using a FrameArenaAllocator do when destroyed), the arena being reset once all of it has been given back.
+	*
+	* \remark The returned arena must only be used by the calling thread, and must never be explicitly reset
+	*/
+	FrameArena& FrameArena::GetThreadArena()
+	{
+		thread_local FrameArena threadArena;
+		return threadArena;
+	}
+
+	constexpr std::size_t FrameArena::DefaultBlockSize;
+}
@@ -0,0 +1,266 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/MappedFile.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/File.hpp>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#if defined(NAZARA_PLATFORM_WINDOWS)
+	#include <Nazara/Core/Win32/MappedFileImpl.hpp>
+#elif defined(NAZARA_PLATFORM_POSIX)
+	#include <Nazara/Core/Posix/MappedFileImpl.hpp>
+#else
+	#error OS not handled
+#endif
+
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::MappedFile
+	* \brief Core class that represents a read-only file mapped in memory
+	*
+	* Unlike File, reading does not involve a system call: the content is paged in by the OS on access,
+	* and GetMappedPointer gives direct access to it so parsers can work without copying the file.
+	*
+	* \see File
+	*/
+
+	/*!
+	* \brief Constructs a MappedFile object by default
+	*/
+
+	MappedFile::MappedFile() :
+	Stream(StreamOption_MemoryMapped, OpenMode_NotOpen),
+	m_impl(nullptr),
+	m_cursorPos(0)
+	{
+	}
+
+	/*!
+	* \brief Constructs a MappedFile object and maps a file
+	*
+	* \param filePath Path to the file
+	*/
+
+	MappedFile::MappedFile(const String& filePath) :
+	MappedFile()
+	{
+		Open(filePath);
+	}
+
+	/*!
+	* \brief Destructs the object and calls Close
+	*
+	* \see Close
+	*/
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	/*!
+	* \brief Unmaps the file
+	*
+	* \remark Pointers returned by GetMappedPointer become dangling
+	*/
+
+	void MappedFile::Close()
+	{
+		if (m_impl)
+		{
+			m_impl->Close();
+			delete m_impl;
+			m_impl = nullptr;
+
+			m_cursorPos = 0;
+			m_openMode = OpenMode_NotOpen;
+		}
+	}
+
+	/*!
+	* \brief Checks whether the cursor has reached the end of the file
+	* \return true if cursor is at the end of the file
+	*
+	* \remark Produces a NazaraAssert if file is not open
+	*/
+
+	bool MappedFile::EndOfStream() const
+	{
+		NazaraAssert(IsOpen(), "File is not open");
+
+		return m_cursorPos >= m_impl->GetSize();
+	}
+
+	/*!
+	* \brief Gets the position of the cursor in the file
+	* \return Position of the cursor
+	*
+	* \remark Produces a NazaraAssert if file is not open
+	*/
+
+	UInt64 MappedFile::GetCursorPos() const
+	{
+		NazaraAssert(IsOpen(), "File is not open");
+
+		return m_cursorPos;
+	}
+
+	/*!
+	* \brief Gets the directory of the file
+	* \return Directory of the file
+	*/
+
+	String MappedFile::GetDirectory() const
+	{
+		return File::GetDirectory(m_filePath);
+	}
+
+	/*!
+	* \brief Gets a pointer to the content of the file
+	* \return Pointer to the first byte of the file, or nullptr if the file is not open or empty
+	*
+	* \remark The pointer stays valid until the file is closed
+	*/
+
+	const void* MappedFile::GetMappedPointer() const
+	{
+		return (m_impl) ? m_impl->GetData() : nullptr;
+	}
+
+	/*!
+	* \brief Gets the path of the file
+	* \return Path of the file
+	*/
+
+	String MappedFile::GetPath() const
+	{
+		return m_filePath;
+	}
+
+	/*!
+	* \brief Gets the size of the file
+	* \return Size of the file, or zero if it is not open
+	*/
+
+	UInt64 MappedFile::GetSize() const
+	{
+		return (m_impl) ? m_impl->GetSize() : 0;
+	}
+
+	/*!
+	* \brief Checks whether the file is open
+	* \return true if open
+	*/
+
+	bool MappedFile::IsOpen() const
+	{
+		return m_impl != nullptr;
+	}
+
+	/*!
+	* \brief Maps a file in memory, for reading
+	* \return true if mapping is successful
+	*
+	* \param filePath Path to the file
+	*
+	* \remark Produces a silent NazaraError if the file could not be mapped
+	*/
+
+	bool MappedFile::Open(const String& filePath)
+	{
+		Close();
+
+		String path = File::NormalizePath(filePath);
+		if (path.IsEmpty())
+			return false;
+
+		std::unique_ptr<MappedFileImpl> impl(new MappedFileImpl);
+		if (!impl->Open(path))
+		{
+			ErrorFlags flags(ErrorFlag_Silent); // Silent by default
+			NazaraError("Failed to map \"" + path + "\": " + Error::GetLastSystemError());
+			return false;
+		}
+
+		m_filePath = std::move(path);
+		m_impl = impl.release();
+		m_openMode = OpenMode_ReadOnly;
+
+		return true;
+	}
+
+	/*!
+	* \brief Sets the position of the cursor
+	* \return true if cursor is successfully positioned
+	*
+	* \param offset Offset according to the beginning of the file
+	*
+	* \remark Produces a NazaraAssert if file is not open
+	*/
+
+	bool MappedFile::SetCursorPos(UInt64 offset)
+	{
+		NazaraAssert(IsOpen(), "File is not open");
+
+		m_cursorPos = std::min(offset, m_impl->GetSize());
+		return true;
+	}
+
+	/*!
+	* \brief Does nothing, a mapped file is read-only
+	*/
+
+	void MappedFile::FlushStream()
+	{
+	}
+
+	/*!
+	* \brief Reads blocks
+	* \return Number of blocks read
+	*
+	* \param buffer Preallocated buffer to contain information read, or nullptr to skip bytes
+	* \param size Size of the read and thus of the buffer
+	*
+	* \remark Produces a NazaraAssert if file is not open
+	*/
+
+	std::size_t MappedFile::ReadBlock(void* buffer, std::size_t size)
+	{
+		NazaraAssert(IsOpen(), "File is not open");
+
+		std::size_t readSize = static_cast<std::size_t>(std::min<UInt64>(size, m_impl->GetSize() - m_cursorPos));
+		if (buffer && readSize > 0)
+			std::memcpy(buffer, m_impl->GetData() + m_cursorPos, readSize);
+
+		m_cursorPos += readSize;
+		return readSize;
+	}
+
+	/*!
+	* \brief Always fails, a mapped file is read-only
+	* \return 0
+	*
+	* \param buffer Unused
+	* \param size Unused
+	*
+	* \remark Produces a NazaraError
+	*/
+
+	std::size_t MappedFile::WriteBlock(const void* buffer, std::size_t size)
+	{
+		NazaraUnused(buffer);
+		NazaraUnused(size);
+
+		NazaraError("Mapped files are read-only");
+		return 0;
+	}
+}
@@ -25,7 +25,7 @@ namespace Nz
 	*/
 
 	MemoryView::MemoryView(void* ptr, UInt64 size) :
-	Stream(StreamOption_None, OpenMode_ReadWrite),
+	Stream(StreamOption_MemoryMapped, OpenMode_ReadWrite),
 	m_ptr(static_cast<UInt8*>(ptr)), 
 	m_pos(0),
 	m_size(size)
@@ -42,7 +42,7 @@ namespace Nz
 	*/
 
 	MemoryView::MemoryView(const void* ptr, UInt64 size) :
-	Stream(StreamOption_None, OpenMode_ReadOnly),
+	Stream(StreamOption_MemoryMapped, OpenMode_ReadOnly),
 	m_ptr(static_cast<UInt8*>(const_cast<void*>(ptr))), //< Okay, right, const_cast is bad, but this pointer is still read-only
 	m_pos(0),
 	m_size(size)
@@ -69,6 +69,16 @@ namespace Nz
 		return m_pos;
 	}
 
+	/*!
+	* \brief Gets a pointer to the viewed memory
+	* \return Pointer to the beginning of the memory
+	*/
+
+	const void* MemoryView::GetMappedPointer() const
+	{
+		return m_ptr;
+	}
+
 	/*!
 	* \brief Gets the size of the raw memory
 	* \return Size of the memory
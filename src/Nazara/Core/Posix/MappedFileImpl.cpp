@@ -0,0 +1,89 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#ifndef _LARGEFILE64_SOURCE
+#define _LARGEFILE64_SOURCE
+#endif
+
+#include <Nazara/Core/Posix/MappedFileImpl.hpp>
+#include <Nazara/Core/String.hpp>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <limits>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	MappedFileImpl::MappedFileImpl() :
+	m_data(nullptr),
+	m_size(0)
+	{
+	}
+
+	void MappedFileImpl::Close()
+	{
+		if (m_data)
+		{
+			munmap(m_data, static_cast<std::size_t>(m_size));
+			m_data = nullptr;
+		}
+
+		m_size = 0;
+	}
+
+	const UInt8* MappedFileImpl::GetData() const
+	{
+		return m_data;
+	}
+
+	UInt64 MappedFileImpl::GetSize() const
+	{
+		return m_size;
+	}
+
+	bool MappedFileImpl::Open(const String& filePath)
+	{
+		int fileDescriptor = open64(filePath.GetConstBuffer(), O_RDONLY);
+		if (fileDescriptor == -1)
+			return false;
+
+		struct stat64 fileInfo;
+		if (fstat64(fileDescriptor, &fileInfo) == -1)
+		{
+			close(fileDescriptor);
+			return false;
+		}
+
+		if (!S_ISREG(fileInfo.st_mode) || static_cast<UInt64>(fileInfo.st_size) > std::numeric_limits<std::size_t>::max())
+		{
+			close(fileDescriptor);
+			errno = EINVAL;
+			return false;
+		}
+
+		m_size = static_cast<UInt64>(fileInfo.st_size);
+
+		// mmap refuses empty mappings, an empty file simply has no data
+		if (m_size > 0)
+		{
+			void* data = mmap(nullptr, static_cast<std::size_t>(m_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+			if (data == MAP_FAILED)
+			{
+				close(fileDescriptor);
+				m_size = 0;
+				return false;
+			}
+
+			m_data = static_cast<UInt8*>(data);
+		}
+
+		// The mapping keeps a reference to the file
+		close(fileDescriptor);
+
+		return true;
+	}
+}
@@ -0,0 +1,313 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/ReadAheadFile.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/File.hpp>
+#include <algorithm>
+#include <cstring>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::ReadAheadFile
+	* \brief Core class that represents a read-only file, whose next chunks are read in advance by the AsyncFileReader
+	*
+	* This is meant for sequential reads, such as streamed audio: while a chunk is consumed, the following ones are already being read,
+	* so reading rarely has to wait for the disk. Seeking outside of the current chunk restarts the read-ahead from the new position.
+	*
+	* \see AsyncFileReader
+	*/
+
+	/*!
+	* \brief Constructs a ReadAheadFile object by default
+	*
+	* \param chunkSize Size of the chunks read in advance
+	* \param chunkCount Number of chunks read in advance
+	*/
+
+	ReadAheadFile::ReadAheadFile(std::size_t chunkSize, unsigned int chunkCount) :
+	Stream(StreamOption_None, OpenMode_NotOpen),
+	m_chunkSize(chunkSize),
+	m_chunkOffset(0),
+	m_cursorPos(0),
+	m_fileSize(0),
+	m_nextChunkOffset(0),
+	m_chunkCount(chunkCount)
+	{
+		NazaraAssert(chunkSize > 0, "Chunk size must be over zero");
+		NazaraAssert(chunkCount > 0, "Chunk count must be over zero");
+	}
+
+	/*!
+	* \brief Constructs a ReadAheadFile object and opens a file
+	*
+	* \param filePath Path to the file
+	* \param chunkSize Size of the chunks read in advance
+	* \param chunkCount Number of chunks read in advance
+	*/
+
+	ReadAheadFile::ReadAheadFile(const String& filePath, std::size_t chunkSize, unsigned int chunkCount) :
+	ReadAheadFile(chunkSize, chunkCount)
+	{
+		Open(filePath);
+	}
+
+	/*!
+	* \brief Destructs the object and calls Close
+	*
+	* \see Close
+	*/
+
+	ReadAheadFile::~ReadAheadFile()
+	{
+		Close();
+	}
+
+	/*!
+	* \brief Closes the file
+	*
+	* Chunks being read are discarded once done
+	*/
+
+	void ReadAheadFile::Close()
+	{
+		m_chunk.Clear();
+		m_pendingChunks.clear();
+		m_filePath.Clear();
+
+		m_chunkOffset = 0;
+		m_cursorPos = 0;
+		m_fileSize = 0;
+		m_nextChunkOffset = 0;
+		m_openMode = OpenMode_NotOpen;
+	}
+
+	/*!
+	* \brief Checks whether the cursor has reached the end of the file
+	* \return true if cursor is at the end of the file
+	*
+	* \remark Produces a NazaraAssert if file is not open
+	*/
+
+	bool ReadAheadFile::EndOfStream() const
+	{
+		NazaraAssert(IsOpen(), "File is not open");
+
+		return m_cursorPos >= m_fileSize;
+	}
+
+	/*!
+	* \brief Gets the position of the cursor in the file
+	* \return Position of the cursor
+	*
+	* \remark Produces a NazaraAssert if file is not open
+	*/
+
+	UInt64 ReadAheadFile::GetCursorPos() const
+	{
+		NazaraAssert(IsOpen(), "File is not open");
+
+		return m_cursorPos;
+	}
+
+	/*!
+	* \brief Gets the directory of the file
+	* \return Directory of the file
+	*/
+
+	String ReadAheadFile::GetDirectory() const
+	{
+		return File::GetDirectory(m_filePath);
+	}
+
+	/*!
+	* \brief Gets the path of the file
+	* \return Path of the file
+	*/
+
+	String ReadAheadFile::GetPath() const
+	{
+		return m_filePath;
+	}
+
+	/*!
+	* \brief Gets the size of the file, as it was when opened
+	* \return Size of the file
+	*/
+
+	UInt64 ReadAheadFile::GetSize() const
+	{
+		return m_fileSize;
+	}
+
+	/*!
+	* \brief Checks whether the file is open
+	* \return true if open
+	*/
+
+	bool ReadAheadFile::IsOpen() const
+	{
+		return m_openMode != OpenMode_NotOpen;
+	}
+
+	/*!
+	* \brief Opens a file for reading and starts reading its first chunks
+	* \return true if the file exists
+	*
+	* \param filePath Path to the file
+	*
+	* \remark Produces a silent NazaraError if the file does not exist
+	*/
+
+	bool ReadAheadFile::Open(const String& filePath)
+	{
+		Close();
+
+		String path = File::NormalizePath(filePath);
+		if (!File::Exists(path))
+		{
+			ErrorFlags flags(ErrorFlag_Silent); // Silent by default
+			NazaraError("Failed to open \"" + path + "\": file does not exist");
+			return false;
+		}
+
+		m_filePath = std::move(path);
+		m_fileSize = File::GetSize(m_filePath);
+		m_openMode = OpenMode_ReadOnly;
+
+		RequestChunks();
+
+		return true;
+	}
+
+	/*!
+	* \brief Sets the position of the cursor
+	* \return true if cursor is successfully positioned
+	*
+	* \param offset Offset according to the beginning of the file
+	*
+	* \remark Produces a NazaraAssert if file is not open
+	*/
+
+	bool ReadAheadFile::SetCursorPos(UInt64 offset)
+	{
+		NazaraAssert(IsOpen(), "File is not open");
+
+		m_cursorPos = std::min(offset, m_fileSize);
+		return true;
+	}
+
+	bool ReadAheadFile::FetchChunk()
+	{
+		UInt64 chunkOffset = m_cursorPos - m_cursorPos % m_chunkSize;
+
+		// Drop the chunks which were skipped over
+		auto it = std::find_if(m_pendingChunks.begin(), m_pendingChunks.end(), [chunkOffset](const PendingChunk& chunk) { return chunk.offset == chunkOffset; });
+		m_pendingChunks.erase(m_pendingChunks.begin(), it);
+
+		if (m_pendingChunks.empty())
+		{
+			m_nextChunkOffset = chunkOffset;
+			RequestChunks();
+		}
+
+		AsyncFileReader::Result result = m_pendingChunks.front().result.get();
+		m_pendingChunks.erase(m_pendingChunks.begin());
+
+		RequestChunks();
+
+		if (!result.succeeded || result.data.IsEmpty())
+		{
+			NazaraError("Failed to read \"" + m_filePath + "\" at offset " + String::Number(chunkOffset));
+			return false;
+		}
+
+		m_chunk = std::move(result.data);
+		m_chunkOffset = chunkOffset;
+
+		return true;
+	}
+
+	/*!
+	* \brief Does nothing, the file is read-only
+	*/
+
+	void ReadAheadFile::FlushStream()
+	{
+	}
+
+	/*!
+	* \brief Reads blocks
+	* \return Number of blocks read
+	*
+	* \param buffer Preallocated buffer to contain information read, or nullptr to skip bytes
+	* \param size Size of the read and thus of the buffer
+	*
+	* \remark Produces a NazaraAssert if file is not open
+	*/
+
+	std::size_t ReadAheadFile::ReadBlock(void* buffer, std::size_t size)
+	{
+		NazaraAssert(IsOpen(), "File is not open");
+
+		std::size_t readSize = 0;
+		while (readSize < size && m_cursorPos < m_fileSize)
+		{
+			if (m_cursorPos < m_chunkOffset || m_cursorPos >= m_chunkOffset + m_chunk.GetSize())
+			{
+				if (!FetchChunk())
+					break;
+			}
+
+			std::size_t chunkPos = static_cast<std::size_t>(m_cursorPos - m_chunkOffset);
+			std::size_t copySize = std::min(size - readSize, m_chunk.GetSize() - chunkPos);
+			if (buffer)
+				std::memcpy(static_cast<UInt8*>(buffer) + readSize, m_chunk.GetConstBuffer() + chunkPos, copySize);
+
+			m_cursorPos += copySize;
+			readSize += copySize;
+		}
+
+		return readSize;
+	}
+
+	void ReadAheadFile::RequestChunks()
+	{
+		while (m_pendingChunks.size() < m_chunkCount && m_nextChunkOffset < m_fileSize)
+		{
+			PendingChunk chunk;
+			chunk.offset = m_nextChunkOffset;
+			chunk.result = AsyncFileReader::Read(m_filePath, m_nextChunkOffset, m_chunkSize);
+
+			m_pendingChunks.emplace_back(std::move(chunk));
+			m_nextChunkOffset += m_chunkSize;
+		}
+	}
+
+	/*!
+	* \brief Always fails, the file is read-only
+	* \return 0
+	*
+	* \param buffer Unused
+	* \param size Unused
+	*
+	* \remark Produces a NazaraError
+	*/
+
+	std::size_t ReadAheadFile::WriteBlock(const void* buffer, std::size_t size)
+	{
+		NazaraUnused(buffer);
+		NazaraUnused(size);
+
+		NazaraError("Read-ahead files are read-only");
+		return 0;
+	}
+
+	constexpr unsigned int ReadAheadFile::DefaultChunkCount;
+	constexpr std::size_t ReadAheadFile::DefaultChunkSize;
+}
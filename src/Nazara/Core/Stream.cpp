@@ -23,6 +23,22 @@ namespace Nz
 
 	Stream::~Stream() = default;
 
+	/*!
+	* \brief Gets a pointer to the whole content of the stream, if it lives in memory
+	* \return Pointer to the beginning of the stream (regardless of the cursor position), or nullptr if the stream is not memory mapped
+	*
+	* This allows readers to parse the stream without copying it.
+	*
+	* \remark The pointer is valid as long as the stream is
+	*
+	* \see IsMemoryMapped
+	*/
+
+	const void* Stream::GetMappedPointer() const
+	{
+		return nullptr;
+	}
+
 	/*!
 	* \brief Gets the directory of the stream
 	* \return Empty string (meant to be virtual)
@@ -26,7 +26,11 @@ namespace Nz
 	{
 		inline bool IsSpace(char32_t character)
 		{
-			return character == '\t' || Unicode::GetCategory(character) & Unicode::Category_Separator;
+			// Space is the only ASCII separator, this avoids a Unicode lookup for most characters
+			if (character < 0x80)
+				return character == ' ' || character == '\t';
+
+			return (Unicode::GetCategory(character) & Unicode::Category_Separator) != 0;
 		}
 
 		// This algorithm is inspired by the documentation of Qt
@@ -93,8 +97,10 @@ namespace Nz
 	*/
 
 	String::String() :
-	m_sharedString(GetEmptyString())
+	m_string(m_smallString),
+	m_size(0)
 	{
+		m_smallString[0] = '\0';
 	}
 
 	/*!
@@ -103,15 +109,15 @@ namespace Nz
 	* \param character Single character
 	*/
 
-	String::String(char character)
+	String::String(char character) :
+	String()
 	{
 		if (character != '\0')
 		{
-			m_sharedString = std::make_shared<SharedString>(1);
-			m_sharedString->string[0] = character;
+			m_size = 1;
+			m_string[0] = character;
+			m_string[1] = '\0';
 		}
-		else
-			m_sharedString = GetEmptyString();
 	}
 
 	/*!
@@ -121,17 +127,15 @@ namespace Nz
 	* \param character Single character
 	*/
 
-	String::String(std::size_t rep, char character)
+	String::String(std::size_t rep, char character) :
+	String()
 	{
 		if (rep > 0)
 		{
-			m_sharedString = std::make_shared<SharedString>(rep);
+			Allocate(rep);
 
-			if (character != '\0')
-				std::memset(m_sharedString->string.get(), character, rep);
+			std::memset(m_string, character, rep);
 		}
-		else
-			m_sharedString = GetEmptyString();
 	}
 
 	/*!
@@ -154,19 +158,18 @@ namespace Nz
 	* \param length Length of the string
 	*/
 
-	String::String(std::size_t rep, const char* string, std::size_t length)
+	String::String(std::size_t rep, const char* string, std::size_t length) :
+	String()
 	{
 		std::size_t totalSize = rep*length;
 
 		if (totalSize > 0)
 		{
-			m_sharedString = std::make_shared<SharedString>(totalSize);
+			Allocate(totalSize);
 
 			for (std::size_t i = 0; i < rep; ++i)
-				std::memcpy(&m_sharedString->string[i*length], string, length);
+				std::memcpy(&m_string[i*length], string, length);
 		}
-		else
-			m_sharedString = GetEmptyString();
 	}
 
 	/*!
@@ -199,15 +202,14 @@ namespace Nz
 	* \param length Length of the string
 	*/
 
-	String::String(const char* string, std::size_t length)
+	String::String(const char* string, std::size_t length) :
+	String()
 	{
 		if (length > 0)
 		{
-			m_sharedString = std::make_shared<SharedString>(length);
-			std::memcpy(m_sharedString->string.get(), string, length);
+			Allocate(length);
+			std::memcpy(m_string, string, length);
 		}
-		else
-			m_sharedString = GetEmptyString();
 	}
 
 	/*!
@@ -221,6 +223,17 @@ namespace Nz
 	{
 	}
 
+	/*!
+	* \brief Constructs a String object which is a copy of another
+	*
+	* \param string String to copy
+	*/
+
+	String::String(const String& string) :
+	String(string.m_string, string.m_size)
+	{
+	}
+
 	/*!
 	* \brief Appends the character to the string
 	* \return A reference to this
@@ -232,7 +245,7 @@ namespace Nz
 
 	String& String::Append(char character)
 	{
-		return Insert(m_sharedString->size, character);
+		return Insert(m_size, character);
 	}
 
 	/*!
@@ -246,7 +259,7 @@ namespace Nz
 
 	String& String::Append(const char* string)
 	{
-		return Insert(m_sharedString->size, string);
+		return Insert(m_size, string);
 	}
 
 	/*!
@@ -261,7 +274,7 @@ namespace Nz
 
 	String& String::Append(const char* string, std::size_t length)
 	{
-		return Insert(m_sharedString->size, string, length);
+		return Insert(m_size, string, length);
 	}
 
 	/*!
@@ -275,7 +288,7 @@ namespace Nz
 
 	String& String::Append(const String& string)
 	{
-		return Insert(m_sharedString->size, string);
+		return Insert(m_size, string);
 	}
 
 	/*!
@@ -288,8 +301,8 @@ namespace Nz
 	{
 		if (keepBuffer)
 		{
-			EnsureOwnership(true);
-			m_sharedString->size = 0;
+			m_size = 0;
+			m_string[0] = '\0';
 		}
 		else
 			ReleaseString();
@@ -354,17 +367,17 @@ namespace Nz
 
 	unsigned int String::Count(char character, std::intmax_t start, UInt32 flags) const
 	{
-		if (character == '\0' || m_sharedString->size == 0)
+		if (character == '\0' || m_size == 0)
 			return 0;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return 0;
 
-		char* str = &m_sharedString->string[pos];
+		char* str = &m_string[pos];
 		unsigned int count = 0;
 		if (flags & CaseInsensitive)
 		{
@@ -400,17 +413,17 @@ namespace Nz
 
 	unsigned int String::Count(const char* string, std::intmax_t start, UInt32 flags) const
 	{
-		if (!string || !string[0] || m_sharedString->size == 0)
+		if (!string || !string[0] || m_size == 0)
 			return 0;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return 0;
 
-		char* str = &m_sharedString->string[pos];
+		char* str = &m_string[pos];
 		unsigned int count = 0;
 		if (flags & CaseInsensitive)
 		{
@@ -520,17 +533,17 @@ namespace Nz
 
 	unsigned int String::CountAny(const char* string, std::intmax_t start, UInt32 flags) const
 	{
-		if (!string || !string[0] || m_sharedString->size == 0)
+		if (!string || !string[0] || m_size == 0)
 			return 0;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return 0;
 
-		char* str = &m_sharedString->string[pos];
+		char* str = &m_string[pos];
 		unsigned int count = 0;
 		if (flags & HandleUtf8)
 		{
@@ -632,13 +645,13 @@ namespace Nz
 
 	bool String::EndsWith(char character, UInt32 flags) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return 0;
 
 		if (flags & CaseInsensitive)
-			return Detail::ToLower(m_sharedString->string[m_sharedString->size-1]) == Detail::ToLower(character);
+			return Detail::ToLower(m_string[m_size-1]) == Detail::ToLower(character);
 		else
-			return m_sharedString->string[m_sharedString->size-1] == character; // character == '\0' will always be false
+			return m_string[m_size-1] == character; // character == '\0' will always be false
 	}
 
 	/*!
@@ -669,18 +682,18 @@ namespace Nz
 
 	bool String::EndsWith(const char* string, std::size_t length, UInt32 flags) const
 	{
-		if (!string || !string[0] || m_sharedString->size == 0 || length > m_sharedString->size)
+		if (!string || !string[0] || m_size == 0 || length > m_size)
 			return false;
 
 		if (flags & CaseInsensitive)
 		{
 			if (flags & HandleUtf8)
-				return Detail::Unicodecasecmp(&m_sharedString->string[m_sharedString->size - length], string) == 0;
+				return Detail::Unicodecasecmp(&m_string[m_size - length], string) == 0;
 			else
-				return Detail::Strcasecmp(&m_sharedString->string[m_sharedString->size - length], string) == 0;
+				return Detail::Strcasecmp(&m_string[m_size - length], string) == 0;
 		}
 		else
-			return std::strcmp(&m_sharedString->string[m_sharedString->size - length], string) == 0;
+			return std::strcmp(&m_string[m_size - length], string) == 0;
 	}
 
 	/*!
@@ -695,7 +708,7 @@ namespace Nz
 
 	bool String::EndsWith(const String& string, UInt32 flags) const
 	{
-		return EndsWith(string.GetConstBuffer(), string.m_sharedString->size, flags);
+		return EndsWith(string.GetConstBuffer(), string.m_size, flags);
 	}
 
 	/*!
@@ -709,24 +722,24 @@ namespace Nz
 
 	std::size_t String::Find(char character, std::intmax_t start, UInt32 flags) const
 	{
-		if (character == '\0' || m_sharedString->size == 0)
+		if (character == '\0' || m_size == 0)
 			return npos;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return npos;
 
 		if (flags & CaseInsensitive)
 		{
 			char ch = Detail::ToLower(character);
-			const char* str = m_sharedString->string.get();
+			const char* str = m_string;
 			do
 			{
 				if (Detail::ToLower(*str) == ch)
-					return str - m_sharedString->string.get();
+					return str - m_string;
 			}
 			while (*++str);
 
@@ -734,9 +747,9 @@ namespace Nz
 		}
 		else
 		{
-			char* ch = std::strchr(&m_sharedString->string[pos], character);
+			char* ch = std::strchr(&m_string[pos], character);
 			if (ch)
-				return ch - m_sharedString->string.get();
+				return ch - m_string;
 			else
 				return npos;
 		}
@@ -753,17 +766,17 @@ namespace Nz
 
 	std::size_t String::Find(const char* string, std::intmax_t start, UInt32 flags) const
 	{
-		if (!string || !string[0] || m_sharedString->size == 0)
+		if (!string || !string[0] || m_size == 0)
 			return npos;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return npos;
 
-		char* str = &m_sharedString->string[pos];
+		char* str = &m_string[pos];
 		if (flags & CaseInsensitive)
 		{
 			if (flags & HandleUtf8)
@@ -786,7 +799,7 @@ namespace Nz
 						for (;;)
 						{
 							if (*it2 == '\0')
-								return ptrPos - m_sharedString->string.get();
+								return ptrPos - m_string;
 
 							if (*it == '\0')
 								return npos;
@@ -815,7 +828,7 @@ namespace Nz
 						for (;;)
 						{
 							if (*ptr == '\0')
-								return ptrPos - m_sharedString->string.get();
+								return ptrPos - m_string;
 
 							if (*str == '\0')
 								return npos;
@@ -833,9 +846,9 @@ namespace Nz
 		}
 		else
 		{
-			char* ch = std::strstr(&m_sharedString->string[pos], string);
+			char* ch = std::strstr(&m_string[pos], string);
 			if (ch)
-				return ch - m_sharedString->string.get();
+				return ch - m_string;
 		}
 
 		return npos;
@@ -866,17 +879,17 @@ namespace Nz
 
 	std::size_t String::FindAny(const char* string, std::intmax_t start, UInt32 flags) const
 	{
-		if (m_sharedString->size == 0 || !string || !string[0])
+		if (m_size == 0 || !string || !string[0])
 			return npos;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return npos;
 
-		char* str = &m_sharedString->string[pos];
+		char* str = &m_string[pos];
 		if (flags & HandleUtf8)
 		{
 			while (utf8::internal::is_trail(*str))
@@ -893,7 +906,7 @@ namespace Nz
 					do
 					{
 						if (character == Unicode::GetLowercase(*it2))
-							return it.base() - m_sharedString->string.get();
+							return it.base() - m_string;
 					}
 					while (*++it2);
 				}
@@ -907,7 +920,7 @@ namespace Nz
 					do
 					{
 						if (*it == *it2)
-							return it.base() - m_sharedString->string.get();
+							return it.base() - m_string;
 					}
 					while (*++it2);
 				}
@@ -925,7 +938,7 @@ namespace Nz
 					do
 					{
 						if (character == Detail::ToLower(*c))
-							return str - m_sharedString->string.get();
+							return str - m_string;
 					}
 					while (*++c);
 				}
@@ -935,7 +948,7 @@ namespace Nz
 			{
 				str = std::strpbrk(str, string);
 				if (str)
-					return str - m_sharedString->string.get();
+					return str - m_string;
 			}
 		}
 
@@ -967,17 +980,17 @@ namespace Nz
 
 	std::size_t String::FindLast(char character, std::intmax_t start, UInt32 flags) const
 	{
-		if (character == '\0' || m_sharedString->size == 0)
+		if (character == '\0' || m_size == 0)
 			return npos;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return npos;
 
-		char* ptr = &m_sharedString->string[pos];
+		char* ptr = &m_string[pos];
 
 		if (flags & CaseInsensitive)
 		{
@@ -985,18 +998,18 @@ namespace Nz
 			do
 			{
 				if (Detail::ToLower(*ptr) == character)
-					return ptr - m_sharedString->string.get();
+					return ptr - m_string;
 			}
-			while (ptr-- != m_sharedString->string.get());
+			while (ptr-- != m_string);
 		}
 		else
 		{
 			do
 			{
 				if (*ptr == character)
-					return ptr - m_sharedString->string.get();
+					return ptr - m_string;
 			}
-			while (ptr-- != m_sharedString->string.get());
+			while (ptr-- != m_string);
 		}
 
 		return npos;
@@ -1013,18 +1026,18 @@ namespace Nz
 
 	std::size_t String::FindLast(const char* string, std::intmax_t start, UInt32 flags) const
 	{
-		if (!string || !string[0] || m_sharedString->size == 0)
+		if (!string || !string[0] || m_size == 0)
 			return npos;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return npos;
 
 		///Algo 1.FindLast#3 (Size of the pattern unknown)
-		const char* ptr = &m_sharedString->string[pos];
+		const char* ptr = &m_string[pos];
 		if (flags & CaseInsensitive)
 		{
 			if (flags & HandleUtf8)
@@ -1046,9 +1059,9 @@ namespace Nz
 						for (;;)
 						{
 							if (*it2 == '\0')
-								return it.base() - m_sharedString->string.get();
+								return it.base() - m_string;
 
-							if (tIt.base() > &m_sharedString->string[pos])
+							if (tIt.base() > &m_string[pos])
 								break;
 
 							if (Unicode::GetLowercase(*tIt) != Unicode::GetLowercase(*it2))
@@ -1059,7 +1072,7 @@ namespace Nz
 						}
 					}
 				}
-				while (it--.base() != m_sharedString->string.get());
+				while (it--.base() != m_string);
 			}
 			else
 			{
@@ -1073,9 +1086,9 @@ namespace Nz
 						for (;;)
 						{
 							if (*p == '\0')
-								return ptr - m_sharedString->string.get();
+								return ptr - m_string;
 
-							if (tPtr > &m_sharedString->string[pos])
+							if (tPtr > &m_string[pos])
 								break;
 
 							if (Detail::ToLower(*tPtr) != Detail::ToLower(*p))
@@ -1086,7 +1099,7 @@ namespace Nz
 						}
 					}
 				}
-				while (ptr-- != m_sharedString->string.get());
+				while (ptr-- != m_string);
 			}
 		}
 		else
@@ -1100,9 +1113,9 @@ namespace Nz
 					for (;;)
 					{
 						if (*p == '\0')
-							return ptr - m_sharedString->string.get();
+							return ptr - m_string;
 
-						if (tPtr > &m_sharedString->string[pos])
+						if (tPtr > &m_string[pos])
 							break;
 
 						if (*tPtr != *p)
@@ -1113,7 +1126,7 @@ namespace Nz
 					}
 				}
 			}
-			while (ptr-- != m_sharedString->string.get());
+			while (ptr-- != m_string);
 		}
 
 		return npos;
@@ -1130,18 +1143,18 @@ namespace Nz
 
 	std::size_t String::FindLast(const String& string, std::intmax_t start, UInt32 flags) const
 	{
-		if (string.m_sharedString->size == 0 || string.m_sharedString->size > m_sharedString->size)
+		if (string.m_size == 0 || string.m_size > m_size)
 			return npos;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size || string.m_sharedString->size > m_sharedString->size)
+		if (pos >= m_size || string.m_size > m_size)
 			return npos;
 
-		const char* ptr = &m_sharedString->string[pos];
-		const char* limit = &m_sharedString->string[string.m_sharedString->size-1];
+		const char* ptr = &m_string[pos];
+		const char* limit = &m_string[string.m_size-1];
 
 		if (flags & CaseInsensitive)
 		{
@@ -1165,9 +1178,9 @@ namespace Nz
 						for (;;)
 						{
 							if (*it2 == '\0')
-								return it.base() - m_sharedString->string.get();
+								return it.base() - m_string;
 
-							if (tIt.base() > &m_sharedString->string[pos])
+							if (tIt.base() > &m_string[pos])
 								break;
 
 							if (Unicode::GetLowercase(*tIt) != Unicode::GetLowercase(*it2))
@@ -1183,21 +1196,21 @@ namespace Nz
 			else
 			{
 				///Algo 1.FindLast#4 (Size of the pattern unknown)
-				char c = Detail::ToLower(string.m_sharedString->string[string.m_sharedString->size-1]);
+				char c = Detail::ToLower(string.m_string[string.m_size-1]);
 				for (;;)
 				{
 					if (Detail::ToLower(*ptr) == c)
 					{
-						const char* p = &string.m_sharedString->string[string.m_sharedString->size-1];
-						for (; p >= &string.m_sharedString->string[0]; --p, --ptr)
+						const char* p = &string.m_string[string.m_size-1];
+						for (; p >= &string.m_string[0]; --p, --ptr)
 						{
 							if (Detail::ToLower(*ptr) != Detail::ToLower(*p))
 								break;
 
-							if (p == &string.m_sharedString->string[0])
-								return ptr-m_sharedString->string.get();
+							if (p == &string.m_string[0])
+								return ptr-m_string;
 
-							if (ptr == m_sharedString->string.get())
+							if (ptr == m_string)
 								return npos;
 						}
 					}
@@ -1211,18 +1224,18 @@ namespace Nz
 			///Algo 1.FindLast#4 (Size of the pattern known)
 			for (;;)
 			{
-				if (*ptr == string.m_sharedString->string[string.m_sharedString->size-1])
+				if (*ptr == string.m_string[string.m_size-1])
 				{
-					const char* p = &string.m_sharedString->string[string.m_sharedString->size-1];
-					for (; p >= &string.m_sharedString->string[0]; --p, --ptr)
+					const char* p = &string.m_string[string.m_size-1];
+					for (; p >= &string.m_string[0]; --p, --ptr)
 					{
 						if (*ptr != *p)
 							break;
 
-						if (p == &string.m_sharedString->string[0])
-							return ptr-m_sharedString->string.get();
+						if (p == &string.m_string[0])
+							return ptr-m_string;
 
-						if (ptr == m_sharedString->string.get())
+						if (ptr == m_string)
 							return npos;
 					}
 				}
@@ -1245,17 +1258,17 @@ namespace Nz
 
 	std::size_t String::FindLastAny(const char* string, std::intmax_t start, UInt32 flags) const
 	{
-		if (!string || !string[0] || m_sharedString->size == 0)
+		if (!string || !string[0] || m_size == 0)
 			return npos;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return npos;
 
-		char* str = &m_sharedString->string[pos];
+		char* str = &m_string[pos];
 		if (flags & HandleUtf8)
 		{
 			while (utf8::internal::is_trail(*str))
@@ -1272,11 +1285,11 @@ namespace Nz
 					do
 					{
 						if (character == Unicode::GetLowercase(*it2))
-							return it.base() - m_sharedString->string.get();
+							return it.base() - m_string;
 					}
 					while (*++it2);
 				}
-				while (it--.base() != m_sharedString->string.get());
+				while (it--.base() != m_string);
 			}
 			else
 			{
@@ -1286,11 +1299,11 @@ namespace Nz
 					do
 					{
 						if (*it == *it2)
-							return it.base() - m_sharedString->string.get();
+							return it.base() - m_string;
 					}
 					while (*++it2);
 				}
-				while (it--.base() != m_sharedString->string.get());
+				while (it--.base() != m_string);
 			}
 		}
 		else
@@ -1304,11 +1317,11 @@ namespace Nz
 					do
 					{
 						if (character == Detail::ToLower(*c))
-							return str - m_sharedString->string.get();
+							return str - m_string;
 					}
 					while (*++c);
 				}
-				while (str-- != m_sharedString->string.get());
+				while (str-- != m_string);
 			}
 			else
 			{
@@ -1318,11 +1331,11 @@ namespace Nz
 					do
 					{
 						if (*str == *c)
-							return str - m_sharedString->string.get();
+							return str - m_string;
 					}
 					while (*++c);
 				}
-				while (str-- != m_sharedString->string.get());
+				while (str-- != m_string);
 			}
 		}
 
@@ -1354,18 +1367,18 @@ namespace Nz
 
 	std::size_t String::FindLastWord(const char* string, std::intmax_t start, UInt32 flags) const
 	{
-		if (!string || !string[0] || m_sharedString->size == 0)
+		if (!string || !string[0] || m_size == 0)
 			return npos;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return npos;
 
 		///Algo 2.FindLastWord#1 (Size of the pattern unknown)
-		const char* ptr = &m_sharedString->string[pos];
+		const char* ptr = &m_string[pos];
 
 		if (flags & HandleUtf8)
 		{
@@ -1382,7 +1395,7 @@ namespace Nz
 				{
 					if (Unicode::GetLowercase(*it) == c)
 					{
-						if (it.base() != m_sharedString->string.get())
+						if (it.base() != m_string)
 						{
 							--it;
 							if (!Detail::IsSpace(*it++))
@@ -1398,12 +1411,12 @@ namespace Nz
 							if (*p == '\0')
 							{
 								if (*tIt == '\0' || Detail::IsSpace(*tIt))
-									return it.base() - m_sharedString->string.get();
+									return it.base() - m_string;
 								else
 									break;
 							}
 
-							if (tIt.base() > &m_sharedString->string[pos])
+							if (tIt.base() > &m_string[pos])
 								break;
 
 							if (Unicode::GetLowercase(*tIt) != Unicode::GetLowercase(*p))
@@ -1414,7 +1427,7 @@ namespace Nz
 						}
 					}
 				}
-				while (it--.base() != m_sharedString->string.get());
+				while (it--.base() != m_string);
 			}
 			else
 			{
@@ -1424,7 +1437,7 @@ namespace Nz
 				{
 					if (*it == c)
 					{
-						if (it.base() != m_sharedString->string.get())
+						if (it.base() != m_string)
 						{
 							--it;
 							if (!Detail::IsSpace(*it++))
@@ -1440,12 +1453,12 @@ namespace Nz
 							if (*p == '\0')
 							{
 								if (*tIt == '\0' || Detail::IsSpace(*tIt))
-									return it.base() - m_sharedString->string.get();
+									return it.base() - m_string;
 								else
 									break;
 							}
 
-							if (tIt.base() > &m_sharedString->string[pos])
+							if (tIt.base() > &m_string[pos])
 								break;
 
 							if (*tIt != *p)
@@ -1456,7 +1469,7 @@ namespace Nz
 						}
 					}
 				}
-				while (it--.base() != m_sharedString->string.get());
+				while (it--.base() != m_string);
 			}
 		}
 		else
@@ -1468,7 +1481,7 @@ namespace Nz
 				{
 					if (Detail::ToLower(*ptr) == c)
 					{
-						if (ptr != m_sharedString->string.get())
+						if (ptr != m_string)
 						{
 							--ptr;
 							if (!Detail::IsSpace(*ptr++))
@@ -1482,12 +1495,12 @@ namespace Nz
 							if (*p == '\0')
 							{
 								if (*tPtr == '\0' || Detail::IsSpace(*tPtr))
-									return ptr-m_sharedString->string.get();
+									return ptr-m_string;
 								else
 									break;
 							}
 
-							if (tPtr > &m_sharedString->string[pos])
+							if (tPtr > &m_string[pos])
 								break;
 
 							if (Detail::ToLower(*tPtr) != Detail::ToLower(*p))
@@ -1498,7 +1511,7 @@ namespace Nz
 						}
 					}
 				}
-				while (ptr-- != m_sharedString->string.get());
+				while (ptr-- != m_string);
 			}
 			else
 			{
@@ -1506,7 +1519,7 @@ namespace Nz
 				{
 					if (*ptr == string[0])
 					{
-						if (ptr != m_sharedString->string.get())
+						if (ptr != m_string)
 						{
 							--ptr;
 							if (!Detail::IsSpace(*ptr++))
@@ -1520,12 +1533,12 @@ namespace Nz
 							if (*p == '\0')
 							{
 								if (*tPtr == '\0' || Detail::IsSpace(*tPtr))
-									return ptr-m_sharedString->string.get();
+									return ptr-m_string;
 								else
 									break;
 							}
 
-							if (tPtr > &m_sharedString->string[pos])
+							if (tPtr > &m_string[pos])
 								break;
 
 							if (*tPtr != *p)
@@ -1536,7 +1549,7 @@ namespace Nz
 						}
 					}
 				}
-				while (ptr-- != m_sharedString->string.get());
+				while (ptr-- != m_string);
 			}
 		}
 
@@ -1554,18 +1567,18 @@ namespace Nz
 
 	std::size_t String::FindLastWord(const String& string, std::intmax_t start, UInt32 flags) const
 	{
-		if (string.m_sharedString->size == 0 || string.m_sharedString->size > m_sharedString->size)
+		if (string.m_size == 0 || string.m_size > m_size)
 			return npos;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return npos;
 
-		const char* ptr = &m_sharedString->string[pos];
-		const char* limit = &m_sharedString->string[string.m_sharedString->size-1];
+		const char* ptr = &m_string[pos];
+		const char* limit = &m_string[string.m_size-1];
 
 		if (flags & HandleUtf8)
 		{
@@ -1582,7 +1595,7 @@ namespace Nz
 				{
 					if (Unicode::GetLowercase(*it) == c)
 					{
-						if (it.base() != m_sharedString->string.get())
+						if (it.base() != m_string)
 						{
 							--it;
 							if (!Detail::IsSpace(*it++))
@@ -1598,12 +1611,12 @@ namespace Nz
 							if (*p == '\0')
 							{
 								if (*tIt == '\0' || Detail::IsSpace(*tIt))
-									return it.base() - m_sharedString->string.get();
+									return it.base() - m_string;
 								else
 									break;
 							}
 
-							if (tIt.base() > &m_sharedString->string[pos])
+							if (tIt.base() > &m_string[pos])
 								break;
 
 							if (Unicode::GetLowercase(*tIt) != Unicode::GetLowercase(*p))
@@ -1614,7 +1627,7 @@ namespace Nz
 						}
 					}
 				}
-				while (it--.base() != m_sharedString->string.get());
+				while (it--.base() != m_string);
 			}
 			else
 			{
@@ -1624,7 +1637,7 @@ namespace Nz
 				{
 					if (*it == c)
 					{
-						if (it.base() != m_sharedString->string.get())
+						if (it.base() != m_string)
 						{
 							--it;
 							if (!Detail::IsSpace(*it++))
@@ -1640,12 +1653,12 @@ namespace Nz
 							if (*p == '\0')
 							{
 								if (*tIt == '\0' || Detail::IsSpace(*tIt))
-									return it.base() - m_sharedString->string.get();
+									return it.base() - m_string;
 								else
 									break;
 							}
 
-							if (tIt.base() > &m_sharedString->string[pos])
+							if (tIt.base() > &m_string[pos])
 								break;
 
 							if (*tIt != *p)
@@ -1656,7 +1669,7 @@ namespace Nz
 						}
 					}
 				}
-				while (it--.base() != m_sharedString->string.get());
+				while (it--.base() != m_string);
 			}
 		}
 		else
@@ -1664,7 +1677,7 @@ namespace Nz
 			///Algo 2.FindLastWord#2 (Size of the pattern known)
 			if (flags & CaseInsensitive)
 			{
-				char c = Detail::ToLower(string.m_sharedString->string[string.m_sharedString->size-1]);
+				char c = Detail::ToLower(string.m_string[string.m_size-1]);
 				do
 				{
 					if (Detail::ToLower(*ptr) == c)
@@ -1673,21 +1686,21 @@ namespace Nz
 						if (nextC != '\0' && (Detail::IsSpace(nextC)) == 0)
 							continue;
 
-						const char* p = &string.m_sharedString->string[string.m_sharedString->size-1];
-						for (; p >= &string.m_sharedString->string[0]; --p, --ptr)
+						const char* p = &string.m_string[string.m_size-1];
+						for (; p >= &string.m_string[0]; --p, --ptr)
 						{
 							if (Detail::ToLower(*ptr) != Detail::ToLower(*p))
 								break;
 
-							if (p == &string.m_sharedString->string[0])
+							if (p == &string.m_string[0])
 							{
-								if (ptr == m_sharedString->string.get() || Detail::IsSpace(*(ptr-1)))
-									return ptr-m_sharedString->string.get();
+								if (ptr == m_string || Detail::IsSpace(*(ptr-1)))
+									return ptr-m_string;
 								else
 									break;
 							}
 
-							if (ptr == m_sharedString->string.get())
+							if (ptr == m_string)
 								return npos;
 						}
 					}
@@ -1698,27 +1711,27 @@ namespace Nz
 			{
 				do
 				{
-					if (*ptr == string.m_sharedString->string[string.m_sharedString->size-1])
+					if (*ptr == string.m_string[string.m_size-1])
 					{
 						char nextC = *(ptr + 1);
 						if (nextC != '\0' && !Detail::IsSpace(nextC))
 							continue;
 
-						const char* p = &string.m_sharedString->string[string.m_sharedString->size-1];
-						for (; p >= &string.m_sharedString->string[0]; --p, --ptr)
+						const char* p = &string.m_string[string.m_size-1];
+						for (; p >= &string.m_string[0]; --p, --ptr)
 						{
 							if (*ptr != *p)
 								break;
 
-							if (p == &string.m_sharedString->string[0])
+							if (p == &string.m_string[0])
 							{
-								if (ptr == m_sharedString->string.get() || Detail::IsSpace(*(ptr - 1)))
-									return ptr-m_sharedString->string.get();
+								if (ptr == m_string || Detail::IsSpace(*(ptr - 1)))
+									return ptr-m_string;
 								else
 									break;
 							}
 
-							if (ptr == m_sharedString->string.get())
+							if (ptr == m_string)
 								return npos;
 						}
 					}
@@ -1741,18 +1754,18 @@ namespace Nz
 
 	std::size_t String::FindWord(const char* string, std::intmax_t start, UInt32 flags) const
 	{
-		if (!string || !string[0] || m_sharedString->size == 0)
+		if (!string || !string[0] || m_size == 0)
 			return npos;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return npos;
 
 		///Algo 3.FindWord#3 (Size of the pattern unknown)
-		const char* ptr = &m_sharedString->string[pos];
+		const char* ptr = &m_string[pos];
 		if (flags & HandleUtf8)
 		{
 			if (utf8::internal::is_trail(*ptr))
@@ -1769,7 +1782,7 @@ namespace Nz
 				{
 					if (*it == c)
 					{
-						if (it.base() != m_sharedString->string.get())
+						if (it.base() != m_string)
 						{
 							--it;
 							if (!Detail::IsSpace(*it++))
@@ -1785,7 +1798,7 @@ namespace Nz
 							if (*p == '\0')
 							{
 								if (*tIt == '\0' || Detail::IsSpace(*it++))
-									return it.base() - m_sharedString->string.get();
+									return it.base() - m_string;
 								else
 									break;
 							}
@@ -1809,7 +1822,7 @@ namespace Nz
 				{
 					if (*it == c)
 					{
-						if (it.base() != m_sharedString->string.get())
+						if (it.base() != m_string)
 						{
 							--it;
 							if (!Detail::IsSpace(*it++))
@@ -1825,7 +1838,7 @@ namespace Nz
 							if (*p == '\0')
 							{
 								if (*tIt == '\0' || Detail::IsSpace(*it++))
-									return it.base() - m_sharedString->string.get();
+									return it.base() - m_string;
 								else
 									break;
 							}
@@ -1850,7 +1863,7 @@ namespace Nz
 				{
 					if (Detail::ToLower(*ptr) == c)
 					{
-						if (ptr != m_sharedString->string.get() && !Detail::IsSpace(*(ptr - 1)))
+						if (ptr != m_string && !Detail::IsSpace(*(ptr - 1)))
 							continue;
 
 						const char* p = &string[1];
@@ -1860,7 +1873,7 @@ namespace Nz
 							if (*p == '\0')
 							{
 								if (*tPtr == '\0' || Detail::IsSpace(*tPtr))
-									return ptr - m_sharedString->string.get();
+									return ptr - m_string;
 								else
 									break;
 							}
@@ -1881,7 +1894,7 @@ namespace Nz
 				{
 					if (*ptr == string[0])
 					{
-						if (ptr != m_sharedString->string.get() && !Detail::IsSpace(*(ptr-1)))
+						if (ptr != m_string && !Detail::IsSpace(*(ptr-1)))
 							continue;
 
 						const char* p = &string[1];
@@ -1891,7 +1904,7 @@ namespace Nz
 							if (*p == '\0')
 							{
 								if (*tPtr == '\0' || Detail::IsSpace(*tPtr))
-									return ptr - m_sharedString->string.get();
+									return ptr - m_string;
 								else
 									break;
 							}
@@ -1922,17 +1935,17 @@ namespace Nz
 
 	std::size_t String::FindWord(const String& string, std::intmax_t start, UInt32 flags) const
 	{
-		if (string.m_sharedString->size == 0 || string.m_sharedString->size > m_sharedString->size)
+		if (string.m_size == 0 || string.m_size > m_size)
 			return npos;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return npos;
 
-		char* ptr = &m_sharedString->string[pos];
+		char* ptr = &m_string[pos];
 		if (flags & HandleUtf8)
 		{
 			///Algo 3.FindWord#3 (Iterator too slow for #2)
@@ -1950,7 +1963,7 @@ namespace Nz
 				{
 					if (*it == c)
 					{
-						if (it.base() != m_sharedString->string.get())
+						if (it.base() != m_string)
 						{
 							--it;
 							if (!Detail::IsSpace(*it++))
@@ -1966,7 +1979,7 @@ namespace Nz
 							if (*p == '\0')
 							{
 								if (*tIt == '\0' || Detail::IsSpace(*it++))
-									return it.base() - m_sharedString->string.get();
+									return it.base() - m_string;
 								else
 									break;
 							}
@@ -1990,7 +2003,7 @@ namespace Nz
 				{
 					if (*it == c)
 					{
-						if (it.base() != m_sharedString->string.get())
+						if (it.base() != m_string)
 						{
 							--it;
 							if (!Detail::IsSpace(*it++))
@@ -2006,7 +2019,7 @@ namespace Nz
 							if (*p == '\0')
 							{
 								if (*tIt == '\0' || Detail::IsSpace(*it++))
-									return it.base() - m_sharedString->string.get();
+									return it.base() - m_string;
 								else
 									break;
 							}
@@ -2027,22 +2040,22 @@ namespace Nz
 			///Algo 3.FindWord#2 (Size of the pattern known)
 			if (flags & CaseInsensitive)
 			{
-				char c = Detail::ToLower(string.m_sharedString->string[0]);
+				char c = Detail::ToLower(string.m_string[0]);
 				do
 				{
 					if (Detail::ToLower(*ptr) == c)
 					{
-						if (ptr != m_sharedString->string.get() && !Detail::IsSpace(*(ptr-1)))
+						if (ptr != m_string && !Detail::IsSpace(*(ptr-1)))
 							continue;
 
-						const char* p = &string.m_sharedString->string[1];
+						const char* p = &string.m_string[1];
 						const char* tPtr = ptr+1;
 						for (;;)
 						{
 							if (*p == '\0')
 							{
 								if (*tPtr == '\0' || Detail::IsSpace(*tPtr))
-									return ptr - m_sharedString->string.get();
+									return ptr - m_string;
 								else
 									break;
 							}
@@ -2062,8 +2075,8 @@ namespace Nz
 				while ((ptr = std::strstr(ptr, string.GetConstBuffer())) != nullptr)
 				{
 					// If the word is really alone
-					if ((ptr == m_sharedString->string.get() || Detail::IsSpace(*(ptr-1))) && (*(ptr+m_sharedString->size) == '\0' || Detail::IsSpace(*(ptr+m_sharedString->size))))
-						return ptr - m_sharedString->string.get();
+					if ((ptr == m_string || Detail::IsSpace(*(ptr-1))) && (*(ptr+m_size) == '\0' || Detail::IsSpace(*(ptr+m_size))))
+						return ptr - m_string;
 
 					ptr++;
 				}
@@ -2080,9 +2093,7 @@ namespace Nz
 
 	char* String::GetBuffer()
 	{
-		EnsureOwnership();
-
-		return m_sharedString->string.get();
+		return m_string;
 	}
 
 	/*!
@@ -2092,7 +2103,7 @@ namespace Nz
 
 	std::size_t String::GetCapacity() const
 	{
-		return m_sharedString->capacity;
+		return (IsSmall()) ? SmallStringCapacity : m_capacity;
 	}
 
 	/*!
@@ -2107,14 +2118,14 @@ namespace Nz
 	*/
 	std::size_t String::GetCharacterPosition(std::size_t characterIndex) const
 	{
-		const char* ptr = m_sharedString->string.get();
-		const char* end = &m_sharedString->string[m_sharedString->size];
+		const char* ptr = m_string;
+		const char* end = &m_string[m_size];
 
 		try
 		{
 			utf8::advance(ptr, characterIndex, end);
 
-			return ptr - m_sharedString->string.get();
+			return ptr - m_string;
 		}
 		catch (utf8::not_enough_room& /*e*/)
 		{
@@ -2139,7 +2150,7 @@ namespace Nz
 
 	const char* String::GetConstBuffer() const
 	{
-		return m_sharedString->string.get();
+		return m_string;
 	}
 
 	/*!
@@ -2149,7 +2160,7 @@ namespace Nz
 
 	std::size_t String::GetLength() const
 	{
-		return utf8::distance(m_sharedString->string.get(), &m_sharedString->string[m_sharedString->size]);
+		return utf8::distance(m_string, &m_string[m_size]);
 	}
 
 	/*!
@@ -2159,7 +2170,7 @@ namespace Nz
 
 	std::size_t String::GetSize() const
 	{
-		return m_sharedString->size;
+		return m_size;
 	}
 
 	/*!
@@ -2169,7 +2180,7 @@ namespace Nz
 
 	std::string String::GetUtf8String() const
 	{
-		return std::string(m_sharedString->string.get(), m_sharedString->size);
+		return std::string(m_string, m_size);
 	}
 
 	/*!
@@ -2179,11 +2190,11 @@ namespace Nz
 
 	std::u16string String::GetUtf16String() const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return std::u16string();
 
 		std::u16string str;
-		str.reserve(m_sharedString->size);
+		str.reserve(m_size);
 
 		utf8::utf8to16(begin(), end(), std::back_inserter(str));
 
@@ -2197,11 +2208,11 @@ namespace Nz
 
 	std::u32string String::GetUtf32String() const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return std::u32string();
 
 		std::u32string str;
-		str.reserve(m_sharedString->size);
+		str.reserve(m_size);
 
 		utf8::utf8to32(begin(), end(), std::back_inserter(str));
 
@@ -2216,17 +2227,17 @@ namespace Nz
 	std::wstring String::GetWideString() const
 	{
 		static_assert(sizeof(wchar_t) == 2 || sizeof(wchar_t) == 4, "wchar_t size is not supported");
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return std::wstring();
 
 		std::wstring str;
-		str.reserve(m_sharedString->size);
+		str.reserve(m_size);
 
 		if (sizeof(wchar_t) == 4) // I want a static_if :(
 			utf8::utf8to32(begin(), end(), std::back_inserter(str));
 		else
 		{
-			utf8::unchecked::iterator<const char*> it(m_sharedString->string.get());
+			utf8::unchecked::iterator<const char*> it(m_string);
 			do
 			{
 				char32_t cp = *it;
@@ -2256,7 +2267,7 @@ namespace Nz
 			return String();
 
 		std::intmax_t endPos = -1;
-		const char* ptr = &m_sharedString->string[startPos];
+		const char* ptr = &m_string[startPos];
 		if (flags & HandleUtf8)
 		{
 			utf8::unchecked::iterator<const char*> it(ptr);
@@ -2264,7 +2275,7 @@ namespace Nz
 			{
 				if (Detail::IsSpace(*it))
 				{
-					endPos = static_cast<std::intmax_t>(it.base() - m_sharedString->string.get() - 1);
+					endPos = static_cast<std::intmax_t>(it.base() - m_string - 1);
 					break;
 				}
 			}
@@ -2276,7 +2287,7 @@ namespace Nz
 			{
 				if (Detail::IsSpace(*ptr))
 				{
-					endPos = static_cast<std::intmax_t>(ptr - m_sharedString->string.get() - 1);
+					endPos = static_cast<std::intmax_t>(ptr - m_string - 1);
 					break;
 				}
 			}
@@ -2296,13 +2307,13 @@ namespace Nz
 
 	std::size_t String::GetWordPosition(unsigned int index, UInt32 flags) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return npos;
 
 		unsigned int currentWord = 0;
 		bool inWord = false;
 
-		const char* ptr = m_sharedString->string.get();
+		const char* ptr = m_string;
 		if (flags & HandleUtf8)
 		{
 			utf8::unchecked::iterator<const char*> it(ptr);
@@ -2316,7 +2327,7 @@ namespace Nz
 					{
 						inWord = true;
 						if (++currentWord > index)
-							return it.base() - m_sharedString->string.get();
+							return it.base() - m_string;
 					}
 				}
 			}
@@ -2334,7 +2345,7 @@ namespace Nz
 					{
 						inWord = true;
 						if (++currentWord > index)
-							return ptr - m_sharedString->string.get();
+							return ptr - m_string;
 					}
 				}
 			}
@@ -2385,40 +2396,40 @@ namespace Nz
 			return *this;
 
 		if (pos < 0)
-			pos = std::max<std::size_t>(m_sharedString->size + pos, 0);
+			pos = std::max<std::size_t>(m_size + pos, 0);
 
-		std::size_t start = std::min<std::size_t>(pos, m_sharedString->size);
+		std::size_t start = std::min<std::size_t>(pos, m_size);
 
 		// If buffer is already big enough
-		if (m_sharedString->capacity >= m_sharedString->size + length)
+		if (GetCapacity() >= m_size + length)
 		{
-			EnsureOwnership();
-
-			std::memmove(&m_sharedString->string[start+length], &m_sharedString->string[start], m_sharedString->size - start);
-			std::memcpy(&m_sharedString->string[start], string, length);
+			std::memmove(&m_string[start+length], &m_string[start], m_size - start);
+			std::memcpy(&m_string[start], string, length);
 
-			m_sharedString->size += length;
-			m_sharedString->string[m_sharedString->size] = '\0';
+			m_size += length;
+			m_string[m_size] = '\0';
 		}
 		else
 		{
-			auto newString = std::make_shared<SharedString>(m_sharedString->size + length);
+			// Grow geometrically, so appending repeatedly stays linear
+			String newString;
+			newString.Allocate(m_size + length, Detail::GetNewSize(m_size + length));
 
-			char* ptr = newString->string.get();
+			char* ptr = newString.m_string;
 
 			if (start > 0)
 			{
-				std::memcpy(ptr, m_sharedString->string.get(), start*sizeof(char));
+				std::memcpy(ptr, m_string, start*sizeof(char));
 				ptr += start;
 			}
 
 			std::memcpy(ptr, string, length*sizeof(char));
 			ptr += length;
 
-			if (m_sharedString->size > start)
-				std::memcpy(ptr, &m_sharedString->string[start], m_sharedString->size - start);
+			if (m_size > start)
+				std::memcpy(ptr, &m_string[start], m_size - start);
 
-			m_sharedString = std::move(newString);
+			Swap(newString);
 		}
 
 		return *this;
@@ -2434,7 +2445,7 @@ namespace Nz
 
 	String& String::Insert(std::intmax_t pos, const String& string)
 	{
-		return Insert(pos, string.GetConstBuffer(), string.m_sharedString->size);
+		return Insert(pos, string.GetConstBuffer(), string.m_size);
 	}
 
 	/*!
@@ -2444,7 +2455,7 @@ namespace Nz
 
 	bool String::IsEmpty() const
 	{
-		return m_sharedString->size == 0;
+		return m_size == 0;
 	}
 
 	/*!
@@ -2454,7 +2465,7 @@ namespace Nz
 
 	bool String::IsNull() const
 	{
-		return m_sharedString.get() == GetEmptyString().get();
+		return m_size == 0 && IsSmall();
 	}
 
 	/*!
@@ -2477,14 +2488,14 @@ namespace Nz
 		}
 		#endif
 
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return false;
 
 		String check = Simplified();
-		if (check.m_sharedString->size == 0)
+		if (check.m_size == 0)
 			return false;
 
-		char* ptr = (check.m_sharedString->string[0] == '-') ? &check.m_sharedString->string[1] : check.m_sharedString->string.get();
+		char* ptr = (check.m_string[0] == '-') ? &check.m_string[1] : check.m_string;
 
 		if (base > 10)
 		{
@@ -2538,12 +2549,12 @@ namespace Nz
 
 	bool String::Match(const char* pattern) const
 	{
-		if (m_sharedString->size == 0 || !pattern)
+		if (m_size == 0 || !pattern)
 			return false;
 
 		// Par Jack Handy - akkhandy@hotmail.com
 		// From : http://www.codeproject.com/Articles/1088/Wildcard-string-compare-globbing
-		const char* str = m_sharedString->string.get();
+		const char* str = m_string;
 		while (*str && *pattern != '*')
 		{
 			if (*pattern != *str && *pattern != '?')
@@ -2592,7 +2603,7 @@ namespace Nz
 
 	bool String::Match(const String& pattern) const
 	{
-		return Match(pattern.m_sharedString->string.get());
+		return Match(pattern.m_string);
 	}
 
 	/*!
@@ -2671,15 +2682,14 @@ namespace Nz
 			return Replace(String(oldCharacter), String(), start);
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return npos;
 
 		unsigned int count = 0;
-		char* ptr = &m_sharedString->string[pos];
-		bool found = false;
+		char* ptr = &m_string[pos];
 		if (flags & CaseInsensitive)
 		{
 			char character_lower = Detail::ToLower(oldCharacter);
@@ -2688,16 +2698,6 @@ namespace Nz
 			{
 				if (*ptr == character_lower || *ptr == character_upper)
 				{
-					if (!found)
-					{
-						std::ptrdiff_t offset = ptr - m_sharedString->string.get();
-
-						EnsureOwnership();
-
-						ptr = &m_sharedString->string[offset];
-						found = true;
-					}
-
 					*ptr = newCharacter;
 					++count;
 				}
@@ -2708,16 +2708,6 @@ namespace Nz
 		{
 			while ((ptr = std::strchr(ptr, oldCharacter)) != nullptr)
 			{
-				if (!found)
-				{
-					std::ptrdiff_t offset = ptr-m_sharedString->string.get();
-
-					EnsureOwnership();
-
-					ptr = &m_sharedString->string[offset];
-					found = true;
-				}
-
 				*ptr = newCharacter;
 				++count;
 			}
@@ -2759,27 +2749,19 @@ namespace Nz
 			return 0;
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return 0;
 
 		unsigned int count = 0;
 		if (oldLength == replaceLength)
 		{
-			bool found = false;
-
 			// If no size change is necessary, we can thus use a quicker algorithm
 			while ((pos = Find(oldString, pos, flags)) != npos)
 			{
-				if (!found)
-				{
-					EnsureOwnership();
-					found = true;
-				}
-
-				std::memcpy(&m_sharedString->string[pos], replaceString, oldLength);
+				std::memcpy(&m_string[pos], replaceString, oldLength);
 				pos += oldLength;
 
 				++count;
@@ -2787,19 +2769,20 @@ namespace Nz
 		}
 		else ///TODO: Replacement algorithm without changing the buffer (if replaceLength < oldLength)
 		{
-			std::size_t newSize = m_sharedString->size + Count(oldString)*(replaceLength - oldLength);
-			if (newSize == m_sharedString->size) // Then it's the fact that Count(oldString) == 0
+			std::size_t newSize = m_size + Count(oldString)*(replaceLength - oldLength);
+			if (newSize == m_size) // Then it's the fact that Count(oldString) == 0
 				return 0;
 
-			auto newString = std::make_shared<SharedString>(newSize);
+			String newString;
+			newString.Allocate(newSize);
 
 			///Algo 4.Replace#2
-			char* ptr = newString->string.get();
-			const char* p = m_sharedString->string.get();
+			char* ptr = newString.m_string;
+			const char* p = m_string;
 
 			while ((pos = Find(oldString, pos, flags)) != npos)
 			{
-				const char* r = &m_sharedString->string[pos];
+				const char* r = &m_string[pos];
 
 				std::memcpy(ptr, p, r-p);
 				ptr += r-p;
@@ -2813,7 +2796,7 @@ namespace Nz
 
 			std::strcpy(ptr, p);
 
-			m_sharedString = std::move(newString);
+			Swap(newString);
 		}
 
 		return count;
@@ -2831,7 +2814,7 @@ namespace Nz
 
 	unsigned int String::Replace(const String& oldString, const String& replaceString, std::intmax_t start, UInt32 flags)
 	{
-		return Replace(oldString.GetConstBuffer(), oldString.m_sharedString->size, replaceString.GetConstBuffer(), replaceString.m_sharedString->size, start, flags);
+		return Replace(oldString.GetConstBuffer(), oldString.m_size, replaceString.GetConstBuffer(), replaceString.m_size, start, flags);
 	}
 
 	/*!
@@ -2856,35 +2839,24 @@ namespace Nz
 			return ReplaceAny(String(oldCharacters), String(), start);*/
 
 		if (start < 0)
-			start = std::max<std::size_t>(m_sharedString->size + start, 0);
+			start = std::max<std::size_t>(m_size + start, 0);
 
 		std::size_t pos = static_cast<std::size_t>(start);
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			return npos;
 
 		unsigned int count = 0;
-		char* ptr = &m_sharedString->string[pos];
+		char* ptr = &m_string[pos];
 		if (flags & CaseInsensitive)
 		{
 			do
 			{
 				const char* c = oldCharacters;
 				char character = Detail::ToLower(*ptr);
-				bool found = false;
 				do
 				{
 					if (character == Detail::ToLower(*c))
 					{
-						if (!found)
-						{
-							std::ptrdiff_t offset = ptr - m_sharedString->string.get();
-
-							EnsureOwnership();
-
-							ptr = &m_sharedString->string[offset];
-							found = true;
-						}
-
 						*ptr = replaceCharacter;
 						++count;
 						break;
@@ -2896,19 +2868,8 @@ namespace Nz
 		}
 		else
 		{
-			bool found = false;
 			while ((ptr = std::strpbrk(ptr, oldCharacters)) != nullptr)
 			{
-				if (!found)
-				{
-					std::ptrdiff_t offset = ptr - m_sharedString->string.get();
-
-					EnsureOwnership();
-
-					ptr = &m_sharedString->string[offset];
-					found = true;
-				}
-
 				*ptr++ = replaceCharacter;
 				++count;
 			}
@@ -2921,7 +2882,7 @@ namespace Nz
 		{
 			if (start < 0)
 			{
-				start = m_sharedString->size+start;
+				start = m_size+start;
 				if (start < 0)
 					start = 0;
 			}
@@ -2930,7 +2891,7 @@ namespace Nz
 			unsigned int oSize = (oldCharacters) ? std::strlen(oldCharacters) : 0;
 			unsigned int rSize = (replaceString) ? std::strlen(replaceString) : 0;
 
-			if (pos >= m_sharedString->size || m_sharedString->size == 0 || oSize == 0)
+			if (pos >= m_size || m_size == 0 || oSize == 0)
 				return 0;
 
 			unsigned int count = 0;
@@ -2939,13 +2900,13 @@ namespace Nz
 			{
 				EnsureOwnership();
 
-				f or (; pos < m_sharedString->size; ++pos)
+				f or (; pos < m_size; ++pos)
 				{
 					for (unsigned int i = 0; i < oSize; ++i)
 					{
-						if (m_sharedString->string[pos] == oldCharacters[i])
+						if (m_string[pos] == oldCharacters[i])
 						{
-							m_sharedString->string[pos] = replaceString[0];
+							m_string[pos] = replaceString[0];
 							++count;
 
 							break;
@@ -2958,21 +2919,21 @@ namespace Nz
 				unsigned int newSize;
 				{
 					unsigned int count = CountAny(oldCharacters);
-					newSize = m_sharedString->size - count + count*rSize;
+					newSize = m_size - count + count*rSize;
 				}
 				char* newString = new char[newSize+1];
 
 				unsigned int j = 0;
-				for (unsigned int i = 0; i < m_sharedString->size; ++i)
+				for (unsigned int i = 0; i < m_size; ++i)
 				{
 					if (i < pos) // Avant la position où on est censé commencer à remplacer, on ne fait que recopier
-						newString[j++] = m_sharedString->string[i];
+						newString[j++] = m_string[i];
 					else
 					{
 						bool found = false;
 						for (unsigned int l = 0; l < oSize; ++l)
 						{
-							if (m_sharedString->string[i] == oldCharacters[l])
+							if (m_string[i] == oldCharacters[l])
 							{
 								for (unsigned int k = 0; k < rSize; ++k)
 									newString[j++] = replaceString[k];
@@ -2984,14 +2945,14 @@ namespace Nz
 						}
 
 						if (!found)
-							newString[j++] = m_sharedString->string[i];
+							newString[j++] = m_string[i];
 					}
 				}
 				newString[newSize] = '\0';
 
 				ReleaseString();
 
-				m_sharedString->size = newSize;
+				m_size = newSize;
 				m_sharedString->string = newString;
 			}
 
@@ -3002,30 +2963,30 @@ namespace Nz
 		{
 			if (start < 0)
 			{
-				start = m_sharedString->size+start;
+				start = m_size+start;
 				if (start < 0)
 					start = 0;
 			}
 
 			unsigned int pos = static_cast<unsigned int>(start);
 
-			if (pos >= m_sharedString->size || m_sharedString->size == 0 || oldCharacters.m_sharedString->size == 0)
+			if (pos >= m_size || m_size == 0 || oldCharacters.m_size == 0)
 				return 0;
 
 			unsigned int count = 0;
 
-			if (replaceString.m_sharedString->size == 1) // On utilise un algorithme optimisé
+			if (replaceString.m_size == 1) // On utilise un algorithme optimisé
 			{
 				EnsureOwnership();
 
 				char character = replaceString[0];
-				for (; pos < m_sharedString->size; ++pos)
+				for (; pos < m_size; ++pos)
 				{
-					for (unsigned int i = 0; i < oldCharacters.m_sharedString->size; ++i)
+					for (unsigned int i = 0; i < oldCharacters.m_size; ++i)
 					{
-						if (m_sharedString->string[pos] == oldCharacters[i])
+						if (m_string[pos] == oldCharacters[i])
 						{
-							m_sharedString->string[pos] = character;
+							m_string[pos] = character;
 							++count;
 							break;
 						}
@@ -3037,23 +2998,23 @@ namespace Nz
 				unsigned int newSize;
 				{
 					unsigned int count = CountAny(oldCharacters);
-					newSize = m_sharedString->size - count + count*replaceString.m_sharedString->size;
+					newSize = m_size - count + count*replaceString.m_size;
 				}
 				char* newString = new char[newSize+1];
 
 				unsigned int j = 0;
-				for (unsigned int i = 0; i < m_sharedString->size; ++i)
+				for (unsigned int i = 0; i < m_size; ++i)
 				{
 					if (i < pos) // Avant la position où on est censé commencer à remplacer, on ne fait que recopier
-						newString[j++] = m_sharedString->string[i];
+						newString[j++] = m_string[i];
 					else
 					{
 						bool found = false;
-						for (unsigned int l = 0; l < oldCharacters.m_sharedString->size; ++l)
+						for (unsigned int l = 0; l < oldCharacters.m_size; ++l)
 						{
-							if (m_sharedString->string[i] == oldCharacters[l])
+							if (m_string[i] == oldCharacters[l])
 							{
-								for (unsigned int k = 0; k < replaceString.m_sharedString->size; ++k)
+								for (unsigned int k = 0; k < replaceString.m_size; ++k)
 									newString[j++] = replaceString[k];
 
 								++count;
@@ -3063,14 +3024,14 @@ namespace Nz
 						}
 
 						if (!found)
-							newString[j++] = m_sharedString->string[i];
+							newString[j++] = m_string[i];
 					}
 				}
 				newString[newSize] = '\0';
 
 				ReleaseString();
 
-				m_sharedString->size = newSize;
+				m_size = newSize;
 				m_sharedString->string = newString;
 			}
 
@@ -3088,16 +3049,16 @@ namespace Nz
 
 	void String::Reserve(std::size_t bufferSize)
 	{
-		if (m_sharedString->capacity > bufferSize)
+		if (GetCapacity() >= bufferSize)
 			return;
 
-		auto newString = std::make_shared<SharedString>(bufferSize);
-		newString->size = m_sharedString->size;
+		String newString;
+		newString.Allocate(m_size, bufferSize);
 
-		if (m_sharedString->size > 0)
-			std::memcpy(newString->string.get(), m_sharedString->string.get(), m_sharedString->size);
+		if (m_size > 0)
+			std::memcpy(newString.m_string, m_string, m_size);
 
-		m_sharedString = std::move(newString);
+		Swap(newString);
 	}
 
 	/*!
@@ -3117,34 +3078,33 @@ namespace Nz
 		}
 
 		if (size < 0)
-			size = std::max<std::intmax_t>(m_sharedString->size + size, 0);
+			size = std::max<std::intmax_t>(m_size + size, 0);
 
 		std::size_t newSize = static_cast<std::size_t>(size);
 
-		if (flags & HandleUtf8 && newSize < m_sharedString->size)
+		if (flags & HandleUtf8 && newSize < m_size)
 		{
-			std::size_t characterToRemove = m_sharedString->size - newSize;
+			std::size_t characterToRemove = m_size - newSize;
 
-			char* ptr = &m_sharedString->string[m_sharedString->size];
+			char* ptr = &m_string[m_size];
 			for (std::size_t i = 0; i < characterToRemove; ++i)
-				utf8::prior(ptr, m_sharedString->string.get());
+				utf8::prior(ptr, m_string);
 
-			newSize = ptr - m_sharedString->string.get();
+			newSize = ptr - m_string;
 		}
 
-		if (m_sharedString->capacity >= newSize)
+		if (GetCapacity() >= newSize)
 		{
-			EnsureOwnership();
-
-			m_sharedString->size = newSize;
-			m_sharedString->string[newSize] = '\0'; // Adds the EoS character
+			m_size = newSize;
+			m_string[newSize] = '\0'; // Adds the EoS character
 		}
 		else // Then we want to make the string bigger
 		{
-			auto newString = std::make_shared<SharedString>(newSize);
-			std::memcpy(newString->string.get(), m_sharedString->string.get(), m_sharedString->size);
+			String newString;
+			newString.Allocate(newSize);
+			std::memcpy(newString.m_string, m_string, m_size);
 
-			m_sharedString = std::move(newString);
+			Swap(newString);
 		}
 
 		return *this;
@@ -3161,33 +3121,34 @@ namespace Nz
 	String String::Resized(std::intmax_t size, UInt32 flags) const
 	{
 		if (size < 0)
-			size = m_sharedString->size + size;
+			size = m_size + size;
 
 		if (size <= 0)
 			return String();
 
 		std::size_t newSize = static_cast<std::size_t>(size);
-		if (newSize == m_sharedString->size)
+		if (newSize == m_size)
 			return *this;
 
-		if (flags & HandleUtf8 && newSize < m_sharedString->size)
+		if (flags & HandleUtf8 && newSize < m_size)
 		{
-			std::size_t characterToRemove = m_sharedString->size - newSize;
+			std::size_t characterToRemove = m_size - newSize;
 
-			char* ptr = &m_sharedString->string[m_sharedString->size - 1];
+			char* ptr = &m_string[m_size - 1];
 			for (std::size_t i = 0; i < characterToRemove; ++i)
-				utf8::prior(ptr, m_sharedString->string.get());
+				utf8::prior(ptr, m_string);
 
-			newSize = ptr - m_sharedString->string.get();
+			newSize = ptr - m_string;
 		}
 
-		auto sharedStr = std::make_shared<SharedString>(newSize);
-		if (newSize > m_sharedString->size)
-			std::memcpy(sharedStr->string.get(), m_sharedString->string.get(), m_sharedString->size);
+		String sharedStr;
+		sharedStr.Allocate(newSize);
+		if (newSize > m_size)
+			std::memcpy(sharedStr.m_string, m_string, m_size);
 		else
-			std::memcpy(sharedStr->string.get(), m_sharedString->string.get(), newSize);
+			std::memcpy(sharedStr.m_string, m_string, newSize);
 
-		return String(std::move(sharedStr));
+		return sharedStr;
 	}
 
 	/*!
@@ -3197,13 +3158,13 @@ namespace Nz
 
 	String& String::Reverse()
 	{
-		if (m_sharedString->size != 0)
+		if (m_size != 0)
 		{
 			std::size_t i = 0;
-			std::size_t j = m_sharedString->size-1;
+			std::size_t j = m_size-1;
 
 			while (i < j)
-				std::swap(m_sharedString->string[i++], m_sharedString->string[j--]);
+				std::swap(m_string[i++], m_string[j--]);
 		}
 
 		return *this;
@@ -3216,19 +3177,20 @@ namespace Nz
 
 	String String::Reversed() const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return String();
 
-		auto sharedStr = std::make_shared<SharedString>(m_sharedString->size);
+		String sharedStr;
+		sharedStr.Allocate(m_size);
 
-		char* ptr = &sharedStr->string[m_sharedString->size - 1];
-		char* p = m_sharedString->string.get();
+		char* ptr = &sharedStr.m_string[m_size - 1];
+		char* p = m_string;
 
 		do
 			*ptr-- = *p;
 		while (*(++p));
 
-		return String(std::move(sharedStr));
+		return sharedStr;
 	}
 
 	/*!
@@ -3242,17 +3204,9 @@ namespace Nz
 	{
 		if (character != '\0')
 		{
-			if (m_sharedString->capacity >= 1)
-			{
-				EnsureOwnership(true);
+			Allocate(1);
 
-				m_sharedString->size = 1;
-				m_sharedString->string[1] = '\0';
-			}
-			else
-				m_sharedString = std::make_shared<SharedString>(1);
-
-			m_sharedString->string[0] = character;
+			m_string[0] = character;
 		}
 		else
 			ReleaseString();
@@ -3273,18 +3227,10 @@ namespace Nz
 	{
 		if (rep > 0)
 		{
-			if (m_sharedString->capacity >= rep)
-			{
-				EnsureOwnership(true);
-
-				m_sharedString->size = rep;
-				m_sharedString->string[rep] = '\0';
-			}
-			else
-				m_sharedString = std::make_shared<SharedString>(rep);
+			Allocate(rep);
 
 			if (character != '\0')
-				std::memset(m_sharedString->string.get(), character, rep);
+				std::memset(m_string, character, rep);
 		}
 		else
 			ReleaseString();
@@ -3320,18 +3266,10 @@ namespace Nz
 
 		if (totalSize > 0)
 		{
-			if (m_sharedString->capacity >= totalSize)
-			{
-				EnsureOwnership(true);
-
-				m_sharedString->size = totalSize;
-				m_sharedString->string[totalSize] = '\0';
-			}
-			else
-				m_sharedString = std::make_shared<SharedString>(totalSize);
+			Allocate(totalSize);
 
 			for (std::size_t i = 0; i < rep; ++i)
-				std::memcpy(&m_sharedString->string[i*length], string, length);
+				std::memcpy(&m_string[i*length], string, length);
 		}
 		else
 			ReleaseString();
@@ -3349,7 +3287,7 @@ namespace Nz
 
 	String& String::Set(std::size_t rep, const String& string)
 	{
-		return Set(rep, string.GetConstBuffer(), string.m_sharedString->size);
+		return Set(rep, string.GetConstBuffer(), string.m_size);
 	}
 
 	/*!
@@ -3376,17 +3314,9 @@ namespace Nz
 	{
 		if (length > 0)
 		{
-			if (m_sharedString->capacity >= length)
-			{
-				EnsureOwnership(true);
+			Allocate(length);
 
-				m_sharedString->size = length;
-				m_sharedString->string[length] = '\0';
-			}
-			else
-				m_sharedString = std::make_shared<SharedString>(length);
-
-			std::memcpy(m_sharedString->string.get(), string, length);
+			std::memcpy(m_string, string, length);
 		}
 		else
 			ReleaseString();
@@ -3415,7 +3345,8 @@ namespace Nz
 
 	String& String::Set(const String& string)
 	{
-		m_sharedString = string.m_sharedString;
+		if (this != &string)
+			Set(string.m_string, string.m_size);
 
 		return *this;
 	}
@@ -3429,7 +3360,11 @@ namespace Nz
 
 	String& String::Set(String&& string) noexcept
 	{
-		std::swap(m_sharedString, string.m_sharedString);
+		if (this != &string)
+		{
+			ReleaseString();
+			MoveBuffer(string);
+		}
 
 		return *this;
 	}
@@ -3443,14 +3378,15 @@ namespace Nz
 
 	String String::Simplified(UInt32 flags) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return String();
 
-		auto newString = std::make_shared<SharedString>(m_sharedString->size);
-		char* str = newString->string.get();
+		String newString;
+		newString.Allocate(m_size);
+		char* str = newString.m_string;
 		char* p = str;
 
-		const char* ptr = m_sharedString->string.get();
+		const char* ptr = m_string;
 		bool inword = false;
 		if (flags & HandleUtf8)
 		{
@@ -3475,7 +3411,7 @@ namespace Nz
 		}
 		else
 		{
-			const char* limit = &m_sharedString->string[m_sharedString->size];
+			const char* limit = &m_string[m_size];
 			do
 			{
 				if (Detail::IsSpace(*ptr))
@@ -3499,9 +3435,9 @@ namespace Nz
 			p--;
 
 		*p = '\0';
-		newString->size = p - str;
+		newString.m_size = p - str;
 
-		return String(std::move(newString));
+		return newString;
 	}
 
 	/*!
@@ -3528,7 +3464,7 @@ namespace Nz
 
 	unsigned int String::Split(std::vector<String>& result, char separation, std::intmax_t start, UInt32 flags) const
 	{
-		if (separation == '\0' || m_sharedString->size == 0)
+		if (separation == '\0' || m_size == 0)
 			return 0;
 
 		std::size_t lastSep = Find(separation, start, flags);
@@ -3552,7 +3488,7 @@ namespace Nz
 			lastSep = sep;
 		}
 
-		if (lastSep != m_sharedString->size-1)
+		if (lastSep != m_size-1)
 			result.push_back(SubString(lastSep+1));
 
 		return result.size();
@@ -3586,17 +3522,17 @@ namespace Nz
 
 	unsigned int String::Split(std::vector<String>& result, const char* separation, std::size_t length, std::intmax_t start, UInt32 flags) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return 0;
 		else if (length == 0)
 		{
-			result.reserve(m_sharedString->size);
-			for (std::size_t i = 0; i < m_sharedString->size; ++i)
-				result.push_back(String(m_sharedString->string[i]));
+			result.reserve(m_size);
+			for (std::size_t i = 0; i < m_size; ++i)
+				result.push_back(String(m_string[i]));
 
-			return m_sharedString->size;
+			return m_size;
 		}
-		else if (length > m_sharedString->size)
+		else if (length > m_size)
 		{
 			result.push_back(*this);
 			return 1;
@@ -3621,7 +3557,7 @@ namespace Nz
 			lastSep = sep;
 		}
 
-		if (lastSep != m_sharedString->size - length)
+		if (lastSep != m_size - length)
 			result.push_back(SubString(lastSep + length));
 
 		return result.size()-oldSize;
@@ -3639,7 +3575,7 @@ namespace Nz
 
 	unsigned int String::Split(std::vector<String>& result, const String& separation, std::intmax_t start, UInt32 flags) const
 	{
-		return Split(result, separation.m_sharedString->string.get(), separation.m_sharedString->size, start, flags);
+		return Split(result, separation.m_string, separation.m_size, start, flags);
 	}
 
 	/*!
@@ -3654,7 +3590,7 @@ namespace Nz
 
 	unsigned int String::SplitAny(std::vector<String>& result, const char* separations, std::intmax_t start, UInt32 flags) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return 0;
 
 		std::size_t oldSize = result.size();
@@ -3677,7 +3613,7 @@ namespace Nz
 			lastSep = sep;
 		}
 
-		if (lastSep != m_sharedString->size-1)
+		if (lastSep != m_size-1)
 			result.push_back(SubString(lastSep+1));
 
 		return result.size()-oldSize;
@@ -3695,7 +3631,7 @@ namespace Nz
 
 	unsigned int String::SplitAny(std::vector<String>& result, const String& separations, std::intmax_t start, UInt32 flags) const
 	{
-		return SplitAny(result, separations.m_sharedString->string.get(), start, flags);
+		return SplitAny(result, separations.m_string, start, flags);
 	}
 
 	/*!
@@ -3710,13 +3646,13 @@ namespace Nz
 
 	bool String::StartsWith(char character, UInt32 flags) const
 	{
-		if (character == '\0' || m_sharedString->size == 0)
+		if (character == '\0' || m_size == 0)
 			return false;
 
 		if (flags & CaseInsensitive)
-			return Detail::ToLower(m_sharedString->string[0]) == Detail::ToLower(character);
+			return Detail::ToLower(m_string[0]) == Detail::ToLower(character);
 		else
-			return m_sharedString->string[0] == character;
+			return m_string[0] == character;
 	}
 
 	/*!
@@ -3731,14 +3667,14 @@ namespace Nz
 
 	bool String::StartsWith(const char* string, UInt32 flags) const
 	{
-		if (!string || !string[0] || m_sharedString->size == 0)
+		if (!string || !string[0] || m_size == 0)
 			return false;
 
 		if (flags & CaseInsensitive)
 		{
 			if (flags & HandleUtf8)
 			{
-				utf8::unchecked::iterator<const char*> it(m_sharedString->string.get());
+				utf8::unchecked::iterator<const char*> it(m_string);
 				utf8::unchecked::iterator<const char*> it2(string);
 				do
 				{
@@ -3754,7 +3690,7 @@ namespace Nz
 			}
 			else
 			{
-				char* ptr = m_sharedString->string.get();
+				char* ptr = m_string;
 				const char* s = string;
 				do
 				{
@@ -3771,7 +3707,7 @@ namespace Nz
 		}
 		else
 		{
-			char* ptr = m_sharedString->string.get();
+			char* ptr = m_string;
 			const char* s = string;
 			do
 			{
@@ -3801,17 +3737,17 @@ namespace Nz
 
 	bool String::StartsWith(const String& string, UInt32 flags) const
 	{
-		if (string.m_sharedString->size == 0)
+		if (string.m_size == 0)
 			return false;
 
-		if (m_sharedString->size < string.m_sharedString->size)
+		if (m_size < string.m_size)
 			return false;
 
 		if (flags & CaseInsensitive)
 		{
 			if (flags & HandleUtf8)
 			{
-				utf8::unchecked::iterator<const char*> it(m_sharedString->string.get());
+				utf8::unchecked::iterator<const char*> it(m_string);
 				utf8::unchecked::iterator<const char*> it2(string.GetConstBuffer());
 				do
 				{
@@ -3827,7 +3763,7 @@ namespace Nz
 			}
 			else
 			{
-				char* ptr = m_sharedString->string.get();
+				char* ptr = m_string;
 				const char* s = string.GetConstBuffer();
 				do
 				{
@@ -3843,7 +3779,7 @@ namespace Nz
 			}
 		}
 		else
-			return std::memcmp(m_sharedString->string.get(), string.GetConstBuffer(), string.m_sharedString->size) == 0;
+			return std::memcmp(m_string, string.GetConstBuffer(), string.m_size) == 0;
 
 		return false;
 	}
@@ -3859,27 +3795,28 @@ namespace Nz
 	String String::SubString(std::intmax_t startPos, std::intmax_t endPos) const
 	{
 		if (startPos < 0)
-			startPos = std::max<std::size_t>(m_sharedString->size + startPos, 0);
+			startPos = std::max<std::size_t>(m_size + startPos, 0);
 
 		std::size_t start = static_cast<std::size_t>(startPos);
 
 		if (endPos < 0)
 		{
-			endPos = m_sharedString->size+endPos;
+			endPos = m_size+endPos;
 			if (endPos < 0)
 				return String();
 		}
 
-		std::size_t minEnd = std::min(static_cast<std::size_t>(endPos), m_sharedString->size - 1);
-		if (start > minEnd || start >= m_sharedString->size)
+		std::size_t minEnd = std::min(static_cast<std::size_t>(endPos), m_size - 1);
+		if (start > minEnd || start >= m_size)
 			return String();
 
 		std::size_t size = minEnd - start + 1;
 
-		auto str = std::make_shared<SharedString>(size);
-		std::memcpy(str->string.get(), &m_sharedString->string[start], size);
+		String str;
+		str.Allocate(size);
+		std::memcpy(str.m_string, &m_string[start], size);
 
-		return String(std::move(str));
+		return str;
 	}
 
 	/*!
@@ -3969,7 +3906,7 @@ namespace Nz
 
 	String String::SubStringFrom(const String& string, std::intmax_t startPos, bool fromLast, bool include, UInt32 flags) const
 	{
-		return SubStringFrom(string.GetConstBuffer(), string.m_sharedString->size, startPos, fromLast, include, flags);
+		return SubStringFrom(string.GetConstBuffer(), string.m_size, startPos, fromLast, include, flags);
 	}
 
 	/*!
@@ -4059,7 +3996,7 @@ namespace Nz
 
 	String String::SubStringTo(const String& string, std::intmax_t startPos, bool toLast, bool include, UInt32 flags) const
 	{
-		return SubStringTo(string.GetConstBuffer(), string.m_sharedString->size, startPos, toLast, include, flags);
+		return SubStringTo(string.GetConstBuffer(), string.m_size, startPos, toLast, include, flags);
 	}
 
 	/*!
@@ -4070,7 +4007,9 @@ namespace Nz
 
 	void String::Swap(String& str)
 	{
-		std::swap(m_sharedString, str.m_sharedString);
+		String temp(std::move(str));
+		str.Set(std::move(*this));
+		Set(std::move(temp));
 	}
 
 	/*!
@@ -4083,7 +4022,7 @@ namespace Nz
 
 	bool String::ToBool(bool* value, UInt32 flags) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return false;
 
 		String word = GetWord(0);
@@ -4129,11 +4068,11 @@ namespace Nz
 
 	bool String::ToDouble(double* value) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return false;
 
 		if (value)
-			*value = std::atof(m_sharedString->string.get());
+			*value = std::atof(m_string);
 
 		return true;
 	}
@@ -4168,14 +4107,14 @@ namespace Nz
 
 	String String::ToLower(UInt32 flags) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return *this;
 
 		if (flags & HandleUtf8)
 		{
 			String lower;
-			lower.Reserve(m_sharedString->size);
-			utf8::unchecked::iterator<const char*> it(m_sharedString->string.get());
+			lower.Reserve(m_size);
+			utf8::unchecked::iterator<const char*> it(m_string);
 			do
 				utf8::append(Unicode::GetLowercase(*it), std::back_inserter(lower));
 			while (*++it);
@@ -4184,17 +4123,18 @@ namespace Nz
 		}
 		else
 		{
-			auto str = std::make_shared<SharedString>(m_sharedString->size);
+			String str;
+			str.Allocate(m_size);
 
-			char* ptr = m_sharedString->string.get();
-			char* s = str->string.get();
+			char* ptr = m_string;
+			char* s = str.m_string;
 			do
 				*s++ = Detail::ToLower(*ptr);
 			while (*++ptr);
 
 			*s = '\0';
 
-			return String(std::move(str));
+			return str;
 		}
 	}
 
@@ -4204,7 +4144,7 @@ namespace Nz
 	*/
 	std::string String::ToStdString() const
 	{
-		return std::string(m_sharedString->string.get(), m_sharedString->size);
+		return std::string(m_string, m_size);
 	}
 
 	/*!
@@ -4215,14 +4155,14 @@ namespace Nz
 	*/
 	String String::ToUpper(UInt32 flags) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return *this;
 
 		if (flags & HandleUtf8)
 		{
 			String upper;
-			upper.Reserve(m_sharedString->size);
-			utf8::unchecked::iterator<const char*> it(m_sharedString->string.get());
+			upper.Reserve(m_size);
+			utf8::unchecked::iterator<const char*> it(m_string);
 			do
 				utf8::append(Unicode::GetUppercase(*it), std::back_inserter(upper));
 			while (*++it);
@@ -4231,17 +4171,18 @@ namespace Nz
 		}
 		else
 		{
-			auto str = std::make_shared<SharedString>(m_sharedString->size);
+			String str;
+			str.Allocate(m_size);
 
-			char* ptr = m_sharedString->string.get();
-			char* s = str->string.get();
+			char* ptr = m_string;
+			char* s = str.m_string;
 			do
 				*s++ = Detail::ToUpper(*ptr);
 			while (*++ptr);
 
 			*s = '\0';
 
-			return String(std::move(str));
+			return str;
 		}
 	}
 
@@ -4279,7 +4220,7 @@ namespace Nz
 
 	String String::Trimmed(UInt32 flags) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return *this;
 
 		std::size_t startPos;
@@ -4288,7 +4229,7 @@ namespace Nz
 		{
 			if ((flags & TrimOnlyRight) == 0)
 			{
-				utf8::unchecked::iterator<const char*> it(m_sharedString->string.get());
+				utf8::unchecked::iterator<const char*> it(m_string);
 				do
 				{
 					if (!Detail::IsSpace(*it))
@@ -4296,44 +4237,44 @@ namespace Nz
 				}
 				while (*++it);
 
-				startPos = it.base() - m_sharedString->string.get();
+				startPos = it.base() - m_string;
 			}
 			else
 				startPos = 0;
 
 			if ((flags & TrimOnlyLeft) == 0)
 			{
-				utf8::unchecked::iterator<const char*> it(&m_sharedString->string[m_sharedString->size]);
-				while ((it--).base() != m_sharedString->string.get())
+				utf8::unchecked::iterator<const char*> it(&m_string[m_size]);
+				while ((it--).base() != m_string)
 				{
 					if (!Detail::IsSpace(*it))
 						break;
 				}
 
-				endPos = it.base() - m_sharedString->string.get();
+				endPos = it.base() - m_string;
 			}
 			else
-				endPos = m_sharedString->size-1;
+				endPos = m_size-1;
 		}
 		else
 		{
 			startPos = 0;
 			if ((flags & TrimOnlyRight) == 0)
 			{
-				for (; startPos < m_sharedString->size; ++startPos)
+				for (; startPos < m_size; ++startPos)
 				{
-					char c = m_sharedString->string[startPos];
+					char c = m_string[startPos];
 					if (!Detail::IsSpace(c))
 						break;
 				}
 			}
 
-			endPos = m_sharedString->size-1;
+			endPos = m_size-1;
 			if ((flags & TrimOnlyLeft) == 0)
 			{
 				for (; endPos > 0; --endPos)
 				{
-					char c = m_sharedString->string[endPos];
+					char c = m_string[endPos];
 					if (!Detail::IsSpace(c))
 						break;
 				}
@@ -4353,19 +4294,19 @@ namespace Nz
 
 	String String::Trimmed(char character, UInt32 flags) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return *this;
 
 		std::size_t startPos = 0;
-		std::size_t endPos = m_sharedString->size-1;
+		std::size_t endPos = m_size-1;
 		if (flags & CaseInsensitive)
 		{
 			char ch = Detail::ToLower(character);
 			if ((flags & TrimOnlyRight) == 0)
 			{
-				for (; startPos < m_sharedString->size; ++startPos)
+				for (; startPos < m_size; ++startPos)
 				{
-					if (Detail::ToLower(m_sharedString->string[startPos]) != ch)
+					if (Detail::ToLower(m_string[startPos]) != ch)
 						break;
 				}
 			}
@@ -4374,7 +4315,7 @@ namespace Nz
 			{
 				for (; endPos > 0; --endPos)
 				{
-					if (Detail::ToLower(m_sharedString->string[endPos]) != ch)
+					if (Detail::ToLower(m_string[endPos]) != ch)
 						break;
 				}
 			}
@@ -4383,9 +4324,9 @@ namespace Nz
 		{
 			if ((flags & TrimOnlyRight) == 0)
 			{
-				for (; startPos < m_sharedString->size; ++startPos)
+				for (; startPos < m_size; ++startPos)
 				{
-					if (m_sharedString->string[startPos] != character)
+					if (m_string[startPos] != character)
 						break;
 				}
 			}
@@ -4394,7 +4335,7 @@ namespace Nz
 			{
 				for (; endPos > 0; --endPos)
 				{
-					if (m_sharedString->string[endPos] != character)
+					if (m_string[endPos] != character)
 						break;
 				}
 			}
@@ -4410,7 +4351,7 @@ namespace Nz
 
 	char* String::begin()
 	{
-		return m_sharedString->string.get();
+		return m_string;
 	}
 
 	/*!
@@ -4420,7 +4361,7 @@ namespace Nz
 
 	const char* String::begin() const
 	{
-		return m_sharedString->string.get();
+		return m_string;
 	}
 
 	/*!
@@ -4430,7 +4371,7 @@ namespace Nz
 
 	char* String::end()
 	{
-		return &m_sharedString->string[m_sharedString->size];
+		return &m_string[m_size];
 	}
 
 	/*!
@@ -4440,7 +4381,7 @@ namespace Nz
 
 	const char* String::end() const
 	{
-		return &m_sharedString->string[m_sharedString->size];
+		return &m_string[m_size];
 	}
 
 	/*!
@@ -4471,22 +4412,22 @@ namespace Nz
 	/*
 	char* String::rbegin()
 	{
-		return &m_sharedString->string[m_sharedString->size-1];
+		return &m_string[m_size-1];
 	}
 
 	const char* String::rbegin() const
 	{
-		return &m_sharedString->string[m_sharedString->size-1];
+		return &m_string[m_size-1];
 	}
 
 	char* String::rend()
 	{
-		return &m_sharedString->string[-1];
+		return &m_string[-1];
 	}
 
 	const char* String::rend() const
 	{
-		return &m_sharedString->string[-1];
+		return &m_string[-1];
 	}
 	*/
 
@@ -4501,12 +4442,10 @@ namespace Nz
 
 	char& String::operator[](std::size_t pos)
 	{
-		EnsureOwnership();
-
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 			Resize(pos+1);
 
-		return m_sharedString->string[pos];
+		return m_string[pos];
 	}
 
 	/*!
@@ -4521,14 +4460,14 @@ namespace Nz
 	char String::operator[](std::size_t pos) const
 	{
 		#if NAZARA_CORE_SAFE
-		if (pos >= m_sharedString->size)
+		if (pos >= m_size)
 		{
-			NazaraError("Index out of range (" + Number(pos) + " >= " + Number(m_sharedString->size) + ')');
+			NazaraError("Index out of range (" + Number(pos) + " >= " + Number(m_size) + ')');
 			return 0;
 		}
 		#endif
 
-		return m_sharedString->string[pos];
+		return m_string[pos];
 	}
 
 	/*!
@@ -4603,11 +4542,12 @@ namespace Nz
 		if (character == '\0')
 			return *this;
 
-		auto str = std::make_shared<SharedString>(m_sharedString->size + 1);
-		std::memcpy(str->string.get(), GetConstBuffer(), m_sharedString->size);
-		str->string[m_sharedString->size] = character;
+		String str;
+		str.Allocate(m_size + 1);
+		std::memcpy(str.m_string, GetConstBuffer(), m_size);
+		str.m_string[m_size] = character;
 
-		return String(std::move(str));
+		return str;
 	}
 
 	/*!
@@ -4622,18 +4562,19 @@ namespace Nz
 		if (!string || !string[0])
 			return *this;
 
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return string;
 
 		std::size_t length = std::strlen(string);
 		if (length == 0)
 			return *this;
 
-		auto str = std::make_shared<SharedString>(m_sharedString->size + length);
-		std::memcpy(str->string.get(), GetConstBuffer(), m_sharedString->size);
-		std::memcpy(&str->string[m_sharedString->size], string, length+1);
+		String str;
+		str.Allocate(m_size + length);
+		std::memcpy(str.m_string, GetConstBuffer(), m_size);
+		std::memcpy(&str.m_string[m_size], string, length+1);
 
-		return String(std::move(str));
+		return str;
 	}
 
 	/*!
@@ -4648,14 +4589,15 @@ namespace Nz
 		if (string.empty())
 			return *this;
 
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return string;
 
-		auto str = std::make_shared<SharedString>(m_sharedString->size + string.size());
-		std::memcpy(str->string.get(), GetConstBuffer(), m_sharedString->size);
-		std::memcpy(&str->string[m_sharedString->size], string.c_str(), string.size()+1);
+		String str;
+		str.Allocate(m_size + string.size());
+		std::memcpy(str.m_string, GetConstBuffer(), m_size);
+		std::memcpy(&str.m_string[m_size], string.c_str(), string.size()+1);
 
-		return String(std::move(str));
+		return str;
 	}
 
 	/*!
@@ -4667,17 +4609,18 @@ namespace Nz
 
 	String String::operator+(const String& string) const
 	{
-		if (string.m_sharedString->size == 0)
+		if (string.m_size == 0)
 			return *this;
 
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return string;
 
-		auto str = std::make_shared<SharedString>(m_sharedString->size + string.m_sharedString->size);
-		std::memcpy(str->string.get(), GetConstBuffer(), m_sharedString->size);
-		std::memcpy(&str->string[m_sharedString->size], string.GetConstBuffer(), string.m_sharedString->size);
+		String str;
+		str.Allocate(m_size + string.m_size);
+		std::memcpy(str.m_string, GetConstBuffer(), m_size);
+		std::memcpy(&str.m_string[m_size], string.GetConstBuffer(), string.m_size);
 
-		return String(std::move(str));
+		return str;
 	}
 
 	/*!
@@ -4689,7 +4632,7 @@ namespace Nz
 
 	String& String::operator+=(char character)
 	{
-		return Insert(m_sharedString->size, character);
+		return Insert(m_size, character);
 	}
 
 	/*!
@@ -4701,7 +4644,7 @@ namespace Nz
 
 	String& String::operator+=(const char* string)
 	{
-		return Insert(m_sharedString->size, string);
+		return Insert(m_size, string);
 	}
 
 	/*!
@@ -4713,7 +4656,7 @@ namespace Nz
 
 	String& String::operator+=(const std::string& string)
 	{
-		return Insert(m_sharedString->size, string.c_str(), string.size());
+		return Insert(m_size, string.c_str(), string.size());
 	}
 
 	/*!
@@ -4725,7 +4668,7 @@ namespace Nz
 
 	String& String::operator+=(const String& string)
 	{
-		return Insert(m_sharedString->size, string);
+		return Insert(m_size, string);
 	}
 
 	/*!
@@ -4737,13 +4680,13 @@ namespace Nz
 
 	bool String::operator==(char character) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return character == '\0';
 
-		if (m_sharedString->size > 1)
+		if (m_size > 1)
 			return false;
 
-		return m_sharedString->string[0] == character;
+		return m_string[0] == character;
 	}
 
 	/*!
@@ -4755,7 +4698,7 @@ namespace Nz
 
 	bool String::operator==(const char* string) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return !string || !string[0];
 
 		if (!string || !string[0])
@@ -4773,10 +4716,10 @@ namespace Nz
 
 	bool String::operator==(const std::string& string) const
 	{
-		if (m_sharedString->size == 0 || string.empty())
-			return m_sharedString->size == string.size();
+		if (m_size == 0 || string.empty())
+			return m_size == string.size();
 
-		if (m_sharedString->size != string.size())
+		if (m_size != string.size())
 			return false;
 
 		return std::strcmp(GetConstBuffer(), string.c_str()) == 0;
@@ -4791,16 +4734,16 @@ namespace Nz
 
 	bool String::operator!=(char character) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return character != '\0';
 
-		if (character == '\0' || m_sharedString->size != 1)
+		if (character == '\0' || m_size != 1)
 			return true;
 
-		if (m_sharedString->size != 1)
+		if (m_size != 1)
 			return true;
 
-		return m_sharedString->string[0] != character;
+		return m_string[0] != character;
 	}
 
 	/*!
@@ -4812,7 +4755,7 @@ namespace Nz
 
 	bool String::operator!=(const char* string) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return string && string[0];
 
 		if (!string || !string[0])
@@ -4830,10 +4773,10 @@ namespace Nz
 
 	bool String::operator!=(const std::string& string) const
 	{
-		if (m_sharedString->size == 0 || string.empty())
-			return m_sharedString->size == string.size();
+		if (m_size == 0 || string.empty())
+			return m_size == string.size();
 
-		if (m_sharedString->size != string.size())
+		if (m_size != string.size())
 			return false;
 
 		return std::strcmp(GetConstBuffer(), string.c_str()) != 0;
@@ -4851,10 +4794,10 @@ namespace Nz
 		if (character == '\0')
 			return false;
 
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return true;
 
-		return m_sharedString->string[0] < character;
+		return m_string[0] < character;
 	}
 
 	/*!
@@ -4869,7 +4812,7 @@ namespace Nz
 		if (!string || !string[0])
 			return false;
 
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return true;
 
 		return std::strcmp(GetConstBuffer(), string) < 0;
@@ -4887,7 +4830,7 @@ namespace Nz
 		if (string.empty())
 			return false;
 
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return true;
 
 		return std::strcmp(GetConstBuffer(), string.c_str()) < 0;
@@ -4902,13 +4845,13 @@ namespace Nz
 
 	bool String::operator<=(char character) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return true;
 
 		if (character == '\0')
 			return false;
 
-		return m_sharedString->string[0] < character || (m_sharedString->string[0] == character && m_sharedString->size == 1);
+		return m_string[0] < character || (m_string[0] == character && m_size == 1);
 	}
 
 	/*!
@@ -4920,7 +4863,7 @@ namespace Nz
 
 	bool String::operator<=(const char* string) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return true;
 
 		if (!string || !string[0])
@@ -4938,7 +4881,7 @@ namespace Nz
 
 	bool String::operator<=(const std::string& string) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return true;
 
 		if (string.empty())
@@ -4956,13 +4899,13 @@ namespace Nz
 
 	bool String::operator>(char character) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return false;
 
 		if (character == '\0')
 			return true;
 
-		return m_sharedString->string[0] > character;
+		return m_string[0] > character;
 	}
 
 	/*!
@@ -4974,7 +4917,7 @@ namespace Nz
 
 	bool String::operator>(const char* string) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return false;
 
 		if (!string || !string[0])
@@ -4992,7 +4935,7 @@ namespace Nz
 
 	bool String::operator>(const std::string& string) const
 	{
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return false;
 
 		if (string.empty())
@@ -5013,10 +4956,10 @@ namespace Nz
 		if (character == '\0')
 			return true;
 
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return false;
 
-		return m_sharedString->string[0] > character || (m_sharedString->string[0] == character && m_sharedString->size == 1);
+		return m_string[0] > character || (m_string[0] == character && m_size == 1);
 	}
 
 	/*!
@@ -5031,7 +4974,7 @@ namespace Nz
 		if (!string || !string[0])
 			return true;
 
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return false;
 
 		return std::strcmp(GetConstBuffer(), string) >= 0;
@@ -5049,7 +4992,7 @@ namespace Nz
 		if (string.empty())
 			return true;
 
-		if (m_sharedString->size == 0)
+		if (m_size == 0)
 			return false;
 
 		return std::strcmp(GetConstBuffer(), string.c_str()) >= 0;
@@ -5066,10 +5009,11 @@ namespace Nz
 	{
 		std::size_t size = (boolean) ? 4 : 5;
 
-		auto str = std::make_shared<SharedString>(size);
-		std::memcpy(str->string.get(), (boolean) ? "true" : "false", size);
+		String str;
+		str.Allocate(size);
+		std::memcpy(str.m_string, (boolean) ? "true" : "false", size);
 
-		return String(std::move(str));
+		return str;
 	}
 
 	/*!
@@ -5082,10 +5026,10 @@ namespace Nz
 
 	int String::Compare(const String& first, const String& second)
 	{
-		if (first.m_sharedString->size == 0)
-			return (second.m_sharedString->size == 0) ? 0 : -1;
+		if (first.m_size == 0)
+			return (second.m_size == 0) ? 0 : -1;
 
-		if (second.m_sharedString->size == 0)
+		if (second.m_size == 0)
 			return 1;
 
 		return std::strcmp(first.GetConstBuffer(), second.GetConstBuffer());
@@ -5106,10 +5050,11 @@ namespace Nz
 
 		std::size_t length = std::vsnprintf(nullptr, 0, format, args);
 
-		auto str = std::make_shared<SharedString>(length);
-		std::vsnprintf(str->string.get(), length + 1, format, args2);
+		String str;
+		str.Allocate(length);
+		std::vsnprintf(str.m_string, length + 1, format, args2);
 
-		return String(std::move(str));
+		return str;
 	}
 
 	/*!
@@ -5304,10 +5249,11 @@ namespace Nz
 	{
 		const std::size_t capacity = sizeof(void*)*2 + 2;
 
-		auto str = std::make_shared<SharedString>(capacity);
-		str->size = std::sprintf(str->string.get(), "0x%p", ptr);
+		String str;
+		str.Allocate(capacity);
+		str.m_size = std::sprintf(str.m_string, "0x%p", ptr);
 
-		return String(std::move(str));
+		return str;
 	}
 
 	/*!
@@ -5332,10 +5278,11 @@ namespace Nz
 		else
 			count = 4;
 
-		auto str = std::make_shared<SharedString>(count);
-		utf8::append(character, str->string.get());
+		String str;
+		str.Allocate(count);
+		utf8::append(character, str.m_string);
 
-		return String(std::move(str));
+		return str;
 	}
 
 	/*!
@@ -5370,14 +5317,15 @@ namespace Nz
 
 		count *= 2; // We ensure to have enough place
 
-		auto str = std::make_shared<SharedString>(count);
+		String str;
+		str.Allocate(count);
 
-		char* r = utf8::utf16to8(u16String, ptr, str->string.get());
+		char* r = utf8::utf16to8(u16String, ptr, str.m_string);
 		*r = '\0';
 
-		str->size = r - str->string.get();
+		str.m_size = r - str.m_string;
 
-		return String(std::move(str));
+		return str;
 	}
 
 	/*!
@@ -5408,10 +5356,11 @@ namespace Nz
 		}
 		while (*++ptr);
 
-		auto str = std::make_shared<SharedString>(count);
-		utf8::utf32to8(u32String, ptr, str->string.get());
+		String str;
+		str.Allocate(count);
+		utf8::utf32to8(u32String, ptr, str.m_string);
 
-		return String(std::move(str));
+		return str;
 	}
 
 	/*!
@@ -5442,10 +5391,11 @@ namespace Nz
 		}
 		while (*++ptr);
 
-		auto str = std::make_shared<SharedString>(count);
-		utf8::utf32to8(wString, ptr, str->string.get());
+		String str;
+		str.Allocate(count);
+		utf8::utf32to8(wString, ptr, str.m_string);
 
-		return String(std::move(str));
+		return str;
 	}
 
 	/*!
@@ -5493,7 +5443,7 @@ namespace Nz
 		if (str.IsEmpty())
 			return os;
 
-		return operator<<(os, str.m_sharedString->string.get());
+		return operator<<(os, str.m_string);
 	}
 
 	/*!
@@ -5512,11 +5462,12 @@ namespace Nz
 		if (string.IsEmpty())
 			return String(character);
 
-		auto str = std::make_shared<String::SharedString>(string.m_sharedString->size + 1);
-		str->string[0] = character;
-		std::memcpy(&str->string[1], string.GetConstBuffer(), string.m_sharedString->size);
+		String str;
+		str.Allocate(string.m_size + 1);
+		str.m_string[0] = character;
+		std::memcpy(&str.m_string[1], string.GetConstBuffer(), string.m_size);
 
-		return String(std::move(str));
+		return str;
 	}
 
 	/*!
@@ -5536,13 +5487,14 @@ namespace Nz
 			return string;
 
 		std::size_t size = std::strlen(string);
-		std::size_t totalSize = size + nstring.m_sharedString->size;
+		std::size_t totalSize = size + nstring.m_size;
 
-		auto str = std::make_shared<String::SharedString>(totalSize);
-		std::memcpy(str->string.get(), string, size);
-		std::memcpy(&str->string[size], nstring.GetConstBuffer(), nstring.m_sharedString->size+1);
+		String str;
+		str.Allocate(totalSize);
+		std::memcpy(str.m_string, string, size);
+		std::memcpy(&str.m_string[size], nstring.GetConstBuffer(), nstring.m_size+1);
 
-		return String(std::move(str));
+		return str;
 	}
 
 	/*!
@@ -5558,16 +5510,17 @@ namespace Nz
 		if (string.empty())
 			return nstring;
 
-		if (nstring.m_sharedString->size == 0)
+		if (nstring.m_size == 0)
 			return string;
 
-		std::size_t totalSize = string.size() + nstring.m_sharedString->size;
+		std::size_t totalSize = string.size() + nstring.m_size;
 
-		auto str = std::make_shared<String::SharedString>(totalSize);
-		std::memcpy(str->string.get(), string.c_str(), string.size());
-		std::memcpy(&str->string[string.size()], nstring.GetConstBuffer(), nstring.m_sharedString->size+1);
+		String str;
+		str.Allocate(totalSize);
+		std::memcpy(str.m_string, string.c_str(), string.size());
+		std::memcpy(&str.m_string[string.size()], nstring.GetConstBuffer(), nstring.m_size+1);
 
-		return String(std::move(str));
+		return str;
 	}
 
 	/*!
@@ -5580,16 +5533,13 @@ namespace Nz
 
 	bool operator==(const String& first, const String& second)
 	{
-		if (first.m_sharedString->size == 0 || second.m_sharedString->size == 0)
-			return first.m_sharedString->size == second.m_sharedString->size;
+		if (first.m_size == 0 || second.m_size == 0)
+			return first.m_size == second.m_size;
 
-		if (first.m_sharedString->size != second.m_sharedString->size)
+		if (first.m_size != second.m_size)
 			return false;
 
-		if (first.m_sharedString == second.m_sharedString)
-			return true;
-
-		return std::strcmp(first.GetConstBuffer(), second.GetConstBuffer()) == 0;
+		return std::memcmp(first.m_string, second.m_string, first.m_size) == 0;
 	}
 
 	/*!
@@ -5615,10 +5565,10 @@ namespace Nz
 
 	bool operator<(const String& first, const String& second)
 	{
-		if (second.m_sharedString->size == 0)
+		if (second.m_size == 0)
 			return false;
 
-		if (first.m_sharedString->size == 0)
+		if (first.m_size == 0)
 			return true;
 
 		return std::strcmp(first.GetConstBuffer(), second.GetConstBuffer()) < 0;
@@ -5898,35 +5848,28 @@ namespace Nz
 	}
 
 	/*!
-	* \brief Ensures the ownership of the string
+	* \brief Prepares the buffer for a new content
+	*
+	* The current content is discarded, the buffer is reallocated only if it is too small
 	*
-	* \param discardContent Should discard the content
+	* \param size New size of the string
+	* \param capacity Minimal capacity of the buffer
 	*/
 
-	void String::EnsureOwnership(bool discardContent)
+	void String::Allocate(std::size_t size, std::size_t capacity)
 	{
-		if (!m_sharedString)
-			return;
-
-		if (!m_sharedString.unique())
+		capacity = std::max(size, capacity);
+		if (capacity > GetCapacity())
 		{
-			auto newSharedString = std::make_shared<SharedString>(GetSize(), GetCapacity());
-			if (!discardContent && newSharedString->size > 0)
-				std::memcpy(newSharedString->string.get(), GetConstBuffer(), GetSize()+1);
+			char* buffer = new char[capacity + 1];
 
-			m_sharedString = std::move(newSharedString);
+			ReleaseString();
+			m_string = buffer;
+			m_capacity = capacity;
 		}
-	}
 
-	/*!
-	* \brief Gets the empty string
-	* \return A reference to the empty string
-	*/
-
-	const std::shared_ptr<String::SharedString>& String::GetEmptyString()
-	{
-		static auto emptyString = std::make_shared<SharedString>();
-		return emptyString;
+		m_size = size;
+		m_string[size] = '\0';
 	}
 
 	/*!
@@ -5962,6 +5905,7 @@ namespace Nz
 	}
 
 	const std::size_t String::npos(std::numeric_limits<std::size_t>::max());
+	constexpr std::size_t String::SmallStringCapacity;
 }
 
 namespace std
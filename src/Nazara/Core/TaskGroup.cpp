@@ -0,0 +1,69 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/TaskGroup.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Core/TaskSchedulerImpl.hpp>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Waits for every task of this group to be done
+	*
+	* The calling thread runs pending tasks (of any group) while waiting, which makes it possible to wait on a group from inside a task.
+	*
+	* \remark Waiting on a group from one of its own tasks will never return
+	*/
+	void TaskGroup::Wait()
+	{
+		TaskSchedulerImpl::Wait(m_pendingTaskCount);
+	}
+
+	/*!
+	* \brief Adds a task to the group and submits it to the TaskScheduler
+	*
+	* \param taskFunctor Functor representing a task to be done
+	*
+	* \remark Produce a NazaraError if the TaskScheduler failed to initialize
+	*/
+	void TaskGroup::AddTaskFunctor(Functor* taskFunctor)
+	{
+		AddTaskFunctors(&taskFunctor, 1);
+	}
+
+	/*!
+	* \brief Adds multiple tasks to the group and submits them to the TaskScheduler at once
+	*
+	* \param taskFunctors Functors representing the tasks to be done
+	* \param count Number of functors
+	*
+	* \remark Produce a NazaraError if the TaskScheduler failed to initialize
+	*/
+	void TaskGroup::AddTaskFunctors(Functor** taskFunctors, std::size_t count)
+	{
+		if (!TaskScheduler::Initialize())
+		{
+			NazaraError("Failed to initialize Task Scheduler");
+			return;
+		}
+
+		m_pendingTaskCount.fetch_add(count, std::memory_order_relaxed);
+		TaskSchedulerImpl::Submit(taskFunctors, count);
+	}
+
+	ConcurrentMemoryPool& TaskGroup::GetTaskPool()
+	{
+		static ConcurrentMemoryPool taskPool(TaskBlockSize);
+		return taskPool;
+	}
+
+	void TaskGroup::NotifyCompletion()
+	{
+		TaskSchedulerImpl::NotifyCompletion();
+	}
+
+	constexpr std::size_t TaskGroup::TaskBlockSize;
+}
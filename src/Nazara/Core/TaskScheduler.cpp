@@ -5,15 +5,8 @@
 #include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/HardwareInfo.hpp>
-
-#if defined(NAZARA_PLATFORM_WINDOWS)
-	#include <Nazara/Core/Win32/TaskSchedulerImpl.hpp>
-#elif defined(NAZARA_PLATFORM_POSIX)
-	#include <Nazara/Core/Posix/TaskSchedulerImpl.hpp>
-#else
-	#error Lack of implementation: Task Scheduler
-#endif
-
+#include <Nazara/Core/TaskSchedulerImpl.hpp>
+#include <vector>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -21,6 +14,7 @@ namespace Nz
 	namespace
 	{
 		std::vector<Functor*> s_pendingWorks;
+		TaskGroup s_defaultGroup;
 		unsigned int s_workerCount = 0;
 	}
 
@@ -29,6 +23,9 @@ namespace Nz
 	* \class Nz::TaskScheduler
 	* \brief Core class that represents a pool of threads
 	*
+	* Each worker owns a lock-free work-stealing queue, idle workers steal tasks from the others.
+	* Tasks submitted from inside a task go directly to the queue of the worker running it.
+	*
 	* \remark Initialized should be called first
 	*/
 
@@ -68,7 +65,7 @@ namespace Nz
 
 		if (!s_pendingWorks.empty())
 		{
-			TaskSchedulerImpl::Run(&s_pendingWorks[0], s_pendingWorks.size());
+			s_defaultGroup.AddTaskFunctors(&s_pendingWorks[0], s_pendingWorks.size());
 			s_pendingWorks.clear();
 		}
 	}
@@ -105,9 +102,12 @@ namespace Nz
 	}
 
 	/*!
-	* \brief Waits for tasks to be done
+	* \brief Waits for tasks started by Run() to be done
+	*
+	* The calling thread helps the workers while waiting
 	*
 	* \remark Produce a NazaraError if the class is not initialized
+	* \remark Calling this from a task started by Run() will never return
 	*/
 
 	void TaskScheduler::WaitForTasks()
@@ -118,7 +118,7 @@ namespace Nz
 			return;
 		}
 
-		TaskSchedulerImpl::WaitForTasks();
+		s_defaultGroup.Wait();
 	}
 
 	/*!
@@ -127,7 +127,7 @@ namespace Nz
 	* \param taskFunctor Functor represeting a task to be done
 	*
 	* \remark Produce a NazaraError if the class is not initialized
-	* \remark A task containing a call on this class is undefined behaviour
+	* \remark Tasks submitting other tasks should use a TaskGroup instead
 	*/
 
 	void TaskScheduler::AddTaskFunctor(Functor* taskFunctor)
@@ -140,4 +140,14 @@ namespace Nz
 
 		s_pendingWorks.push_back(taskFunctor);
 	}
+
+	/*!
+	* \brief Gets the group used by the tasks started with Run()
+	* \return Default task group
+	*/
+
+	TaskGroup& TaskScheduler::GetDefaultGroup()
+	{
+		return s_defaultGroup;
+	}
 }
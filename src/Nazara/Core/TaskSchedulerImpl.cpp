@@ -0,0 +1,292 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/TaskSchedulerImpl.hpp>
+#include <Nazara/Core/ConditionVariable.hpp>
+#include <Nazara/Core/Config.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/Functor.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Core/String.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <Nazara/Core/WorkStealingQueue.hpp>
+#include <vector>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	struct TaskSchedulerImpl::Worker
+	{
+		std::atomic_size_t inboxSize;
+		std::vector<Functor*> inbox;      //< Tasks submitted by external threads, only the owner pushes in its queue
+		std::vector<Functor*> inboxSwap;
+		Mutex inboxMutex;
+		Thread thread;
+		WorkStealingQueue queue;
+		unsigned int index;
+	};
+
+	namespace
+	{
+		// Protects the sleep of workers and waiting threads, signaled when tasks are submitted or when a group is finished
+		ConditionVariable s_stateChanged;
+		Mutex s_stateMutex;
+	}
+
+	bool TaskSchedulerImpl::Initialize(unsigned int workerCount)
+	{
+		if (IsInitialized())
+			return true; // Already initialized
+
+		#if NAZARA_CORE_SAFE
+		if (workerCount == 0)
+		{
+			NazaraError("Invalid worker count ! (0)");
+			return false;
+		}
+		#endif
+
+		s_nextInbox = 0;
+		s_queuedTaskCount = 0;
+		s_shouldFinish = false;
+		s_sleepingThreadCount = 0;
+		s_workerCount = workerCount;
+		s_workers.reset(new Worker[workerCount]);
+
+		for (unsigned int i = 0; i < workerCount; ++i)
+		{
+			Worker& worker = s_workers[i];
+			worker.inboxSize = 0;
+			worker.index = i;
+		}
+
+		// Every worker has to be set up before the first one starts to steal tasks from the others
+		for (unsigned int i = 0; i < workerCount; ++i)
+			s_workers[i].thread = Thread(WorkerProc, &s_workers[i]);
+
+		return true;
+	}
+
+	bool TaskSchedulerImpl::IsInitialized()
+	{
+		return s_workerCount > 0;
+	}
+
+	void TaskSchedulerImpl::NotifyCompletion()
+	{
+		LockGuard lock(s_stateMutex);
+		s_stateChanged.SignalAll();
+	}
+
+	void TaskSchedulerImpl::Submit(Functor** tasks, std::size_t count)
+	{
+		if (count == 0)
+			return;
+
+		// Count the tasks before making them visible, so that the counter never goes below the real task count
+		s_queuedTaskCount.fetch_add(count);
+
+		if (Worker* worker = s_currentWorker)
+		{
+			// Nested submission from a task: the owner can push directly into its queue without locking
+			for (std::size_t i = 0; i < count; ++i)
+				worker->queue.Push(tasks[i]);
+		}
+		else
+		{
+			// External submission: split the tasks between the worker inboxes, starting from a different worker each time
+			std::size_t taskPerWorker = count / s_workerCount;
+			std::size_t remainingTasks = count % s_workerCount;
+			unsigned int firstWorker = s_nextInbox.fetch_add(1, std::memory_order_relaxed) % s_workerCount;
+
+			for (unsigned int i = 0; i < s_workerCount; ++i)
+			{
+				std::size_t taskCount = (i < remainingTasks) ? taskPerWorker + 1 : taskPerWorker;
+				if (taskCount == 0)
+					break;
+
+				Worker& target = s_workers[(firstWorker + i) % s_workerCount];
+
+				LockGuard lock(target.inboxMutex);
+				target.inbox.insert(target.inbox.end(), tasks, tasks + taskCount);
+				target.inboxSize.store(target.inbox.size(), std::memory_order_release);
+
+				tasks += taskCount;
+			}
+		}
+
+		// Only wake up sleeping threads if there are any, this pairs with the check made before sleeping
+		if (s_sleepingThreadCount.load() > 0)
+		{
+			LockGuard lock(s_stateMutex);
+			s_stateChanged.SignalAll();
+		}
+	}
+
+	bool TaskSchedulerImpl::TryRunTask()
+	{
+		Functor* task = FindTask(s_currentWorker);
+		if (!task)
+			return false;
+
+		RunTask(task);
+		return true;
+	}
+
+	void TaskSchedulerImpl::Uninitialize()
+	{
+		#ifdef NAZARA_CORE_SAFE
+		if (s_workerCount == 0)
+		{
+			NazaraError("Task scheduler is not initialized");
+			return;
+		}
+		#endif
+
+		// Wake up the workers so they can leave their loop and end
+		s_shouldFinish = true;
+		{
+			LockGuard lock(s_stateMutex);
+			s_stateChanged.SignalAll();
+		}
+
+		for (unsigned int i = 0; i < s_workerCount; ++i)
+			s_workers[i].thread.Join();
+
+		// Run the tasks left behind on this thread, so that no task group waits forever
+		while (TryRunTask());
+
+		s_workers.reset();
+		s_workerCount = 0;
+	}
+
+	void TaskSchedulerImpl::Wait(const std::atomic_size_t& pendingTaskCount)
+	{
+		while (pendingTaskCount.load(std::memory_order_acquire) > 0)
+		{
+			// Help the workers instead of sleeping while there is still work to do
+			if (TryRunTask())
+				continue;
+
+			LockGuard lock(s_stateMutex);
+			s_sleepingThreadCount++;
+
+			while (pendingTaskCount.load(std::memory_order_acquire) > 0 && s_queuedTaskCount.load() == 0)
+				s_stateChanged.Wait(&s_stateMutex);
+
+			s_sleepingThreadCount--;
+		}
+	}
+
+	Functor* TaskSchedulerImpl::FindTask(Worker* worker)
+	{
+		if (worker)
+		{
+			if (Functor* task = worker->queue.Pop())
+				return task;
+
+			// Move the tasks sent by other threads to our queue, so they can be stolen without locking
+			if (worker->inboxSize.load(std::memory_order_acquire) > 0)
+			{
+				worker->inboxMutex.Lock();
+				std::swap(worker->inbox, worker->inboxSwap);
+				worker->inboxSize.store(0, std::memory_order_relaxed);
+				worker->inboxMutex.Unlock();
+
+				for (Functor* task : worker->inboxSwap)
+					worker->queue.Push(task);
+
+				worker->inboxSwap.clear();
+
+				if (Functor* task = worker->queue.Pop())
+					return task;
+			}
+
+			return StealTask(worker->index + 1);
+		}
+		else
+			return StealTask(0);
+	}
+
+	void TaskSchedulerImpl::RunTask(Functor* task)
+	{
+		s_queuedTaskCount.fetch_sub(1);
+
+		task->Run();
+		delete task;
+	}
+
+	Functor* TaskSchedulerImpl::StealTask(unsigned int firstVictim)
+	{
+		for (unsigned int i = 0; i < s_workerCount; ++i)
+		{
+			Worker& victim = s_workers[(firstVictim + i) % s_workerCount];
+			if (&victim == s_currentWorker)
+				continue;
+
+			if (Functor* task = victim.queue.Steal())
+				return task;
+		}
+
+		// Queues are empty, but some tasks may not have been dispatched from the inboxes yet
+		for (unsigned int i = 0; i < s_workerCount; ++i)
+		{
+			Worker& victim = s_workers[(firstVictim + i) % s_workerCount];
+			if (&victim == s_currentWorker || victim.inboxSize.load(std::memory_order_acquire) == 0)
+				continue;
+
+			if (victim.inboxMutex.TryLock())
+			{
+				Functor* task = nullptr;
+				if (!victim.inbox.empty())
+				{
+					task = victim.inbox.back();
+					victim.inbox.pop_back();
+					victim.inboxSize.store(victim.inbox.size(), std::memory_order_release);
+				}
+				victim.inboxMutex.Unlock();
+
+				if (task)
+					return task;
+			}
+		}
+
+		return nullptr;
+	}
+
+	void TaskSchedulerImpl::WorkerProc(Worker* worker)
+	{
+		s_currentWorker = worker;
+
+		Thread::SetCurrentThreadName("NzWorker #" + String::Number(worker->index));
+
+		while (!s_shouldFinish)
+		{
+			if (Functor* task = FindTask(worker))
+			{
+				RunTask(task);
+				continue;
+			}
+
+			LockGuard lock(s_stateMutex);
+			s_sleepingThreadCount++;
+
+			while (s_queuedTaskCount.load() == 0 && !s_shouldFinish)
+				s_stateChanged.Wait(&s_stateMutex);
+
+			s_sleepingThreadCount--;
+		}
+
+		s_currentWorker = nullptr;
+	}
+
+	thread_local TaskSchedulerImpl::Worker* TaskSchedulerImpl::s_currentWorker = nullptr;
+	std::unique_ptr<TaskSchedulerImpl::Worker[]> TaskSchedulerImpl::s_workers;
+	std::atomic_bool TaskSchedulerImpl::s_shouldFinish;
+	std::atomic_size_t TaskSchedulerImpl::s_queuedTaskCount;
+	std::atomic_uint TaskSchedulerImpl::s_sleepingThreadCount;
+	std::atomic_uint TaskSchedulerImpl::s_nextInbox;
+	unsigned int TaskSchedulerImpl::s_workerCount;
+}
@@ -0,0 +1,55 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_TASKSCHEDULERIMPL_HPP
+#define NAZARA_TASKSCHEDULERIMPL_HPP
+
+#include <Nazara/Prerequisites.hpp>
+#include <atomic>
+#include <memory>
+
+namespace Nz
+{
+	struct Functor;
+
+	class TaskSchedulerImpl
+	{
+		public:
+			TaskSchedulerImpl() = delete;
+			~TaskSchedulerImpl() = delete;
+
+			static bool Initialize(unsigned int workerCount);
+			static bool IsInitialized();
+
+			static void NotifyCompletion();
+
+			static void Submit(Functor** tasks, std::size_t count);
+
+			static bool TryRunTask();
+
+			static void Uninitialize();
+
+			static void Wait(const std::atomic_size_t& pendingTaskCount);
+
+		private:
+			struct Worker;
+
+			static Functor* FindTask(Worker* worker);
+			static void RunTask(Functor* task);
+			static Functor* StealTask(unsigned int firstVictim);
+			static void WorkerProc(Worker* worker);
+
+			static thread_local Worker* s_currentWorker;
+			static std::unique_ptr<Worker[]> s_workers;
+			static std::atomic_bool s_shouldFinish;
+			static std::atomic_size_t s_queuedTaskCount;
+			static std::atomic_uint s_sleepingThreadCount;
+			static std::atomic_uint s_nextInbox;
+			static unsigned int s_workerCount;
+	};
+}
+
+#endif // NAZARA_TASKSCHEDULERIMPL_HPP
@@ -0,0 +1,88 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Win32/MappedFileImpl.hpp>
+#include <Nazara/Core/String.hpp>
+#include <limits>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	MappedFileImpl::MappedFileImpl() :
+	m_file(INVALID_HANDLE_VALUE),
+	m_mapping(nullptr),
+	m_data(nullptr),
+	m_size(0)
+	{
+	}
+
+	void MappedFileImpl::Close()
+	{
+		if (m_data)
+		{
+			UnmapViewOfFile(m_data);
+			m_data = nullptr;
+		}
+
+		if (m_mapping)
+		{
+			CloseHandle(m_mapping);
+			m_mapping = nullptr;
+		}
+
+		if (m_file != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(m_file);
+			m_file = INVALID_HANDLE_VALUE;
+		}
+
+		m_size = 0;
+	}
+
+	const UInt8* MappedFileImpl::GetData() const
+	{
+		return m_data;
+	}
+
+	UInt64 MappedFileImpl::GetSize() const
+	{
+		return m_size;
+	}
+
+	bool MappedFileImpl::Open(const String& filePath)
+	{
+		m_file = CreateFileW(filePath.GetWideString().data(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (m_file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(m_file, &fileSize) || static_cast<UInt64>(fileSize.QuadPart) > std::numeric_limits<std::size_t>::max())
+		{
+			Close();
+			return false;
+		}
+
+		m_size = static_cast<UInt64>(fileSize.QuadPart);
+
+		// Empty files cannot be mapped, they simply have no data
+		if (m_size > 0)
+		{
+			m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (!m_mapping)
+			{
+				Close();
+				return false;
+			}
+
+			m_data = static_cast<UInt8*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+			if (!m_data)
+			{
+				Close();
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,63 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_WORKSTEALINGQUEUE_HPP
+#define NAZARA_WORKSTEALINGQUEUE_HPP
+
+#include <Nazara/Prerequisites.hpp>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Nz
+{
+	struct Functor;
+
+	class WorkStealingQueue
+	{
+		public:
+			inline WorkStealingQueue(std::size_t capacity = 256);
+			WorkStealingQueue(const WorkStealingQueue&) = delete;
+			WorkStealingQueue(WorkStealingQueue&&) = delete;
+			~WorkStealingQueue() = default;
+
+			inline bool IsEmpty() const;
+
+			inline Functor* Pop();
+			inline void Push(Functor* task);
+
+			inline Functor* Steal();
+
+			WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+			WorkStealingQueue& operator=(WorkStealingQueue&&) = delete;
+
+		private:
+			struct Buffer
+			{
+				inline Buffer(std::size_t capacity);
+
+				inline Functor* Get(std::ptrdiff_t index) const;
+				inline void Put(std::ptrdiff_t index, Functor* task);
+
+				std::size_t mask;
+				std::unique_ptr<std::atomic<Functor*>[]> tasks;
+			};
+
+			inline Buffer* Grow(Buffer* buffer, std::ptrdiff_t top, std::ptrdiff_t bottom);
+
+			// Top is written by thieves while bottom is written by the owner, keep them on different cache lines
+			std::atomic<std::ptrdiff_t> m_top;
+			char m_padding[64 - sizeof(std::atomic<std::ptrdiff_t>)];
+			std::atomic<std::ptrdiff_t> m_bottom;
+			std::atomic<Buffer*> m_buffer;
+			std::vector<std::unique_ptr<Buffer>> m_buffers; //< Retired buffers may still be read by thieves, they're released with the queue
+	};
+}
+
+#include <Nazara/Core/WorkStealingQueue.inl>
+
+#endif // NAZARA_WORKSTEALINGQUEUE_HPP
@@ -0,0 +1,157 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/WorkStealingQueue.hpp>
+#include <cassert>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::WorkStealingQueue
+	* \brief Core class that represents a lock-free Chase-Lev deque of tasks
+	*
+	* The owner thread pushes and pops tasks at the bottom of the queue (LIFO) while any other thread may steal tasks from the top (FIFO).
+	*
+	* \remark Push and Pop must only be called by the owner thread, Steal can be called by any thread
+	*/
+
+	/*!
+	* \brief Constructs a WorkStealingQueue object with an initial capacity
+	*
+	* \param capacity Initial capacity of the queue, must be a power of two
+	*/
+	inline WorkStealingQueue::WorkStealingQueue(std::size_t capacity) :
+	m_top(0),
+	m_bottom(0)
+	{
+		assert(capacity > 0 && (capacity & (capacity - 1)) == 0);
+
+		m_buffers.emplace_back(std::make_unique<Buffer>(capacity));
+		m_buffer = m_buffers.back().get();
+	}
+
+	/*!
+	* \brief Checks whether the queue seems empty
+	* \return true if no task was found at the time of the call
+	*/
+	inline bool WorkStealingQueue::IsEmpty() const
+	{
+		std::ptrdiff_t bottom = m_bottom.load(std::memory_order_relaxed);
+		std::ptrdiff_t top = m_top.load(std::memory_order_relaxed);
+
+		return bottom <= top;
+	}
+
+	/*!
+	* \brief Pops the last pushed task
+	* \return Task or nullptr if the queue was empty
+	*
+	* \remark Must only be called by the owner thread
+	*/
+	inline Functor* WorkStealingQueue::Pop()
+	{
+		std::ptrdiff_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+		Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+		m_bottom.store(bottom, std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		std::ptrdiff_t top = m_top.load(std::memory_order_relaxed);
+		if (top > bottom)
+		{
+			// Queue was empty
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		Functor* task = buffer->Get(bottom);
+		if (top == bottom)
+		{
+			// Last task of the queue, we have to race with thieves for it
+			if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				task = nullptr;
+
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+
+		return task;
+	}
+
+	/*!
+	* \brief Pushes a task at the bottom of the queue, growing it if required
+	*
+	* \param task Task to push
+	*
+	* \remark Must only be called by the owner thread
+	*/
+	inline void WorkStealingQueue::Push(Functor* task)
+	{
+		std::ptrdiff_t bottom = m_bottom.load(std::memory_order_relaxed);
+		std::ptrdiff_t top = m_top.load(std::memory_order_acquire);
+		Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+
+		if (bottom - top > static_cast<std::ptrdiff_t>(buffer->mask))
+			buffer = Grow(buffer, top, bottom);
+
+		buffer->Put(bottom, task);
+
+		std::atomic_thread_fence(std::memory_order_release);
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+
+	/*!
+	* \brief Tries to steal the oldest task of the queue
+	* \return Task or nullptr if the queue was empty or if another thread took the task first
+	*/
+	inline Functor* WorkStealingQueue::Steal()
+	{
+		std::ptrdiff_t top = m_top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		std::ptrdiff_t bottom = m_bottom.load(std::memory_order_acquire);
+
+		if (top >= bottom)
+			return nullptr;
+
+		Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+		Functor* task = buffer->Get(top);
+		if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return nullptr;
+
+		return task;
+	}
+
+	inline auto WorkStealingQueue::Grow(Buffer* buffer, std::ptrdiff_t top, std::ptrdiff_t bottom) -> Buffer*
+	{
+		std::unique_ptr<Buffer> newBuffer = std::make_unique<Buffer>((buffer->mask + 1) * 2);
+		for (std::ptrdiff_t i = top; i < bottom; ++i)
+			newBuffer->Put(i, buffer->Get(i));
+
+		Buffer* newBufferPtr = newBuffer.get();
+		m_buffers.emplace_back(std::move(newBuffer));
+
+		m_buffer.store(newBufferPtr, std::memory_order_release);
+
+		return newBufferPtr;
+	}
+
+	inline WorkStealingQueue::Buffer::Buffer(std::size_t capacity) :
+	mask(capacity - 1),
+	tasks(new std::atomic<Functor*>[capacity])
+	{
+	}
+
+	inline Functor* WorkStealingQueue::Buffer::Get(std::ptrdiff_t index) const
+	{
+		return tasks[static_cast<std::size_t>(index) & mask].load(std::memory_order_relaxed);
+	}
+
+	inline void WorkStealingQueue::Buffer::Put(std::ptrdiff_t index, Functor* task)
+	{
+		tasks[static_cast<std::size_t>(index) & mask].store(task, std::memory_order_relaxed);
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -694,6 +694,10 @@ namespace Nz
 	* \brief Clears the queue
 	*
 	* \param fully Should everything be cleared or we can keep layers
+	*
+	* \remark This also removes every keyed entry
+	*
+	* \see ClearUnkeyedData
 	*/
 
 	void BasicRenderQueue::Clear(bool fully)
@@ -702,42 +706,112 @@ namespace Nz
 
 		basicSprites.Clear();
 		billboards.Clear();
+		customDrawables.Clear();
 		depthSortedBillboards.Clear();
 		depthSortedModels.Clear();
 		depthSortedSprites.Clear();
 		models.Clear();
 
-		m_pipelineCache.clear();
-		m_materialCache.clear();
-		m_overlayCache.clear();
-		m_shaderCache.clear();
-		m_textureCache.clear();
-		m_vertexBufferCache.clear();
-
 		m_billboards.clear();
 		m_renderLayers.clear();
+
+		for (Entry& entry : m_entries)
+			m_freeEntryQueues.emplace_back(std::move(entry.renderQueue));
+
+		m_entries.clear();
+		m_entryIndices.clear();
+		m_keyedDataSizes = KeyedDataSizes();
+		m_keyedDataInvalidated = false;
+		m_keyedLayers.clear();
+	}
+
+	/*!
+	* \brief Clears everything that was not added through an entry (lights and directly added render data), keeping the entries
+	*
+	* \see UpdateEntry
+	*/
+
+	void BasicRenderQueue::ClearUnkeyedData()
+	{
+		AbstractRenderQueue::Clear(false);
+
+		TruncateRenderData(basicSprites, m_keyedDataSizes.basicSprites);
+		TruncateRenderData(billboards, m_keyedDataSizes.billboards);
+		TruncateRenderData(customDrawables, m_keyedDataSizes.customDrawables);
+		TruncateRenderData(depthSortedBillboards, m_keyedDataSizes.depthSortedBillboards);
+		TruncateRenderData(depthSortedModels, m_keyedDataSizes.depthSortedModels);
+		TruncateRenderData(depthSortedSprites, m_keyedDataSizes.depthSortedSprites);
+		TruncateRenderData(models, m_keyedDataSizes.models);
+
+		m_billboards.resize(m_keyedDataSizes.billboardData);
+		m_renderLayers = m_keyedLayers;
+	}
+
+	/*!
+	* \brief Removes an entry from the queue
+	*
+	* \param key Key of the entry, does nothing if there's no entry with this key
+	*/
+
+	void BasicRenderQueue::RemoveEntry(const void* key)
+	{
+		auto it = m_entryIndices.find(key);
+		if (it != m_entryIndices.end())
+			RemoveEntryAt(it->second);
+	}
+
+	/*!
+	* \brief Removes every entry which was not updated since the last call to this function, and updates the rebuilt/reused entry counters
+	* \return Number of removed entries
+	*
+	* \see GetRebuiltEntryCount
+	* \see GetReusedEntryCount
+	* \see UpdateEntry
+	*/
+
+	std::size_t BasicRenderQueue::RemoveUnusedEntries()
+	{
+		std::size_t removedEntryCount = 0;
+		for (std::size_t i = 0; i < m_entries.size();)
+		{
+			if (m_entries[i].updateGeneration != m_entryGeneration)
+			{
+				RemoveEntryAt(i);
+				removedEntryCount++;
+			}
+			else
+				++i;
+		}
+
+		m_rebuiltEntryCount = m_rebuiltEntryCounter;
+		m_reusedEntryCount = m_reusedEntryCounter;
+		m_rebuiltEntryCounter = 0;
+		m_reusedEntryCounter = 0;
+
+		m_entryGeneration++;
+
+		return removedEntryCount;
 	}
 
 	/*!
 	* \brief Sorts the object according to the viewer position, furthest to nearest
 	*
-	* \param viewer Viewer of the scene
+	* \param viewer Viewer of the scene, can be null if there's no depth-sorted object to sort
 	*/
 
 	void BasicRenderQueue::Sort(const AbstractViewer* viewer)
 	{
-		m_layerCache.clear();
-		for (int layer : m_renderLayers)
-			m_layerCache.emplace(layer, m_layerCache.size());
+		if (m_keyedDataInvalidated)
+			RebuildKeyedData();
 
-		auto GetOrInsert = [](auto& container, auto&& value)
-		{
-			auto it = container.find(value);
-			if (it == container.end())
-				it = container.emplace(value, container.size()).first;
+		m_sortArena.Reset();
 
-			return it->second;
-		};
+		m_pipelineCache.Reset();
+		m_materialCache.Reset();
+		m_overlayCache.Reset();
+		m_shaderCache.Reset();
+		m_textureCache.Reset();
+		m_vertexBufferCache.Reset();
 
 		basicSprites.Sort([&](const SpriteChain& vertices)
 		{
@@ -751,12 +825,12 @@ namespace Nz
 			// - Scissor (4bits)
 			// - ??? (4bits)
 
-			UInt64 layerIndex = m_layerCache[vertices.layerIndex];
-			UInt64 pipelineIndex = GetOrInsert(m_pipelineCache, vertices.material->GetPipeline());
-			UInt64 materialIndex = GetOrInsert(m_materialCache, vertices.material);
-			UInt64 shaderIndex = GetOrInsert(m_shaderCache, vertices.material->GetShader());
-			UInt64 textureIndex = GetOrInsert(m_textureCache, vertices.material->GetDiffuseMap());
-			UInt64 overlayIndex = GetOrInsert(m_overlayCache, vertices.overlay);
+			UInt64 layerIndex = GetLayerId(vertices.layerIndex);
+			UInt64 pipelineIndex = m_pipelineCache.GetId(vertices.material->GetPipeline());
+			UInt64 materialIndex = m_materialCache.GetId(vertices.material);
+			UInt64 shaderIndex = m_shaderCache.GetId(vertices.material->GetShader());
+			UInt64 textureIndex = m_textureCache.GetId(vertices.material->GetDiffuseMap());
+			UInt64 overlayIndex = m_overlayCache.GetId(vertices.overlay);
 			UInt64 scissorIndex = 0; //< TODO
 
 			UInt64 index = (layerIndex    & 0xFFFF) << 48 |
@@ -768,7 +842,7 @@ namespace Nz
 			               (scissorIndex  & 0x0F)   << 4;
 
 			return index;
-		});
+		}, m_sortArena);
 		
 		billboards.Sort([&](const BillboardChain& billboard)
 		{
@@ -781,11 +855,11 @@ namespace Nz
 			// - Scissor (4bits)
 			// - ??? (12bits)
 
-			UInt64 layerIndex = m_layerCache[billboard.layerIndex];
-			UInt64 pipelineIndex = GetOrInsert(m_pipelineCache, billboard.material->GetPipeline());
-			UInt64 materialIndex = GetOrInsert(m_materialCache, billboard.material);
-			UInt64 shaderIndex = GetOrInsert(m_shaderCache, billboard.material->GetShader());
-			UInt64 textureIndex = GetOrInsert(m_textureCache, billboard.material->GetDiffuseMap());
+			UInt64 layerIndex = GetLayerId(billboard.layerIndex);
+			UInt64 pipelineIndex = m_pipelineCache.GetId(billboard.material->GetPipeline());
+			UInt64 materialIndex = m_materialCache.GetId(billboard.material);
+			UInt64 shaderIndex = m_shaderCache.GetId(billboard.material->GetShader());
+			UInt64 textureIndex = m_textureCache.GetId(billboard.material->GetDiffuseMap());
 			UInt64 unknownIndex = 0; //< ???
 			UInt64 scissorIndex = 0; //< TODO
 
@@ -798,20 +872,20 @@ namespace Nz
 			               (unknownIndex  & 0xFF)   <<  0;
 
 			return index;
-		});
+		}, m_sortArena);
 
 		customDrawables.Sort([&](const CustomDrawable& drawable)
 		{
 			// RQ index:
 			// - Layer (16bits)
 
-			UInt64 layerIndex = m_layerCache[drawable.layerIndex];
+			UInt64 layerIndex = GetLayerId(drawable.layerIndex);
 
 			UInt64 index = (layerIndex & 0xFFFF) << 48;
 
 			return index;
 
-		});
+		}, m_sortArena);
 
 		models.Sort([&](const Model& renderData)
 		{
@@ -825,12 +899,12 @@ namespace Nz
 			// - Scissor (4bits)
 			// - ??? (4bits)
 
-			UInt64 layerIndex = m_layerCache[renderData.layerIndex];
-			UInt64 pipelineIndex = GetOrInsert(m_pipelineCache, renderData.material->GetPipeline());
-			UInt64 materialIndex = GetOrInsert(m_materialCache, renderData.material);
-			UInt64 shaderIndex = GetOrInsert(m_shaderCache, renderData.material->GetShader());
-			UInt64 textureIndex = GetOrInsert(m_textureCache, renderData.material->GetDiffuseMap());
-			UInt64 bufferIndex = GetOrInsert(m_vertexBufferCache, renderData.meshData.vertexBuffer);
+			UInt64 layerIndex = GetLayerId(renderData.layerIndex);
+			UInt64 pipelineIndex = m_pipelineCache.GetId(renderData.material->GetPipeline());
+			UInt64 materialIndex = m_materialCache.GetId(renderData.material);
+			UInt64 shaderIndex = m_shaderCache.GetId(renderData.material->GetShader());
+			UInt64 textureIndex = m_textureCache.GetId(renderData.material->GetDiffuseMap());
+			UInt64 bufferIndex = m_vertexBufferCache.GetId(renderData.meshData.vertexBuffer);
 			UInt64 scissorIndex = 0; //< TODO
 			UInt64 depthIndex = 0; //< TODO
 
@@ -843,7 +917,7 @@ namespace Nz
 			               (scissorIndex  & 0x0F)   <<  4;
 
 			return index;
-		});
+		}, m_sortArena);
 
 		static_assert(std::numeric_limits<float>::is_iec559, "The following sorting functions relies on IEEE 754 floatings-points");
 
@@ -853,6 +927,10 @@ namespace Nz
 	#error The following code relies on native-endian IEEE-754 representation, which your platform does not guarantee
 #endif
 
+		// Depth-sorted objects can only be sorted relatively to a viewer
+		if (!viewer)
+			return;
+
 		Planef nearPlane = viewer->GetFrustum().GetPlane(FrustumPlane_Near);
 
 		depthSortedBillboards.Sort([&](const Billboard& billboard)
@@ -866,14 +944,14 @@ namespace Nz
 			// a negative distance may happen with billboard behind the camera which we don't care about since they'll not be rendered)
 			float depth = nearPlane.Distance(billboard.data.center);
 
-			UInt64 layerIndex = m_layerCache[billboard.layerIndex];
+			UInt64 layerIndex = GetLayerId(billboard.layerIndex);
 			UInt64 depthIndex = ~reinterpret_cast<UInt32&>(depth);
 
 			UInt64 index = (layerIndex & 0xFFFF)     << 48 |
 			               (depthIndex & 0xFFFFFFFF) << 16;
 
 			return index;
-		});
+		}, m_sortArena);
 
 		if (viewer->GetProjectionType() == ProjectionType_Orthogonal)
 		{
@@ -886,14 +964,14 @@ namespace Nz
 
 				float depth = nearPlane.Distance(model.obbSphere.GetPosition());
 
-				UInt64 layerIndex = m_layerCache[model.layerIndex];
+				UInt64 layerIndex = GetLayerId(model.layerIndex);
 				UInt64 depthIndex = ~reinterpret_cast<UInt32&>(depth);
 
 				UInt64 index = (layerIndex & 0xFFFF)     << 48 |
 				               (depthIndex & 0xFFFFFFFF) << 16;
 
 				return index;
-			});
+			}, m_sortArena);
 
 			depthSortedSprites.Sort([&](const SpriteChain& spriteChain)
 			{
@@ -904,14 +982,14 @@ namespace Nz
 
 				float depth = nearPlane.Distance(spriteChain.vertices[0].position);
 
-				UInt64 layerIndex = m_layerCache[spriteChain.layerIndex];
+				UInt64 layerIndex = GetLayerId(spriteChain.layerIndex);
 				UInt64 depthIndex = ~reinterpret_cast<UInt32&>(depth);
 
 				UInt64 index = (layerIndex & 0xFFFF)     << 48 |
 				               (depthIndex & 0xFFFFFFFF) << 16;
 
 				return index;
-			});
+			}, m_sortArena);
 		}
 		else
 		{
@@ -926,14 +1004,14 @@ namespace Nz
 
 				float depth = viewerPos.SquaredDistance(model.obbSphere.GetPosition());
 
-				UInt64 layerIndex = m_layerCache[model.layerIndex];
+				UInt64 layerIndex = GetLayerId(model.layerIndex);
 				UInt64 depthIndex = ~reinterpret_cast<UInt32&>(depth);
 
 				UInt64 index = (layerIndex & 0x0F)       << 48 |
 				               (depthIndex & 0xFFFFFFFF) << 16;
 
 				return index;
-			});
+			}, m_sortArena);
 
 			depthSortedSprites.Sort([&](const SpriteChain& sprites)
 			{
@@ -944,14 +1022,165 @@ namespace Nz
 
 				float depth = viewerPos.SquaredDistance(sprites.vertices[0].position);
 
-				UInt64 layerIndex = m_layerCache[sprites.layerIndex];
+				UInt64 layerIndex = GetLayerId(sprites.layerIndex);
 				UInt64 depthIndex = ~reinterpret_cast<UInt32&>(depth);
 
 				UInt64 index = (layerIndex & 0xFFFF)     << 48 |
 				               (depthIndex & 0xFFFFFFFF) << 16;
 
 				return index;
-			});
+			}, m_sortArena);
+		}
+	}
+
+	/*!
+	* \brief Updates an entry of the queue, identified by a key
+	* \return Queue to fill with the data of the entry if it needs to be (re)built, nullptr if the data of the entry can be kept
+	*
+	* Entries allow to keep render data between frames: they're only rebuilt when their revision changes, and every entry
+	* which is not updated between two calls to RemoveUnusedEntries is removed. Entry data is placed before unkeyed data
+	* (added directly to the queue) when sorting.
+	*
+	* \param key Key of the entry (for example, the object adding itself to the entry queue)
+	* \param revision Revision of the entry data, VolatileRevision means the entry has to be rebuilt every time
+	*
+	* \remark The returned queue is empty and has to be filled before the next sort, entry queues can be filled concurrently
+	* \remark Data added to the entry queue goes through BasicRenderQueue functions, even if this queue is of a derived type
+	*/
+
+	BasicRenderQueue* BasicRenderQueue::UpdateEntry(const void* key, UInt64 revision)
+	{
+		auto it = m_entryIndices.find(key);
+		if (it == m_entryIndices.end())
+		{
+			it = m_entryIndices.emplace(key, m_entries.size()).first;
+
+			m_entries.emplace_back();
+			Entry& newEntry = m_entries.back();
+			newEntry.key = key;
+
+			if (!m_freeEntryQueues.empty())
+			{
+				newEntry.renderQueue = std::move(m_freeEntryQueues.back());
+				m_freeEntryQueues.pop_back();
+			}
+			else
+				newEntry.renderQueue = std::make_unique<BasicRenderQueue>();
+		}
+		else
+		{
+			Entry& entry = m_entries[it->second];
+			if (entry.revision == revision && revision != VolatileRevision)
+			{
+				entry.updateGeneration = m_entryGeneration;
+				m_reusedEntryCounter++;
+
+				return nullptr;
+			}
 		}
+
+		Entry& entry = m_entries[it->second];
+		entry.renderQueue->Clear();
+		entry.revision = revision;
+		entry.updateGeneration = m_entryGeneration;
+
+		m_keyedDataInvalidated = true;
+		m_rebuiltEntryCounter++;
+
+		return entry.renderQueue.get();
 	}
+
+	void BasicRenderQueue::AppendRenderData(const BasicRenderQueue& renderQueue)
+	{
+		for (int layer : renderQueue.m_renderLayers)
+			RegisterLayer(layer);
+
+		std::size_t billboardOffset = m_billboards.size();
+		m_billboards.insert(m_billboards.end(), renderQueue.m_billboards.begin(), renderQueue.m_billboards.end());
+
+		basicSprites.Append(renderQueue.basicSprites);
+		billboards.Append(renderQueue.billboards, [billboardOffset](BillboardChain& billboardChain)
+		{
+			billboardChain.billboardIndex += billboardOffset;
+		});
+		customDrawables.Append(renderQueue.customDrawables);
+		depthSortedBillboards.Append(renderQueue.depthSortedBillboards);
+		depthSortedModels.Append(renderQueue.depthSortedModels);
+		depthSortedSprites.Append(renderQueue.depthSortedSprites);
+		models.Append(renderQueue.models);
+	}
+
+	void BasicRenderQueue::RebuildKeyedData()
+	{
+		// Move unkeyed data out of the way, rebuild the keyed part from the entries and put unkeyed data back after it
+		if (!m_unkeyedData)
+			m_unkeyedData = std::make_unique<BasicRenderQueue>();
+
+		BasicRenderQueue& unkeyedData = *m_unkeyedData;
+		unkeyedData.Clear();
+
+		MoveRenderData(basicSprites, m_keyedDataSizes.basicSprites, unkeyedData.basicSprites);
+		MoveRenderData(billboards, m_keyedDataSizes.billboards, unkeyedData.billboards);
+		MoveRenderData(customDrawables, m_keyedDataSizes.customDrawables, unkeyedData.customDrawables);
+		MoveRenderData(depthSortedBillboards, m_keyedDataSizes.depthSortedBillboards, unkeyedData.depthSortedBillboards);
+		MoveRenderData(depthSortedModels, m_keyedDataSizes.depthSortedModels, unkeyedData.depthSortedModels);
+		MoveRenderData(depthSortedSprites, m_keyedDataSizes.depthSortedSprites, unkeyedData.depthSortedSprites);
+		MoveRenderData(models, m_keyedDataSizes.models, unkeyedData.models);
+
+		unkeyedData.m_billboards.assign(m_billboards.begin() + m_keyedDataSizes.billboardData, m_billboards.end());
+		for (BillboardChain& billboardChain : unkeyedData.billboards.m_data)
+			billboardChain.billboardIndex -= m_keyedDataSizes.billboardData;
+
+		std::swap(unkeyedData.m_renderLayers, m_renderLayers); //< Keeps the capacity of both lists
+
+		basicSprites.Clear();
+		billboards.Clear();
+		customDrawables.Clear();
+		depthSortedBillboards.Clear();
+		depthSortedModels.Clear();
+		depthSortedSprites.Clear();
+		models.Clear();
+
+		m_billboards.clear();
+		m_renderLayers.clear();
+
+		for (const Entry& entry : m_entries)
+			AppendRenderData(*entry.renderQueue);
+
+		m_keyedDataSizes.basicSprites = basicSprites.m_data.size();
+		m_keyedDataSizes.billboards = billboards.m_data.size();
+		m_keyedDataSizes.billboardData = m_billboards.size();
+		m_keyedDataSizes.customDrawables = customDrawables.m_data.size();
+		m_keyedDataSizes.depthSortedBillboards = depthSortedBillboards.m_data.size();
+		m_keyedDataSizes.depthSortedModels = depthSortedModels.m_data.size();
+		m_keyedDataSizes.depthSortedSprites = depthSortedSprites.m_data.size();
+		m_keyedDataSizes.models = models.m_data.size();
+		m_keyedLayers = m_renderLayers;
+
+		AppendRenderData(unkeyedData);
+
+		m_keyedDataInvalidated = false;
+	}
+
+	void BasicRenderQueue::RemoveEntryAt(std::size_t entryIndex)
+	{
+		NazaraAssert(entryIndex < m_entries.size(), "Entry index out of range");
+
+		Entry& entry = m_entries[entryIndex];
+		m_entryIndices.erase(entry.key);
+		m_freeEntryQueues.emplace_back(std::move(entry.renderQueue));
+
+		// Swap with the last entry to keep the entry list packed
+		if (entryIndex != m_entries.size() - 1)
+		{
+			entry = std::move(m_entries.back());
+			m_entryIndices[entry.key] = entryIndex;
+		}
+
+		m_entries.pop_back();
+
+		m_keyedDataInvalidated = true;
+	}
+
+	constexpr UInt64 BasicRenderQueue::VolatileRevision;
 }
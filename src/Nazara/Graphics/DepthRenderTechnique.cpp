@@ -62,11 +62,13 @@ namespace Nz
 	* \brief Clears the data
 	*
 	* \param sceneData Data of the scene
+	*
+	* \remark The viewer of the scene data is optional
 	*/
 
 	void DepthRenderTechnique::Clear(const SceneData& sceneData) const
 	{
-		const RenderTarget* renderTarget = sceneData.viewer->GetTarget();
+		const RenderTarget* renderTarget = GetRenderTarget(sceneData);
 		Recti fullscreenScissorRect = Recti(Vector2i(renderTarget->GetSize()));
 
 		Renderer::SetScissorRect(fullscreenScissorRect);
@@ -91,26 +93,41 @@ namespace Nz
 	{
 		m_renderQueue.Sort(sceneData.viewer);
 
-		if (!m_renderQueue.models.empty())
-			DrawModels(sceneData, m_renderQueue, m_renderQueue.models);
+		return Draw(sceneData, m_renderQueue);
+	}
+
+	/*!
+	* \brief Draws an external render queue
+	* \return true If successful
+	*
+	* \param sceneData Data of the scene
+	* \param renderQueue Render queue to draw, which must already be sorted
+	*
+	* \remark This allows to keep render queues around (for example one per shadow map) and to draw them again without rebuilding them
+	*/
+
+	bool DepthRenderTechnique::Draw(const SceneData& sceneData, const BasicRenderQueue& renderQueue) const
+	{
+		if (!renderQueue.models.empty())
+			DrawModels(sceneData, renderQueue, renderQueue.models);
 
-		if (!m_renderQueue.basicSprites.empty())
-			DrawSprites(sceneData, m_renderQueue, m_renderQueue.basicSprites);
+		if (!renderQueue.basicSprites.empty())
+			DrawSprites(sceneData, renderQueue, renderQueue.basicSprites);
 
-		if (!m_renderQueue.billboards.empty())
-			DrawBillboards(sceneData, m_renderQueue, m_renderQueue.billboards);
+		if (!renderQueue.billboards.empty())
+			DrawBillboards(sceneData, renderQueue, renderQueue.billboards);
 
-		if (!m_renderQueue.depthSortedModels.empty())
-			DrawModels(sceneData, m_renderQueue, m_renderQueue.depthSortedModels);
+		if (!renderQueue.depthSortedModels.empty())
+			DrawModels(sceneData, renderQueue, renderQueue.depthSortedModels);
 
-		if (!m_renderQueue.depthSortedSprites.empty())
-			DrawSprites(sceneData, m_renderQueue, m_renderQueue.depthSortedSprites);
+		if (!renderQueue.depthSortedSprites.empty())
+			DrawSprites(sceneData, renderQueue, renderQueue.depthSortedSprites);
 
-		if (!m_renderQueue.depthSortedBillboards.empty())
-			DrawBillboards(sceneData, m_renderQueue, m_renderQueue.depthSortedBillboards);
+		if (!renderQueue.depthSortedBillboards.empty())
+			DrawBillboards(sceneData, renderQueue, renderQueue.depthSortedBillboards);
 
-		if (!m_renderQueue.customDrawables.empty())
-			DrawCustomDrawables(sceneData, m_renderQueue, m_renderQueue.customDrawables);
+		if (!renderQueue.customDrawables.empty())
+			DrawCustomDrawables(sceneData, renderQueue, renderQueue.customDrawables);
 
 		return true;
 	}
@@ -233,7 +250,7 @@ namespace Nz
 			}
 		};
 
-		const RenderTarget* renderTarget = sceneData.viewer->GetTarget();
+		const RenderTarget* renderTarget = GetRenderTarget(sceneData);
 		Recti fullscreenScissorRect = Recti(Vector2i(renderTarget->GetSize()));
 
 		const Material* lastMaterial = nullptr;
@@ -320,7 +337,7 @@ namespace Nz
 			}
 		};
 
-		const RenderTarget* renderTarget = sceneData.viewer->GetTarget();
+		const RenderTarget* renderTarget = GetRenderTarget(sceneData);
 		Recti fullscreenScissorRect = Recti(Vector2i(renderTarget->GetSize()));
 
 		const Material* lastMaterial = nullptr;
@@ -404,7 +421,7 @@ namespace Nz
 
 	void DepthRenderTechnique::DrawModels(const SceneData& sceneData, const BasicRenderQueue& renderQueue, const Nz::RenderQueue<Nz::BasicRenderQueue::Model>& models) const
 	{
-		const RenderTarget* renderTarget = sceneData.viewer->GetTarget();
+		const RenderTarget* renderTarget = GetRenderTarget(sceneData);
 		Recti fullscreenScissorRect = Recti(Vector2i(renderTarget->GetSize()));
 
 		const Material* lastMaterial = nullptr;
@@ -483,7 +500,7 @@ namespace Nz
 
 	void DepthRenderTechnique::DrawSprites(const SceneData& sceneData, const BasicRenderQueue& renderQueue, const RenderQueue<BasicRenderQueue::SpriteChain>& spriteList) const
 	{
-		const RenderTarget* renderTarget = sceneData.viewer->GetTarget();
+		const RenderTarget* renderTarget = GetRenderTarget(sceneData);
 		Recti fullscreenScissorRect = Recti(Vector2i(renderTarget->GetSize()));
 
 		const std::size_t maxSpriteCount = std::min<std::size_t>(s_maxQuadPerDraw, m_spriteBuffer.GetVertexCount() / 4);
@@ -631,6 +648,20 @@ namespace Nz
 		Draw();
 	}
 
+	/*!
+	* \brief Gets the render target of the scene
+	* \return The viewer target, or the current target if there is no viewer
+	*
+	* \param sceneData Data of the scene
+	*
+	* \remark Shadow maps are rendered without any viewer, in the current target
+	*/
+
+	const RenderTarget* DepthRenderTechnique::GetRenderTarget(const SceneData& sceneData)
+	{
+		return (sceneData.viewer) ? sceneData.viewer->GetTarget() : Renderer::GetTarget();
+	}
+
 	/*!
 	* \brief Gets the shader uniforms
 	* \return Uniforms of the shader
@@ -26,6 +26,18 @@ namespace Nz
 		OnInstancedRenderableRelease(this);
 	}
 
+	/*!
+	* \brief Checks whether AddToRenderQueue can be called from multiple threads at once (on different render queues and instance data)
+	* \return true by default
+	*
+	* \remark Renderables touching shared state or the renderer when adding themselves to a render queue should return false
+	*/
+
+	bool InstancedRenderable::CanBeQueuedConcurrently() const
+	{
+		return true;
+	}
+
 	/*!
 	* \brief Culls the instanced if not in the frustum
 	* \return true If instanced is in the frustum
@@ -3,16 +3,137 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Graphics/RenderQueue.hpp>
-#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Core/FrameArenaAllocator.hpp>
+#include <algorithm>
+#include <array>
+#include <climits>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
 {
-	void RenderQueueInternal::Sort()
+	namespace
 	{
-		std::sort(m_orderedRenderQueue.begin(), m_orderedRenderQueue.end(), [](const RenderDataPair& lhs, const RenderDataPair& rhs)
+		// Under this size, a comparison sort is faster than going through the histograms
+		constexpr std::size_t RadixSortThreshold = 256;
+
+		// Runs sorted by insertion before being merged
+		constexpr std::size_t InsertionSortRunSize = 16;
+
+		template<typename T>
+		void InsertionSort(T* first, T* last)
+		{
+			for (T* it = first; it != last; ++it)
+			{
+				T pair = *it;
+
+				T* hole = it;
+				for (; hole != first && pair.first < (hole - 1)->first; --hole)
+					*hole = *(hole - 1);
+
+				*hole = pair;
+			}
+		}
+
+		template<typename T>
+		T* MergeSort(T* source, T* destination, std::size_t count)
+		{
+			for (std::size_t first = 0; first < count; first += InsertionSortRunSize)
+				InsertionSort(source + first, source + std::min(first + InsertionSortRunSize, count));
+
+			for (std::size_t width = InsertionSortRunSize; width < count; width *= 2)
+			{
+				for (std::size_t first = 0; first < count; first += 2 * width)
+				{
+					std::size_t middle = std::min(first + width, count);
+					std::size_t last = std::min(first + 2 * width, count);
+
+					std::merge(source + first, source + middle, source + middle, source + last, destination + first, [](const T& lhs, const T& rhs)
+					{
+						return lhs.first < rhs.first;
+					});
+				}
+
+				std::swap(source, destination);
+			}
+
+			return source;
+		}
+
+		template<typename T>
+		T* RadixSort(T* source, T* destination, std::size_t count)
 		{
-			return lhs.first < rhs.first;
-		});
+			using Index = decltype(T::first);
+
+			constexpr unsigned int DigitBits = 8;
+			constexpr unsigned int DigitCount = sizeof(Index) * CHAR_BIT / DigitBits;
+			constexpr std::size_t BucketCount = 1 << DigitBits;
+			constexpr Index DigitMask = BucketCount - 1;
+
+			// Build the histograms of every digit in a single pass
+			std::array<std::array<std::size_t, BucketCount>, DigitCount> histograms = {};
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				for (unsigned int digit = 0; digit < DigitCount; ++digit)
+					histograms[digit][(source[i].first >> (digit * DigitBits)) & DigitMask]++;
+			}
+
+			for (unsigned int digit = 0; digit < DigitCount; ++digit)
+			{
+				unsigned int shift = digit * DigitBits;
+				std::array<std::size_t, BucketCount>& histogram = histograms[digit];
+
+				// Every index has the same digit, this pass wouldn't change anything
+				if (histogram[(source[0].first >> shift) & DigitMask] == count)
+					continue;
+
+				std::size_t offset = 0;
+				for (std::size_t& bucket : histogram)
+				{
+					std::size_t bucketSize = bucket;
+					bucket = offset;
+					offset += bucketSize;
+				}
+
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					const T& pair = source[i];
+					destination[histogram[(pair.first >> shift) & DigitMask]++] = pair;
+				}
+
+				std::swap(source, destination);
+			}
+
+			return source;
+		}
+	}
+
+	/*!
+	* \brief Sorts the render data pairs by their index
+	*
+	* Big queues are sorted using a least significant digit radix sort (one byte per pass), small ones using a merge sort of insertion-sorted runs, both being stable.
+	* Radix passes on bytes shared by every index (which is common, as some bits of the indices are unused) are skipped.
+	*
+	* \param scratchArena Arena providing the sort buffer
+	*/
+	void RenderQueueInternal::Sort(FrameArena& scratchArena)
+	{
+		std::size_t count = m_orderedRenderQueue.size();
+		if (count <= InsertionSortRunSize)
+		{
+			InsertionSort(m_orderedRenderQueue.data(), m_orderedRenderQueue.data() + count);
+			return;
+		}
+
+		// Being the latest allocation of the arena, the buffer goes back to it once the sort is done
+		std::vector<RenderDataPair, FrameArenaAllocator<RenderDataPair>> sortBuffer(count, scratchArena);
+
+		RenderDataPair* result;
+		if (count < RadixSortThreshold)
+			result = MergeSort(m_orderedRenderQueue.data(), sortBuffer.data(), count);
+		else
+			result = RadixSort(m_orderedRenderQueue.data(), sortBuffer.data(), count);
+
+		if (result != m_orderedRenderQueue.data())
+			std::copy(result, result + count, m_orderedRenderQueue.begin());
 	}
 }
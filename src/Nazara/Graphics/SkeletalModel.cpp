@@ -73,6 +73,16 @@ namespace Nz
 		}
 	}
 
+	/*!
+	* \brief Checks whether the skeletal model can be added to render queues from multiple threads at once
+	* \return false, skinning buffers are created and registered by the SkinningManager when the model is added to a render queue
+	*/
+
+	bool SkeletalModel::CanBeQueuedConcurrently() const
+	{
+		return false;
+	}
+
 	/*!
 	* \brief Updates the animation of the mesh
 	*
@@ -4,6 +4,9 @@
 
 #include <Nazara/Graphics/SkinningManager.hpp>
 #include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/FrameArena.hpp>
+#include <Nazara/Core/FrameArenaAllocator.hpp>
+#include <Nazara/Core/ParallelAlgorithm.hpp>
 #include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Utility/Algorithm.hpp>
 #include <Nazara/Utility/Joint.hpp>
@@ -11,6 +14,7 @@
 #include <Nazara/Utility/SkeletalMesh.hpp>
 #include <Nazara/Utility/Skeleton.hpp>
 #include <Nazara/Utility/VertexBuffer.hpp>
+#include <algorithm>
 #include <unordered_map>
 #include <Nazara/Graphics/Debug.hpp>
 
@@ -18,6 +22,8 @@ namespace Nz
 {
 	namespace
 	{
+		constexpr unsigned int SkinningGrainSize = 1024; //< Vertices skinned by a single task
+
 		struct BufferData
 		{
 			NazaraSlot(SkeletalMesh, OnSkeletalMeshDestroy, skeletalMeshDestroySlot);
@@ -43,64 +49,19 @@ namespace Nz
 			VertexBuffer* buffer;
 		};
 
+		struct SkinningChunk
+		{
+			std::size_t queueIndex;
+			unsigned int firstVertex;
+			unsigned int vertexCount;
+		};
+
 		using SkeletonMap = std::unordered_map<const Skeleton*, MeshData>;
 		SkeletonMap s_cache;
+		FrameArena s_frameArena; //< Transient skinning data, reset by every Skin call
 		std::vector<QueueData> s_skinningQueue;
 
-		/*!
-		* \brief Skins the mesh for a single thread context
-		*
-		* \param mesh Skeletal mesh to get vertex buffer from
-		* \param skeleton Skeleton to consider for getting data
-		* \param buffer Vertex buffer symbolizing the transition
-		*/
-
-		void Skin_MonoCPU(const SkeletalMesh* mesh, const Skeleton* skeleton, VertexBuffer* buffer)
-		{
-			BufferMapper<VertexBuffer> inputMapper(mesh->GetVertexBuffer(), BufferAccess_ReadOnly);
-			BufferMapper<VertexBuffer> outputMapper(buffer, BufferAccess_DiscardAndWrite);
-
-			SkinningData skinningData;
-			skinningData.inputVertex = static_cast<SkeletalMeshVertex*>(inputMapper.GetPointer());
-			skinningData.outputVertex = static_cast<MeshVertex*>(outputMapper.GetPointer());
-			skinningData.joints = skeleton->GetJoints();
-
-			SkinPositionNormalTangent(skinningData, 0, mesh->GetVertexCount());
-		}
-
-		/*!
-		* \brief Skins the mesh for a multi-threaded context
-		*
-		* \param mesh Skeletal mesh to get vertex buffer from
-		* \param skeleton Skeleton to consider for getting data
-		* \param buffer Vertex buffer symbolizing the transition
-		*/
-
-		void Skin_MultiCPU(const SkeletalMesh* mesh, const Skeleton* skeleton, VertexBuffer* buffer)
-		{
-			BufferMapper<VertexBuffer> inputMapper(mesh->GetVertexBuffer(), BufferAccess_ReadOnly);
-			BufferMapper<VertexBuffer> outputMapper(buffer, BufferAccess_DiscardAndWrite);
-
-			SkinningData skinningData;
-			skinningData.inputVertex = static_cast<SkeletalMeshVertex*>(inputMapper.GetPointer());
-			skinningData.outputVertex = static_cast<MeshVertex*>(outputMapper.GetPointer());
-			skinningData.joints = skeleton->GetJoints();
-
-			// To avoid different threads to update the same matrix at the same time
-			// We try to update them before launching the tasks
-			unsigned int jointCount = skeleton->GetJointCount();
-			for (unsigned int i = 0; i < jointCount; ++i)
-				skinningData.joints[i].EnsureSkinningMatrixUpdate();
-
-			unsigned int workerCount = TaskScheduler::GetWorkerCount();
-
-			std::ldiv_t div = std::ldiv(mesh->GetVertexCount(), workerCount);
-			for (unsigned int i = 0; i < workerCount; ++i)
-				TaskScheduler::AddTask(SkinPositionNormalTangent, skinningData, i*div.quot, (i == workerCount-1) ? div.quot + div.rem : div.quot);
-
-			TaskScheduler::Run();
-			TaskScheduler::WaitForTasks();
-		}
+		template<typename T> using FrameVector = std::vector<T, FrameArenaAllocator<T>>;
 	}
 
 	/*!
@@ -183,13 +144,102 @@ namespace Nz
 	}
 
 	/*!
-	* \brief Skins the skeletal mesh
+	* \brief Skins every queued skeletal mesh
+	*
+	* Joint palettes are computed once per skeleton, then all meshes are split in chunks skinned by a single parallel dispatch
 	*/
 
 	void SkinningManager::Skin()
 	{
-		for (QueueData& data : s_skinningQueue)
-			s_skinFunc(data.mesh, data.skeleton, data.buffer);
+		if (s_skinningQueue.empty())
+			return;
+
+		s_frameArena.Reset();
+
+		std::size_t jointCount = 0;
+		std::size_t chunkCount = 0;
+		for (const QueueData& data : s_skinningQueue)
+		{
+			jointCount += data.skeleton->GetJointCount();
+			chunkCount += (data.mesh->GetVertexCount() + SkinningGrainSize - 1) / SkinningGrainSize;
+		}
+
+		using PaletteOffsetMap = std::unordered_map<const Skeleton*, std::size_t, std::hash<const Skeleton*>, std::equal_to<const Skeleton*>, FrameArenaAllocator<std::pair<const Skeleton* const, std::size_t>>>;
+		PaletteOffsetMap paletteOffsets(s_skinningQueue.size(), std::hash<const Skeleton*>(), std::equal_to<const Skeleton*>(), s_frameArena);
+
+		FrameVector<Vector4f> palettes(s_frameArena);
+		palettes.reserve(jointCount * 3);
+
+		// Palettes are computed before launching the tasks, which also prevents different threads to update the same joint matrix
+		for (const QueueData& data : s_skinningQueue)
+		{
+			auto pair = paletteOffsets.emplace(data.skeleton, palettes.size());
+			if (pair.second)
+			{
+				unsigned int skeletonJointCount = data.skeleton->GetJointCount();
+				palettes.resize(palettes.size() + skeletonJointCount * 3);
+
+				ComputeSkinningPalette(data.skeleton->GetJoints(), skeletonJointCount, &palettes[pair.first->second]);
+			}
+		}
+
+		// A mesh shared by multiple skeletons is queued once per skeleton, but its buffer can only be mapped once
+		using InputVertexMap = std::unordered_map<const VertexBuffer*, const SkeletalMeshVertex*, std::hash<const VertexBuffer*>, std::equal_to<const VertexBuffer*>, FrameArenaAllocator<std::pair<const VertexBuffer* const, const SkeletalMeshVertex*>>>;
+		InputVertexMap inputVertices(s_skinningQueue.size(), std::hash<const VertexBuffer*>(), std::equal_to<const VertexBuffer*>(), s_frameArena);
+
+		FrameVector<SkinningChunk> skinningChunks(s_frameArena);
+		skinningChunks.reserve(chunkCount);
+
+		FrameVector<SkinningPaletteData> skinningData(s_frameArena);
+		skinningData.reserve(s_skinningQueue.size());
+
+		for (std::size_t i = 0; i < s_skinningQueue.size(); ++i)
+		{
+			const QueueData& data = s_skinningQueue[i];
+			const VertexBuffer* inputBuffer = data.mesh->GetVertexBuffer();
+
+			auto inputIt = inputVertices.find(inputBuffer);
+			if (inputIt == inputVertices.end())
+				inputIt = inputVertices.emplace(inputBuffer, static_cast<const SkeletalMeshVertex*>(inputBuffer->Map(BufferAccess_ReadOnly))).first;
+
+			SkinningPaletteData meshSkinningData;
+			meshSkinningData.inputVertex = inputIt->second;
+			meshSkinningData.outputVertex = static_cast<MeshVertex*>(data.buffer->Map(BufferAccess_DiscardAndWrite));
+			meshSkinningData.palette = &palettes[paletteOffsets[data.skeleton]];
+
+			skinningData.push_back(meshSkinningData);
+
+			if (!meshSkinningData.inputVertex || !meshSkinningData.outputVertex)
+			{
+				NazaraError("Failed to map skinning vertex buffers");
+				continue;
+			}
+
+			unsigned int vertexCount = data.mesh->GetVertexCount();
+			for (unsigned int firstVertex = 0; firstVertex < vertexCount; firstVertex += SkinningGrainSize)
+				skinningChunks.push_back(SkinningChunk{i, firstVertex, std::min(SkinningGrainSize, vertexCount - firstVertex)});
+		}
+
+		ParallelFor(std::size_t(0), skinningChunks.size(), 1, [&](std::size_t firstChunk, std::size_t lastChunk)
+		{
+			for (std::size_t i = firstChunk; i < lastChunk; ++i)
+			{
+				const SkinningChunk& chunk = skinningChunks[i];
+				SkinPositionNormalTangent(skinningData[chunk.queueIndex], chunk.firstVertex, chunk.vertexCount);
+			}
+		});
+
+		for (std::size_t i = 0; i < s_skinningQueue.size(); ++i)
+		{
+			if (skinningData[i].outputVertex)
+				s_skinningQueue[i].buffer->Unmap();
+		}
+
+		for (const auto& pair : inputVertices)
+		{
+			if (pair.second)
+				pair.first->Unmap();
+		}
 
 		s_skinningQueue.clear();
 	}
@@ -202,12 +252,9 @@ namespace Nz
 	bool SkinningManager::Initialize()
 	{
 		///TODO: GPU Skinning
-		if (TaskScheduler::Initialize())
-			s_skinFunc = Skin_MultiCPU;
-		else
-			s_skinFunc = Skin_MonoCPU;
+		TaskScheduler::Initialize(); // Skinning runs inline if it fails
 
-		return true; // Nothing particular to do
+		return true;
 	}
 
 	/*!
@@ -255,8 +302,7 @@ namespace Nz
 	void SkinningManager::Uninitialize()
 	{
 		s_cache.clear();
+		s_frameArena = FrameArena();
 		s_skinningQueue.clear();
 	}
-
-	SkinningManager::SkinFunction SkinningManager::s_skinFunc = nullptr;
 }
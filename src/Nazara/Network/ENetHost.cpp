@@ -311,9 +311,9 @@ namespace Nz
 
 	ENetPacketRef ENetHost::AllocatePacket(ENetPacketFlags flags)
 	{
-		ENetPacketRef enetPacket = m_packetPool.New<ENetPacket>();
+		ENetPacketRef enetPacket = m_packetPool->New<ENetPacket>();
 		enetPacket->flags = flags;
-		enetPacket->owner = &m_packetPool;
+		enetPacket->owner = m_packetPool.get();
 
 		return enetPacket;
 	}
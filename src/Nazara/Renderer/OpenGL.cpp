@@ -1181,6 +1181,12 @@ namespace Nz
 		// Shader_ImageLoadStore
 		s_openGLextensions[OpenGLExtension_Shader_ImageLoadStore] = (s_openglVersion >= 420 || IsSupported("GL_ARB_shader_image_load_store"));
 
+		// TextureCompression_bptc
+		s_openGLextensions[OpenGLExtension_TextureCompression_bptc] = (s_openglVersion >= 420 || IsSupported("GL_ARB_texture_compression_bptc"));
+
+		// TextureCompression_rgtc
+		s_openGLextensions[OpenGLExtension_TextureCompression_rgtc] = (s_openglVersion >= 300 || IsSupported("GL_ARB_texture_compression_rgtc"));
+
 		// TextureCompression_s3tc
 		s_openGLextensions[OpenGLExtension_TextureCompression_s3tc] = IsSupported("GL_EXT_texture_compression_s3tc");
 
@@ -1399,6 +1405,24 @@ namespace Nz
 				else
 					return false;
 
+			case PixelFormatType_BC4:
+				format->dataFormat = GL_RED;
+				format->dataType = GL_UNSIGNED_BYTE;
+				format->internalFormat = GL_COMPRESSED_RED_RGTC1;
+				return true;
+
+			case PixelFormatType_BC5:
+				format->dataFormat = GL_RG;
+				format->dataType = GL_UNSIGNED_BYTE;
+				format->internalFormat = GL_COMPRESSED_RG_RGTC2;
+				return true;
+
+			case PixelFormatType_BC7:
+				format->dataFormat = GL_RGBA;
+				format->dataType = GL_UNSIGNED_BYTE;
+				format->internalFormat = GL_COMPRESSED_RGBA_BPTC_UNORM;
+				return true;
+
 			case PixelFormatType_BGR8:
 				format->dataFormat = GL_BGR;
 				format->dataType = GL_UNSIGNED_BYTE;
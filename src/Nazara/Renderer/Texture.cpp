@@ -905,6 +905,13 @@ namespace Nz
 			case PixelFormatType_DXT5:
 				return OpenGL::IsSupported(OpenGLExtension_TextureCompression_s3tc);
 
+			case PixelFormatType_BC4:
+			case PixelFormatType_BC5:
+				return OpenGL::IsSupported(OpenGLExtension_TextureCompression_rgtc);
+
+			case PixelFormatType_BC7:
+				return OpenGL::IsSupported(OpenGLExtension_TextureCompression_bptc);
+
 			case PixelFormatType_Undefined:
 				break;
 		}
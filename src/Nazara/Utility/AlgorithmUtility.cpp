@@ -2,34 +2,23 @@
 // This file is part of the "Nazara Engine - Utility module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
-/*
- * vcacheopt.h - Vertex Cache Optimizer
- * Copyright 2009 Michael Georgoulpoulos <mgeorgoulopoulos at gmail>
- *
- * Permission is hereby granted, free of charge, to any person obtaining a copy
- * of this software and associated documentation files (the "Software"), to deal
- * in the Software without restriction, including without limitation the rights
- * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
- * copies of the Software, and to permit persons to whom the Software is
- * furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included in
- * all copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
- * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
- * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
- * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
- * THE SOFTWARE.
- */
-
 #include <Nazara/Utility/Algorithm.hpp>
 #include <Nazara/Utility/IndexIterator.hpp>
 #include <Nazara/Utility/Joint.hpp>
 #include <algorithm>
+#include <cstring>
+#include <limits>
 #include <unordered_map>
+#include <vector>
+
+#if defined(__AVX__)
+	#define NAZARA_UTILITY_SKINNING_AVX
+	#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define NAZARA_UTILITY_SKINNING_SSE
+	#include <emmintrin.h>
+#endif
+
 #include <Nazara/Utility/Debug.hpp>
 #include <Nazara/Utility/Mesh.hpp>
 #include <Nazara/Utility/SkeletalMesh.hpp>
@@ -168,468 +157,356 @@ namespace Nz
 				unsigned int m_vertexIndex;
 		};
 
-		// Source: https://code.google.com/p/vcacne/
-		// Auteur: Michael Georgoulpoulos
-		// Selon ce papier: http://home.comcast.net/~tom_forsyth/papers/fast_vert_cache_opt.html
-		// Modifié pour les besoins du moteur
-		///TODO: Déplacer dans un fichier à part ?
-		struct VertexCacheData
-		{
-			int position_in_cache = -1;
-			float current_score = 0.f;
-			int total_valence = 0; // toatl number of triangles using this vertex
-			int remaining_valence = 0; // number of triangles using it but not yet rendered
-			std::vector<int> tri_indices; // indices to the indices that use this vertex
-			bool calculated; // was the score calculated during this iteration?
+		// Vertex cache optimization, as described in "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw" (Sander, Nehab, Barczak)
+		// Every algorithm here runs in linear time and assumes a FIFO post-transform cache, as most GPUs have
 
+		constexpr UInt32 InvalidVertex = std::numeric_limits<UInt32>::max();
 
-			int FindTriangle(int tri)
-			{
-				for (unsigned int i = 0; i < tri_indices.size(); ++i)
-					if (tri_indices[i] == tri) return i;
+		std::vector<UInt32> ReadIndices(IndexIterator indices, unsigned int indexCount, unsigned int* vertexCount)
+		{
+			std::vector<UInt32> result(indexCount);
 
-				return -1;
+			UInt32 maxIndex = 0;
+			for (unsigned int i = 0; i < indexCount; ++i)
+			{
+				result[i] = *indices++;
+				maxIndex = std::max(maxIndex, result[i]);
 			}
 
-			void MoveTriangleToEnd(int tri)
-			{
-				auto it = std::find(tri_indices.begin(), tri_indices.end(), tri);
-				NazaraAssert(it != tri_indices.end(), "Triangle not found");
+			*vertexCount = (indexCount > 0) ? maxIndex + 1 : 0;
 
-				tri_indices.erase(it);
-				tri_indices.push_back(tri);
-			}
-		};
+			return result;
+		}
 
-		struct TriangleCacheData
+		void WriteIndices(IndexIterator indices, const std::vector<UInt32>& values)
 		{
-			bool rendered = false; // has the triangle been added to the draw list yet?
-			float current_score = 0.f; // sum of the score of its vertices
-			int verts[3] = {-1, -1, -1}; // indices to the triangle's vertices
-			bool calculated = false; // was the score calculated during this iteration?
-		};
+			for (UInt32 index : values)
+				*indices++ = index;
+		}
 
-		class VertexCache
+		class FifoVertexCache
 		{
 			public:
-				VertexCache()
+				FifoVertexCache(unsigned int vertexCount, unsigned int cacheSize) :
+				m_timestamps(vertexCount, 0),
+				m_cacheSize(cacheSize),
+				m_time(cacheSize + 1)
 				{
-					Clear();
 				}
 
-				VertexCache(IndexIterator indices, unsigned int indexCount)
+				// Returns true if the vertex wasn't in the cache (and had to be transformed)
+				bool AddVertex(UInt32 vertex)
 				{
-					Clear();
-
-					for (unsigned int i = 0; i < indexCount; ++i)
-						AddVertex(*indices++);
-				}
-
-				// the vertex will be placed on top
-				// if the vertex didn't exist previewsly in
-				// the cache, then miss count is incermented
-				void AddVertex(unsigned int v)
-				{
-					int w = FindVertex(v);
-					if (w >= 0)
-						// remove the vertex from the cache (to reinsert it later on the top)
-						RemoveVertex(w);
+					// A vertex is still in the cache as long as less than cacheSize vertices were added after it
+					if (m_time - m_timestamps[vertex] > m_cacheSize)
+					{
+						m_timestamps[vertex] = m_time++;
+						return true;
+					}
 					else
-						// the vertex was not found in the cache - increment misses
-						m_misses++;
-
-					// shift all vertices down (to make room for the new top vertex)
-					for (int i=39; i>0; i--)
-						m_cache[i] = m_cache[i-1];
-
-					// add the new vertex on top
-					m_cache[0] = v;
-				}
-
-				void Clear()
-				{
-					for (int i=0; i<40; i++)
-						m_cache[i] = -1;
-
-					m_misses = 0;
-				}
-
-				int GetMissCount() const
-				{
-					return m_misses;
+						return false;
 				}
 
-				int GetVertex(int which) const
+				unsigned int AddTriangle(const UInt32* triangle)
 				{
-					return m_cache[which];
-				}
-
-			private:
-				int FindVertex(int v) const
-				{
-					for (int i = 0; i < 32; ++i)
+					unsigned int missCount = 0;
+					for (unsigned int i = 0; i < 3; ++i)
 					{
-						if (m_cache[i] == v)
-							return i;
+						if (AddVertex(triangle[i]))
+							missCount++;
 					}
 
-					return -1;
+					return missCount;
 				}
 
-				void RemoveVertex(int stack_index)
+				void Clear()
 				{
-					for (int i=stack_index; i<38; i++)
-						m_cache[i] = m_cache[i+1];
+					m_time += m_cacheSize + 1;
 				}
 
-				int m_cache[40];
-				int m_misses; // cache miss count
+			private:
+				std::vector<UInt32> m_timestamps;
+				UInt32 m_cacheSize;
+				UInt32 m_time;
 		};
 
-		class VertexCacheOptimizer
+		std::vector<UInt32> Tipsify(const std::vector<UInt32>& indices, unsigned int vertexCount, unsigned int cacheSize)
 		{
-			public:
-				enum Result
-				{
-					Success,
-					Fail_BadIndex,
-					Fail_NoVerts
-				};
+			std::size_t triangleCount = indices.size() / 3;
 
-				VertexCacheOptimizer()
-				{
-					// initialize constants
-					m_cacheDecayPower = 1.5f;
-					m_lastTriScore = 0.75f;
-					m_valenceBoostScale = 2.0f;
-					m_valenceBoostPower = 0.5f;
+			// Triangles using each vertex, grouped with a counting sort
+			std::vector<UInt32> adjacencyOffsets(vertexCount + 1, 0);
+			for (std::size_t i = 0; i < triangleCount * 3; ++i)
+				adjacencyOffsets[indices[i] + 1]++;
 
-					m_bestTri = 0;
-				}
+			std::vector<UInt32> liveTriangles(vertexCount);
+			for (unsigned int i = 0; i < vertexCount; ++i)
+			{
+				liveTriangles[i] = adjacencyOffsets[i + 1];
+				adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+			}
 
-				// stores new indices in place
-				Result Optimize(IndexIterator indices, unsigned int indexCount)
-				{
-					if (indexCount == 0)
-						return Fail_NoVerts;
+			std::vector<UInt32> adjacency(triangleCount * 3);
+			{
+				std::vector<UInt32> cursors(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+				for (std::size_t i = 0; i < triangleCount * 3; ++i)
+					adjacency[cursors[indices[i]]++] = UInt32(i / 3);
+			}
 
-					// find vertex count
-					int max_vert = *std::max_element(indices, indices + indexCount);
+			std::vector<UInt32> cacheTimestamps(vertexCount, 0);
+			std::vector<UInt32> candidates;
+			std::vector<UInt32> deadEndStack;
+			std::vector<bool> emitted(triangleCount, false);
 
-					Result res = Init(indices, indexCount, max_vert + 1);
-					if (res != Success)
-						return res;
+			std::vector<UInt32> result;
+			result.reserve(indices.size());
 
-					// iterate until Iterate returns false
-					while (Iterate());
+			UInt32 time = cacheSize + 1;
+			unsigned int cursor = 0;
 
-					// rewrite optimized index list
-					for (int index : m_drawList)
-					{
-						*indices++ = m_triangles[index].verts[0];
-						*indices++ = m_triangles[index].verts[1];
-						*indices++ = m_triangles[index].verts[2];
-					}
+			// When no vertex of the last fan is worth fanning around, use the most recently used vertex having triangles left
+			// and if there is none, the next one in the input order
+			auto SkipDeadEnd = [&]() -> UInt32
+			{
+				while (!deadEndStack.empty())
+				{
+					UInt32 vertex = deadEndStack.back();
+					deadEndStack.pop_back();
 
-					return Success;
+					if (liveTriangles[vertex] > 0)
+						return vertex;
 				}
 
-			private:
-				float CalculateVertexScore(VertexCacheData& vertex) const
+				for (; cursor < vertexCount; ++cursor)
 				{
-					if (vertex.remaining_valence <= 0)
-						// No tri needs this vertex!
-						return -1.0f;
-
-					float ret = 0.0f;
-					if (vertex.position_in_cache < 0)
-					{
-						// Vertex is not in FIFO cache - no score.
-					}
-					else
-					{
-						if (vertex.position_in_cache < 3)
-						{
-							// This vertex was used in the last triangle,
-							// so it has a fixed score, whichever of the three
-							// it's in. Otherwise, you can get very different
-							// answers depending on whether you add
-							// the triangle 1,2,3 or 3,1,2 - which is silly.
-							ret = m_lastTriScore;
-						}
-						else
-						{
-							// Points for being high in the cache.
-							const float Scaler = 1.0f / (32  - 3);
-							ret = 1.0f - (vertex.position_in_cache - 3) * Scaler;
-							ret = std::pow(ret, m_cacheDecayPower);
-						}
-					}
-
-					// Bonus points for having a low number of tris still to
-					// use the vert, so we get rid of lone verts quickly.
-					float valence_boost = std::pow(static_cast<float>(vertex.remaining_valence), -m_valenceBoostPower);
-					ret += m_valenceBoostScale * valence_boost;
-
-					return ret;
+					if (liveTriangles[cursor] > 0)
+						return cursor;
 				}
 
-				// returns the index of the triangle with the highest score
-				// (or -1, if there aren't any active triangles)
-				int FullScoreRecalculation()
+				return InvalidVertex;
+			};
+
+			UInt32 fanningVertex = SkipDeadEnd();
+			while (fanningVertex != InvalidVertex)
+			{
+				// Emit every remaining triangle around the fanning vertex
+				candidates.clear();
+				for (UInt32 i = adjacencyOffsets[fanningVertex]; i < adjacencyOffsets[fanningVertex + 1]; ++i)
 				{
-					// calculate score for all vertices
-					for (VertexCacheData& vertex : m_vertices)
-						vertex.current_score = CalculateVertexScore(vertex);
+					UInt32 triangle = adjacency[i];
+					if (emitted[triangle])
+						continue;
 
-					// calculate scores for all active triangles
-					float max_score = std::numeric_limits<float>::lowest();
-					int max_score_tri = -1;
+					emitted[triangle] = true;
 
-					for (unsigned int i = 0; i < m_triangles.size(); ++i)
+					for (unsigned int j = 0; j < 3; ++j)
 					{
-						if (m_triangles[i].rendered)
-							continue;
-
-						// sum the score of all the triangle's vertices
-						float sc = m_vertices[m_triangles[i].verts[0]].current_score +
-								   m_vertices[m_triangles[i].verts[1]].current_score +
-								   m_vertices[m_triangles[i].verts[2]].current_score;
+						UInt32 vertex = indices[triangle * 3 + j];
+						result.push_back(vertex);
+						candidates.push_back(vertex);
+						deadEndStack.push_back(vertex);
 
-						m_triangles[i].current_score = sc;
+						liveTriangles[vertex]--;
 
-						if (sc > max_score)
-						{
-							max_score = sc;
-							max_score_tri = i;
-						}
+						if (time - cacheTimestamps[vertex] > cacheSize)
+							cacheTimestamps[vertex] = time++;
 					}
-
-					return max_score_tri;
 				}
 
-				Result InitialPass()
+				// Then pick the oldest vertex of that fan which will still be in the cache once its own fan is emitted
+				UInt32 bestVertex = InvalidVertex;
+				Int64 bestPriority = -1;
+				for (UInt32 vertex : candidates)
 				{
-					for (unsigned int i = 0; i < m_indices.size(); ++i)
-					{
-						int index = m_indices[i];
-						if (index < 0 || index >= static_cast<int>(m_vertices.size()))
-							return Fail_BadIndex;
-
-						m_vertices[index].total_valence++;
-						m_vertices[index].remaining_valence++;
+					if (liveTriangles[vertex] == 0)
+						continue;
 
-						m_vertices[index].tri_indices.push_back(i/3);
-					}
-
-					m_bestTri = FullScoreRecalculation();
+					Int64 priority = 0;
 
-					return Success;
-				}
+					UInt32 age = time - cacheTimestamps[vertex];
+					if (age + 2 * liveTriangles[vertex] <= cacheSize)
+						priority = age;
 
-				Result Init(IndexIterator indices, unsigned int indexCount, int vertex_count)
-				{
-					// clear the draw list
-					m_drawList.clear();
-
-					// allocate and initialize vertices and triangles
-					m_vertices.clear(); // Pour reconstruire tous les éléments
-					m_vertices.resize(vertex_count);
-
-					m_triangles.clear();
-					for (unsigned int i = 0; i < indexCount; i += 3)
+					if (priority > bestPriority)
 					{
-						TriangleCacheData dat;
-						for (unsigned int j = 0; j < 3; ++j)
-							dat.verts[j] = indices[i + j];
-
-						m_triangles.push_back(dat);
+						bestPriority = priority;
+						bestVertex = vertex;
 					}
-
-					// copy the indices
-					m_indices.resize(indexCount);
-					for (unsigned int i = 0; i < indexCount; ++i)
-						m_indices[i] = indices[i];
-
-					m_vertexCache.Clear();
-					m_bestTri = -1;
-
-					return InitialPass();
 				}
 
-				void AddTriangleToDrawList(int tri)
-				{
-					// reset all cache positions
-					for (unsigned int i = 0; i < 32; ++i)
-					{
-						int ind = m_vertexCache.GetVertex(i);
-						if (ind < 0)
-							continue;
-
-						m_vertices[ind].position_in_cache = -1;
-					}
-
-					TriangleCacheData* t = &m_triangles[tri];
-					if (t->rendered)
-						return; // triangle is already in the draw list
-
-					for (unsigned int i = 0; i < 3; ++i)
-					{
-						// add all triangle vertices to the cache
-						m_vertexCache.AddVertex(t->verts[i]);
+				fanningVertex = (bestVertex != InvalidVertex) ? bestVertex : SkipDeadEnd();
+			}
 
-						VertexCacheData *v = &m_vertices[t->verts[i]];
+			// Indices not forming a complete triangle are kept as is
+			result.insert(result.end(), indices.begin() + triangleCount * 3, indices.end());
 
-						// decrease remaining velence
-						v->remaining_valence--;
+			return result;
+		}
 
-						// move the added triangle to the end of the vertex's
-						// triangle index list, so that the first 'remaining_valence'
-						// triangles in the list are the active ones
-						v->MoveTriangleToEnd(tri);
-					}
+		#if defined(NAZARA_UTILITY_SKINNING_AVX) || defined(NAZARA_UTILITY_SKINNING_SSE)
+		// Vectors are loaded four floats at a time, the fourth one being the first component of the next vertex attribute (never read)
+		inline __m128 LoadVector3(const Vector3f& vector)
+		{
+			return _mm_loadu_ps(&vector.x);
+		}
 
-					m_drawList.push_back(tri);
+		inline __m128 NormalizeVector3(__m128 vector)
+		{
+			// The fourth component is always zero here
+			__m128 squared = _mm_mul_ps(vector, vector);
+			__m128 sum = _mm_add_ps(squared, _mm_shuffle_ps(squared, squared, _MM_SHUFFLE(2, 3, 0, 1)));
+			sum = _mm_add_ps(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 0, 3, 2)));
 
-					t->rendered = true;
+			return _mm_div_ps(vector, _mm_sqrt_ps(sum));
+		}
 
-					// update all vertex cache positions
-					for (unsigned int i = 0; i < 32; ++i)
-					{
-						int ind = m_vertexCache.GetVertex(i);
-						if (ind < 0)
-							continue;
+		inline void StoreVector3(Vector3f& vector, __m128 value)
+		{
+			_mm_storel_pi(reinterpret_cast<__m64*>(&vector.x), value);
+			_mm_store_ss(&vector.z, _mm_movehl_ps(value, value));
+		}
 
-						m_vertices[ind].position_in_cache = i;
-					}
-				}
+		inline __m128 TransformVector3(__m128 column0, __m128 column1, __m128 column2, __m128 vector)
+		{
+			__m128 result = _mm_mul_ps(column0, _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(0, 0, 0, 0)));
+			result = _mm_add_ps(result, _mm_mul_ps(column1, _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(1, 1, 1, 1))));
+			result = _mm_add_ps(result, _mm_mul_ps(column2, _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(2, 2, 2, 2))));
 
-				// Optimization: to avoid duplicate calculations durind the same iteration,
-				// both vertices and triangles have a 'calculated' flag. This flag
-				// must be cleared at the beginning of the iteration to all *active* triangles
-				// that have one or more of their vertices currently cached, and all their
-				// other vertices.
-				// If there aren't any active triangles in the cache, the function returns
-				// false and full recalculation is performed.
-				bool CleanCalculationFlags()
-				{
-					bool ret = false;
-					for (unsigned int i = 0; i < 32; ++i)
-					{
-						int vert = m_vertexCache.GetVertex(i);
-						if (vert < 0)
-							continue;
+			return result;
+		}
 
-						VertexCacheData *v = &m_vertices[vert];
+		void SkinVertex(const Vector4f* palette, const SkeletalMeshVertex& inputVertex, MeshVertex& outputVertex)
+		{
+			__m128 row0 = _mm_setzero_ps();
+			__m128 row1 = _mm_setzero_ps();
+			__m128 row2 = _mm_setzero_ps();
+			__m128 row3 = _mm_setzero_ps();
 
-						for (int j = 0; j < v->remaining_valence; j++)
-						{
-							TriangleCacheData *t = &m_triangles[v->tri_indices[j]];
+			for (int j = 0; j < inputVertex.weightCount; ++j)
+			{
+				const float* jointRows = &palette[inputVertex.jointIndexes[j] * 3].x;
+				__m128 weight = _mm_set1_ps(inputVertex.weights[j]);
 
-							// we actually found a triangle to process
-							ret = true;
+				row0 = _mm_add_ps(row0, _mm_mul_ps(_mm_loadu_ps(&jointRows[0]), weight));
+				row1 = _mm_add_ps(row1, _mm_mul_ps(_mm_loadu_ps(&jointRows[4]), weight));
+				row2 = _mm_add_ps(row2, _mm_mul_ps(_mm_loadu_ps(&jointRows[8]), weight));
+			}
 
-							// clear triangle flag
-							t->calculated = false;
+			// Rows become columns, the translation being the last one
+			_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
 
-							// clear vertex flags
-							for (unsigned int k = 0; k < 3; ++k)
-								m_vertices[t->verts[k]].calculated = false;
-						}
-					}
+			__m128 position = _mm_add_ps(TransformVector3(row0, row1, row2, LoadVector3(inputVertex.position)), row3);
+			__m128 normal = NormalizeVector3(TransformVector3(row0, row1, row2, LoadVector3(inputVertex.normal)));
+			__m128 tangent = NormalizeVector3(TransformVector3(row0, row1, row2, LoadVector3(inputVertex.tangent)));
 
-					return ret;
-				}
+			StoreVector3(outputVertex.position, position);
+			StoreVector3(outputVertex.normal, normal);
+			StoreVector3(outputVertex.tangent, tangent);
+			outputVertex.uv = inputVertex.uv;
+		}
+		#else
+		void SkinVertex(const Vector4f* palette, const SkeletalMeshVertex& inputVertex, MeshVertex& outputVertex)
+		{
+			Vector4f rows[3] = {Vector4f::Zero(), Vector4f::Zero(), Vector4f::Zero()};
+			for (int j = 0; j < inputVertex.weightCount; ++j)
+			{
+				const Vector4f* jointRows = &palette[inputVertex.jointIndexes[j] * 3];
+				for (unsigned int k = 0; k < 3; ++k)
+					rows[k] += jointRows[k] * inputVertex.weights[j];
+			}
 
-				void TriangleScoreRecalculation(int tri)
-				{
-					TriangleCacheData* t = &m_triangles[tri];
+			auto Transform = [&rows](const Vector3f& vector, float w)
+			{
+				Vector4f homogeneous(vector, w);
+				return Vector3f(rows[0].DotProduct(homogeneous), rows[1].DotProduct(homogeneous), rows[2].DotProduct(homogeneous));
+			};
+
+			outputVertex.position = Transform(inputVertex.position, 1.f);
+			outputVertex.normal = Transform(inputVertex.normal, 0.f).Normalize();
+			outputVertex.tangent = Transform(inputVertex.tangent, 0.f).Normalize();
+			outputVertex.uv = inputVertex.uv;
+		}
+		#endif
 
-					// calculate vertex scores
-					float sum = 0.f;
-					for (unsigned int i = 0; i < 3; ++i)
-					{
-						VertexCacheData& v = m_vertices[t->verts[i]];
-						float sc = v.current_score;
-						if (!v.calculated)
-							sc = CalculateVertexScore(v);
-
-						v.current_score = sc;
-						v.calculated = true;
-						sum += sc;
-					}
+		#ifdef NAZARA_UTILITY_SKINNING_AVX
+		inline __m256 LoadPair(const float* first, const float* second)
+		{
+			return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(first)), _mm_loadu_ps(second), 1);
+		}
 
-					t->current_score = sum;
-					t->calculated = true;
-				}
+		inline __m256 NormalizePair(__m256 vectors)
+		{
+			__m256 squared = _mm256_mul_ps(vectors, vectors);
+			__m256 sum = _mm256_add_ps(squared, _mm256_shuffle_ps(squared, squared, _MM_SHUFFLE(2, 3, 0, 1)));
+			sum = _mm256_add_ps(sum, _mm256_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 0, 3, 2)));
 
-				int PartialScoreRecalculation()
-				{
-					// iterate through all the vertices of the cache
-					float max_score = std::numeric_limits<float>::lowest();
-					int max_score_tri = -1;
+			return _mm256_div_ps(vectors, _mm256_sqrt_ps(sum));
+		}
 
-					for (unsigned int i = 0; i < 32; ++i)
-					{
-						int vert = m_vertexCache.GetVertex(i);
-						if (vert < 0)
-							continue;
+		inline void StorePair(Vector3f& first, Vector3f& second, __m256 values)
+		{
+			StoreVector3(first, _mm256_castps256_ps128(values));
+			StoreVector3(second, _mm256_extractf128_ps(values, 1));
+		}
 
-						const VertexCacheData* v = &m_vertices[vert];
+		inline __m256 TransformPair(__m256 column0, __m256 column1, __m256 column2, __m256 vectors)
+		{
+			__m256 result = _mm256_mul_ps(column0, _mm256_shuffle_ps(vectors, vectors, _MM_SHUFFLE(0, 0, 0, 0)));
+			result = _mm256_add_ps(result, _mm256_mul_ps(column1, _mm256_shuffle_ps(vectors, vectors, _MM_SHUFFLE(1, 1, 1, 1))));
+			result = _mm256_add_ps(result, _mm256_mul_ps(column2, _mm256_shuffle_ps(vectors, vectors, _MM_SHUFFLE(2, 2, 2, 2))));
 
-						// iterate through all *active* triangles of this vertex
-						for (int j = 0; j < v->remaining_valence; j++)
-						{
-							int tri = v->tri_indices[j];
-							TriangleCacheData* t = &m_triangles[tri];
-							if (!t->calculated)
-								// calculate triangle score
-								TriangleScoreRecalculation(tri);
-
-							float sc = t->current_score;
-
-							// we actually found a triangle to process
-							if (sc > max_score)
-							{
-								max_score = sc;
-								max_score_tri = tri;
-							}
-						}
-					}
+			return result;
+		}
 
-					return max_score_tri;
-				}
+		// Skins two vertices at once, each one using a 128 bits lane
+		void SkinVertexPair(const Vector4f* palette, const SkeletalMeshVertex* inputVertices, MeshVertex* outputVertices)
+		{
+			const SkeletalMeshVertex& first = inputVertices[0];
+			const SkeletalMeshVertex& second = inputVertices[1];
 
-				// returns true while there are more steps to take
-				// false when optimization is complete
-				bool Iterate()
-				{
-					if (m_drawList.size() == m_triangles.size())
-						return false;
+			__m256 row0 = _mm256_setzero_ps();
+			__m256 row1 = _mm256_setzero_ps();
+			__m256 row2 = _mm256_setzero_ps();
 
-					// add the selected triangle to the draw list
-					AddTriangleToDrawList(m_bestTri);
+			int weightCount = std::max(first.weightCount, second.weightCount);
+			for (int j = 0; j < weightCount; ++j)
+			{
+				// The vertex with fewer weights gets null weights on its first joint
+				bool firstValid = (j < first.weightCount);
+				bool secondValid = (j < second.weightCount);
 
-					// recalculate vertex and triangle scores and
-					// select the best triangle for the next iteration
-					m_bestTri = (CleanCalculationFlags()) ? PartialScoreRecalculation() : FullScoreRecalculation();
+				const float* firstRows = &palette[first.jointIndexes[(firstValid) ? j : 0] * 3].x;
+				const float* secondRows = &palette[second.jointIndexes[(secondValid) ? j : 0] * 3].x;
+				__m256 weight = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps((firstValid) ? first.weights[j] : 0.f)), _mm_set1_ps((secondValid) ? second.weights[j] : 0.f), 1);
 
-					return true;
-				}
+				row0 = _mm256_add_ps(row0, _mm256_mul_ps(LoadPair(&firstRows[0], &secondRows[0]), weight));
+				row1 = _mm256_add_ps(row1, _mm256_mul_ps(LoadPair(&firstRows[4], &secondRows[4]), weight));
+				row2 = _mm256_add_ps(row2, _mm256_mul_ps(LoadPair(&firstRows[8], &secondRows[8]), weight));
+			}
 
-				std::vector<VertexCacheData> m_vertices;
-				std::vector<TriangleCacheData> m_triangles;
-				std::vector<int> m_indices;
-				int m_bestTri; // the next triangle to add to the render list
-				VertexCache m_vertexCache;
-				std::vector<int> m_drawList;
-
-				// CalculateVertexScore constants
-				float m_cacheDecayPower;
-				float m_lastTriScore;
-				float m_valenceBoostScale;
-				float m_valenceBoostPower;
-		};
+			// Per-lane transposition, rows become columns (the translation being the last one)
+			__m256 zero = _mm256_setzero_ps();
+			__m256 rows01Low = _mm256_unpacklo_ps(row0, row1);
+			__m256 rows01High = _mm256_unpackhi_ps(row0, row1);
+			__m256 rows2zLow = _mm256_unpacklo_ps(row2, zero);
+			__m256 rows2zHigh = _mm256_unpackhi_ps(row2, zero);
+
+			__m256 column0 = _mm256_shuffle_ps(rows01Low, rows2zLow, _MM_SHUFFLE(1, 0, 1, 0));
+			__m256 column1 = _mm256_shuffle_ps(rows01Low, rows2zLow, _MM_SHUFFLE(3, 2, 3, 2));
+			__m256 column2 = _mm256_shuffle_ps(rows01High, rows2zHigh, _MM_SHUFFLE(1, 0, 1, 0));
+			__m256 column3 = _mm256_shuffle_ps(rows01High, rows2zHigh, _MM_SHUFFLE(3, 2, 3, 2));
+
+			__m256 position = _mm256_add_ps(TransformPair(column0, column1, column2, LoadPair(&first.position.x, &second.position.x)), column3);
+			__m256 normal = NormalizePair(TransformPair(column0, column1, column2, LoadPair(&first.normal.x, &second.normal.x)));
+			__m256 tangent = NormalizePair(TransformPair(column0, column1, column2, LoadPair(&first.tangent.x, &second.tangent.x)));
+
+			StorePair(outputVertices[0].position, outputVertices[1].position, position);
+			StorePair(outputVertices[0].normal, outputVertices[1].normal, normal);
+			StorePair(outputVertices[0].tangent, outputVertices[1].tangent, tangent);
+			outputVertices[0].uv = first.uv;
+			outputVertices[1].uv = second.uv;
+		}
+		#endif
 	}
 
 	/**********************************Compute**********************************/
@@ -667,10 +544,21 @@ namespace Nz
 			*vertexCount = xVertexCount*2 + yVertexCount*2 + zVertexCount*2;
 	}
 
-	unsigned int ComputeCacheMissCount(IndexIterator indices, unsigned int indexCount)
+	unsigned int ComputeCacheMissCount(IndexIterator indices, unsigned int indexCount, unsigned int cacheSize)
 	{
-		VertexCache cache(indices, indexCount);
-		return cache.GetMissCount();
+		unsigned int vertexCount;
+		std::vector<UInt32> sourceIndices = ReadIndices(indices, indexCount, &vertexCount);
+
+		FifoVertexCache cache(vertexCount, cacheSize);
+
+		unsigned int missCount = 0;
+		for (UInt32 index : sourceIndices)
+		{
+			if (cache.AddVertex(index))
+				missCount++;
+		}
+
+		return missCount;
 	}
 
 	void ComputeConeIndexVertexCount(unsigned int subdivision, unsigned int* indexCount, unsigned int* vertexCount)
@@ -720,6 +608,19 @@ namespace Nz
 			*vertexCount = horizontalVertexCount*verticalVertexCount;
 	}
 
+	void ComputeSkinningPalette(const Joint* joints, unsigned int jointCount, Vector4f* palette)
+	{
+		// Each joint gets the first three rows of its skinning matrix (as in Matrix4::Transform), the last one being always (0, 0, 0, 1)
+		for (unsigned int i = 0; i < jointCount; ++i)
+		{
+			const Matrix4f& matrix = joints[i].GetSkinningMatrix();
+
+			*palette++ = Vector4f(matrix.m11, matrix.m21, matrix.m31, matrix.m41);
+			*palette++ = Vector4f(matrix.m12, matrix.m22, matrix.m32, matrix.m42);
+			*palette++ = Vector4f(matrix.m13, matrix.m23, matrix.m33, matrix.m43);
+		}
+	}
+
 	void ComputeUvSphereIndexVertexCount(unsigned int sliceCount, unsigned int stackCount, unsigned int* indexCount, unsigned int* vertexCount)
 	{
 		if (indexCount)
@@ -1047,11 +948,156 @@ namespace Nz
 
 	/**********************************Optimize*********************************/
 
-	void OptimizeIndices(IndexIterator indices, unsigned int indexCount)
+	void OptimizeIndices(IndexIterator indices, unsigned int indexCount, unsigned int cacheSize)
 	{
-		VertexCacheOptimizer optimizer;
-		if (optimizer.Optimize(indices, indexCount) != VertexCacheOptimizer::Success)
-			NazaraWarning("Indices optimizer failed");
+		unsigned int vertexCount;
+		std::vector<UInt32> sourceIndices = ReadIndices(indices, indexCount, &vertexCount);
+
+		WriteIndices(indices, Tipsify(sourceIndices, vertexCount, cacheSize));
+	}
+
+	void OptimizeOverdraw(IndexIterator indices, unsigned int indexCount, SparsePtr<const Vector3f> positionPtr, unsigned int cacheSize, float threshold)
+	{
+		unsigned int vertexCount;
+		std::vector<UInt32> sourceIndices = ReadIndices(indices, indexCount, &vertexCount);
+
+		unsigned int triangleCount = indexCount / 3;
+		if (triangleCount == 0)
+			return;
+
+		// The triangle order (expected to be optimized for the vertex cache) is first split where the cache gets flushed
+		FifoVertexCache cache(vertexCount, cacheSize);
+
+		std::vector<unsigned int> hardBoundaries;
+		for (unsigned int i = 0; i < triangleCount; ++i)
+		{
+			if (cache.AddTriangle(&sourceIndices[i * 3]) == 3 || i == 0)
+				hardBoundaries.push_back(i);
+		}
+		hardBoundaries.push_back(triangleCount);
+
+		// Then each of these parts is split into the smallest clusters whose cache efficiency stays close to the one of the whole part
+		std::vector<unsigned int> clusters;
+		for (std::size_t i = 0; i < hardBoundaries.size() - 1; ++i)
+		{
+			unsigned int start = hardBoundaries[i];
+			unsigned int end = hardBoundaries[i + 1];
+
+			cache.Clear();
+
+			unsigned int partMissCount = 0;
+			for (unsigned int j = start; j < end; ++j)
+				partMissCount += cache.AddTriangle(&sourceIndices[j * 3]);
+
+			float clusterThreshold = threshold * partMissCount / (end - start);
+
+			cache.Clear();
+			clusters.push_back(start);
+
+			unsigned int clusterStart = start;
+			unsigned int missCount = 0;
+			for (unsigned int j = start; j < end - 1; ++j)
+			{
+				missCount += cache.AddTriangle(&sourceIndices[j * 3]);
+
+				if (missCount <= clusterThreshold * (j + 1 - clusterStart))
+				{
+					cache.Clear();
+					clusters.push_back(j + 1);
+
+					clusterStart = j + 1;
+					missCount = 0;
+				}
+			}
+		}
+		clusters.push_back(triangleCount);
+
+		// Clusters facing away from the mesh center are more likely to occlude others, and are drawn first
+		Vector3f meshCentroid = Vector3f::Zero();
+		for (unsigned int i = 0; i < triangleCount * 3; ++i)
+			meshCentroid += positionPtr[sourceIndices[i]];
+
+		meshCentroid /= float(triangleCount * 3);
+
+		struct ClusterSortData
+		{
+			float sortKey;
+			unsigned int cluster;
+		};
+
+		std::vector<ClusterSortData> clusterSortData(clusters.size() - 1);
+		for (std::size_t i = 0; i < clusters.size() - 1; ++i)
+		{
+			Vector3f centroid = Vector3f::Zero();
+			Vector3f normal = Vector3f::Zero();
+			float area = 0.f;
+
+			for (unsigned int j = clusters[i]; j < clusters[i + 1]; ++j)
+			{
+				const Vector3f& a = positionPtr[sourceIndices[j * 3 + 0]];
+				const Vector3f& b = positionPtr[sourceIndices[j * 3 + 1]];
+				const Vector3f& c = positionPtr[sourceIndices[j * 3 + 2]];
+
+				Vector3f triangleNormal = Vector3f::CrossProduct(b - a, c - a);
+				float triangleArea = triangleNormal.GetLength();
+
+				centroid += (a + b + c) * (triangleArea / 3.f);
+				normal += triangleNormal;
+				area += triangleArea;
+			}
+
+			float sortKey = 0.f;
+
+			float normalLength = normal.GetLength();
+			if (area > 0.f && normalLength > 0.f)
+				sortKey = Vector3f::DotProduct(centroid / area - meshCentroid, normal / normalLength);
+
+			clusterSortData[i] = {sortKey, static_cast<unsigned int>(i)};
+		}
+
+		std::stable_sort(clusterSortData.begin(), clusterSortData.end(), [](const ClusterSortData& lhs, const ClusterSortData& rhs)
+		{
+			return lhs.sortKey > rhs.sortKey;
+		});
+
+		for (const ClusterSortData& sortData : clusterSortData)
+		{
+			for (unsigned int i = clusters[sortData.cluster] * 3; i < clusters[sortData.cluster + 1] * 3; ++i)
+				*indices++ = sourceIndices[i];
+		}
+	}
+
+	void OptimizeVertexFetch(IndexIterator indices, unsigned int indexCount, void* vertices, std::size_t vertexStride, unsigned int vertexCount)
+	{
+		// Vertices are renumbered in the order of their first use, unused ones are moved at the end
+		// Vertices are moved in place, any other index list referencing them becomes invalid
+		std::vector<UInt32> remap(vertexCount, InvalidVertex);
+		UInt32 nextVertex = 0;
+
+		for (unsigned int i = 0; i < indexCount; ++i)
+		{
+			IndexIterator::Reference index = *indices++;
+
+			UInt32 vertex = index;
+			NazaraAssert(vertex < vertexCount, "Index out of range");
+
+			if (remap[vertex] == InvalidVertex)
+				remap[vertex] = nextVertex++;
+
+			index = remap[vertex];
+		}
+
+		for (UInt32& newVertex : remap)
+		{
+			if (newVertex == InvalidVertex)
+				newVertex = nextVertex++;
+		}
+
+		UInt8* vertexData = static_cast<UInt8*>(vertices);
+		std::vector<UInt8> sourceVertices(vertexData, vertexData + vertexCount * vertexStride);
+
+		for (unsigned int i = 0; i < vertexCount; ++i)
+			std::memcpy(&vertexData[remap[i] * vertexStride], &sourceVertices[i * vertexStride], vertexStride);
 	}
 
 	/************************************Skin***********************************/
@@ -1148,6 +1194,22 @@ namespace Nz
 		}
 	}
 
+	void SkinPositionNormalTangent(const SkinningPaletteData& skinningInfos, unsigned int startVertex, unsigned int vertexCount)
+	{
+		const SkeletalMeshVertex* inputVertex = &skinningInfos.inputVertex[startVertex];
+		MeshVertex* outputVertex = &skinningInfos.outputVertex[startVertex];
+
+		unsigned int i = 0;
+
+		#ifdef NAZARA_UTILITY_SKINNING_AVX
+		for (; i + 1 < vertexCount; i += 2)
+			SkinVertexPair(skinningInfos.palette, &inputVertex[i], &outputVertex[i]);
+		#endif
+
+		for (; i < vertexCount; ++i)
+			SkinVertex(skinningInfos.palette, inputVertex[i], outputVertex[i]);
+	}
+
 	/*********************************Transform*********************************/
 
 	void TransformVertices(VertexPointers vertexPointers, unsigned int vertexCount, const Matrix4f& matrix)
@@ -115,7 +115,7 @@ namespace Nz
 
 
 				if (parameters.loadFormat != PixelFormatType_Undefined)
-					image->Convert(parameters.loadFormat);
+					image->Convert(parameters.loadFormat, parameters.compressionQuality);
 
 				return image;
 			}
@@ -199,7 +199,17 @@ namespace Nz
 							break;
 
 						case D3DFMT_DXT5:
-							*format = PixelFormatType_DXT3;
+							*format = PixelFormatType_DXT5;
+							break;
+
+						case D3DFMT_ATI1:
+						case D3DFMT_BC4U:
+							*format = PixelFormatType_BC4;
+							break;
+
+						case D3DFMT_ATI2:
+						case D3DFMT_BC5U:
+							*format = PixelFormatType_BC5;
 							break;
 
 						case D3DFMT_DX10:
@@ -232,6 +242,30 @@ namespace Nz
 								case DXGI_FORMAT_R16G16B16A16_UNORM:
 									*format = PixelFormatType_RGBA16UI;
 									break;
+								case DXGI_FORMAT_R8G8B8A8_UNORM:
+									*format = PixelFormatType_RGBA8;
+									break;
+								case DXGI_FORMAT_BC1_UNORM:
+									*format = PixelFormatType_DXT1;
+									break;
+								case DXGI_FORMAT_BC2_UNORM:
+									*format = PixelFormatType_DXT3;
+									break;
+								case DXGI_FORMAT_BC3_UNORM:
+									*format = PixelFormatType_DXT5;
+									break;
+								case DXGI_FORMAT_BC4_UNORM:
+									*format = PixelFormatType_BC4;
+									break;
+								case DXGI_FORMAT_BC5_UNORM:
+									*format = PixelFormatType_BC5;
+									break;
+								case DXGI_FORMAT_BC7_UNORM:
+									*format = PixelFormatType_BC7;
+									break;
+								default:
+									NazaraError("Unhandled DXGI format 0x" + String::Number(headerExt.dxgiFormat, 16));
+									return false;
 							}
 							break;
 						}
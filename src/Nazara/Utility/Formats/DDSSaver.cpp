@@ -0,0 +1,193 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/Formats/DDSSaver.hpp>
+#include <Nazara/Core/ByteStream.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Utility/Image.hpp>
+#include <Nazara/Utility/PixelFormat.hpp>
+#include <Nazara/Utility/Formats/DDSConstants.hpp>
+#include <cstring>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		bool IsSupported(const String& extension)
+		{
+			return (extension == "dds");
+		}
+
+		// Compressed formats are written as is, other formats are converted to RGBA8
+		bool IdentifyFormat(PixelFormatType format, DDSPixelFormat* pixelFormat, DXGI_FORMAT* dxgiFormat)
+		{
+			std::memset(pixelFormat, 0, sizeof(DDSPixelFormat));
+			pixelFormat->size = sizeof(DDSPixelFormat);
+			pixelFormat->flags = DDPF_FOURCC;
+
+			*dxgiFormat = DXGI_FORMAT_UNKNOWN;
+
+			switch (format)
+			{
+				case PixelFormatType_BC4:
+					pixelFormat->fourCC = D3DFMT_ATI1;
+					return true;
+
+				case PixelFormatType_BC5:
+					pixelFormat->fourCC = D3DFMT_ATI2;
+					return true;
+
+				case PixelFormatType_DXT1:
+					pixelFormat->fourCC = D3DFMT_DXT1;
+					return true;
+
+				case PixelFormatType_DXT3:
+					pixelFormat->fourCC = D3DFMT_DXT3;
+					return true;
+
+				case PixelFormatType_DXT5:
+					pixelFormat->fourCC = D3DFMT_DXT5;
+					return true;
+
+				// Formats without a FourCC code are described by the DX10 extended header
+				case PixelFormatType_BC7:
+					pixelFormat->fourCC = D3DFMT_DX10;
+					*dxgiFormat = DXGI_FORMAT_BC7_UNORM;
+					return true;
+
+				case PixelFormatType_RGBA8:
+					pixelFormat->fourCC = D3DFMT_DX10;
+					*dxgiFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
+					return true;
+
+				default:
+					return false;
+			}
+		}
+
+		bool SaveToStream(const Image& image, const String& format, Stream& stream, const ImageParams& parameters)
+		{
+			NazaraUnused(format);
+			NazaraUnused(parameters);
+
+			if (!image.IsValid())
+			{
+				NazaraError("Invalid image");
+				return false;
+			}
+
+			ImageType type = image.GetType();
+			if (type != ImageType_1D && type != ImageType_2D && type != ImageType_3D)
+			{
+				NazaraError("Image type 0x" + String::Number(type, 16) + " is not in a supported format");
+				return false;
+			}
+
+			Image tempImage(image); //< We're using COW here to prevent Image copy unless required
+
+			DDSPixelFormat pixelFormat;
+			DXGI_FORMAT dxgiFormat;
+			if (!IdentifyFormat(tempImage.GetFormat(), &pixelFormat, &dxgiFormat))
+			{
+				if (!tempImage.Convert(PixelFormatType_RGBA8))
+				{
+					NazaraError("Failed to convert image to suitable format");
+					return false;
+				}
+
+				IdentifyFormat(PixelFormatType_RGBA8, &pixelFormat, &dxgiFormat);
+			}
+
+			PixelFormatType pixelFormatType = tempImage.GetFormat();
+			bool compressed = PixelFormat::IsCompressed(pixelFormatType);
+			unsigned int width = tempImage.GetWidth();
+			unsigned int height = tempImage.GetHeight();
+			unsigned int depth = tempImage.GetDepth();
+			UInt8 levelCount = tempImage.GetLevelCount();
+
+			DDSHeader header;
+			std::memset(&header, 0, sizeof(DDSHeader));
+			header.size = sizeof(DDSHeader);
+			header.flags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | ((compressed) ? DDSD_LINEARSIZE : DDSD_PITCH);
+			header.width = width;
+			header.height = height;
+			header.pitch = static_cast<UInt32>((compressed) ? PixelFormat::ComputeSize(pixelFormatType, width, height, 1) : PixelFormat::ComputeSize(pixelFormatType, width, 1, 1));
+			header.levelCount = levelCount;
+			header.format = pixelFormat;
+			header.ddsCaps[0] = DDSCAPS_TEXTURE;
+
+			if (levelCount > 1)
+			{
+				header.flags |= DDSD_MIPMAPCOUNT;
+				header.ddsCaps[0] |= DDSCAPS_COMPLEX | DDSCAPS_MIPMAP;
+			}
+
+			if (type == ImageType_3D)
+			{
+				header.flags |= DDSD_DEPTH;
+				header.depth = depth;
+				header.ddsCaps[0] |= DDSCAPS_COMPLEX;
+				header.ddsCaps[1] |= DDSCAPS2_VOLUME;
+			}
+
+			ByteStream byteStream(&stream);
+			byteStream.SetDataEndianness(Endianness_LittleEndian);
+
+			byteStream << DDS_Magic << header;
+
+			if (pixelFormat.fourCC == D3DFMT_DX10)
+			{
+				DDSHeaderDX10Ext headerDX10;
+				headerDX10.dxgiFormat = dxgiFormat;
+				headerDX10.miscFlag = 0;
+				headerDX10.arraySize = 1;
+				headerDX10.reserved = 0;
+
+				switch (type)
+				{
+					case ImageType_1D:
+						headerDX10.resourceDimension = D3D10_RESOURCE_DIMENSION_TEXTURE1D;
+						break;
+
+					case ImageType_3D:
+						headerDX10.resourceDimension = D3D10_RESOURCE_DIMENSION_TEXTURE3D;
+						break;
+
+					default:
+						headerDX10.resourceDimension = D3D10_RESOURCE_DIMENSION_TEXTURE2D;
+						break;
+				}
+
+				byteStream << headerDX10;
+			}
+
+			// Levels are stored one after the other, as in DDS files
+			for (UInt8 level = 0; level < levelCount; ++level)
+			{
+				std::size_t byteCount = PixelFormat::ComputeSize(pixelFormatType, tempImage.GetWidth(level), tempImage.GetHeight(level), tempImage.GetDepth(level));
+				if (byteStream.Write(tempImage.GetConstPixels(0, 0, 0, level), byteCount) != byteCount)
+				{
+					NazaraError("Failed to write level #" + String::Number(level));
+					return false;
+				}
+			}
+
+			return true;
+		}
+	}
+
+	namespace Loaders
+	{
+		void RegisterDDSSaver()
+		{
+			ImageSaver::RegisterSaver(IsSupported, SaveToStream);
+		}
+
+		void UnregisterDDSSaver()
+		{
+			ImageSaver::UnregisterSaver(IsSupported, SaveToStream);
+		}
+	}
+}
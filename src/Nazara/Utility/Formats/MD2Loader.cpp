@@ -241,6 +241,12 @@ namespace Nz
 
 			vertexMapper.Unmap();
 
+			if (parameters.optimizeOverdraw)
+				indexBuffer->OptimizeOverdraw(vertexBuffer);
+
+			if (parameters.optimizeVertexBuffers)
+				indexBuffer->OptimizeVertexFetch(vertexBuffer);
+
 			subMesh->SetIndexBuffer(indexBuffer);
 			subMesh->SetMaterialIndex(0);
 
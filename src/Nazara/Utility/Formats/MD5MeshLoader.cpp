@@ -196,6 +196,12 @@ namespace Nz
 
 					vertexMapper.Unmap();
 
+					if (parameters.optimizeOverdraw)
+						indexBuffer->OptimizeOverdraw(vertexBuffer);
+
+					if (parameters.optimizeVertexBuffers)
+						indexBuffer->OptimizeVertexFetch(vertexBuffer);
+
 					// Material
 					ParameterList matData;
 					matData.SetParameter(MaterialData::FilePath, baseDir + md5Mesh.shader);
@@ -289,6 +295,12 @@ namespace Nz
 
 					vertexMapper.Unmap();
 
+					if (parameters.optimizeOverdraw)
+						indexBuffer->OptimizeOverdraw(vertexBuffer);
+
+					if (parameters.optimizeVertexBuffers)
+						indexBuffer->OptimizeVertexFetch(vertexBuffer);
+
 					// Submesh
 					StaticMeshRef subMesh = StaticMesh::New(vertexBuffer, indexBuffer);
 					subMesh->GenerateAABB();
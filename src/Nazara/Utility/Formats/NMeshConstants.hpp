@@ -0,0 +1,44 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_FORMATS_NMESHCONSTANTS_HPP
+#define NAZARA_FORMATS_NMESHCONSTANTS_HPP
+
+#include <Nazara/Prerequisites.hpp>
+
+namespace Nz
+{
+	/*
+	 * Nazara binary mesh (.nmesh), storing meshes as they are once loaded so they don't need any processing
+	 * Every value is little-endian, vertex and index data are aligned on NMesh_DataAlignment bytes from the start of the file
+	 *
+	 * Header:
+	 *   UInt32 magic, UInt32 version
+	 *   UInt8 animation type, UInt32 joint count (skeletal meshes only), String animation path
+	 *   UInt32 material count, UInt32 submesh count
+	 * Materials:
+	 *   UInt32 parameter count, then for each parameter: String name, UInt8 type, value (pointers and userdata are not stored)
+	 * Joints (skeletal meshes only):
+	 *   String name, Int32 parent index, Matrix4f inverse bind matrix, Vector3f position, Quaternionf rotation, Vector3f scale
+	 * Submeshes:
+	 *   String identifier, UInt32 material index, UInt8 primitive mode, Boxf AABB
+	 *   UInt32 vertex stride, UInt8 component count, then for each component: UInt8 component, UInt8 type, UInt32 offset
+	 *   UInt32 vertex count, UInt8 flags, UInt32 index count (indexed submeshes only)
+	 *   Vertex data, index data (indexed submeshes only), both preceded by their alignment padding
+	 */
+
+	constexpr UInt32 NMesh_Magic = 0x48534D4E; // "NMSH"
+	constexpr UInt32 NMesh_Version = 1;
+	constexpr UInt64 NMesh_DataAlignment = 16;
+
+	enum NMeshSubMeshFlags : UInt8
+	{
+		NMeshSubMeshFlag_Indexed      = 0x01,
+		NMeshSubMeshFlag_LargeIndices = 0x02
+	};
+}
+
+#endif // NAZARA_FORMATS_NMESHCONSTANTS_HPP
@@ -0,0 +1,420 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/Formats/NMeshLoader.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/SerializationContext.hpp>
+#include <Nazara/Utility/BufferMapper.hpp>
+#include <Nazara/Utility/IndexBuffer.hpp>
+#include <Nazara/Utility/Joint.hpp>
+#include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Utility/SkeletalMesh.hpp>
+#include <Nazara/Utility/Skeleton.hpp>
+#include <Nazara/Utility/StaticMesh.hpp>
+#include <Nazara/Utility/VertexBuffer.hpp>
+#include <Nazara/Utility/Formats/NMeshConstants.hpp>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		bool IsSupported(const String& extension)
+		{
+			return (extension == "nmesh");
+		}
+
+		Ternary Check(Stream& stream, const MeshParams& parameters)
+		{
+			bool skip;
+			if (parameters.custom.GetBooleanParameter("SkipNativeNMeshLoader", &skip) && skip)
+				return Ternary_False;
+
+			SerializationContext context;
+			context.endianness = Endianness_LittleEndian;
+			context.stream = &stream;
+
+			UInt32 magic;
+			UInt32 version;
+			if (!Unserialize(context, &magic) || !Unserialize(context, &version))
+				return Ternary_False;
+
+			return (magic == NMesh_Magic && version == NMesh_Version) ? Ternary_True : Ternary_False;
+		}
+
+		// Copies raw data from the file to a buffer, straight from memory when the file is mapped
+		template<typename T>
+		bool ReadBufferData(Stream& stream, UInt64 startPos, T* buffer, std::size_t size)
+		{
+			UInt64 misalignment = (stream.GetCursorPos() - startPos) % NMesh_DataAlignment;
+			UInt64 dataPos = stream.GetCursorPos() + ((misalignment != 0) ? NMesh_DataAlignment - misalignment : 0);
+			if (dataPos + size > stream.GetSize())
+				return false;
+
+			if (stream.IsMemoryMapped())
+			{
+				if (!buffer->FillRaw(static_cast<const UInt8*>(stream.GetMappedPointer()) + dataPos, 0, static_cast<UInt32>(size)))
+					return false;
+			}
+			else
+			{
+				if (!stream.SetCursorPos(dataPos))
+					return false;
+
+				BufferMapper<T> mapper(buffer, BufferAccess_DiscardAndWrite);
+				if (stream.Read(mapper.GetPointer(), size) != size)
+					return false;
+			}
+
+			return stream.SetCursorPos(dataPos + size);
+		}
+
+		bool ReadMaterial(SerializationContext& context, ParameterList* material)
+		{
+			UInt32 parameterCount;
+			if (!Unserialize(context, &parameterCount))
+				return false;
+
+			for (UInt32 i = 0; i < parameterCount; ++i)
+			{
+				String name;
+				UInt8 type;
+				if (!Unserialize(context, &name) || !Unserialize(context, &type))
+					return false;
+
+				switch (type)
+				{
+					case ParameterType_Boolean:
+					{
+						UInt8 value;
+						if (!Unserialize(context, &value))
+							return false;
+
+						material->SetParameter(name, value != 0);
+						break;
+					}
+
+					case ParameterType_Color:
+					{
+						Color value;
+						if (!Unserialize(context, &value))
+							return false;
+
+						material->SetParameter(name, value);
+						break;
+					}
+
+					case ParameterType_Double:
+					{
+						double value;
+						if (!Unserialize(context, &value))
+							return false;
+
+						material->SetParameter(name, value);
+						break;
+					}
+
+					case ParameterType_Integer:
+					{
+						Int64 value;
+						if (!Unserialize(context, &value))
+							return false;
+
+						material->SetParameter(name, static_cast<long long>(value));
+						break;
+					}
+
+					case ParameterType_None:
+						material->SetParameter(name);
+						break;
+
+					case ParameterType_String:
+					{
+						String value;
+						if (!Unserialize(context, &value))
+							return false;
+
+						material->SetParameter(name, value);
+						break;
+					}
+
+					default:
+						NazaraError("Invalid parameter type (0x" + String::Number(type, 16) + ')');
+						return false;
+				}
+			}
+
+			return true;
+		}
+
+		VertexDeclarationConstRef ReadVertexDeclaration(SerializationContext& context)
+		{
+			UInt32 stride;
+			UInt8 componentCount;
+			if (!Unserialize(context, &stride) || !Unserialize(context, &componentCount))
+				return nullptr;
+
+			VertexDeclarationRef declaration = VertexDeclaration::New();
+			for (UInt8 i = 0; i < componentCount; ++i)
+			{
+				UInt8 component;
+				UInt8 type;
+				UInt32 offset;
+				if (!Unserialize(context, &component) || !Unserialize(context, &type) || !Unserialize(context, &offset))
+					return nullptr;
+
+				if (component > VertexComponent_Max || type > ComponentType_Max || offset >= stride)
+				{
+					NazaraError("Invalid vertex component");
+					return nullptr;
+				}
+
+				declaration->EnableComponent(static_cast<VertexComponent>(component), static_cast<ComponentType>(type), offset);
+			}
+
+			declaration->SetStride(stride);
+
+			// Most meshes use one of the predefined declarations, which the rest of the engine may rely on
+			for (unsigned int i = 0; i <= VertexLayout_Max; ++i)
+			{
+				const VertexDeclaration* predefined = VertexDeclaration::Get(static_cast<VertexLayout>(i));
+				if (predefined->GetStride() != stride)
+					continue;
+
+				bool identical = true;
+				for (unsigned int j = 0; j <= VertexComponent_Max && identical; ++j)
+				{
+					bool enabled[2];
+					ComponentType types[2];
+					std::size_t offsets[2];
+					declaration->GetComponent(static_cast<VertexComponent>(j), &enabled[0], &types[0], &offsets[0]);
+					predefined->GetComponent(static_cast<VertexComponent>(j), &enabled[1], &types[1], &offsets[1]);
+
+					identical = (enabled[0] == enabled[1]) && (!enabled[0] || (types[0] == types[1] && offsets[0] == offsets[1]));
+				}
+
+				if (identical)
+					return predefined;
+			}
+
+			return declaration;
+		}
+
+		MeshRef Load(Stream& stream, const MeshParams& parameters)
+		{
+			if (GetPlatformEndianness() != Endianness_LittleEndian)
+			{
+				NazaraError("NMesh format is only supported on little-endian platforms");
+				return nullptr;
+			}
+
+			UInt64 startPos = stream.GetCursorPos();
+
+			SerializationContext context;
+			context.endianness = Endianness_LittleEndian;
+			context.stream = &stream;
+
+			UInt32 magic;
+			UInt32 version;
+			UInt8 animationType;
+			if (!Unserialize(context, &magic) || !Unserialize(context, &version) || !Unserialize(context, &animationType))
+			{
+				NazaraError("Failed to read header");
+				return nullptr;
+			}
+
+			if (magic != NMesh_Magic || version != NMesh_Version || animationType > AnimationType_Max)
+			{
+				NazaraError("Invalid header");
+				return nullptr;
+			}
+
+			UInt32 jointCount = 0;
+			if (animationType == AnimationType_Skeletal && !Unserialize(context, &jointCount))
+			{
+				NazaraError("Failed to read joint count");
+				return nullptr;
+			}
+
+			String animationPath;
+			UInt32 materialCount;
+			UInt32 subMeshCount;
+			if (!Unserialize(context, &animationPath) || !Unserialize(context, &materialCount) || !Unserialize(context, &subMeshCount))
+			{
+				NazaraError("Failed to read header");
+				return nullptr;
+			}
+
+			MeshRef mesh = Mesh::New();
+			if (animationType == AnimationType_Skeletal)
+				mesh->CreateSkeletal(jointCount);
+			else
+				mesh->CreateStatic();
+
+			if (!animationPath.IsEmpty())
+				mesh->SetAnimation(animationPath);
+
+			mesh->SetMaterialCount(materialCount);
+			for (UInt32 i = 0; i < materialCount; ++i)
+			{
+				ParameterList material;
+				if (!ReadMaterial(context, &material))
+				{
+					NazaraError("Failed to read material #" + String::Number(i));
+					return nullptr;
+				}
+
+				mesh->SetMaterialData(i, std::move(material));
+			}
+
+			if (animationType == AnimationType_Skeletal)
+			{
+				Skeleton* skeleton = mesh->GetSkeleton();
+				for (UInt32 i = 0; i < jointCount; ++i)
+				{
+					String name;
+					Int32 parentIndex;
+					Matrix4f inverseBindMatrix;
+					Vector3f position;
+					Quaternionf rotation;
+					Vector3f scale;
+					if (!Unserialize(context, &name) || !Unserialize(context, &parentIndex) || !Unserialize(context, &inverseBindMatrix) ||
+					    !Unserialize(context, &position) || !Unserialize(context, &rotation) || !Unserialize(context, &scale))
+					{
+						NazaraError("Failed to read joint #" + String::Number(i));
+						return nullptr;
+					}
+
+					if (parentIndex >= Int32(jointCount))
+					{
+						NazaraError("Joint #" + String::Number(i) + " parent index is out of range");
+						return nullptr;
+					}
+
+					Joint* joint = skeleton->GetJoint(i);
+					if (parentIndex >= 0)
+						joint->SetParent(skeleton->GetJoint(parentIndex));
+
+					joint->SetName(name);
+					joint->SetInverseBindMatrix(inverseBindMatrix);
+					joint->SetPosition(position);
+					joint->SetRotation(rotation);
+					joint->SetScale(scale);
+				}
+			}
+
+			for (UInt32 i = 0; i < subMeshCount; ++i)
+			{
+				String identifier;
+				UInt32 materialIndex;
+				UInt8 primitiveMode;
+				Boxf aabb;
+				if (!Unserialize(context, &identifier) || !Unserialize(context, &materialIndex) || !Unserialize(context, &primitiveMode) || !Unserialize(context, &aabb))
+				{
+					NazaraError("Failed to read submesh #" + String::Number(i));
+					return nullptr;
+				}
+
+				VertexDeclarationConstRef declaration = ReadVertexDeclaration(context);
+				if (!declaration)
+				{
+					NazaraError("Failed to read vertex declaration of submesh #" + String::Number(i));
+					return nullptr;
+				}
+
+				UInt32 vertexCount;
+				UInt8 flags;
+				UInt32 indexCount = 0;
+				if (!Unserialize(context, &vertexCount) || !Unserialize(context, &flags) || ((flags & NMeshSubMeshFlag_Indexed) && !Unserialize(context, &indexCount)))
+				{
+					NazaraError("Failed to read submesh #" + String::Number(i));
+					return nullptr;
+				}
+
+				if (primitiveMode > PrimitiveMode_Max)
+				{
+					NazaraError("Invalid submesh #" + String::Number(i));
+					return nullptr;
+				}
+
+				if (materialIndex >= materialCount)
+				{
+					NazaraError("Submesh #" + String::Number(i) + " material index is out of range (" + String::Number(materialIndex) + " >= " + String::Number(materialCount) + ')');
+					return nullptr;
+				}
+
+				// Counts come from the file, check them before allocating the buffers
+				UInt64 indexStride = (flags & NMeshSubMeshFlag_LargeIndices) ? sizeof(UInt32) : sizeof(UInt16);
+				UInt64 dataSize = UInt64(vertexCount) * declaration->GetStride() + UInt64(indexCount) * indexStride;
+				if (dataSize > stream.GetSize() - stream.GetCursorPos())
+				{
+					NazaraError("Submesh #" + String::Number(i) + " data exceeds file size");
+					return nullptr;
+				}
+
+				// Skeletal meshes are skinned on the CPU, like the ones from the other loaders
+				BufferUsageFlags vertexBufferFlags = parameters.vertexBufferFlags;
+				if (animationType == AnimationType_Skeletal)
+					vertexBufferFlags |= BufferUsage_Dynamic;
+
+				VertexBufferRef vertexBuffer = VertexBuffer::New(declaration, vertexCount, parameters.storage, vertexBufferFlags);
+				if (!ReadBufferData(stream, startPos, vertexBuffer.Get(), vertexCount * vertexBuffer->GetStride()))
+				{
+					NazaraError("Failed to read vertices of submesh #" + String::Number(i));
+					return nullptr;
+				}
+
+				IndexBufferRef indexBuffer;
+				if (flags & NMeshSubMeshFlag_Indexed)
+				{
+					indexBuffer = IndexBuffer::New((flags & NMeshSubMeshFlag_LargeIndices) != 0, indexCount, parameters.storage, parameters.indexBufferFlags);
+					if (!ReadBufferData(stream, startPos, indexBuffer.Get(), indexCount * indexBuffer->GetStride()))
+					{
+						NazaraError("Failed to read indices of submesh #" + String::Number(i));
+						return nullptr;
+					}
+				}
+
+				SubMeshRef subMesh;
+				if (animationType == AnimationType_Skeletal)
+				{
+					SkeletalMeshRef skeletalMesh = SkeletalMesh::New(vertexBuffer, indexBuffer);
+					skeletalMesh->SetAABB(aabb);
+
+					subMesh = skeletalMesh;
+				}
+				else
+				{
+					StaticMeshRef staticMesh = StaticMesh::New(vertexBuffer, indexBuffer);
+					staticMesh->SetAABB(aabb);
+
+					subMesh = staticMesh;
+				}
+
+				subMesh->SetMaterialIndex(materialIndex);
+				subMesh->SetPrimitiveMode(static_cast<PrimitiveMode>(primitiveMode));
+
+				if (identifier.IsEmpty())
+					mesh->AddSubMesh(subMesh);
+				else
+					mesh->AddSubMesh(identifier, subMesh);
+			}
+
+			return mesh;
+		}
+	}
+
+	namespace Loaders
+	{
+		void RegisterNMeshLoader()
+		{
+			MeshLoader::RegisterLoader(IsSupported, Check, Load);
+		}
+
+		void UnregisterNMeshLoader()
+		{
+			MeshLoader::UnregisterLoader(IsSupported, Check, Load);
+		}
+	}
+}
@@ -0,0 +1,264 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/Formats/NMeshSaver.hpp>
+#include <Nazara/Core/ByteStream.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Utility/BufferMapper.hpp>
+#include <Nazara/Utility/IndexBuffer.hpp>
+#include <Nazara/Utility/Joint.hpp>
+#include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Utility/SkeletalMesh.hpp>
+#include <Nazara/Utility/Skeleton.hpp>
+#include <Nazara/Utility/StaticMesh.hpp>
+#include <Nazara/Utility/VertexBuffer.hpp>
+#include <Nazara/Utility/Formats/NMeshConstants.hpp>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		bool IsSupported(const String& extension)
+		{
+			return (extension == "nmesh");
+		}
+
+		bool WritePadding(ByteStream& byteStream, UInt64 startPos)
+		{
+			static const UInt8 zeroes[NMesh_DataAlignment] = {};
+
+			UInt64 misalignment = (byteStream.GetStream()->GetCursorPos() - startPos) % NMesh_DataAlignment;
+			if (misalignment == 0)
+				return true;
+
+			std::size_t paddingSize = static_cast<std::size_t>(NMesh_DataAlignment - misalignment);
+			return byteStream.Write(zeroes, paddingSize) == paddingSize;
+		}
+
+		void WriteMaterial(ByteStream& byteStream, const ParameterList& material)
+		{
+			// Pointers and userdata only make sense in the current process
+			auto IsStorable = [&material](const String& name)
+			{
+				ParameterType type;
+				material.GetParameterType(name, &type);
+
+				return type != ParameterType_Pointer && type != ParameterType_Userdata;
+			};
+
+			UInt32 parameterCount = 0;
+			material.ForEach([&](const ParameterList& /*list*/, const String& name)
+			{
+				if (IsStorable(name))
+					parameterCount++;
+			});
+
+			byteStream << parameterCount;
+
+			material.ForEach([&](const ParameterList& /*list*/, const String& name)
+			{
+				if (!IsStorable(name))
+					return;
+
+				ParameterType type;
+				material.GetParameterType(name, &type);
+
+				byteStream << name << UInt8(type);
+				switch (type)
+				{
+					case ParameterType_Boolean:
+					{
+						bool value;
+						material.GetBooleanParameter(name, &value);
+
+						byteStream << UInt8((value) ? 1 : 0);
+						break;
+					}
+
+					case ParameterType_Color:
+					{
+						Color value;
+						material.GetColorParameter(name, &value);
+
+						byteStream << value;
+						break;
+					}
+
+					case ParameterType_Double:
+					{
+						double value;
+						material.GetDoubleParameter(name, &value);
+
+						byteStream << value;
+						break;
+					}
+
+					case ParameterType_Integer:
+					{
+						long long value;
+						material.GetIntegerParameter(name, &value);
+
+						byteStream << Int64(value);
+						break;
+					}
+
+					case ParameterType_String:
+					{
+						String value;
+						material.GetStringParameter(name, &value);
+
+						byteStream << value;
+						break;
+					}
+
+					case ParameterType_None:
+					case ParameterType_Pointer:
+					case ParameterType_Userdata:
+						break;
+				}
+			});
+		}
+
+		void WriteVertexDeclaration(ByteStream& byteStream, const VertexDeclaration& declaration)
+		{
+			UInt8 componentCount = 0;
+			for (unsigned int i = 0; i <= VertexComponent_Max; ++i)
+			{
+				if (declaration.HasComponent(static_cast<VertexComponent>(i)))
+					componentCount++;
+			}
+
+			byteStream << UInt32(declaration.GetStride()) << componentCount;
+
+			for (unsigned int i = 0; i <= VertexComponent_Max; ++i)
+			{
+				bool enabled;
+				ComponentType type;
+				std::size_t offset;
+				declaration.GetComponent(static_cast<VertexComponent>(i), &enabled, &type, &offset);
+
+				if (enabled)
+					byteStream << UInt8(i) << UInt8(type) << UInt32(offset);
+			}
+		}
+
+		bool SaveToStream(const Mesh& mesh, const String& format, Stream& stream, const MeshParams& parameters)
+		{
+			NazaraUnused(format);
+			NazaraUnused(parameters);
+
+			if (!mesh.IsValid())
+			{
+				NazaraError("Invalid mesh");
+				return false;
+			}
+
+			// Buffers are written as they are in memory
+			if (GetPlatformEndianness() != Endianness_LittleEndian)
+			{
+				NazaraError("NMesh format is only supported on little-endian platforms");
+				return false;
+			}
+
+			UInt64 startPos = stream.GetCursorPos();
+
+			ByteStream byteStream(&stream);
+			byteStream.SetDataEndianness(Endianness_LittleEndian);
+
+			AnimationType animationType = mesh.GetAnimationType();
+
+			byteStream << NMesh_Magic << NMesh_Version << UInt8(animationType);
+			if (animationType == AnimationType_Skeletal)
+				byteStream << mesh.GetJointCount();
+
+			byteStream << mesh.GetAnimation() << mesh.GetMaterialCount() << mesh.GetSubMeshCount();
+
+			for (UInt32 i = 0; i < mesh.GetMaterialCount(); ++i)
+				WriteMaterial(byteStream, mesh.GetMaterialData(i));
+
+			if (animationType == AnimationType_Skeletal)
+			{
+				const Skeleton* skeleton = mesh.GetSkeleton();
+				const Joint* joints = skeleton->GetJoints();
+
+				for (UInt32 i = 0; i < skeleton->GetJointCount(); ++i)
+				{
+					const Joint& joint = joints[i];
+
+					Int32 parentIndex = -1;
+					if (const Node* parent = joint.GetParent())
+						parentIndex = static_cast<Int32>(static_cast<const Joint*>(parent) - joints);
+
+					byteStream << joint.GetName() << parentIndex << joint.GetInverseBindMatrix();
+					byteStream << joint.GetPosition(CoordSys_Local) << joint.GetRotation(CoordSys_Local) << joint.GetScale(CoordSys_Local);
+				}
+			}
+
+			for (UInt32 i = 0; i < mesh.GetSubMeshCount(); ++i)
+			{
+				const SubMesh* subMesh = mesh.GetSubMesh(i);
+
+				const VertexBuffer* vertexBuffer;
+				if (animationType == AnimationType_Skeletal)
+					vertexBuffer = static_cast<const SkeletalMesh*>(subMesh)->GetVertexBuffer();
+				else
+					vertexBuffer = static_cast<const StaticMesh*>(subMesh)->GetVertexBuffer();
+
+				const IndexBuffer* indexBuffer = subMesh->GetIndexBuffer();
+
+				UInt8 flags = 0;
+				if (indexBuffer)
+				{
+					flags |= NMeshSubMeshFlag_Indexed;
+					if (indexBuffer->HasLargeIndices())
+						flags |= NMeshSubMeshFlag_LargeIndices;
+				}
+
+				byteStream << mesh.GetSubMeshIdentifier(i) << subMesh->GetMaterialIndex() << UInt8(subMesh->GetPrimitiveMode()) << subMesh->GetAABB();
+				WriteVertexDeclaration(byteStream, *vertexBuffer->GetVertexDeclaration());
+
+				byteStream << vertexBuffer->GetVertexCount() << flags;
+				if (indexBuffer)
+					byteStream << indexBuffer->GetIndexCount();
+
+				BufferMapper<VertexBuffer> vertexMapper(vertexBuffer, BufferAccess_ReadOnly);
+
+				std::size_t vertexDataSize = vertexBuffer->GetVertexCount() * vertexBuffer->GetStride();
+				if (!WritePadding(byteStream, startPos) || byteStream.Write(vertexMapper.GetPointer(), vertexDataSize) != vertexDataSize)
+				{
+					NazaraError("Failed to write vertices of submesh #" + String::Number(i));
+					return false;
+				}
+
+				if (indexBuffer)
+				{
+					BufferMapper<IndexBuffer> indexMapper(indexBuffer, BufferAccess_ReadOnly);
+
+					std::size_t indexDataSize = indexBuffer->GetIndexCount() * indexBuffer->GetStride();
+					if (!WritePadding(byteStream, startPos) || byteStream.Write(indexMapper.GetPointer(), indexDataSize) != indexDataSize)
+					{
+						NazaraError("Failed to write indices of submesh #" + String::Number(i));
+						return false;
+					}
+				}
+			}
+
+			return true;
+		}
+	}
+
+	namespace Loaders
+	{
+		void RegisterNMeshSaver()
+		{
+			MeshSaver::RegisterSaver(IsSupported, SaveToStream);
+		}
+
+		void UnregisterNMeshSaver()
+		{
+			MeshSaver::UnregisterSaver(IsSupported, SaveToStream);
+		}
+	}
+}
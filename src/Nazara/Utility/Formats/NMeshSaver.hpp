@@ -0,0 +1,21 @@
+// Copyright (C) 2017 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_FORMATS_NMESHSAVER_HPP
+#define NAZARA_FORMATS_NMESHSAVER_HPP
+
+#include <Nazara/Prerequisites.hpp>
+
+namespace Nz
+{
+	namespace Loaders
+	{
+		void RegisterNMeshSaver();
+		void UnregisterNMeshSaver();
+	}
+}
+
+#endif // NAZARA_FORMATS_NMESHSAVER_HPP
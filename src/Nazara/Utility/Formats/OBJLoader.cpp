@@ -317,6 +317,12 @@ namespace Nz
 
 				vertexMapper.Unmap();
 
+				if (parameters.optimizeOverdraw)
+					indexBuffer->OptimizeOverdraw(vertexBuffer);
+
+				if (parameters.optimizeVertexBuffers)
+					indexBuffer->OptimizeVertexFetch(vertexBuffer);
+
 				StaticMeshRef subMesh = StaticMesh::New(vertexBuffer, indexBuffer);
 				subMesh->GenerateAABB();
 				subMesh->SetMaterialIndex(meshes[i].material);
@@ -333,8 +333,11 @@ namespace Nz
 					return nullptr;
 			}
 
+			if (image->GetLevelCount() > 1)
+				image->GenerateMipmaps();
+
 			if (parameters.loadFormat != PixelFormatType_Undefined)
-				image->Convert(parameters.loadFormat);
+				image->Convert(parameters.loadFormat, parameters.compressionQuality);
 
 			return image;
 		}
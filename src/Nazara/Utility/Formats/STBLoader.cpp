@@ -9,6 +9,7 @@
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/Stream.hpp>
 #include <Nazara/Utility/Image.hpp>
+#include <limits>
 #include <set>
 #include <Nazara/Utility/Debug.hpp>
 
@@ -36,6 +37,21 @@ namespace Nz
 
 		static stbi_io_callbacks callbacks = {Read, Skip, Eof};
 
+		bool GetMappedData(Stream& stream, const stbi_uc** data, int* size)
+		{
+			if (!stream.IsMemoryMapped())
+				return false;
+
+			UInt64 cursorPos = stream.GetCursorPos();
+			UInt64 remainingSize = stream.GetSize() - cursorPos;
+			if (remainingSize > static_cast<UInt64>(std::numeric_limits<int>::max()))
+				return false;
+
+			*data = static_cast<const stbi_uc*>(stream.GetMappedPointer()) + cursorPos;
+			*size = static_cast<int>(remainingSize);
+			return true;
+		}
+
 		bool IsSupported(const String& extension)
 		{
 			static std::set<String> supportedExtensions = {"bmp", "gif", "hdr", "jpg", "jpeg", "pic", "png", "ppm", "pgm", "psd", "tga"};
@@ -48,8 +64,15 @@ namespace Nz
 			if (parameters.custom.GetBooleanParameter("SkipNativeSTBLoader", &skip) && skip)
 				return Ternary_False;
 
+			// Memory mapped streams are parsed in place, without copying them through the callbacks
+			const stbi_uc* data;
+			int dataSize;
+			bool mapped = GetMappedData(stream, &data, &dataSize);
+
 			int width, height, bpp;
-			if (stbi_info_from_callbacks(&callbacks, &stream, &width, &height, &bpp))
+			if (mapped && stbi_info_from_memory(data, dataSize, &width, &height, &bpp))
+				return Ternary_True;
+			else if (!mapped && stbi_info_from_callbacks(&callbacks, &stream, &width, &height, &bpp))
 				return Ternary_True;
 			else
 				return Ternary_False;
@@ -60,8 +83,16 @@ namespace Nz
 			// Je charge tout en RGBA8 et je converti ensuite via la méthode Convert
 			// Ceci à cause d'un bug de STB lorsqu'il s'agit de charger certaines images (ex: JPG) en "default"
 
+			const stbi_uc* data;
+			int dataSize;
+
 			int width, height, bpp;
-			UInt8* ptr = stbi_load_from_callbacks(&callbacks, &stream, &width, &height, &bpp, STBI_rgb_alpha);
+			UInt8* ptr;
+			if (GetMappedData(stream, &data, &dataSize))
+				ptr = stbi_load_from_memory(data, dataSize, &width, &height, &bpp, STBI_rgb_alpha);
+			else
+				ptr = stbi_load_from_callbacks(&callbacks, &stream, &width, &height, &bpp, STBI_rgb_alpha);
+
 			if (!ptr)
 			{
 				NazaraError("Failed to load image: " + String(stbi_failure_reason()));
@@ -84,8 +115,11 @@ namespace Nz
 
 			freeStbiImage.CallAndReset();
 
+			if (image->GetLevelCount() > 1)
+				image->GenerateMipmaps();
+
 			if (parameters.loadFormat != PixelFormatType_Undefined)
-				image->Convert(parameters.loadFormat);
+				image->Convert(parameters.loadFormat, parameters.compressionQuality);
 
 			return image;
 		}
@@ -5,9 +5,16 @@
 #include <Nazara/Utility/Image.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/FrameArena.hpp>
+#include <Nazara/Core/FrameArenaAllocator.hpp>
+#include <Nazara/Core/ParallelAlgorithm.hpp>
 #include <Nazara/Utility/Config.hpp>
 #include <Nazara/Utility/PixelFormat.hpp>
+#include <array>
+#include <atomic>
+#include <cmath>
 #include <memory>
+#include <vector>
 #include <Nazara/Utility/Debug.hpp>
 
 ///TODO: Rajouter des warnings (Formats compressés avec les méthodes Copy/Update, tests taille dans Copy)
@@ -18,6 +25,190 @@ namespace Nz
 {
 	namespace
 	{
+		constexpr unsigned int CompressGrainSize = 16 * 1024; //< Pixels compressés par une seule tâche
+		constexpr unsigned int ConvertGrainSize = 64 * 1024; //< Pixels convertis par une seule tâche
+		constexpr unsigned int MipmapGrainSize = 16 * 1024; //< Pixels de destination calculés par une seule tâche
+		constexpr float KaiserAlpha = 4.f;
+		constexpr float KaiserWidth = 3.f;
+		constexpr unsigned int SRGBEncodingPrecision = 4096;
+
+		// Pixels sources contribuant à chaque pixel de destination sur un axe
+		struct ResamplingTable
+		{
+			std::vector<unsigned int> offsets; //< Premier échantillon de chaque pixel de destination, suivi de la fin du dernier
+			std::vector<unsigned int> sources;
+			std::vector<float> weights;
+		};
+
+		float BesselI0(float x)
+		{
+			float halfX = x * 0.5f;
+			float sum = 1.f;
+			float term = 1.f;
+			for (unsigned int k = 1; k < 32 && term > sum * 1e-8f; ++k)
+			{
+				float factor = halfX / k;
+				term *= factor * factor;
+				sum += term;
+			}
+
+			return sum;
+		}
+
+		float KaiserSinc(float x)
+		{
+			if (std::abs(x) >= KaiserWidth)
+				return 0.f;
+
+			float sinc = (x != 0.f) ? std::sin(float(M_PI) * x) / (float(M_PI) * x) : 1.f;
+			float ratio = x / KaiserWidth;
+
+			return sinc * BesselI0(KaiserAlpha * std::sqrt(1.f - ratio * ratio)) / BesselI0(KaiserAlpha);
+		}
+
+		ResamplingTable BuildIdentityTable(unsigned int size)
+		{
+			ResamplingTable table;
+			table.offsets.resize(size + 1);
+			table.sources.resize(size);
+			table.weights.assign(size, 1.f);
+
+			for (unsigned int i = 0; i < size; ++i)
+			{
+				table.offsets[i] = i;
+				table.sources[i] = i;
+			}
+			table.offsets[size] = size;
+
+			return table;
+		}
+
+		ResamplingTable BuildResamplingTable(MipmapFilter filter, unsigned int srcSize, unsigned int dstSize)
+		{
+			if (srcSize == dstSize)
+				return BuildIdentityTable(dstSize);
+
+			ResamplingTable table;
+			table.offsets.reserve(dstSize + 1);
+
+			float scale = float(srcSize) / dstSize;
+			for (unsigned int i = 0; i < dstSize; ++i)
+			{
+				unsigned int firstTap = static_cast<unsigned int>(table.sources.size());
+				table.offsets.push_back(firstTap);
+
+				float begin = i * scale;
+				float end = begin + scale;
+
+				switch (filter)
+				{
+					case MipmapFilter_Box:
+					{
+						// Couverture exacte, les tailles non-puissances de deux donnent un poids partiel aux pixels des bords
+						unsigned int last = std::min(static_cast<unsigned int>(std::ceil(end)), srcSize);
+						for (unsigned int j = static_cast<unsigned int>(begin); j < last; ++j)
+						{
+							float coverage = std::min(end, j + 1.f) - std::max(begin, float(j));
+							if (coverage > 0.f)
+							{
+								table.sources.push_back(j);
+								table.weights.push_back(coverage);
+							}
+						}
+						break;
+					}
+
+					case MipmapFilter_Kaiser:
+					{
+						float center = begin + scale * 0.5f;
+						float radius = KaiserWidth * scale;
+
+						int first = static_cast<int>(std::floor(center - radius));
+						int last = static_cast<int>(std::ceil(center + radius));
+						for (int j = first; j <= last; ++j)
+						{
+							float weight = KaiserSinc((j + 0.5f - center) / scale);
+							if (weight == 0.f)
+								continue;
+
+							// Les bords sont répétés, les échantillons tombant sur le même pixel sont fusionnés
+							unsigned int source = static_cast<unsigned int>(Clamp(j, 0, int(srcSize) - 1));
+							if (table.sources.size() > firstTap && table.sources.back() == source)
+								table.weights.back() += weight;
+							else
+							{
+								table.sources.push_back(source);
+								table.weights.push_back(weight);
+							}
+						}
+						break;
+					}
+				}
+
+				float weightSum = 0.f;
+				for (std::size_t j = firstTap; j < table.weights.size(); ++j)
+					weightSum += table.weights[j];
+
+				for (std::size_t j = firstTap; j < table.weights.size(); ++j)
+					table.weights[j] /= weightSum;
+			}
+			table.offsets.push_back(static_cast<unsigned int>(table.sources.size()));
+
+			return table;
+		}
+
+		bool GetMipmapChannels(PixelFormatType format, unsigned int* channelCount, int* alphaChannel)
+		{
+			switch (format)
+			{
+				case PixelFormatType_A8:
+					*channelCount = 1;
+					*alphaChannel = 0;
+					return true;
+
+				case PixelFormatType_L8:
+				case PixelFormatType_R8:
+					*channelCount = 1;
+					*alphaChannel = -1;
+					return true;
+
+				case PixelFormatType_LA8:
+					*channelCount = 2;
+					*alphaChannel = 1;
+					return true;
+
+				case PixelFormatType_RG8:
+					*channelCount = 2;
+					*alphaChannel = -1;
+					return true;
+
+				case PixelFormatType_BGR8:
+				case PixelFormatType_RGB8:
+					*channelCount = 3;
+					*alphaChannel = -1;
+					return true;
+
+				case PixelFormatType_BGRA8:
+				case PixelFormatType_RGBA8:
+					*channelCount = 4;
+					*alphaChannel = 3;
+					return true;
+
+				default:
+					return false;
+			}
+		}
+
+		float LinearToSRGB(float value)
+		{
+			return (value <= 0.0031308f) ? value * 12.92f : 1.055f * std::pow(value, 1.f / 2.4f) - 0.055f;
+		}
+
+		float SRGBToLinear(float value)
+		{
+			return (value <= 0.04045f) ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+		}
+
 		inline unsigned int GetLevelSize(unsigned int size, UInt8 level)
 		{
 			if (size == 0) // Possible dans le cas d'une image invalide
@@ -70,7 +261,7 @@ namespace Nz
 		Destroy();
 	}
 
-	bool Image::Convert(PixelFormatType newFormat)
+	bool Image::Convert(PixelFormatType newFormat, CompressionQuality quality)
 	{
 		#if NAZARA_UTILITY_SAFE
 		if (m_sharedImage == &emptyImage)
@@ -84,17 +275,27 @@ namespace Nz
 			NazaraError("Invalid pixel format");
 			return false;
 		}
+		#endif
+
+		if (m_sharedImage->format == newFormat)
+			return true;
+
+		bool compress = PixelFormat::IsCompressed(newFormat);
+
+		#if NAZARA_UTILITY_SAFE
+		if (compress && !PixelFormat::IsCompressionSupported(m_sharedImage->format, newFormat))
+		{
+			NazaraError("Compression from " + PixelFormat::GetName(m_sharedImage->format) + " to " + PixelFormat::GetName(newFormat) + " is not supported");
+			return false;
+		}
 
-		if (!PixelFormat::IsConversionSupported(m_sharedImage->format, newFormat))
+		if (!compress && !PixelFormat::IsConversionSupported(m_sharedImage->format, newFormat))
 		{
 			NazaraError("Conversion from " + PixelFormat::GetName(m_sharedImage->format) + " to " + PixelFormat::GetName(newFormat) + " is not supported");
 			return false;
 		}
 		#endif
 
-		if (m_sharedImage->format == newFormat)
-			return true;
-
 		SharedImage::PixelContainer levels(m_sharedImage->levels.size());
 
 		unsigned int width = m_sharedImage->width;
@@ -103,26 +304,53 @@ namespace Nz
 		// Les images 3D et cubemaps sont stockés de la même façon
 		unsigned int depth = (m_sharedImage->type == ImageType_Cubemap) ? 6 : m_sharedImage->depth;
 
+		UInt8 srcBpp = PixelFormat::GetBytesPerPixel(m_sharedImage->format);
+		UInt8 dstBpp = PixelFormat::GetBytesPerPixel(newFormat);
+
 		for (unsigned int i = 0; i < levels.size(); ++i)
 		{
-			unsigned int pixelsPerFace = width * height;
-			levels[i] = std::make_unique<UInt8[]>(pixelsPerFace * depth * PixelFormat::GetBytesPerPixel(newFormat));
+			unsigned int pixelCount = width * height * depth;
+			levels[i].reset(new UInt8[PixelFormat::ComputeSize(newFormat, width, height, depth)]); //< Chaque octet est écrit par la conversion, inutile de les mettre à zéro
 
 			UInt8* dst = levels[i].get();
-			UInt8* src = m_sharedImage->levels[i].get();
-			unsigned int srcStride = pixelsPerFace * PixelFormat::GetBytesPerPixel(m_sharedImage->format);
-			unsigned int dstStride = pixelsPerFace * PixelFormat::GetBytesPerPixel(newFormat);
+			const UInt8* src = m_sharedImage->levels[i].get();
 
-			for (unsigned int d = 0; d < depth; ++d)
+			std::atomic_bool failed(false);
+			if (compress)
 			{
-				if (!PixelFormat::Convert(m_sharedImage->format, newFormat, src, &src[srcStride], dst))
+				// Chaque ligne de blocs de chaque tranche est compressée indépendamment
+				unsigned int blockRowCount = (height + 3) / 4;
+				std::size_t blockRowSize = PixelFormat::ComputeSize(newFormat, width, 4, 1);
+				std::size_t sliceSize = PixelFormat::ComputeSize(newFormat, width, height, 1);
+
+				ParallelFor(0U, depth * blockRowCount, std::max(CompressGrainSize / (width * 4), 1U), [&](unsigned int firstRow, unsigned int lastRow)
 				{
-					NazaraError("Failed to convert image");
-					return false;
-				}
+					for (unsigned int row = firstRow; row < lastRow; ++row)
+					{
+						unsigned int z = row / blockRowCount;
+						unsigned int y = (row % blockRowCount) * 4;
+
+						const UInt8* srcRow = &src[((z * height + y) * width) * srcBpp];
+						UInt8* dstRow = &dst[z * sliceSize + (y / 4) * blockRowSize];
+						if (!PixelFormat::Compress(m_sharedImage->format, newFormat, width, std::min(height - y, 4U), srcRow, dstRow, quality))
+							failed = true;
+					}
+				});
+			}
+			else
+			{
+				// Chaque pixel est converti indépendamment, les grands niveaux sont découpés en bandes converties par les workers du TaskScheduler
+				ParallelFor(0U, pixelCount, ConvertGrainSize, [&](unsigned int firstPixel, unsigned int lastPixel)
+				{
+					if (!PixelFormat::Convert(m_sharedImage->format, newFormat, &src[firstPixel * srcBpp], &src[lastPixel * srcBpp], &dst[firstPixel * dstBpp]))
+						failed = true;
+				});
+			}
 
-				src += srcStride;
-				dst += dstStride;
+			if (failed)
+			{
+				NazaraError("Failed to convert image");
+				return false;
 			}
 
 			if (width > 1)
@@ -563,6 +791,154 @@ namespace Nz
 		return true;
 	}
 
+	bool Image::GenerateMipmaps(MipmapFilter filter, bool sRGB)
+	{
+		#if NAZARA_UTILITY_SAFE
+		if (m_sharedImage == &emptyImage)
+		{
+			NazaraError("Image must be valid");
+			return false;
+		}
+
+		if (filter > MipmapFilter_Max)
+		{
+			NazaraError("Mipmap filter out of enum (0x" + String::Number(filter, 16) + ')');
+			return false;
+		}
+		#endif
+
+		PixelFormatType format = m_sharedImage->format;
+
+		unsigned int channelCount;
+		int alphaChannel;
+		if (!GetMipmapChannels(format, &channelCount, &alphaChannel))
+		{
+			NazaraError("Mipmap generation is not supported for " + PixelFormat::GetName(format) + " format");
+			return false;
+		}
+
+		// Une image sans mipmaps reçoit une chaîne complète, sinon les niveaux existants sont régénérés
+		if (m_sharedImage->levels.size() <= 1)
+			SetLevelCount(GetMaxLevel());
+
+		EnsureOwnership();
+
+		UInt8 levelCount = UInt8(m_sharedImage->levels.size());
+		if (levelCount <= 1)
+			return true;
+
+		// Les canaux sont filtrés dans l'espace linéaire, l'alpha n'est jamais encodé en sRGB
+		std::array<float, 256> linearDecoding;
+		std::array<float, 256> sRGBDecoding;
+		for (unsigned int i = 0; i < 256; ++i)
+		{
+			linearDecoding[i] = i / 255.f;
+			sRGBDecoding[i] = SRGBToLinear(i / 255.f);
+		}
+
+		std::vector<UInt8> sRGBEncoding;
+		if (sRGB)
+		{
+			sRGBEncoding.resize(SRGBEncodingPrecision);
+			for (unsigned int i = 0; i < SRGBEncodingPrecision; ++i)
+				sRGBEncoding[i] = static_cast<UInt8>(LinearToSRGB(float(i) / (SRGBEncodingPrecision - 1)) * 255.f + 0.5f);
+		}
+
+		std::array<const float*, 4> decoding;
+		std::array<bool, 4> sRGBChannel;
+		for (unsigned int c = 0; c < channelCount; ++c)
+		{
+			sRGBChannel[c] = sRGB && int(c) != alphaChannel;
+			decoding[c] = (sRGBChannel[c]) ? sRGBDecoding.data() : linearDecoding.data();
+		}
+
+		ImageType type = m_sharedImage->type;
+
+		unsigned int width = m_sharedImage->width;
+		unsigned int height = m_sharedImage->height;
+		unsigned int depth = (type == ImageType_Cubemap) ? 6 : m_sharedImage->depth;
+		for (UInt8 level = 1; level < levelCount; ++level)
+		{
+			unsigned int dstWidth = std::max(width >> 1, 1U);
+			unsigned int dstHeight = std::max(height >> 1, 1U);
+			unsigned int dstDepth = (type == ImageType_Cubemap) ? 6 : std::max(depth >> 1, 1U);
+
+			// Les couches des tableaux et les faces des cubemaps ne sont pas mélangées
+			ResamplingTable xTable = BuildResamplingTable(filter, width, dstWidth);
+			ResamplingTable yTable = (type != ImageType_1D_Array) ? BuildResamplingTable(filter, height, dstHeight) : BuildIdentityTable(dstHeight);
+			ResamplingTable zTable = (type == ImageType_3D) ? BuildResamplingTable(filter, depth, dstDepth) : BuildIdentityTable(dstDepth);
+
+			const UInt8* source = m_sharedImage->levels[level - 1].get();
+			UInt8* destination = m_sharedImage->levels[level].get();
+
+			unsigned int srcRowSize = width * channelCount;
+			unsigned int dstRowSize = dstWidth * channelCount;
+
+			// Chaque ligne de destination est calculée indépendamment : filtrage vertical (et en profondeur) puis horizontal
+			ParallelFor(0U, dstDepth * dstHeight, std::max(MipmapGrainSize / dstWidth, 1U), [&](unsigned int firstRow, unsigned int lastRow)
+			{
+				// Mémoire temporaire de la tâche, prise dans l'arène du thread
+				FrameArena& threadArena = FrameArena::GetThreadArena();
+				std::vector<float, FrameArenaAllocator<float>> accumulator(srcRowSize, threadArena);
+				std::vector<float, FrameArenaAllocator<float>> decodedRow(srcRowSize, threadArena);
+
+				for (unsigned int row = firstRow; row < lastRow; ++row)
+				{
+					unsigned int z = row / dstHeight;
+					unsigned int y = row % dstHeight;
+
+					std::fill(accumulator.begin(), accumulator.end(), 0.f);
+
+					for (unsigned int zTap = zTable.offsets[z]; zTap < zTable.offsets[z + 1]; ++zTap)
+					{
+						for (unsigned int yTap = yTable.offsets[y]; yTap < yTable.offsets[y + 1]; ++yTap)
+						{
+							float weight = zTable.weights[zTap] * yTable.weights[yTap];
+							const UInt8* srcRow = &source[(zTable.sources[zTap] * height + yTable.sources[yTap]) * srcRowSize];
+
+							for (unsigned int x = 0; x < width; ++x)
+							{
+								for (unsigned int c = 0; c < channelCount; ++c)
+									decodedRow[x * channelCount + c] = decoding[c][srcRow[x * channelCount + c]];
+							}
+
+							for (unsigned int i = 0; i < srcRowSize; ++i)
+								accumulator[i] += weight * decodedRow[i];
+						}
+					}
+
+					UInt8* dstRow = &destination[row * dstRowSize];
+					for (unsigned int x = 0; x < dstWidth; ++x)
+					{
+						float values[4] = {0.f, 0.f, 0.f, 0.f};
+						for (unsigned int xTap = xTable.offsets[x]; xTap < xTable.offsets[x + 1]; ++xTap)
+						{
+							float weight = xTable.weights[xTap];
+							const float* pixel = &accumulator[xTable.sources[xTap] * channelCount];
+							for (unsigned int c = 0; c < channelCount; ++c)
+								values[c] += weight * pixel[c];
+						}
+
+						for (unsigned int c = 0; c < channelCount; ++c)
+						{
+							float value = Clamp(values[c], 0.f, 1.f);
+							if (sRGBChannel[c])
+								dstRow[x * channelCount + c] = sRGBEncoding[static_cast<unsigned int>(value * (SRGBEncodingPrecision - 1) + 0.5f)];
+							else
+								dstRow[x * channelCount + c] = static_cast<UInt8>(value * 255.f + 0.5f);
+						}
+					}
+				}
+			});
+
+			width = dstWidth;
+			height = dstHeight;
+			depth = dstDepth;
+		}
+
+		return true;
+	}
+
 	const UInt8* Image::GetConstPixels(unsigned int x, unsigned int y, unsigned int z, UInt8 level) const
 	{
 		#if NAZARA_UTILITY_SAFE
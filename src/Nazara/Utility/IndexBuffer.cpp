@@ -6,9 +6,12 @@
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/ErrorFlags.hpp>
 #include <Nazara/Utility/Algorithm.hpp>
+#include <Nazara/Utility/BufferMapper.hpp>
 #include <Nazara/Utility/Config.hpp>
 #include <Nazara/Utility/IndexIterator.hpp>
 #include <Nazara/Utility/IndexMapper.hpp>
+#include <Nazara/Utility/VertexBuffer.hpp>
+#include <Nazara/Utility/VertexMapper.hpp>
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
@@ -91,6 +94,42 @@ namespace Nz
 		OptimizeIndices(mapper.begin(), m_indexCount);
 	}
 
+	void IndexBuffer::OptimizeOverdraw(const VertexBuffer* vertexBuffer)
+	{
+		NazaraAssert(vertexBuffer && vertexBuffer->IsValid(), "Invalid vertex buffer");
+
+		VertexMapper vertexMapper(vertexBuffer, BufferAccess_ReadOnly);
+
+		SparsePtr<Vector3f> positionPtr = vertexMapper.GetComponentPtr<Vector3f>(VertexComponent_Position);
+		if (!positionPtr)
+		{
+			NazaraError("Vertex buffer has no position component");
+			return;
+		}
+
+		IndexMapper mapper(this);
+
+		Nz::OptimizeOverdraw(mapper.begin(), m_indexCount, positionPtr);
+	}
+
+	/*!
+	* \brief Reorders the vertices of a vertex buffer in the order of their first use by this index buffer, and remaps the indices accordingly
+	*
+	* \param vertexBuffer Vertex buffer referenced by this index buffer, rewritten in place
+	*
+	* \remark The vertex buffer must not be shared with any other index buffer (or used directly), as vertices are moved and other references to them would no longer be valid
+	* \remark Vertices not referenced by this index buffer are moved at the end of the vertex buffer
+	*/
+	void IndexBuffer::OptimizeVertexFetch(VertexBuffer* vertexBuffer)
+	{
+		NazaraAssert(vertexBuffer && vertexBuffer->IsValid(), "Invalid vertex buffer");
+
+		BufferMapper<VertexBuffer> vertexMapper(vertexBuffer, BufferAccess_ReadWrite);
+		IndexMapper mapper(this);
+
+		Nz::OptimizeVertexFetch(mapper.begin(), m_indexCount, vertexMapper.GetPointer(), vertexBuffer->GetStride(), vertexBuffer->GetVertexCount());
+	}
+
 	void IndexBuffer::Reset()
 	{
 		m_buffer.Reset();
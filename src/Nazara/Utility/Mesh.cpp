@@ -3,8 +3,12 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Core/AbstractHash.hpp>
+#include <Nazara/Core/ByteStream.hpp>
+#include <Nazara/Core/Directory.hpp>
 #include <Nazara/Core/Enums.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/File.hpp>
 #include <Nazara/Core/PrimitiveList.hpp>
 #include <Nazara/Utility/Algorithm.hpp>
 #include <Nazara/Utility/Buffer.hpp>
@@ -21,6 +25,51 @@
 
 namespace Nz
 {
+	namespace
+	{
+		// Cache files are named after the file and the parameters which change the loaded data, so changing either of them doesn't reuse an outdated cache
+		// Other files read by the loader (such as .mtl material libraries) are not part of the key, the cache has to be cleared when they change
+		String GetCacheFilePath(const String& filePath, const MeshParams& params)
+		{
+			if (!params.IsValid())
+				return String(); //< Let the loader report invalid parameters
+
+			std::unique_ptr<AbstractHash> hash = AbstractHash::Get(HashType_CRC64);
+			hash->Begin();
+
+			File file(filePath);
+			if (!HashAppend(hash.get(), file))
+				return String();
+
+			ByteArray paramsData;
+			{
+				ByteStream stream(&paramsData);
+				stream.SetDataEndianness(Endianness_LittleEndian);
+
+				stream << params.matrix << params.texCoordOffset << params.texCoordScale;
+				stream << UInt8(params.animated) << UInt8(params.center) << UInt8(params.optimizeIndexBuffers) << UInt8(params.optimizeOverdraw) << UInt8(params.optimizeVertexBuffers);
+
+				stream << UInt32(params.vertexDeclaration->GetStride());
+				for (unsigned int i = 0; i <= VertexComponent_Max; ++i)
+				{
+					bool enabled;
+					ComponentType type;
+					std::size_t offset;
+					params.vertexDeclaration->GetComponent(static_cast<VertexComponent>(i), &enabled, &type, &offset);
+
+					if (enabled)
+						stream << UInt8(i) << UInt8(type) << UInt32(offset);
+				}
+
+				stream << params.custom.ToString();
+			}
+
+			HashAppend(hash.get(), paramsData);
+
+			return params.cacheDirectory + NAZARA_DIRECTORY_SEPARATOR + file.GetFileName() + '_' + hash->End().ToHex() + ".nmesh";
+		}
+	}
+
 	MeshParams::MeshParams()
 	{
 		if (!Buffer::IsStorageSupported(storage))
@@ -247,6 +296,12 @@ namespace Nz
 		if (params.optimizeIndexBuffers)
 			indexBuffer->Optimize();
 
+		if (params.optimizeOverdraw)
+			indexBuffer->OptimizeOverdraw(vertexBuffer);
+
+		if (params.optimizeVertexBuffers)
+			indexBuffer->OptimizeVertexFetch(vertexBuffer);
+
 		StaticMeshRef subMesh = StaticMesh::New(vertexBuffer, indexBuffer);
 		subMesh->SetAABB(aabb);
 
@@ -454,6 +509,20 @@ namespace Nz
 		return static_cast<UInt32>(m_subMeshes.size());
 	}
 
+	String Mesh::GetSubMeshIdentifier(UInt32 index) const
+	{
+		NazaraAssert(m_isValid, "Mesh should be created first");
+		NazaraAssert(index < m_subMeshes.size(), "Submesh index out of range");
+
+		for (const auto& pair : m_subMeshMap)
+		{
+			if (pair.second == index)
+				return pair.first;
+		}
+
+		return String();
+	}
+
 	UInt32 Mesh::GetSubMeshIndex(const String& identifier) const
 	{
 		NazaraAssert(m_isValid, "Mesh should be created first");
@@ -650,7 +719,33 @@ namespace Nz
 
 	MeshRef Mesh::LoadFromFile(const String& filePath, const MeshParams& params)
 	{
-		return MeshLoader::LoadFromFile(filePath, params);
+		if (params.cacheDirectory.IsEmpty() || filePath.SubStringFrom('.', -1, true).ToLower() == "nmesh")
+			return MeshLoader::LoadFromFile(filePath, params);
+
+		String cachePath = GetCacheFilePath(filePath, params);
+		if (cachePath.IsEmpty())
+			return MeshLoader::LoadFromFile(filePath, params);
+
+		if (File::Exists(cachePath))
+		{
+			MeshRef mesh = MeshLoader::LoadFromFile(cachePath, params);
+			if (mesh)
+			{
+				mesh->SetFilePath(filePath);
+				return mesh;
+			}
+
+			NazaraWarning("Failed to load cache file \"" + cachePath + "\", loading \"" + filePath + "\" again");
+		}
+
+		MeshRef mesh = MeshLoader::LoadFromFile(filePath, params);
+		if (mesh)
+		{
+			if ((!Directory::Exists(params.cacheDirectory) && !Directory::Create(params.cacheDirectory, true)) || !MeshSaver::SaveToFile(*mesh, cachePath, params))
+				NazaraWarning("Failed to save cache file \"" + cachePath + '"');
+		}
+
+		return mesh;
 	}
 
 	MeshRef Mesh::LoadFromMemory(const void* data, std::size_t size, const MeshParams& params)
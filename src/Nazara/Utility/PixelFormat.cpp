@@ -5,15 +5,38 @@
 #include <Nazara/Utility/PixelFormat.hpp>
 #include <Nazara/Core/Endianness.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/FrameArena.hpp>
+#include <Nazara/Core/FrameArenaAllocator.hpp>
+#include <Nazara/Core/HardwareInfo.hpp>
+#include <Nazara/Math/Algorithm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define NAZARA_UTILITY_PIXELFORMAT_SSE
+	#include <tmmintrin.h>
+
+	// SSSE3 kernels are only used if the processor supports them
+	#if defined(__GNUC__) && !defined(__SSSE3__)
+		#define NAZARA_UTILITY_PIXELFORMAT_SSSE3_TARGET __attribute__((target("ssse3")))
+	#else
+		#define NAZARA_UTILITY_PIXELFORMAT_SSSE3_TARGET
+	#endif
+#endif
+
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
 {
 	namespace
 	{
+		// Integer versions of c * (max(to) / max(from)), truncated
 		inline UInt8 c4to5(UInt8 c)
 		{
-			return static_cast<UInt8>(c * (31.f/15.f));
+			return static_cast<UInt8>(c * 31U / 15U);
 		}
 
 		inline UInt8 c4to8(UInt8 c)
@@ -23,12 +46,12 @@ namespace Nz
 
 		inline UInt8 c5to4(UInt8 c)
 		{
-			return static_cast<UInt8>(c * (15.f/31.f));
+			return static_cast<UInt8>(c * 15U / 31U);
 		}
 
 		inline UInt8 c5to8(UInt8 c)
 		{
-			return static_cast<UInt8>(c * (255.f/31.f));
+			return static_cast<UInt8>(c * 255U / 31U);
 		}
 
 		inline UInt8 c8to4(UInt8 c)
@@ -38,7 +61,7 @@ namespace Nz
 
 		inline UInt8 c8to5(UInt8 c)
 		{
-			return static_cast<UInt8>(c * (31.f/255.f));
+			return static_cast<UInt8>(c * 31U / 255U);
 		}
 
 		template<PixelFormatType from, PixelFormatType to>
@@ -92,7 +115,7 @@ namespace Nz
 				*ptr = (static_cast<UInt16>(0x1F) << 11) |
 					   (static_cast<UInt16>(0x1F) << 6)  |
 					   (static_cast<UInt16>(0x1F) << 1)  |
-					   ((*start > 0xF) ? 1 : 0); // > 128
+					   ((*start > 0x7F) ? 1 : 0);
 
 				#ifdef NAZARA_BIG_ENDIAN
 				SwapBytes(ptr, sizeof(UInt16));
@@ -121,7 +144,7 @@ namespace Nz
 				start += 1;
 			}
 
-			return dst;
+			return reinterpret_cast<UInt8*>(ptr);
 		}
 
 		template<>
@@ -240,7 +263,7 @@ namespace Nz
 				start += 3;
 			}
 
-			return dst;
+			return reinterpret_cast<UInt8*>(ptr);
 		}
 
 		template<>
@@ -334,7 +357,7 @@ namespace Nz
 				start += 4;
 			}
 
-			return dst;
+			return reinterpret_cast<UInt8*>(ptr);
 		}
 
 		template<>
@@ -346,7 +369,7 @@ namespace Nz
 				*ptr = (static_cast<UInt16>(c8to5(start[2])) << 11) |
 					   (static_cast<UInt16>(c8to5(start[1])) << 6)  |
 					   (static_cast<UInt16>(c8to5(start[0])) << 1)  |
-					   ((start[3] > 0xF) ? 1 : 0); // > 128
+					   ((start[3] > 0x7F) ? 1 : 0);
 
 				#ifdef NAZARA_BIG_ENDIAN
 				SwapBytes(ptr, sizeof(UInt16));
@@ -496,7 +519,7 @@ namespace Nz
 				start += 1;
 			}
 
-			return dst;
+			return reinterpret_cast<UInt8*>(ptr);
 		}
 
 		template<>
@@ -581,7 +604,7 @@ namespace Nz
 			{
 				UInt16 l = static_cast<UInt16>(c8to5(start[0]));
 
-				*ptr = (l << 11) | (l << 6) | (l << 1) | ((start[1] > 0xF) ? 1 : 0);
+				*ptr = (l << 11) | (l << 6) | (l << 1) | ((start[1] > 0x7F) ? 1 : 0);
 
 				#ifdef NAZARA_BIG_ENDIAN
 				SwapBytes(ptr, sizeof(UInt16));
@@ -627,7 +650,7 @@ namespace Nz
 				start += 2;
 			}
 
-			return dst;
+			return reinterpret_cast<UInt8*>(ptr);
 		}
 
 		template<>
@@ -986,7 +1009,7 @@ namespace Nz
 				start += 2;
 			}
 
-			return dst;
+			return reinterpret_cast<UInt8*>(ptr);
 		}
 
 		template<>
@@ -1111,7 +1134,7 @@ namespace Nz
 				start += 3;
 			}
 
-			return dst;
+			return reinterpret_cast<UInt8*>(ptr);
 		}
 
 		template<>
@@ -1211,7 +1234,7 @@ namespace Nz
 				*ptr = (static_cast<UInt16>(c8to5(start[0])) << 11) |
 					   (static_cast<UInt16>(c8to5(start[1])) << 6)  |
 					   (static_cast<UInt16>(c8to5(start[2])) << 1)  |
-					   ((start[3] > 0xF) ? 1 : 0); // > 128
+					   ((start[3] > 0x7F) ? 1 : 0);
 
 				#ifdef NAZARA_BIG_ENDIAN
 				SwapBytes(ptr, sizeof(UInt16));
@@ -1258,7 +1281,806 @@ namespace Nz
 				start += 4;
 			}
 
-			return dst;
+			return reinterpret_cast<UInt8*>(ptr);
+		}
+
+		#ifdef NAZARA_UTILITY_PIXELFORMAT_SSE
+		/*********************************SIMD***********************************/
+		// Vectorized kernels process the bulk of the pixels and leave the remaining ones to the scalar version above
+		// Results are exactly the same as the scalar conversions
+		// Packing to 16 bits formats (RGBA4, RGB5A1) is left to the compiler, which vectorizes the integer scalar version well
+
+		inline __m128i LoadPixels(const UInt8* ptr)
+		{
+			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+		}
+
+		inline void StorePixels(UInt8* ptr, __m128i pixels)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(ptr), pixels);
+		}
+
+		// A8 => BGRA8/RGBA8, sixteen pixels at a time
+		template<PixelFormatType from, PixelFormatType to>
+		UInt8* ExpandAlphaSSE2(const UInt8* start, const UInt8* end, UInt8* dst)
+		{
+			const __m128i white = _mm_set1_epi32(0x00FFFFFF);
+			const __m128i zero = _mm_setzero_si128();
+
+			for (; end - start >= 16; start += 16, dst += 64)
+			{
+				__m128i alpha = LoadPixels(start);
+				__m128i lo = _mm_unpacklo_epi8(zero, alpha);
+				__m128i hi = _mm_unpackhi_epi8(zero, alpha);
+
+				StorePixels(&dst[0],  _mm_or_si128(_mm_unpacklo_epi16(zero, lo), white));
+				StorePixels(&dst[16], _mm_or_si128(_mm_unpackhi_epi16(zero, lo), white));
+				StorePixels(&dst[32], _mm_or_si128(_mm_unpacklo_epi16(zero, hi), white));
+				StorePixels(&dst[48], _mm_or_si128(_mm_unpackhi_epi16(zero, hi), white));
+			}
+
+			return ConvertPixels<from, to>(start, end, dst);
+		}
+
+		// L8 => BGRA8/RGBA8, sixteen pixels at a time
+		template<PixelFormatType from, PixelFormatType to>
+		UInt8* ExpandLuminanceSSE2(const UInt8* start, const UInt8* end, UInt8* dst)
+		{
+			const __m128i opaque = _mm_set1_epi32(static_cast<int>(0xFF000000));
+
+			for (; end - start >= 16; start += 16, dst += 64)
+			{
+				__m128i luminance = LoadPixels(start);
+				__m128i lo = _mm_unpacklo_epi8(luminance, luminance);
+				__m128i hi = _mm_unpackhi_epi8(luminance, luminance);
+
+				StorePixels(&dst[0],  _mm_or_si128(_mm_unpacklo_epi16(lo, lo), opaque));
+				StorePixels(&dst[16], _mm_or_si128(_mm_unpackhi_epi16(lo, lo), opaque));
+				StorePixels(&dst[32], _mm_or_si128(_mm_unpacklo_epi16(hi, hi), opaque));
+				StorePixels(&dst[48], _mm_or_si128(_mm_unpackhi_epi16(hi, hi), opaque));
+			}
+
+			return ConvertPixels<from, to>(start, end, dst);
+		}
+
+		// A8/L8 => LA8, sixteen pixels at a time
+		template<PixelFormatType from, PixelFormatType to, bool alphaSource>
+		UInt8* ExpandToLuminanceAlphaSSE2(const UInt8* start, const UInt8* end, UInt8* dst)
+		{
+			const __m128i full = _mm_set1_epi8(static_cast<char>(0xFF));
+
+			for (; end - start >= 16; start += 16, dst += 32)
+			{
+				__m128i source = LoadPixels(start);
+				if (alphaSource)
+				{
+					StorePixels(&dst[0],  _mm_unpacklo_epi8(full, source));
+					StorePixels(&dst[16], _mm_unpackhi_epi8(full, source));
+				}
+				else
+				{
+					StorePixels(&dst[0],  _mm_unpacklo_epi8(source, full));
+					StorePixels(&dst[16], _mm_unpackhi_epi8(source, full));
+				}
+			}
+
+			return ConvertPixels<from, to>(start, end, dst);
+		}
+
+		// BGRA8 <=> RGBA8, four pixels at a time
+		template<PixelFormatType from, PixelFormatType to>
+		UInt8* SwapRedBlueSSE2(const UInt8* start, const UInt8* end, UInt8* dst)
+		{
+			const __m128i greenAlphaMask = _mm_set1_epi32(static_cast<int>(0xFF00FF00));
+
+			for (; end - start >= 16; start += 16, dst += 16)
+			{
+				__m128i pixels = LoadPixels(start);
+				__m128i greenAlpha = _mm_and_si128(pixels, greenAlphaMask);
+				__m128i redBlue = _mm_andnot_si128(greenAlphaMask, pixels);
+
+				redBlue = _mm_or_si128(_mm_slli_epi32(redBlue, 16), _mm_srli_epi32(redBlue, 16));
+				StorePixels(dst, _mm_or_si128(greenAlpha, redBlue));
+			}
+
+			return ConvertPixels<from, to>(start, end, dst);
+		}
+
+		// BGR8/RGB8 => BGRA8/RGBA8, sixteen pixels at a time
+		template<PixelFormatType from, PixelFormatType to>
+		NAZARA_UTILITY_PIXELFORMAT_SSSE3_TARGET UInt8* ExpandRGBSSSE3(const UInt8* start, const UInt8* end, UInt8* dst)
+		{
+			constexpr bool swapRedBlue = (from == PixelFormatType_RGB8) != (to == PixelFormatType_RGBA8);
+
+			const __m128i opaque = _mm_set1_epi32(static_cast<int>(0xFF000000));
+			const __m128i shuffleMask = (swapRedBlue) ? _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1) : _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+
+			for (; end - start >= 48; start += 48, dst += 64)
+			{
+				__m128i first = LoadPixels(&start[0]);
+				__m128i second = LoadPixels(&start[16]);
+				__m128i third = LoadPixels(&start[32]);
+
+				StorePixels(&dst[0],  _mm_or_si128(_mm_shuffle_epi8(first, shuffleMask), opaque));
+				StorePixels(&dst[16], _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(second, first, 12), shuffleMask), opaque));
+				StorePixels(&dst[32], _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(third, second, 8), shuffleMask), opaque));
+				StorePixels(&dst[48], _mm_or_si128(_mm_shuffle_epi8(_mm_srli_si128(third, 4), shuffleMask), opaque));
+			}
+
+			return ConvertPixels<from, to>(start, end, dst);
+		}
+
+		// BGRA8/RGBA8 => BGR8/RGB8, sixteen pixels at a time
+		template<PixelFormatType from, PixelFormatType to>
+		NAZARA_UTILITY_PIXELFORMAT_SSSE3_TARGET UInt8* ShrinkRGBASSSE3(const UInt8* start, const UInt8* end, UInt8* dst)
+		{
+			constexpr bool swapRedBlue = (from == PixelFormatType_RGBA8) != (to == PixelFormatType_RGB8);
+
+			// Color bytes are moved to the first twelve bytes
+			const __m128i shuffleMask = (swapRedBlue) ? _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1) : _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+
+			for (; end - start >= 64; start += 64, dst += 48)
+			{
+				__m128i first = _mm_shuffle_epi8(LoadPixels(&start[0]), shuffleMask);
+				__m128i second = _mm_shuffle_epi8(LoadPixels(&start[16]), shuffleMask);
+				__m128i third = _mm_shuffle_epi8(LoadPixels(&start[32]), shuffleMask);
+				__m128i fourth = _mm_shuffle_epi8(LoadPixels(&start[48]), shuffleMask);
+
+				StorePixels(&dst[0],  _mm_or_si128(first, _mm_slli_si128(second, 12)));
+				StorePixels(&dst[16], _mm_or_si128(_mm_srli_si128(second, 4), _mm_slli_si128(third, 8)));
+				StorePixels(&dst[32], _mm_or_si128(_mm_srli_si128(third, 8), _mm_slli_si128(fourth, 4)));
+			}
+
+			return ConvertPixels<from, to>(start, end, dst);
+		}
+
+		void RegisterSIMDConverters()
+		{
+			PixelFormat::SetConvertFunction(PixelFormatType_A8, PixelFormatType_BGRA8, &ExpandAlphaSSE2<PixelFormatType_A8, PixelFormatType_BGRA8>);
+			PixelFormat::SetConvertFunction(PixelFormatType_A8, PixelFormatType_LA8, &ExpandToLuminanceAlphaSSE2<PixelFormatType_A8, PixelFormatType_LA8, true>);
+			PixelFormat::SetConvertFunction(PixelFormatType_A8, PixelFormatType_RGBA8, &ExpandAlphaSSE2<PixelFormatType_A8, PixelFormatType_RGBA8>);
+
+			PixelFormat::SetConvertFunction(PixelFormatType_BGRA8, PixelFormatType_RGBA8, &SwapRedBlueSSE2<PixelFormatType_BGRA8, PixelFormatType_RGBA8>);
+
+			PixelFormat::SetConvertFunction(PixelFormatType_L8, PixelFormatType_BGRA8, &ExpandLuminanceSSE2<PixelFormatType_L8, PixelFormatType_BGRA8>);
+			PixelFormat::SetConvertFunction(PixelFormatType_L8, PixelFormatType_LA8, &ExpandToLuminanceAlphaSSE2<PixelFormatType_L8, PixelFormatType_LA8, false>);
+			PixelFormat::SetConvertFunction(PixelFormatType_L8, PixelFormatType_RGBA8, &ExpandLuminanceSSE2<PixelFormatType_L8, PixelFormatType_RGBA8>);
+
+			PixelFormat::SetConvertFunction(PixelFormatType_RGBA8, PixelFormatType_BGRA8, &SwapRedBlueSSE2<PixelFormatType_RGBA8, PixelFormatType_BGRA8>);
+
+			// Byte shuffles require SSSE3, which is not part of the x64 baseline
+			if (HardwareInfo::Initialize() && HardwareInfo::HasCapability(ProcessorCap_SSSE3))
+			{
+				PixelFormat::SetConvertFunction(PixelFormatType_BGR8, PixelFormatType_BGRA8, &ExpandRGBSSSE3<PixelFormatType_BGR8, PixelFormatType_BGRA8>);
+				PixelFormat::SetConvertFunction(PixelFormatType_BGR8, PixelFormatType_RGBA8, &ExpandRGBSSSE3<PixelFormatType_BGR8, PixelFormatType_RGBA8>);
+				PixelFormat::SetConvertFunction(PixelFormatType_BGRA8, PixelFormatType_BGR8, &ShrinkRGBASSSE3<PixelFormatType_BGRA8, PixelFormatType_BGR8>);
+				PixelFormat::SetConvertFunction(PixelFormatType_BGRA8, PixelFormatType_RGB8, &ShrinkRGBASSSE3<PixelFormatType_BGRA8, PixelFormatType_RGB8>);
+				PixelFormat::SetConvertFunction(PixelFormatType_RGB8, PixelFormatType_BGRA8, &ExpandRGBSSSE3<PixelFormatType_RGB8, PixelFormatType_BGRA8>);
+				PixelFormat::SetConvertFunction(PixelFormatType_RGB8, PixelFormatType_RGBA8, &ExpandRGBSSSE3<PixelFormatType_RGB8, PixelFormatType_RGBA8>);
+				PixelFormat::SetConvertFunction(PixelFormatType_RGBA8, PixelFormatType_BGR8, &ShrinkRGBASSSE3<PixelFormatType_RGBA8, PixelFormatType_BGR8>);
+				PixelFormat::SetConvertFunction(PixelFormatType_RGBA8, PixelFormatType_RGB8, &ShrinkRGBASSSE3<PixelFormatType_RGBA8, PixelFormatType_RGB8>);
+			}
+		}
+		#endif
+
+		/****************************Block compression****************************/
+		// Blocks of 4x4 pixels are encoded from RGBA8 pixels, stored channel by channel to process four pixels at a time
+		struct PixelBlock
+		{
+			alignas(16) float channels[4][16];
+		};
+
+		using BlockEncoder = void(*)(const PixelBlock& block, UInt8* dst, CompressionQuality quality);
+
+		// Maximal number of least-squares refinements of the endpoints
+		constexpr unsigned int s_refinementCounts[CompressionQuality_Max + 1] = {0, 1, 8};
+
+		constexpr float s_colorWeights[4] = {0.f, 1.f, 1.f / 3.f, 2.f / 3.f};
+		constexpr UInt8 s_bc7Weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+		// Finds the closest palette entry of every pixel, using channels [firstChannel, firstChannel + channelCount) of the block
+		// Returns the sum of the squared errors
+		float FindClosestIndices(const PixelBlock& block, unsigned int firstChannel, unsigned int channelCount, const float (*palette)[4], unsigned int paletteSize, UInt8* indices)
+		{
+			#ifdef NAZARA_UTILITY_PIXELFORMAT_SSE
+			__m128 totalError = _mm_setzero_ps();
+			for (unsigned int i = 0; i < 16; i += 4)
+			{
+				__m128 pixels[4];
+				for (unsigned int c = 0; c < channelCount; ++c)
+					pixels[c] = _mm_load_ps(&block.channels[firstChannel + c][i]);
+
+				__m128 bestError = _mm_set1_ps(std::numeric_limits<float>::max());
+				__m128i bestIndex = _mm_setzero_si128();
+				for (unsigned int p = 0; p < paletteSize; ++p)
+				{
+					__m128 error = _mm_setzero_ps();
+					for (unsigned int c = 0; c < channelCount; ++c)
+					{
+						__m128 diff = _mm_sub_ps(pixels[c], _mm_set1_ps(palette[p][c]));
+						error = _mm_add_ps(error, _mm_mul_ps(diff, diff));
+					}
+
+					__m128i closer = _mm_castps_si128(_mm_cmplt_ps(error, bestError));
+					bestError = _mm_min_ps(error, bestError);
+					bestIndex = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi32(p)), _mm_andnot_si128(closer, bestIndex));
+				}
+
+				totalError = _mm_add_ps(totalError, bestError);
+
+				alignas(16) Int32 bestIndices[4];
+				_mm_store_si128(reinterpret_cast<__m128i*>(bestIndices), bestIndex);
+				for (unsigned int j = 0; j < 4; ++j)
+					indices[i + j] = static_cast<UInt8>(bestIndices[j]);
+			}
+
+			alignas(16) float errors[4];
+			_mm_store_ps(errors, totalError);
+			#else
+			float errors[4] = {0.f, 0.f, 0.f, 0.f};
+			for (unsigned int i = 0; i < 16; ++i)
+			{
+				float bestError = std::numeric_limits<float>::max();
+				for (unsigned int p = 0; p < paletteSize; ++p)
+				{
+					float error = 0.f;
+					for (unsigned int c = 0; c < channelCount; ++c)
+					{
+						float diff = block.channels[firstChannel + c][i] - palette[p][c];
+						error += diff * diff;
+					}
+
+					if (error < bestError)
+					{
+						bestError = error;
+						indices[i] = static_cast<UInt8>(p);
+					}
+				}
+
+				errors[i % 4] += bestError;
+			}
+			#endif
+
+			return errors[0] + errors[1] + errors[2] + errors[3];
+		}
+
+		// Computes the mean and the principal axis (by power iteration on the covariance matrix) of the pixels
+		// The axis is null if every pixel is the same
+		void ComputePrincipalAxis(const PixelBlock& block, unsigned int channelCount, float* mean, float* axis)
+		{
+			for (unsigned int c = 0; c < channelCount; ++c)
+			{
+				float sum = 0.f;
+				for (unsigned int i = 0; i < 16; ++i)
+					sum += block.channels[c][i];
+
+				mean[c] = sum / 16.f;
+			}
+
+			float covariance[4][4];
+			for (unsigned int a = 0; a < channelCount; ++a)
+			{
+				for (unsigned int b = a; b < channelCount; ++b)
+				{
+					float sum = 0.f;
+					for (unsigned int i = 0; i < 16; ++i)
+						sum += (block.channels[a][i] - mean[a]) * (block.channels[b][i] - mean[b]);
+
+					covariance[a][b] = sum;
+					covariance[b][a] = sum;
+				}
+			}
+
+			// Start from the channel with the most variance, which converges quickly
+			unsigned int mainChannel = 0;
+			for (unsigned int c = 1; c < channelCount; ++c)
+			{
+				if (covariance[c][c] > covariance[mainChannel][mainChannel])
+					mainChannel = c;
+			}
+
+			for (unsigned int c = 0; c < channelCount; ++c)
+				axis[c] = covariance[mainChannel][c];
+
+			for (unsigned int iteration = 0; iteration < 8; ++iteration)
+			{
+				float product[4];
+				float maxComponent = 0.f;
+				for (unsigned int a = 0; a < channelCount; ++a)
+				{
+					product[a] = 0.f;
+					for (unsigned int b = 0; b < channelCount; ++b)
+						product[a] += covariance[a][b] * axis[b];
+
+					maxComponent = std::max(maxComponent, std::abs(product[a]));
+				}
+
+				if (maxComponent <= 0.f)
+					break;
+
+				for (unsigned int c = 0; c < channelCount; ++c)
+					axis[c] = product[c] / maxComponent;
+			}
+
+			float length = 0.f;
+			for (unsigned int c = 0; c < channelCount; ++c)
+				length += axis[c] * axis[c];
+
+			length = std::sqrt(length);
+			for (unsigned int c = 0; c < channelCount; ++c)
+				axis[c] = (length > 0.f) ? axis[c] / length : 0.f;
+		}
+
+		// Places the endpoints at the extremities of the pixels projected on the axis
+		void ComputeAxisEndpoints(const PixelBlock& block, unsigned int channelCount, const float* mean, const float* axis, float* endpoint0, float* endpoint1)
+		{
+			float minProjection = 0.f;
+			float maxProjection = 0.f;
+			for (unsigned int i = 0; i < 16; ++i)
+			{
+				float projection = 0.f;
+				for (unsigned int c = 0; c < channelCount; ++c)
+					projection += (block.channels[c][i] - mean[c]) * axis[c];
+
+				minProjection = std::min(minProjection, projection);
+				maxProjection = std::max(maxProjection, projection);
+			}
+
+			for (unsigned int c = 0; c < channelCount; ++c)
+			{
+				endpoint0[c] = Clamp(mean[c] + maxProjection * axis[c], 0.f, 255.f);
+				endpoint1[c] = Clamp(mean[c] + minProjection * axis[c], 0.f, 255.f);
+			}
+		}
+
+		// Least-squares endpoints for the interpolation weight of each pixel (zero for the first endpoint, one for the second)
+		bool RefineEndpoints(const PixelBlock& block, unsigned int channelCount, const float* weights, float* endpoint0, float* endpoint1)
+		{
+			float a = 0.f;
+			float b = 0.f;
+			float c = 0.f;
+			float sums0[4] = {0.f, 0.f, 0.f, 0.f};
+			float sums1[4] = {0.f, 0.f, 0.f, 0.f};
+			for (unsigned int i = 0; i < 16; ++i)
+			{
+				float weight = weights[i];
+				float invWeight = 1.f - weight;
+
+				a += invWeight * invWeight;
+				b += invWeight * weight;
+				c += weight * weight;
+
+				for (unsigned int channel = 0; channel < channelCount; ++channel)
+				{
+					sums0[channel] += invWeight * block.channels[channel][i];
+					sums1[channel] += weight * block.channels[channel][i];
+				}
+			}
+
+			float determinant = a * c - b * b;
+			if (std::abs(determinant) < 0.0001f)
+				return false;
+
+			for (unsigned int channel = 0; channel < channelCount; ++channel)
+			{
+				endpoint0[channel] = Clamp((c * sums0[channel] - b * sums1[channel]) / determinant, 0.f, 255.f);
+				endpoint1[channel] = Clamp((a * sums1[channel] - b * sums0[channel]) / determinant, 0.f, 255.f);
+			}
+
+			return true;
+		}
+
+		/*********************************BC1 color*********************************/
+		inline UInt16 PackRGB565(const float* color)
+		{
+			return static_cast<UInt16>((static_cast<UInt16>(color[0] * 31.f / 255.f + 0.5f) << 11) |
+			                           (static_cast<UInt16>(color[1] * 63.f / 255.f + 0.5f) << 5)  |
+			                           (static_cast<UInt16>(color[2] * 31.f / 255.f + 0.5f) << 0));
+		}
+
+		inline void UnpackRGB565(UInt16 color, float* rgb)
+		{
+			unsigned int r = (color >> 11) & 0x1F;
+			unsigned int g = (color >> 5) & 0x3F;
+			unsigned int b = color & 0x1F;
+
+			rgb[0] = float((r << 3) | (r >> 2));
+			rgb[1] = float((g << 2) | (g >> 4));
+			rgb[2] = float((b << 3) | (b >> 2));
+		}
+
+		void ComputeColorPalette(UInt16 color0, UInt16 color1, float (*palette)[4])
+		{
+			UnpackRGB565(color0, palette[0]);
+			UnpackRGB565(color1, palette[1]);
+
+			for (unsigned int c = 0; c < 3; ++c)
+			{
+				palette[2][c] = (2.f * palette[0][c] + palette[1][c]) / 3.f;
+				palette[3][c] = (palette[0][c] + 2.f * palette[1][c]) / 3.f;
+			}
+		}
+
+		// Endpoints of 5 or 6 bits whose first interpolated value best matches every 8 bits value, for blocks of a single color
+		struct SingleColorTable
+		{
+			SingleColorTable(unsigned int bits)
+			{
+				unsigned int maxValue = (1U << bits) - 1;
+				auto Expand = [bits](unsigned int value)
+				{
+					return float((value << (8 - bits)) | (value >> (2 * bits - 8)));
+				};
+
+				for (unsigned int value = 0; value < 256; ++value)
+				{
+					float bestError = std::numeric_limits<float>::max();
+					for (unsigned int e0 = 0; e0 <= maxValue; ++e0)
+					{
+						for (unsigned int e1 = 0; e1 <= maxValue; ++e1)
+						{
+							float error = std::abs((2.f * Expand(e0) + Expand(e1)) / 3.f - value);
+							if (error < bestError)
+							{
+								bestError = error;
+								endpoints[value][0] = static_cast<UInt8>(e0);
+								endpoints[value][1] = static_cast<UInt8>(e1);
+							}
+						}
+					}
+				}
+			}
+
+			UInt8 endpoints[256][2];
+		};
+
+		void WriteColorBlock(UInt16 color0, UInt16 color1, UInt8* indices, UInt8* dst)
+		{
+			// The four colors mode requires color0 > color1
+			if (color0 < color1)
+			{
+				std::swap(color0, color1);
+				for (unsigned int i = 0; i < 16; ++i)
+					indices[i] ^= 1;
+			}
+			else if (color0 == color1)
+				std::fill(indices, indices + 16, UInt8(0));
+
+			UInt32 bits = 0;
+			for (unsigned int i = 0; i < 16; ++i)
+				bits |= UInt32(indices[i]) << (2 * i);
+
+			dst[0] = static_cast<UInt8>(color0 & 0xFF);
+			dst[1] = static_cast<UInt8>(color0 >> 8);
+			dst[2] = static_cast<UInt8>(color1 & 0xFF);
+			dst[3] = static_cast<UInt8>(color1 >> 8);
+			for (unsigned int i = 0; i < 4; ++i)
+				dst[4 + i] = static_cast<UInt8>(bits >> (8 * i));
+		}
+
+		void EncodeColorBlock(const PixelBlock& block, UInt8* dst, CompressionQuality quality)
+		{
+			float mean[3];
+			float axis[3];
+			ComputePrincipalAxis(block, 3, mean, axis);
+
+			UInt8 indices[16];
+			if (axis[0] == 0.f && axis[1] == 0.f && axis[2] == 0.f)
+			{
+				static const SingleColorTable table5(5);
+				static const SingleColorTable table6(6);
+
+				unsigned int r = static_cast<unsigned int>(block.channels[0][0]);
+				unsigned int g = static_cast<unsigned int>(block.channels[1][0]);
+				unsigned int b = static_cast<unsigned int>(block.channels[2][0]);
+
+				UInt16 color0 = static_cast<UInt16>((table5.endpoints[r][0] << 11) | (table6.endpoints[g][0] << 5) | table5.endpoints[b][0]);
+				UInt16 color1 = static_cast<UInt16>((table5.endpoints[r][1] << 11) | (table6.endpoints[g][1] << 5) | table5.endpoints[b][1]);
+
+				std::fill(indices, indices + 16, UInt8(2));
+				WriteColorBlock(color0, color1, indices, dst);
+				return;
+			}
+
+			float endpoint0[3];
+			float endpoint1[3];
+			ComputeAxisEndpoints(block, 3, mean, axis, endpoint0, endpoint1);
+
+			UInt16 color0 = PackRGB565(endpoint0);
+			UInt16 color1 = PackRGB565(endpoint1);
+
+			float palette[4][4];
+			ComputeColorPalette(color0, color1, palette);
+			float error = FindClosestIndices(block, 0, 3, palette, 4, indices);
+
+			for (unsigned int iteration = 0; iteration < s_refinementCounts[quality] && error > 0.f; ++iteration)
+			{
+				float weights[16];
+				for (unsigned int i = 0; i < 16; ++i)
+					weights[i] = s_colorWeights[indices[i]];
+
+				if (!RefineEndpoints(block, 3, weights, endpoint0, endpoint1))
+					break;
+
+				UInt16 newColor0 = PackRGB565(endpoint0);
+				UInt16 newColor1 = PackRGB565(endpoint1);
+				if (newColor0 == color0 && newColor1 == color1)
+					break;
+
+				UInt8 newIndices[16];
+				ComputeColorPalette(newColor0, newColor1, palette);
+				float newError = FindClosestIndices(block, 0, 3, palette, 4, newIndices);
+				if (newError >= error)
+					break;
+
+				color0 = newColor0;
+				color1 = newColor1;
+				error = newError;
+				std::copy(newIndices, newIndices + 16, indices);
+			}
+
+			WriteColorBlock(color0, color1, indices, dst);
+		}
+
+		/****************************BC4 single channel****************************/
+		void ComputeSingleChannelPalette(UInt8 value0, UInt8 value1, float (*palette)[4])
+		{
+			palette[0][0] = value0;
+			palette[1][0] = value1;
+
+			if (value0 > value1)
+			{
+				for (unsigned int i = 1; i < 7; ++i)
+					palette[i + 1][0] = ((7 - i) * value0 + i * value1) / 7.f;
+			}
+			else
+			{
+				for (unsigned int i = 1; i < 5; ++i)
+					palette[i + 1][0] = ((5 - i) * value0 + i * value1) / 5.f;
+
+				palette[6][0] = 0.f;
+				palette[7][0] = 255.f;
+			}
+		}
+
+		void EncodeSingleChannelBlock(const PixelBlock& block, unsigned int channel, UInt8* dst, CompressionQuality quality)
+		{
+			UInt8 minValue = 255;
+			UInt8 maxValue = 0;
+			UInt8 innerMinValue = 255;
+			UInt8 innerMaxValue = 0;
+			for (unsigned int i = 0; i < 16; ++i)
+			{
+				UInt8 value = static_cast<UInt8>(block.channels[channel][i]);
+				minValue = std::min(minValue, value);
+				maxValue = std::max(maxValue, value);
+
+				if (value > 0 && value < 255)
+				{
+					innerMinValue = std::min(innerMinValue, value);
+					innerMaxValue = std::max(innerMaxValue, value);
+				}
+			}
+
+			UInt8 bestValues[2];
+			UInt8 bestIndices[16];
+			float bestError = std::numeric_limits<float>::max();
+
+			auto TryEndpoints = [&](UInt8 value0, UInt8 value1)
+			{
+				float palette[8][4];
+				ComputeSingleChannelPalette(value0, value1, palette);
+
+				UInt8 indices[16];
+				float error = FindClosestIndices(block, channel, 1, palette, 8, indices);
+				if (error < bestError)
+				{
+					bestError = error;
+					bestValues[0] = value0;
+					bestValues[1] = value1;
+					std::copy(indices, indices + 16, bestIndices);
+				}
+			};
+
+			// Eight values interpolated between the extremities
+			TryEndpoints(maxValue, minValue);
+
+			// Six interpolated values plus exact 0 and 255, better for blocks mixing extreme and intermediate values
+			if (quality >= CompressionQuality_Normal && bestError > 0.f && innerMinValue <= innerMaxValue && (minValue == 0 || maxValue == 255))
+				TryEndpoints(innerMinValue, innerMaxValue);
+
+			// Endpoints slightly inside of the range often lower the error of the other pixels
+			if (quality >= CompressionQuality_High && bestError > 0.f)
+			{
+				for (unsigned int inset0 = 0; inset0 < 4; ++inset0)
+				{
+					for (unsigned int inset1 = 0; inset1 < 4; ++inset1)
+					{
+						int value0 = maxValue - int(inset0);
+						int value1 = minValue + int(inset1);
+						if ((inset0 != 0 || inset1 != 0) && value0 > value1)
+							TryEndpoints(static_cast<UInt8>(value0), static_cast<UInt8>(value1));
+					}
+				}
+			}
+
+			UInt64 bits = 0;
+			for (unsigned int i = 0; i < 16; ++i)
+				bits |= UInt64(bestIndices[i]) << (3 * i);
+
+			dst[0] = bestValues[0];
+			dst[1] = bestValues[1];
+			for (unsigned int i = 0; i < 6; ++i)
+				dst[2 + i] = static_cast<UInt8>(bits >> (8 * i));
+		}
+
+		/*****************************BC2 explicit alpha****************************/
+		void EncodeExplicitAlphaBlock(const PixelBlock& block, UInt8* dst)
+		{
+			for (unsigned int i = 0; i < 8; ++i)
+			{
+				unsigned int alpha0 = static_cast<unsigned int>(block.channels[3][2 * i] * 15.f / 255.f + 0.5f);
+				unsigned int alpha1 = static_cast<unsigned int>(block.channels[3][2 * i + 1] * 15.f / 255.f + 0.5f);
+
+				dst[i] = static_cast<UInt8>(alpha0 | (alpha1 << 4));
+			}
+		}
+
+		/***********************************BC7************************************/
+		// Only mode 6 is used: a single pair of RGBA endpoints with 7 bits per channel plus a p-bit, and 4 bits indices
+		struct BC7Endpoint
+		{
+			UInt8 values[4];
+			UInt8 pBit;
+		};
+
+		BC7Endpoint QuantizeBC7Endpoint(const float* endpoint)
+		{
+			BC7Endpoint bestEndpoint;
+			float bestError = std::numeric_limits<float>::max();
+
+			for (UInt8 pBit = 0; pBit < 2; ++pBit)
+			{
+				BC7Endpoint quantized;
+				quantized.pBit = pBit;
+
+				float error = 0.f;
+				for (unsigned int c = 0; c < 4; ++c)
+				{
+					int value = Clamp(static_cast<int>((endpoint[c] - pBit) / 2.f + 0.5f), 0, 127);
+					quantized.values[c] = static_cast<UInt8>(value);
+
+					float diff = endpoint[c] - float((value << 1) | pBit);
+					error += diff * diff;
+				}
+
+				if (error < bestError)
+				{
+					bestError = error;
+					bestEndpoint = quantized;
+				}
+			}
+
+			return bestEndpoint;
+		}
+
+		void ComputeBC7Palette(const BC7Endpoint& endpoint0, const BC7Endpoint& endpoint1, float (*palette)[4])
+		{
+			for (unsigned int c = 0; c < 4; ++c)
+			{
+				unsigned int value0 = (endpoint0.values[c] << 1) | endpoint0.pBit;
+				unsigned int value1 = (endpoint1.values[c] << 1) | endpoint1.pBit;
+
+				for (unsigned int i = 0; i < 16; ++i)
+					palette[i][c] = float(((64 - s_bc7Weights[i]) * value0 + s_bc7Weights[i] * value1 + 32) >> 6);
+			}
+		}
+
+		void EncodeBC7Block(const PixelBlock& block, UInt8* dst, CompressionQuality quality)
+		{
+			float mean[4];
+			float axis[4];
+			ComputePrincipalAxis(block, 4, mean, axis);
+
+			float endpoints[2][4];
+			ComputeAxisEndpoints(block, 4, mean, axis, endpoints[0], endpoints[1]);
+
+			BC7Endpoint endpoint0 = QuantizeBC7Endpoint(endpoints[0]);
+			BC7Endpoint endpoint1 = QuantizeBC7Endpoint(endpoints[1]);
+
+			float palette[16][4];
+			ComputeBC7Palette(endpoint0, endpoint1, palette);
+
+			UInt8 indices[16];
+			float error = FindClosestIndices(block, 0, 4, palette, 16, indices);
+
+			for (unsigned int iteration = 0; iteration < s_refinementCounts[quality] && error > 0.f; ++iteration)
+			{
+				float weights[16];
+				for (unsigned int i = 0; i < 16; ++i)
+					weights[i] = s_bc7Weights[indices[i]] / 64.f;
+
+				if (!RefineEndpoints(block, 4, weights, endpoints[0], endpoints[1]))
+					break;
+
+				BC7Endpoint newEndpoint0 = QuantizeBC7Endpoint(endpoints[0]);
+				BC7Endpoint newEndpoint1 = QuantizeBC7Endpoint(endpoints[1]);
+
+				UInt8 newIndices[16];
+				ComputeBC7Palette(newEndpoint0, newEndpoint1, palette);
+				float newError = FindClosestIndices(block, 0, 4, palette, 16, newIndices);
+				if (newError >= error)
+					break;
+
+				endpoint0 = newEndpoint0;
+				endpoint1 = newEndpoint1;
+				error = newError;
+				std::copy(newIndices, newIndices + 16, indices);
+			}
+
+			// The index of the first pixel is stored without its most significant bit, which must be zero
+			if (indices[0] & 8)
+			{
+				std::swap(endpoint0, endpoint1);
+				for (unsigned int i = 0; i < 16; ++i)
+					indices[i] = 15 - indices[i];
+			}
+
+			std::memset(dst, 0, 16);
+
+			unsigned int bitOffset = 0;
+			auto WriteBits = [&](unsigned int value, unsigned int bitCount)
+			{
+				for (unsigned int i = 0; i < bitCount; ++i, ++bitOffset)
+				{
+					if (value & (1U << i))
+						dst[bitOffset / 8] |= static_cast<UInt8>(1U << (bitOffset % 8));
+				}
+			};
+
+			WriteBits(1U << 6, 7); // Mode 6
+
+			for (unsigned int c = 0; c < 4; ++c)
+			{
+				WriteBits(endpoint0.values[c], 7);
+				WriteBits(endpoint1.values[c], 7);
+			}
+
+			WriteBits(endpoint0.pBit, 1);
+			WriteBits(endpoint1.pBit, 1);
+
+			WriteBits(indices[0], 3);
+			for (unsigned int i = 1; i < 16; ++i)
+				WriteBits(indices[i], 4);
+		}
+
+		/********************************Formats**********************************/
+		void EncodeBC4Block(const PixelBlock& block, UInt8* dst, CompressionQuality quality)
+		{
+			EncodeSingleChannelBlock(block, 0, dst, quality);
+		}
+
+		void EncodeBC5Block(const PixelBlock& block, UInt8* dst, CompressionQuality quality)
+		{
+			EncodeSingleChannelBlock(block, 0, &dst[0], quality);
+			EncodeSingleChannelBlock(block, 1, &dst[8], quality);
+		}
+
+		void EncodeDXT1Block(const PixelBlock& block, UInt8* dst, CompressionQuality quality)
+		{
+			EncodeColorBlock(block, dst, quality);
+		}
+
+		void EncodeDXT3Block(const PixelBlock& block, UInt8* dst, CompressionQuality quality)
+		{
+			EncodeExplicitAlphaBlock(block, &dst[0]);
+			EncodeColorBlock(block, &dst[8], quality);
+		}
+
+		void EncodeDXT5Block(const PixelBlock& block, UInt8* dst, CompressionQuality quality)
+		{
+			EncodeSingleChannelBlock(block, 3, &dst[0], quality);
+			EncodeColorBlock(block, &dst[8], quality);
 		}
 
 		template<PixelFormatType format1, PixelFormatType format2>
@@ -1268,6 +2090,105 @@ namespace Nz
 		}
 	}
 
+	bool PixelFormat::Compress(PixelFormatType srcFormat, PixelFormatType dstFormat, unsigned int width, unsigned int height, const void* src, void* dst, CompressionQuality quality)
+	{
+		#if NAZARA_UTILITY_SAFE
+		if (!IsCompressionSupported(srcFormat, dstFormat))
+		{
+			NazaraError("Compression from " + GetName(srcFormat) + " to " + GetName(dstFormat) + " is not supported");
+			return false;
+		}
+
+		if (quality > CompressionQuality_Max)
+		{
+			NazaraError("Compression quality out of enum (0x" + String::Number(quality, 16) + ')');
+			return false;
+		}
+		#endif
+
+		BlockEncoder encoder;
+		std::size_t blockSize;
+		switch (dstFormat)
+		{
+			case PixelFormatType_BC4:
+				encoder = &EncodeBC4Block;
+				blockSize = 8;
+				break;
+
+			case PixelFormatType_BC5:
+				encoder = &EncodeBC5Block;
+				blockSize = 16;
+				break;
+
+			case PixelFormatType_BC7:
+				encoder = &EncodeBC7Block;
+				blockSize = 16;
+				break;
+
+			case PixelFormatType_DXT1:
+				encoder = &EncodeDXT1Block;
+				blockSize = 8;
+				break;
+
+			case PixelFormatType_DXT3:
+				encoder = &EncodeDXT3Block;
+				blockSize = 16;
+				break;
+
+			case PixelFormatType_DXT5:
+				encoder = &EncodeDXT5Block;
+				blockSize = 16;
+				break;
+
+			default:
+				NazaraError("Compression to " + GetName(dstFormat) + " is not supported");
+				return false;
+		}
+
+		const UInt8* srcPixels = static_cast<const UInt8*>(src);
+		UInt8* dstBlocks = static_cast<UInt8*>(dst);
+		std::size_t srcRowSize = width * GetBytesPerPixel(srcFormat);
+
+		// Other formats are converted to RGBA8 one row of blocks at a time, in the arena of the thread as Image::Convert compresses rows from multiple tasks
+		std::vector<UInt8, FrameArenaAllocator<UInt8>> convertedRows(FrameArena::GetThreadArena());
+		if (srcFormat != PixelFormatType_RGBA8)
+			convertedRows.resize(width * 4 * 4);
+
+		for (unsigned int y = 0; y < height; y += 4)
+		{
+			unsigned int rowCount = std::min(height - y, 4U);
+
+			const UInt8* rows = &srcPixels[y * srcRowSize];
+			if (!convertedRows.empty())
+			{
+				if (!Convert(srcFormat, PixelFormatType_RGBA8, rows, &rows[rowCount * srcRowSize], convertedRows.data()))
+					return false;
+
+				rows = convertedRows.data();
+			}
+
+			for (unsigned int x = 0; x < width; x += 4)
+			{
+				// Blocks crossing the borders of the image repeat the last pixels
+				PixelBlock block;
+				for (unsigned int i = 0; i < 16; ++i)
+				{
+					unsigned int pixelX = std::min(x + i % 4, width - 1);
+					unsigned int pixelY = std::min(i / 4, rowCount - 1);
+
+					const UInt8* pixel = &rows[(pixelY * width + pixelX) * 4];
+					for (unsigned int c = 0; c < 4; ++c)
+						block.channels[c][i] = pixel[c];
+				}
+
+				encoder(block, dstBlocks, quality);
+				dstBlocks += blockSize;
+			}
+		}
+
+		return true;
+	}
+
 	bool PixelFormat::Flip(PixelFlipping flipping, PixelFormatType format, unsigned int width, unsigned int height, unsigned int depth, const void* src, void* dst)
 	{
 		#if NAZARA_UTILITY_SAFE
@@ -1385,6 +2306,9 @@ namespace Nz
 
 		// Setup informations about every pixel format
 		s_pixelFormatInfos[PixelFormatType_A8]              = PixelFormatInfo("A8",              PixelFormatContent_ColorRGBA,    0,                  0,                  0,                  0xFF,               PixelFormatSubType_Unsigned);
+		s_pixelFormatInfos[PixelFormatType_BC4]             = PixelFormatInfo("BC4",             PixelFormatContent_ColorRGBA,    8,                                                                              PixelFormatSubType_Compressed);
+		s_pixelFormatInfos[PixelFormatType_BC5]             = PixelFormatInfo("BC5",             PixelFormatContent_ColorRGBA,    16,                                                                             PixelFormatSubType_Compressed);
+		s_pixelFormatInfos[PixelFormatType_BC7]             = PixelFormatInfo("BC7",             PixelFormatContent_ColorRGBA,    16,                                                                             PixelFormatSubType_Compressed);
 		s_pixelFormatInfos[PixelFormatType_BGR8]            = PixelFormatInfo("BGR8",            PixelFormatContent_ColorRGBA,    0x0000FF,           0x00FF00,           0xFF0000,           0,                  PixelFormatSubType_Unsigned);
 		s_pixelFormatInfos[PixelFormatType_BGRA8]           = PixelFormatInfo("BGRA8",           PixelFormatContent_ColorRGBA,    0x0000FF00,         0x00FF0000,         0xFF000000,         0x000000FF,         PixelFormatSubType_Unsigned);
 		s_pixelFormatInfos[PixelFormatType_DXT1]            = PixelFormatInfo("DXT1",            PixelFormatContent_ColorRGBA,    8,                                                                              PixelFormatSubType_Compressed);
@@ -1663,6 +2587,10 @@ namespace Nz
 		RegisterConverter<PixelFormatType_RGBA8, PixelFormatType_RGB8>();
 		RegisterConverter<PixelFormatType_RGBA8, PixelFormatType_RGBA4>();
 
+		#ifdef NAZARA_UTILITY_PIXELFORMAT_SSE
+		RegisterSIMDConverters();
+		#endif
+
 		return true;
 	}
 
@@ -16,10 +16,13 @@
 #include <Nazara/Utility/Skeleton.hpp>
 #include <Nazara/Utility/VertexDeclaration.hpp>
 #include <Nazara/Utility/Formats/DDSLoader.hpp>
+#include <Nazara/Utility/Formats/DDSSaver.hpp>
 #include <Nazara/Utility/Formats/FreeTypeLoader.hpp>
 #include <Nazara/Utility/Formats/MD2Loader.hpp>
 #include <Nazara/Utility/Formats/MD5AnimLoader.hpp>
 #include <Nazara/Utility/Formats/MD5MeshLoader.hpp>
+#include <Nazara/Utility/Formats/NMeshLoader.hpp>
+#include <Nazara/Utility/Formats/NMeshSaver.hpp>
 #include <Nazara/Utility/Formats/OBJLoader.hpp>
 #include <Nazara/Utility/Formats/OBJSaver.hpp>
 #include <Nazara/Utility/Formats/PCXLoader.hpp>
@@ -120,6 +123,7 @@ namespace Nz
 
 		// Image
 		Loaders::RegisterDDSLoader(); // DDS Loader (DirectX format)
+		Loaders::RegisterDDSSaver();  // DDS Saver (DirectX format)
 		Loaders::RegisterSTBLoader(); // Generic loader (STB)
 		Loaders::RegisterSTBSaver();  // Generic saver (STB)
 
@@ -134,6 +138,8 @@ namespace Nz
 		// Mesh
 		Loaders::RegisterMD2(); // Loader de fichiers .md2 (v8)
 		Loaders::RegisterMD5Mesh(); // Loader de fichiers .md5mesh (v10)
+		Loaders::RegisterNMeshLoader(); // Binary mesh loader (.nmesh)
+		Loaders::RegisterNMeshSaver();  // Binary mesh saver (.nmesh)
 		Loaders::RegisterOBJLoader(); // Loader de fichiers .md5mesh (v10)
 
 		// Image
@@ -164,10 +170,13 @@ namespace Nz
 		// Libération du module
 		s_moduleReferenceCounter = 0;
 
+		Loaders::UnregisterDDSSaver();
 		Loaders::UnregisterFreeType();
 		Loaders::UnregisterMD2();
 		Loaders::UnregisterMD5Anim();
 		Loaders::UnregisterMD5Mesh();
+		Loaders::UnregisterNMeshLoader();
+		Loaders::UnregisterNMeshSaver();
 		Loaders::UnregisterOBJLoader();
 		Loaders::UnregisterOBJSaver();
 		Loaders::UnregisterPCX();
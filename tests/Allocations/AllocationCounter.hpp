@@ -0,0 +1,11 @@
+#pragma once
+
+#ifndef NAZARA_UNITTESTS_ALLOCATIONCOUNTER_HPP
+#define NAZARA_UNITTESTS_ALLOCATIONCOUNTER_HPP
+
+#include <cstddef>
+
+// Number of calls to the global allocation functions since the start of the program
+std::size_t GetAllocationCount();
+
+#endif // NAZARA_UNITTESTS_ALLOCATIONCOUNTER_HPP
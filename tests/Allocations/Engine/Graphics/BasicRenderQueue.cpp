@@ -0,0 +1,120 @@
+#include <Nazara/Graphics/BasicRenderQueue.hpp>
+#include <Nazara/Core/String.hpp>
+#include <Nazara/Graphics/Drawable.hpp>
+#include <Nazara/Graphics/Material.hpp>
+#include <Nazara/Utility/VertexStruct.hpp>
+#include <AllocationCounter.hpp>
+#include <Catch/catch.hpp>
+#include <array>
+#include <vector>
+
+namespace
+{
+	class TestDrawable : public Nz::Drawable
+	{
+		public:
+			void Draw() const override
+			{
+			}
+	};
+
+	struct Scene
+	{
+		std::size_t entryCount;
+		std::size_t unkeyedDrawableCount;
+		std::size_t spriteCount;
+	};
+
+	constexpr std::size_t DrawablePerEntry = 4;
+	constexpr int LayerCount = 4;
+
+	// Mimics the RenderSystem update of a forward render queue: most drawables are reused, one of them changes every frame
+	std::size_t RenderFrame(Nz::BasicRenderQueue& renderQueue, const Scene& scene, const std::vector<TestDrawable>& drawables, const Nz::Material* material, unsigned int frame)
+	{
+		static std::array<Nz::VertexStruct_XYZ_Color_UV, 4> spriteVertices;
+
+		renderQueue.ClearUnkeyedData();
+
+		for (std::size_t i = 0; i < scene.entryCount; ++i)
+		{
+			const TestDrawable* entryDrawables = &drawables[i * DrawablePerEntry];
+
+			Nz::UInt64 revision = frame / scene.entryCount + ((i <= frame % scene.entryCount) ? 1 : 0); //< Incremented when frame % entryCount == i
+			if (Nz::BasicRenderQueue* entryQueue = renderQueue.UpdateEntry(entryDrawables, revision))
+			{
+				for (std::size_t j = 0; j < DrawablePerEntry; ++j)
+					entryQueue->AddDrawable(static_cast<int>(i % LayerCount), &entryDrawables[j]);
+			}
+		}
+
+		renderQueue.RemoveUnusedEntries();
+
+		for (std::size_t i = 0; i < scene.unkeyedDrawableCount; ++i)
+			renderQueue.AddDrawable(static_cast<int>(i % LayerCount), &drawables[scene.entryCount * DrawablePerEntry + i]);
+
+		for (std::size_t i = 0; i < scene.spriteCount; ++i)
+			renderQueue.AddSprites(static_cast<int>(i % LayerCount), material, spriteVertices.data(), 1, Nz::Recti(-1, -1));
+
+		renderQueue.Sort(nullptr);
+
+		std::size_t drawableCount = 0;
+		for (const Nz::BasicRenderQueue::CustomDrawable& customDrawable : renderQueue.customDrawables)
+		{
+			if (customDrawable.drawable)
+				drawableCount++;
+		}
+
+		return drawableCount;
+	}
+}
+
+SCENARIO("BasicRenderQueue allocations", "[GRAPHICS][BASICRENDERQUEUE]")
+{
+	// Radix sorts are used from 256 elements, merge sorts below and insertion sorts for the smallest queues
+	std::array<Scene, 3> scenes = {{
+		{10, 20, 10},     //< Small queues
+		{500, 1000, 100}, //< Big drawable queue, small sprite queue
+		{500, 1000, 1000} //< Big queues
+	}};
+
+	Nz::MaterialRef material = Nz::Material::New();
+
+	for (const Scene& scene : scenes)
+	{
+		std::size_t drawableCount = scene.entryCount * DrawablePerEntry + scene.unkeyedDrawableCount;
+
+		GIVEN("A render queue with " + Nz::String::Number(drawableCount).ToStdString() + " drawables and " + Nz::String::Number(scene.spriteCount).ToStdString() + " sprites")
+		{
+			std::vector<TestDrawable> drawables(drawableCount);
+
+			Nz::BasicRenderQueue renderQueue;
+
+			WHEN("We render the same scene for some frames")
+			{
+				// The first frames fill the queue and its arena
+				unsigned int frame = 1;
+				for (; frame < 4; ++frame)
+					RenderFrame(renderQueue, scene, drawables, material, frame);
+
+				std::size_t allocationCount = GetAllocationCount();
+
+				bool everythingDrawn = true;
+				for (; frame < 20; ++frame)
+				{
+					everythingDrawn = everythingDrawn && RenderFrame(renderQueue, scene, drawables, material, frame) == drawables.size();
+					everythingDrawn = everythingDrawn && renderQueue.basicSprites.size() == scene.spriteCount;
+				}
+
+				allocationCount = GetAllocationCount() - allocationCount;
+
+				THEN("Steady-state frames don't allocate memory")
+				{
+					CHECK(everythingDrawn);
+					CHECK(renderQueue.GetRebuiltEntryCount() == 1);
+					CHECK(renderQueue.GetReusedEntryCount() == scene.entryCount - 1);
+					CHECK(allocationCount == 0);
+				}
+			}
+		}
+	}
+}
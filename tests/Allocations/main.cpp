@@ -0,0 +1,171 @@
+#define CATCH_CONFIG_RUNNER
+#include <Catch/catch.hpp>
+
+#include <AllocationCounter.hpp>
+#include <Nazara/Core/Initializer.hpp>
+#include <Nazara/Graphics/Graphics.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	std::atomic<std::size_t> s_allocationCount(0);
+
+	void* Allocate(std::size_t size)
+	{
+		s_allocationCount++;
+
+		return std::malloc((size > 0) ? size : 1);
+	}
+
+	#ifdef __cpp_aligned_new
+	// The malloc'd pointer is stored right before the aligned one, to be freed later
+	void* AllocateAligned(std::size_t size, std::align_val_t alignment)
+	{
+		std::size_t align = std::max(static_cast<std::size_t>(alignment), alignof(void*));
+
+		void* basePointer = Allocate(size + align + sizeof(void*));
+		if (!basePointer)
+			return nullptr;
+
+		std::uintptr_t address = (reinterpret_cast<std::uintptr_t>(basePointer) + sizeof(void*) + align - 1) & ~(align - 1);
+
+		void** pointer = reinterpret_cast<void**>(address);
+		pointer[-1] = basePointer;
+
+		return pointer;
+	}
+
+	void FreeAligned(void* pointer)
+	{
+		if (pointer)
+			std::free(static_cast<void**>(pointer)[-1]);
+	}
+	#endif
+}
+
+std::size_t GetAllocationCount()
+{
+	return s_allocationCount.load();
+}
+
+int main(int argc, char* argv[])
+{
+	Nz::Initializer<Nz::Graphics> modules;
+
+	return Catch::Session().run(argc, argv);
+}
+
+// Every replaceable allocation function is counted, as the standard library may call any of them
+void* operator new(std::size_t size)
+{
+	if (void* pointer = Allocate(size))
+		return pointer;
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	return Allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	return Allocate(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+	std::free(pointer);
+}
+
+#ifdef __cpp_sized_deallocation
+void operator delete(void* pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+#endif
+
+#ifdef __cpp_aligned_new
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	if (void* pointer = AllocateAligned(size, alignment))
+		return pointer;
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+	return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return AllocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return AllocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+	FreeAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept
+{
+	FreeAligned(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept
+{
+	FreeAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept
+{
+	FreeAligned(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	FreeAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	FreeAligned(pointer);
+}
+#endif
@@ -0,0 +1,234 @@
+#include <Nazara/Core/AsyncFileReader.hpp>
+#include <Nazara/Core/Directory.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/ReadAheadFile.hpp>
+#include <Nazara/Core/TaskGroup.hpp>
+#include <Catch/catch.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <future>
+#include <vector>
+
+namespace
+{
+	std::vector<Nz::UInt8> GenerateContent(std::size_t size, unsigned int seed)
+	{
+		std::vector<Nz::UInt8> content(size);
+		for (std::size_t i = 0; i < size; ++i)
+			content[i] = static_cast<Nz::UInt8>((i * 31 + seed) ^ (i >> 8));
+
+		return content;
+	}
+
+	void WriteFile(const Nz::String& filePath, const std::vector<Nz::UInt8>& content)
+	{
+		Nz::File file(filePath, Nz::OpenMode_WriteOnly | Nz::OpenMode_Truncate);
+		file.Write(content.data(), content.size());
+	}
+
+	bool Matches(const Nz::ByteArray& data, const std::vector<Nz::UInt8>& content, std::size_t offset)
+	{
+		return offset + data.GetSize() <= content.size() && std::memcmp(data.GetConstBuffer(), &content[offset], data.GetSize()) == 0;
+	}
+}
+
+SCENARIO("AsyncFileReader", "[CORE][ASYNCFILEREADER]")
+{
+	GIVEN("A file on disk")
+	{
+		const Nz::String filePath = "AsyncFileReaderTest.bin";
+		std::vector<Nz::UInt8> content = GenerateContent(200000, 42);
+		WriteFile(filePath, content);
+
+		WHEN("We read it with futures")
+		{
+			std::future<Nz::AsyncFileReader::Result> wholeFile = Nz::AsyncFileReader::Read(filePath);
+			std::future<Nz::AsyncFileReader::Result> range = Nz::AsyncFileReader::Read(filePath, 1000, 5000);
+			std::future<Nz::AsyncFileReader::Result> end = Nz::AsyncFileReader::Read(filePath, content.size() - 10, 100);
+			std::future<Nz::AsyncFileReader::Result> outside = Nz::AsyncFileReader::Read(filePath, content.size() + 1, 100);
+
+			THEN("We get the requested parts of the file")
+			{
+				Nz::AsyncFileReader::Result result = wholeFile.get();
+				CHECK(result.succeeded);
+				CHECK(result.data.GetSize() == content.size());
+				CHECK(Matches(result.data, content, 0));
+
+				result = range.get();
+				CHECK(result.succeeded);
+				CHECK(result.offset == 1000);
+				CHECK(result.data.GetSize() == 5000);
+				CHECK(Matches(result.data, content, 1000));
+
+				result = end.get();
+				CHECK(result.succeeded);
+				CHECK(result.data.GetSize() == 10);
+				CHECK(Matches(result.data, content, content.size() - 10));
+
+				CHECK(!outside.get().succeeded);
+			}
+		}
+
+		WHEN("We read it with callbacks")
+		{
+			constexpr unsigned int requestCount = 50;
+
+			std::atomic_uint validResultCount(0);
+			Nz::TaskGroup callbackGroup;
+			for (unsigned int i = 0; i < requestCount; ++i)
+			{
+				Nz::AsyncFileReader::Read(filePath, i * 1000, 1000, [&](Nz::AsyncFileReader::Result& result)
+				{
+					if (result.succeeded && result.data.GetSize() == 1000 && Matches(result.data, content, static_cast<std::size_t>(result.offset)))
+						validResultCount++;
+				}, &callbackGroup);
+			}
+
+			Nz::AsyncFileReader::WaitForRequests();
+			callbackGroup.Wait();
+
+			THEN("Every callback got its data")
+			{
+				CHECK(validResultCount == requestCount);
+			}
+		}
+
+		WHEN("We read it through a read-ahead file")
+		{
+			Nz::ReadAheadFile file(filePath, 4096, 3);
+			REQUIRE(file.IsOpen());
+			CHECK(file.GetSize() == content.size());
+
+			THEN("Sequential reads give the file content")
+			{
+				std::vector<Nz::UInt8> readContent(content.size());
+				std::size_t readSize = 0;
+				while (!file.EndOfStream())
+					readSize += file.Read(&readContent[readSize], std::min<std::size_t>(1000, content.size() - readSize));
+
+				CHECK(readSize == content.size());
+				CHECK(readContent == content);
+			}
+
+			AND_THEN("Seeking restarts the read-ahead")
+			{
+				Nz::UInt8 buffer[100];
+
+				CHECK(file.SetCursorPos(150000));
+				CHECK(file.Read(buffer, 100) == 100);
+				CHECK(std::memcmp(buffer, &content[150000], 100) == 0);
+
+				CHECK(file.SetCursorPos(10));
+				CHECK(file.Read(buffer, 100) == 100);
+				CHECK(std::memcmp(buffer, &content[10], 100) == 0);
+
+				CHECK(file.SetCursorPos(content.size() - 50));
+				CHECK(file.Read(buffer, 100) == 50);
+				CHECK(file.EndOfStream());
+			}
+		}
+
+		Nz::AsyncFileReader::WaitForRequests();
+		Nz::File::Delete(filePath);
+	}
+
+	GIVEN("A missing file")
+	{
+		THEN("Reading it fails")
+		{
+			CHECK(!Nz::AsyncFileReader::Read("AsyncFileReaderMissing.bin").get().succeeded);
+
+			Nz::ReadAheadFile file;
+			CHECK(!file.Open("AsyncFileReaderMissing.bin"));
+		}
+	}
+}
+
+TEST_CASE("Asynchronous file reads", "[CORE][ASYNCFILEREADER][.benchmark]")
+{
+	const Nz::String directory = "AsyncFileReaderBenchmark";
+	Nz::Directory::Create(directory);
+
+	struct FileSet
+	{
+		const char* name;
+		std::size_t count;
+		std::size_t size;
+	};
+
+	for (const FileSet& fileSet : { FileSet{ "many small files", 1000, 4 * 1024 }, FileSet{ "a few large files", 4, 16 * 1024 * 1024 } })
+	{
+		std::vector<Nz::String> filePaths;
+		for (std::size_t i = 0; i < fileSet.count; ++i)
+		{
+			filePaths.push_back(directory + NAZARA_DIRECTORY_SEPARATOR + Nz::String::Number(i) + ".bin");
+			WriteFile(filePaths.back(), GenerateContent(fileSet.size, static_cast<unsigned int>(i)));
+		}
+
+		BENCHMARK("Read " + std::string(fileSet.name) + " synchronously")
+		{
+			std::vector<Nz::ByteArray> results;
+			results.reserve(filePaths.size());
+			for (const Nz::String& filePath : filePaths)
+			{
+				Nz::File file(filePath, Nz::OpenMode_ReadOnly);
+
+				results.emplace_back(static_cast<std::size_t>(file.GetSize()), Nz::UInt8(0));
+				file.Read(results.back().GetBuffer(), results.back().GetSize());
+			}
+		}
+
+		BENCHMARK("Read " + std::string(fileSet.name) + " asynchronously")
+		{
+			std::vector<std::future<Nz::AsyncFileReader::Result>> results;
+			results.reserve(filePaths.size());
+			for (const Nz::String& filePath : filePaths)
+				results.emplace_back(Nz::AsyncFileReader::Read(filePath));
+
+			for (std::future<Nz::AsyncFileReader::Result>& result : results)
+				result.wait();
+		}
+
+		std::vector<std::future<Nz::AsyncFileReader::Result>> pendingResults;
+		pendingResults.reserve(filePaths.size());
+
+		// Time during which the caller is blocked
+		BENCHMARK("Submit reads of " + std::string(fileSet.name))
+		{
+			for (const Nz::String& filePath : filePaths)
+				pendingResults.emplace_back(Nz::AsyncFileReader::Read(filePath));
+		}
+
+		Nz::AsyncFileReader::WaitForRequests();
+
+		for (const Nz::String& filePath : filePaths)
+			Nz::File::Delete(filePath);
+	}
+
+	// Sequential reads by small blocks, as done by Music
+	const Nz::String streamPath = directory + NAZARA_DIRECTORY_SEPARATOR + "stream.bin";
+	WriteFile(streamPath, GenerateContent(16 * 1024 * 1024, 0));
+
+	auto ReadStream = [](Nz::Stream& stream)
+	{
+		std::array<Nz::UInt8, 16 * 1024> buffer;
+		while (stream.Read(buffer.data(), buffer.size()) > 0);
+	};
+
+	BENCHMARK("Stream a large file synchronously")
+	{
+		Nz::File file(streamPath, Nz::OpenMode_ReadOnly);
+		ReadStream(file);
+	}
+
+	BENCHMARK("Stream a large file with read-ahead")
+	{
+		Nz::ReadAheadFile file(streamPath);
+		ReadStream(file);
+	}
+
+	Nz::File::Delete(streamPath);
+	Nz::Directory::Remove(directory, true);
+}
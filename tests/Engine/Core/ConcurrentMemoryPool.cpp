@@ -0,0 +1,199 @@
+#include <Nazara/Core/ConcurrentMemoryPool.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/MemoryPool.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Core/String.hpp>
+#include <Catch/catch.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	template<typename F>
+	void RunThreads(unsigned int threadCount, F&& func)
+	{
+		std::vector<std::thread> threads;
+		for (unsigned int i = 0; i < threadCount; ++i)
+			threads.emplace_back(func, i);
+
+		for (std::thread& thread : threads)
+			thread.join();
+	}
+}
+
+SCENARIO("ConcurrentMemoryPool", "[CORE][CONCURRENTMEMORYPOOL]")
+{
+	GIVEN("A pool of small blocks")
+	{
+		Nz::ConcurrentMemoryPool pool(sizeof(int) * 3, 64);
+
+		CHECK(pool.GetBlockSize() >= sizeof(int) * 3);
+		CHECK(pool.GetSize() == 64);
+		CHECK(pool.GetGrowthCount() == 0);
+
+		WHEN("We allocate more blocks than a slab holds")
+		{
+			std::vector<int*> blocks;
+			for (int i = 0; i < 100; ++i)
+				blocks.push_back(pool.New<int>(i));
+
+			THEN("Blocks are distinct and aligned, and the pool grew")
+			{
+				std::vector<int*> sortedBlocks = blocks;
+				std::sort(sortedBlocks.begin(), sortedBlocks.end());
+				CHECK(std::adjacent_find(sortedBlocks.begin(), sortedBlocks.end()) == sortedBlocks.end());
+
+				bool validBlocks = true;
+				for (int i = 0; i < 100; ++i)
+					validBlocks = validBlocks && *blocks[i] == i && reinterpret_cast<std::uintptr_t>(blocks[i]) % alignof(std::max_align_t) == 0;
+
+				CHECK(validBlocks);
+				CHECK(pool.GetGrowthCount() == 1);
+				CHECK(pool.GetSize() == 128);
+				CHECK(pool.GetHighWaterMark() >= 100);
+			}
+
+			AND_THEN("Released blocks are reused without growing the pool")
+			{
+				for (int* block : blocks)
+					pool.Delete(block);
+
+				std::size_t highWaterMark = pool.GetHighWaterMark();
+				for (int i = 0; i < 100; ++i)
+					blocks[i] = pool.New<int>(i);
+
+				CHECK(pool.GetGrowthCount() == 1);
+				CHECK(pool.GetHighWaterMark() == highWaterMark);
+
+				for (int* block : blocks)
+					pool.Delete(block);
+			}
+		}
+	}
+
+	GIVEN("A pool shared by multiple threads")
+	{
+		constexpr unsigned int threadCount = 4;
+		constexpr unsigned int iterationCount = 200;
+		constexpr unsigned int batchSize = 100;
+
+		Nz::ConcurrentMemoryPool pool(sizeof(std::uintptr_t) * 2, 256);
+
+		WHEN("Threads allocate blocks, and release their own blocks and the ones of another thread")
+		{
+			Nz::Mutex exchangeMutex;
+			std::vector<std::uintptr_t*> exchangedBlocks;
+			std::atomic_bool validBlocks(true);
+
+			RunThreads(threadCount, [&](unsigned int threadIndex)
+			{
+				std::vector<std::uintptr_t*> blocks;
+				for (unsigned int i = 0; i < iterationCount; ++i)
+				{
+					for (unsigned int j = 0; j < batchSize; ++j)
+					{
+						std::uintptr_t* block = static_cast<std::uintptr_t*>(pool.Allocate());
+						block[0] = threadIndex;
+						block[1] = reinterpret_cast<std::uintptr_t>(block);
+
+						blocks.push_back(block);
+					}
+
+					// Catch assertions are not thread-safe
+					for (std::uintptr_t* block : blocks)
+					{
+						if (block[0] != threadIndex || block[1] != reinterpret_cast<std::uintptr_t>(block))
+							validBlocks = false;
+					}
+
+					// Half of the blocks are released by another thread
+					std::vector<std::uintptr_t*> foreignBlocks;
+					{
+						Nz::LockGuard lock(exchangeMutex);
+						for (std::size_t j = 0; j < blocks.size() / 2; ++j)
+							exchangedBlocks.push_back(blocks[j]);
+
+						foreignBlocks.swap(exchangedBlocks);
+					}
+
+					for (std::size_t j = blocks.size() / 2; j < blocks.size(); ++j)
+						pool.Free(blocks[j]);
+
+					for (std::uintptr_t* block : foreignBlocks)
+						pool.Free(block);
+
+					blocks.clear();
+				}
+			});
+
+			for (std::uintptr_t* block : exchangedBlocks)
+				pool.Free(block);
+
+			THEN("Every block was valid and is back in the pool once the threads exited")
+			{
+				CHECK(validBlocks);
+				CHECK(pool.GetHighWaterMark() <= pool.GetSize());
+
+				// The main thread cache keeps the blocks it released
+				CHECK(pool.GetUsedBlockCount() <= 2 * Nz::ConcurrentMemoryPool::ThreadCacheSize);
+			}
+		}
+	}
+}
+
+TEST_CASE("ConcurrentMemoryPool stress", "[CORE][CONCURRENTMEMORYPOOL][.benchmark]")
+{
+	constexpr std::size_t blockSize = 64;
+	constexpr unsigned int batchSize = 64;
+	constexpr unsigned int iterationCount = 20000;
+
+	unsigned int threadCount = std::max(std::thread::hardware_concurrency(), 2U);
+
+	auto Stress = [&](auto&& allocate, auto&& free)
+	{
+		RunThreads(threadCount, [&](unsigned int /*threadIndex*/)
+		{
+			void* blocks[batchSize];
+			for (unsigned int i = 0; i < iterationCount; ++i)
+			{
+				for (void*& block : blocks)
+					block = allocate();
+
+				for (void* block : blocks)
+					free(block);
+			}
+		});
+	};
+
+	Nz::String suffix = " (" + Nz::String::Number(threadCount) + " threads)";
+
+	BENCHMARK("Alloc/free with operator new" + suffix.ToStdString())
+	{
+		Stress([&]() { return ::operator new(blockSize); }, [](void* block) { ::operator delete(block); });
+	}
+
+	Nz::Mutex poolMutex;
+	Nz::MemoryPool lockedPool(blockSize, batchSize * threadCount);
+	BENCHMARK("Alloc/free with a locked MemoryPool" + suffix.ToStdString())
+	{
+		Stress([&]()
+		{
+			Nz::LockGuard lock(poolMutex);
+			return lockedPool.Allocate(blockSize);
+		},
+		[&](void* block)
+		{
+			Nz::LockGuard lock(poolMutex);
+			lockedPool.Free(block);
+		});
+	}
+
+	Nz::ConcurrentMemoryPool concurrentPool(blockSize, batchSize * threadCount);
+	BENCHMARK("Alloc/free with a ConcurrentMemoryPool" + suffix.ToStdString())
+	{
+		Stress([&]() { return concurrentPool.Allocate(); }, [&](void* block) { concurrentPool.Free(block); });
+	}
+}
@@ -0,0 +1,150 @@
+#include <Nazara/Core/FrameArena.hpp>
+#include <Nazara/Core/FrameArenaAllocator.hpp>
+#include <Catch/catch.hpp>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+	template<typename T> using FrameVector = std::vector<T, Nz::FrameArenaAllocator<T>>;
+	using FrameMap = std::unordered_map<int, int, std::hash<int>, std::equal_to<int>, Nz::FrameArenaAllocator<std::pair<const int, int>>>;
+
+	int FillContainers(Nz::FrameArena& arena, int elementCount)
+	{
+		arena.Reset();
+
+		FrameVector<int> values(arena);
+		for (int i = 0; i < elementCount; ++i)
+			values.push_back(i);
+
+		FrameMap map(16, std::hash<int>(), std::equal_to<int>(), arena);
+		for (int value : values)
+			map[value % 100] += value;
+
+		return map[42];
+	}
+}
+
+SCENARIO("FrameArena", "[CORE][FRAMEARENA]")
+{
+	GIVEN("A frame arena with small blocks")
+	{
+		Nz::FrameArena arena(256);
+		CHECK(arena.GetBlockCount() == 0);
+
+		WHEN("We allocate memory with various alignments")
+		{
+			void* first = arena.Allocate(3, 1);
+			void* second = arena.Allocate(8, 8);
+			void* third = arena.Allocate(12, 64);
+
+			THEN("Allocations are aligned and don't overlap")
+			{
+				CHECK(reinterpret_cast<std::uintptr_t>(second) % 8 == 0);
+				CHECK(reinterpret_cast<std::uintptr_t>(third) % 64 == 0);
+				CHECK(static_cast<Nz::UInt8*>(second) >= static_cast<Nz::UInt8*>(first) + 3);
+				CHECK(static_cast<Nz::UInt8*>(third) >= static_cast<Nz::UInt8*>(second) + 8);
+				CHECK(arena.GetBlockCount() == 1);
+				CHECK(arena.GetUsedSize() >= 23);
+			}
+
+			AND_THEN("The latest allocation can be given back")
+			{
+				std::size_t usedSize = arena.GetUsedSize();
+				arena.Deallocate(second, 8);
+				CHECK(arena.GetUsedSize() == usedSize);
+
+				arena.Deallocate(third, 12);
+				CHECK(arena.GetUsedSize() < usedSize);
+				CHECK(arena.GetUsedSize() > 0);
+
+				arena.Deallocate(first, 3);
+				CHECK(arena.GetUsedSize() == 0); //< Every allocation was given back
+			}
+		}
+
+		WHEN("A frame needs more than one block")
+		{
+			for (int i = 0; i < 10; ++i)
+				arena.Allocate(100);
+
+			arena.Allocate(1000);
+
+			std::size_t capacity = arena.GetCapacity();
+			CHECK(arena.GetBlockCount() > 1);
+
+			arena.Reset();
+
+			THEN("Reset merges them in a single block")
+			{
+				CHECK(arena.GetBlockCount() == 1);
+				CHECK(arena.GetCapacity() == capacity);
+				CHECK(arena.GetUsedSize() == 0);
+			}
+		}
+	}
+
+	GIVEN("Containers using a frame arena allocator")
+	{
+		Nz::FrameArena arena(1024);
+
+		WHEN("We fill them again and again with the same workload")
+		{
+			int expectedValue = FillContainers(arena, 2000);
+			FillContainers(arena, 2000);
+
+			std::size_t capacity = arena.GetCapacity();
+			bool sameResults = true;
+			for (int frame = 0; frame < 10; ++frame)
+				sameResults = sameResults && FillContainers(arena, 2000) == expectedValue;
+
+			THEN("The arena doesn't grow anymore")
+			{
+				CHECK(sameResults);
+				CHECK(arena.GetBlockCount() == 1);
+				CHECK(arena.GetCapacity() == capacity);
+			}
+		}
+	}
+
+	GIVEN("The thread arena")
+	{
+		Nz::FrameArena* mainThreadArena = &Nz::FrameArena::GetThreadArena();
+
+		WHEN("Containers of multiple threads use it")
+		{
+			FrameVector<int> mainThreadValues(*mainThreadArena);
+			mainThreadValues.push_back(42);
+
+			Nz::FrameArena* otherThreadArena = nullptr;
+			bool otherThreadArenaEmptied = false;
+			std::thread thread([&]()
+			{
+				otherThreadArena = &Nz::FrameArena::GetThreadArena();
+
+				{
+					FrameVector<int> values(*otherThreadArena);
+					values.resize(10000);
+				}
+
+				otherThreadArenaEmptied = otherThreadArena->GetUsedSize() == 0;
+			});
+			thread.join();
+
+			THEN("Each thread has its own arena, reset once its memory is given back")
+			{
+				CHECK(mainThreadArena == &Nz::FrameArena::GetThreadArena());
+				CHECK(otherThreadArena != mainThreadArena);
+				CHECK(otherThreadArenaEmptied);
+				CHECK(mainThreadValues.back() == 42);
+				CHECK(mainThreadArena->GetUsedSize() > 0);
+
+				mainThreadValues = FrameVector<int>(*mainThreadArena);
+				CHECK(mainThreadArena->GetUsedSize() == 0);
+			}
+		}
+	}
+}
@@ -0,0 +1,98 @@
+#include <Nazara/Core/MappedFile.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/MemoryView.hpp>
+#include <Nazara/Utility/Image.hpp>
+#include <Catch/catch.hpp>
+#include <cstring>
+#include <vector>
+
+SCENARIO("MappedFile", "[CORE][MAPPEDFILE]")
+{
+	GIVEN("A file on disk")
+	{
+		const char* filePath = "resources/Engine/Graphics/Nazara.png";
+
+		Nz::File file(filePath, Nz::OpenMode_ReadOnly);
+		REQUIRE(file.IsOpen());
+
+		std::vector<Nz::UInt8> fileContent(static_cast<std::size_t>(file.GetSize()));
+		REQUIRE(file.Read(fileContent.data(), fileContent.size()) == fileContent.size());
+
+		WHEN("We map it")
+		{
+			Nz::MappedFile mappedFile(filePath);
+			REQUIRE(mappedFile.IsOpen());
+
+			THEN("Its content is directly accessible")
+			{
+				CHECK(mappedFile.IsMemoryMapped());
+				CHECK(!mappedFile.IsWritable());
+				CHECK(mappedFile.GetSize() == fileContent.size());
+				CHECK(mappedFile.GetPath() == file.GetPath());
+				REQUIRE(mappedFile.GetMappedPointer());
+				CHECK(std::memcmp(mappedFile.GetMappedPointer(), fileContent.data(), fileContent.size()) == 0);
+			}
+
+			AND_THEN("We can read it as a stream")
+			{
+				Nz::UInt8 header[8];
+				CHECK(mappedFile.Read(header, 8) == 8);
+				CHECK(std::memcmp(header, fileContent.data(), 8) == 0);
+				CHECK(mappedFile.GetCursorPos() == 8);
+
+				CHECK(mappedFile.SetCursorPos(fileContent.size() - 4));
+				CHECK(mappedFile.Read(header, 8) == 4);
+				CHECK(std::memcmp(header, &fileContent[fileContent.size() - 4], 4) == 0);
+				CHECK(mappedFile.EndOfStream());
+			}
+
+			AND_THEN("We close it")
+			{
+				mappedFile.Close();
+				CHECK(!mappedFile.IsOpen());
+				CHECK(!mappedFile.GetMappedPointer());
+			}
+		}
+
+		WHEN("We load an image from it")
+		{
+			file.SetCursorPos(0);
+
+			Nz::ImageRef streamImage = Nz::Image::LoadFromStream(file);
+			Nz::ImageRef mappedImage = Nz::Image::LoadFromFile(filePath);
+
+			THEN("Parsing the mapped file gives the same image as reading it")
+			{
+				REQUIRE(streamImage.IsValid());
+				REQUIRE(mappedImage.IsValid());
+				CHECK(mappedImage->GetSize() == streamImage->GetSize());
+				CHECK(mappedImage->GetFormat() == streamImage->GetFormat());
+				CHECK(std::memcmp(mappedImage->GetConstPixels(), streamImage->GetConstPixels(), streamImage->GetMemoryUsage(0)) == 0);
+			}
+		}
+	}
+
+	GIVEN("A missing file")
+	{
+		Nz::MappedFile mappedFile;
+
+		THEN("It cannot be mapped")
+		{
+			CHECK(!mappedFile.Open("resources/Engine/Core/ThisFileDoesNotExist.txt"));
+			CHECK(!mappedFile.IsOpen());
+			CHECK(mappedFile.GetSize() == 0);
+		}
+	}
+
+	GIVEN("A memory view")
+	{
+		Nz::UInt8 data[16] = {};
+		Nz::MemoryView memoryView(data, sizeof(data));
+
+		THEN("It is memory mapped as well")
+		{
+			CHECK(memoryView.IsMemoryMapped());
+			CHECK(memoryView.GetMappedPointer() == static_cast<const void*>(data));
+		}
+	}
+}
@@ -0,0 +1,89 @@
+#include <Nazara/Core/ParallelAlgorithm.hpp>
+#include <Catch/catch.hpp>
+#include <atomic>
+#include <vector>
+
+SCENARIO("ParallelAlgorithm", "[CORE][PARALLELALGORITHM]")
+{
+	GIVEN("A task scheduler with multiple workers")
+	{
+		Nz::TaskScheduler::Uninitialize();
+		Nz::TaskScheduler::SetWorkerCount(4);
+
+		std::vector<unsigned int> values(100000);
+
+		WHEN("We fill a vector with ParallelFor")
+		{
+			std::atomic_uint callCount(0);
+			std::atomic_bool validRanges(true);
+			Nz::ParallelFor(std::size_t(0), values.size(), 1000, [&](std::size_t first, std::size_t last)
+			{
+				// Catch assertions are not thread-safe
+				if (last - first > 1000)
+					validRanges = false;
+
+				for (std::size_t i = first; i < last; ++i)
+					values[i] = static_cast<unsigned int>(i);
+
+				callCount++;
+			});
+
+			THEN("Every index has been processed once")
+			{
+				bool valid = true;
+				for (std::size_t i = 0; i < values.size(); ++i)
+					valid = valid && (values[i] == i);
+
+				CHECK(valid);
+				CHECK(validRanges);
+				CHECK(callCount >= 100);
+			}
+
+			AND_THEN("We sum it with ParallelReduce")
+			{
+				auto sum = Nz::ParallelReduce(std::size_t(0), values.size(), 1000, Nz::UInt64(0), [&](std::size_t first, std::size_t last)
+				{
+					Nz::UInt64 partialSum = 0;
+					for (std::size_t i = first; i < last; ++i)
+						partialSum += values[i];
+
+					return partialSum;
+				}, [](Nz::UInt64 left, Nz::UInt64 right)
+				{
+					return left + right;
+				});
+
+				CHECK(sum == Nz::UInt64(values.size()) * (values.size() - 1) / 2);
+			}
+		}
+
+		WHEN("The range is smaller than the grain size")
+		{
+			int callCount = 0;
+			Nz::ParallelFor(0, 10, 100, [&](int first, int last)
+			{
+				CHECK(first == 0);
+				CHECK(last == 10);
+				callCount++;
+			});
+
+			THEN("The function is called only once")
+			{
+				CHECK(callCount == 1);
+			}
+		}
+
+		WHEN("The range is empty")
+		{
+			int result = Nz::ParallelReduce(5, 5, 1, -1, [](int, int) { return 0; }, [](int, int) { return 0; });
+
+			THEN("The identity is returned")
+			{
+				CHECK(result == -1);
+			}
+		}
+
+		Nz::TaskScheduler::Uninitialize();
+		Nz::TaskScheduler::SetWorkerCount(0);
+	}
+}
@@ -0,0 +1,158 @@
+#include <Nazara/Core/ResourceManager.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/RefCounted.hpp>
+#include <Nazara/Core/Resource.hpp>
+#include <Nazara/Core/ResourceParameters.hpp>
+#include <Catch/catch.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	class TestResource;
+
+	struct TestResourceParams : Nz::ResourceParameters
+	{
+		bool IsValid() const
+		{
+			return true;
+		}
+	};
+
+	using TestResourceRef = Nz::ObjectRef<TestResource>;
+	using TestResourceManager = Nz::ResourceManager<TestResource, TestResourceParams>;
+
+	class TestResource : public Nz::RefCounted, public Nz::Resource
+	{
+		friend TestResourceManager;
+
+		public:
+			TestResource() :
+			RefCounted(false)
+			{
+			}
+
+			static TestResourceRef LoadFromFile(const Nz::String& filePath, const TestResourceParams& /*params*/)
+			{
+				s_loadCount++;
+
+				// Give other requests some time to come while loading
+				std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+				if (!Nz::File::Exists(filePath))
+					return nullptr;
+
+				TestResourceRef resource = new TestResource;
+				resource->SetFilePath(filePath);
+
+				return resource;
+			}
+
+			static std::atomic_int s_loadCount;
+
+		private:
+			static TestResourceManager::ManagerMap s_managerMap;
+			static TestResourceManager::ManagerParams s_managerParameters;
+	};
+
+	std::atomic_int TestResource::s_loadCount(0);
+	TestResourceManager::ManagerMap TestResource::s_managerMap;
+	TestResourceManager::ManagerParams TestResource::s_managerParameters;
+}
+
+SCENARIO("ResourceManager", "[CORE][RESOURCEMANAGER]")
+{
+	GIVEN("A resource manager")
+	{
+		const Nz::String filePath = "resources/Engine/Graphics/Nazara.png";
+		TestResource::s_loadCount = 0;
+
+		WHEN("We request the same resource many times, synchronously and asynchronously")
+		{
+			std::vector<std::shared_future<TestResourceRef>> futures;
+			for (unsigned int i = 0; i < 10; ++i)
+				futures.push_back(TestResourceManager::GetAsync(filePath));
+
+			std::vector<TestResourceRef> resources;
+			std::vector<std::thread> threads;
+			resources.resize(4);
+			for (unsigned int i = 0; i < 4; ++i)
+				threads.emplace_back([&resources, &filePath, i]() { resources[i] = TestResourceManager::Get(filePath); });
+
+			for (std::thread& thread : threads)
+				thread.join();
+
+			THEN("It has been loaded only once")
+			{
+				TestResourceRef resource = futures.front().get();
+				REQUIRE(resource.IsValid());
+
+				bool sameResource = true;
+				for (const auto& future : futures)
+					sameResource = sameResource && future.get() == resource;
+
+				for (const TestResourceRef& otherResource : resources)
+					sameResource = sameResource && otherResource == resource;
+
+				CHECK(sameResource);
+				CHECK(TestResource::s_loadCount == 1);
+				CHECK(TestResourceManager::Get(filePath) == resource);
+				CHECK(TestResourceManager::GetAsync(filePath).get() == resource);
+				CHECK(TestResource::s_loadCount == 1);
+			}
+
+			AND_THEN("Its load statistics are available")
+			{
+				futures.front().wait();
+
+				TestResourceManager::LoadStats stats;
+				REQUIRE(TestResourceManager::GetLoadStats(filePath, &stats));
+				CHECK(stats.fileSize == Nz::File::GetSize(filePath));
+				CHECK(stats.loadTime >= 20000);
+			}
+
+			TestResourceManager::Clear();
+		}
+
+		WHEN("We request a resource which can't be loaded")
+		{
+			TestResourceRef resource = TestResourceManager::GetAsync("resources/missing.png").get();
+
+			THEN("We get an invalid reference, and a later request tries again")
+			{
+				CHECK(!resource.IsValid());
+
+				TestResourceManager::LoadStats stats;
+				CHECK(!TestResourceManager::GetLoadStats("resources/missing.png", &stats));
+
+				CHECK(!TestResourceManager::Get("resources/missing.png").IsValid());
+				CHECK(TestResource::s_loadCount == 2);
+			}
+		}
+
+		WHEN("We register a resource and purge the manager")
+		{
+			TestResourceRef resource = new TestResource;
+			TestResourceManager::Register("registered", resource);
+
+			TestResourceRef fetchedResource = TestResourceManager::Get("registered");
+			TestResourceManager::Purge();
+
+			THEN("The resource is kept as long as it is used")
+			{
+				CHECK(fetchedResource == resource);
+				CHECK(TestResourceManager::Get("registered") == resource);
+				CHECK(TestResource::s_loadCount == 0);
+
+				resource.Reset();
+				fetchedResource.Reset();
+				TestResourceManager::Purge();
+
+				TestResourceManager::Get("registered"); //< Now tries to load it
+				CHECK(TestResource::s_loadCount == 1);
+			}
+		}
+	}
+}
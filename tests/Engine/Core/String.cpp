@@ -1,5 +1,8 @@
 #include <Nazara/Core/String.hpp>
 #include <Catch/catch.hpp>
+#include <random>
+#include <utility>
+#include <vector>
 
 SCENARIO("String", "[CORE][STRING]")
 {
@@ -142,5 +145,148 @@ SCENARIO("String", "[CORE][STRING]")
 			}
 		}
 	}
+
+	GIVEN("A short and a long string")
+	{
+		Nz::String shortString("Nazara");
+		Nz::String longString("This string is too long to be stored inline");
+
+		WHEN("We copy and modify them")
+		{
+			Nz::String shortCopy(shortString);
+			Nz::String longCopy(longString);
+			shortCopy[0] = 'n';
+			longCopy.Append('!');
+
+			THEN("The originals are untouched")
+			{
+				CHECK(shortString == "Nazara");
+				CHECK(shortCopy == "nazara");
+				CHECK(longString == "This string is too long to be stored inline");
+				CHECK(longCopy == "This string is too long to be stored inline!");
+			}
+		}
+
+		WHEN("We move them")
+		{
+			const char* longBuffer = longString.GetConstBuffer();
+
+			Nz::String movedShort(std::move(shortString));
+			Nz::String movedLong;
+			movedLong = std::move(longString);
+
+			THEN("Content is transferred, the heap buffer isn't reallocated and the moved-from strings are empty")
+			{
+				CHECK(movedShort == "Nazara");
+				CHECK(movedLong == "This string is too long to be stored inline");
+				CHECK(static_cast<const void*>(movedLong.GetConstBuffer()) == static_cast<const void*>(longBuffer));
+				CHECK(shortString.IsEmpty());
+				CHECK(longString.IsEmpty());
+				CHECK(shortString.GetConstBuffer()[0] == '\0');
+			}
+		}
+
+		WHEN("We swap them")
+		{
+			shortString.Swap(longString);
+
+			THEN("Their contents are exchanged")
+			{
+				CHECK(shortString == "This string is too long to be stored inline");
+				CHECK(longString == "Nazara");
+			}
+		}
+
+		WHEN("We grow the short string and shrink it back")
+		{
+			for (int i = 0; i < 10; ++i)
+				shortString += "Engine";
+
+			CHECK(shortString.GetSize() == 66);
+
+			shortString.Resize(6);
+
+			THEN("It is still valid")
+			{
+				CHECK(shortString == "Nazara");
+				CHECK(shortString.GetCapacity() >= 66);
+			}
+		}
+	}
 }
 
+TEST_CASE("String operations", "[CORE][STRING][.benchmark]")
+{
+	constexpr std::size_t stringCount = 10000;
+
+	std::mt19937 randomEngine(42);
+	std::uniform_int_distribution<int> wordLengthDis(2, 10);
+	std::uniform_int_distribution<int> letterDis('a', 'z');
+
+	Nz::String sentence;
+	for (int i = 0; i < 1000; ++i)
+	{
+		if (!sentence.IsEmpty())
+			sentence += ' ';
+
+		sentence += Nz::String(wordLengthDis(randomEngine), static_cast<char>(letterDis(randomEngine)));
+	}
+
+	std::vector<Nz::String> words;
+	sentence.Split(words, ' ');
+
+	std::vector<Nz::String> strings(stringCount);
+
+	BENCHMARK("Construct " + Nz::String::Number(stringCount).ToStdString() + " short strings")
+	{
+		for (std::size_t i = 0; i < stringCount; ++i)
+			strings[i] = Nz::String("Nazara", 6);
+	}
+
+	BENCHMARK("Construct " + Nz::String::Number(stringCount).ToStdString() + " long strings")
+	{
+		for (std::size_t i = 0; i < stringCount; ++i)
+			strings[i] = Nz::String("This string is too long to be stored inline");
+	}
+
+	BENCHMARK("Copy " + Nz::String::Number(stringCount).ToStdString() + " short strings and modify them")
+	{
+		Nz::String shortString("Nazara");
+		for (std::size_t i = 0; i < stringCount; ++i)
+		{
+			strings[i] = shortString;
+			strings[i][0] = 'n';
+		}
+	}
+
+	BENCHMARK("Convert " + Nz::String::Number(stringCount).ToStdString() + " numbers")
+	{
+		for (std::size_t i = 0; i < stringCount; ++i)
+			strings[i] = Nz::String::Number(static_cast<unsigned int>(i * 7919));
+	}
+
+	BENCHMARK("Get the words of a sentence one by one")
+	{
+		for (unsigned int i = 0; i < 100; ++i)
+			strings[i] = sentence.GetWord(static_cast<unsigned int>(i * words.size() / 100));
+	}
+
+	BENCHMARK("Split a sentence")
+	{
+		std::vector<Nz::String> splitWords;
+		for (unsigned int i = 0; i < 20; ++i)
+		{
+			splitWords.clear();
+			sentence.Split(splitWords, ' ');
+		}
+	}
+
+	BENCHMARK("Find words in a sentence")
+	{
+		std::size_t positionSum = 0;
+		for (std::size_t i = 0; i < 1000; ++i)
+			positionSum += sentence.Find(words[(i * 13) % words.size()]);
+
+		CHECK(positionSum > 0);
+	}
+}
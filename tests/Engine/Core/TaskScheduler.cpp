@@ -0,0 +1,152 @@
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Core/HardwareInfo.hpp>
+#include <Nazara/Core/String.hpp>
+#include <Catch/catch.hpp>
+#include <atomic>
+#include <vector>
+
+SCENARIO("TaskScheduler", "[CORE][TASKSCHEDULER]")
+{
+	GIVEN("The default task scheduler")
+	{
+		REQUIRE(Nz::TaskScheduler::Initialize());
+
+		WHEN("We run tasks through the static interface")
+		{
+			std::atomic_int counter(0);
+			for (int i = 0; i < 1000; ++i)
+				Nz::TaskScheduler::AddTask([&counter]() { counter++; });
+
+			Nz::TaskScheduler::Run();
+			Nz::TaskScheduler::WaitForTasks();
+
+			THEN("Every task has been executed")
+			{
+				CHECK(counter == 1000);
+			}
+		}
+
+		WHEN("We use a task group")
+		{
+			std::vector<int> values(512, 0);
+
+			Nz::TaskGroup group;
+			for (std::size_t i = 0; i < values.size(); ++i)
+				group.AddTask([&values, i]() { values[i] = static_cast<int>(i * 2); });
+
+			group.Wait();
+
+			THEN("The group is finished and every value was written")
+			{
+				CHECK(group.IsFinished());
+				CHECK(group.GetPendingTaskCount() == 0);
+
+				bool valid = true;
+				for (std::size_t i = 0; i < values.size(); ++i)
+					valid = valid && (values[i] == static_cast<int>(i * 2));
+
+				CHECK(valid);
+			}
+		}
+
+		WHEN("Tasks submit other tasks")
+		{
+			std::atomic_int counter(0);
+
+			Nz::TaskGroup group;
+			for (int i = 0; i < 16; ++i)
+			{
+				group.AddTask([&counter]()
+				{
+					Nz::TaskGroup subGroup;
+					for (int j = 0; j < 16; ++j)
+						subGroup.AddTask([&counter]() { counter++; });
+
+					// Waiting from inside a task must not deadlock
+					subGroup.Wait();
+					counter++;
+				});
+			}
+
+			group.Wait();
+
+			THEN("Nested tasks have been executed")
+			{
+				CHECK(counter == 16 * 16 + 16);
+			}
+		}
+
+		WHEN("We change the worker count")
+		{
+			Nz::TaskScheduler::Uninitialize();
+			Nz::TaskScheduler::SetWorkerCount(1);
+
+			std::atomic_int counter(0);
+			{
+				Nz::TaskGroup group;
+				for (int i = 0; i < 100; ++i)
+					group.AddTask([&counter]() { counter++; });
+			}
+
+			THEN("A group waits for its tasks on destruction")
+			{
+				CHECK(counter == 100);
+				CHECK(Nz::TaskScheduler::GetWorkerCount() == 1);
+			}
+
+			Nz::TaskScheduler::Uninitialize();
+			Nz::TaskScheduler::SetWorkerCount(0);
+		}
+	}
+}
+
+TEST_CASE("TaskScheduler scaling", "[CORE][TASKSCHEDULER][.benchmark]")
+{
+	constexpr std::size_t taskCount = 100000;
+	constexpr unsigned int workPerTask = 200;
+
+	std::vector<float> results(taskCount);
+	auto task = [&results](std::size_t index)
+	{
+		float value = static_cast<float>(index);
+		for (unsigned int i = 0; i < workPerTask; ++i)
+			value = value * 0.999f + 1.f;
+
+		results[index] = value;
+	};
+
+	unsigned int maxWorkerCount = Nz::HardwareInfo::GetProcessorCount();
+	for (unsigned int workerCount = 1; workerCount <= maxWorkerCount; workerCount *= 2)
+	{
+		Nz::TaskScheduler::Uninitialize();
+		Nz::TaskScheduler::SetWorkerCount(workerCount);
+		Nz::TaskScheduler::Initialize();
+
+		BENCHMARK("Static API, " + Nz::String::Number(workerCount).ToStdString() + " worker(s)")
+		{
+			for (std::size_t i = 0; i < taskCount; ++i)
+				Nz::TaskScheduler::AddTask([&task, i]() { task(i); });
+
+			Nz::TaskScheduler::Run();
+			Nz::TaskScheduler::WaitForTasks();
+		}
+
+		BENCHMARK("Nested task groups, " + Nz::String::Number(workerCount).ToStdString() + " worker(s)")
+		{
+			Nz::TaskGroup group;
+			for (std::size_t i = 0; i < taskCount; i += 1000)
+			{
+				group.AddTask([&task, i]()
+				{
+					Nz::TaskGroup subGroup;
+					for (std::size_t j = i; j < i + 1000; ++j)
+						subGroup.AddTask([&task, j]() { task(j); });
+				});
+			}
+			group.Wait();
+		}
+	}
+
+	Nz::TaskScheduler::Uninitialize();
+	Nz::TaskScheduler::SetWorkerCount(0);
+}
@@ -0,0 +1,125 @@
+#include <Nazara/Graphics/BasicRenderQueue.hpp>
+#include <Nazara/Graphics/Drawable.hpp>
+#include <Catch/catch.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+	class TestDrawable : public Nz::Drawable
+	{
+		public:
+			void Draw() const override
+			{
+			}
+	};
+
+	std::vector<const Nz::Drawable*> GetDrawables(Nz::BasicRenderQueue& renderQueue)
+	{
+		renderQueue.Sort(nullptr);
+
+		std::vector<const Nz::Drawable*> drawables;
+		for (const Nz::BasicRenderQueue::CustomDrawable& customDrawable : renderQueue.customDrawables)
+			drawables.push_back(customDrawable.drawable);
+
+		std::sort(drawables.begin(), drawables.end());
+		return drawables;
+	}
+
+	std::vector<const Nz::Drawable*> Sorted(std::vector<const Nz::Drawable*> drawables)
+	{
+		std::sort(drawables.begin(), drawables.end());
+		return drawables;
+	}
+}
+
+SCENARIO("BasicRenderQueue", "[GRAPHICS][BASICRENDERQUEUE]")
+{
+	GIVEN("A render queue with keyed entries and unkeyed data")
+	{
+		TestDrawable drawables[4];
+		int keys[3];
+
+		Nz::BasicRenderQueue renderQueue;
+		for (int i = 0; i < 3; ++i)
+		{
+			Nz::BasicRenderQueue* entryQueue = renderQueue.UpdateEntry(&keys[i], 1);
+			REQUIRE(entryQueue);
+
+			entryQueue->AddDrawable(i, &drawables[i]);
+		}
+		renderQueue.RemoveUnusedEntries();
+
+		renderQueue.AddDrawable(0, &drawables[3]);
+
+		CHECK(renderQueue.GetEntryCount() == 3);
+		CHECK(renderQueue.GetRebuiltEntryCount() == 3);
+		CHECK(renderQueue.GetReusedEntryCount() == 0);
+		CHECK(GetDrawables(renderQueue) == Sorted({ &drawables[0], &drawables[1], &drawables[2], &drawables[3] }));
+
+		WHEN("We clear unkeyed data and update the entries with the same revision")
+		{
+			renderQueue.ClearUnkeyedData();
+
+			bool rebuilt = false;
+			for (int i = 0; i < 3; ++i)
+				rebuilt = rebuilt || renderQueue.UpdateEntry(&keys[i], 1) != nullptr;
+
+			renderQueue.RemoveUnusedEntries();
+
+			THEN("Entry data is reused and unkeyed data is gone")
+			{
+				CHECK(!rebuilt);
+				CHECK(renderQueue.GetRebuiltEntryCount() == 0);
+				CHECK(renderQueue.GetReusedEntryCount() == 3);
+				CHECK(GetDrawables(renderQueue) == Sorted({ &drawables[0], &drawables[1], &drawables[2] }));
+			}
+		}
+
+		WHEN("An entry revision changes and another entry is not updated")
+		{
+			renderQueue.UpdateEntry(&keys[0], 1);
+
+			Nz::BasicRenderQueue* entryQueue = renderQueue.UpdateEntry(&keys[1], 2);
+			REQUIRE(entryQueue);
+			entryQueue->AddDrawable(1, &drawables[3]);
+
+			std::size_t removedEntryCount = renderQueue.RemoveUnusedEntries();
+
+			THEN("Only the changed entry is rebuilt and the other one is removed, unkeyed data stays after the keyed one")
+			{
+				CHECK(removedEntryCount == 1);
+				CHECK(renderQueue.GetEntryCount() == 2);
+				CHECK(renderQueue.GetRebuiltEntryCount() == 1);
+				CHECK(renderQueue.GetReusedEntryCount() == 1);
+				CHECK(GetDrawables(renderQueue) == Sorted({ &drawables[0], &drawables[3], &drawables[3] }));
+
+				renderQueue.ClearUnkeyedData();
+				CHECK(GetDrawables(renderQueue) == Sorted({ &drawables[0], &drawables[3] }));
+			}
+		}
+
+		WHEN("An entry is updated with the volatile revision")
+		{
+			bool rebuiltOnce = renderQueue.UpdateEntry(&keys[0], Nz::BasicRenderQueue::VolatileRevision) != nullptr;
+			bool rebuiltTwice = renderQueue.UpdateEntry(&keys[0], Nz::BasicRenderQueue::VolatileRevision) != nullptr;
+
+			THEN("It is rebuilt every time")
+			{
+				CHECK(rebuiltOnce);
+				CHECK(rebuiltTwice);
+			}
+		}
+
+		WHEN("We clear the queue")
+		{
+			renderQueue.Clear();
+
+			THEN("Entries are removed as well")
+			{
+				CHECK(renderQueue.GetEntryCount() == 0);
+				CHECK(GetDrawables(renderQueue).empty());
+			}
+		}
+	}
+}
@@ -0,0 +1,240 @@
+#include <Nazara/Graphics/CullingList.hpp>
+#include <Nazara/Core/String.hpp>
+#include <Catch/catch.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+	using TestCullingList = Nz::CullingList<int>;
+
+	Nz::Boxf GenerateBox(std::mt19937& randomEngine, float worldSize)
+	{
+		std::uniform_real_distribution<float> positionDis(-worldSize, worldSize);
+		std::uniform_real_distribution<float> sizeDis(0.5f, 5.f);
+
+		return Nz::Boxf(positionDis(randomEngine), positionDis(randomEngine), positionDis(randomEngine), sizeDis(randomEngine), sizeDis(randomEngine), sizeDis(randomEngine));
+	}
+
+	std::vector<const int*> SortedResults(const TestCullingList::ResultContainer& results)
+	{
+		std::vector<const int*> sortedResults(results.begin(), results.end());
+		std::sort(sortedResults.begin(), sortedResults.end());
+
+		return sortedResults;
+	}
+}
+
+SCENARIO("CullingList", "[GRAPHICS][CULLINGLIST]")
+{
+	GIVEN("A linear and a hierarchical culling list with the same boxes")
+	{
+		constexpr std::size_t entryCount = 2000;
+		constexpr float worldSize = 500.f;
+
+		std::mt19937 randomEngine(42);
+		std::vector<int> renderables(entryCount);
+
+		TestCullingList linearList;
+		TestCullingList hierarchicalList(Nz::CullingMode::Hierarchical);
+
+		std::vector<TestCullingList::BoxEntry> linearEntries;
+		std::vector<TestCullingList::BoxEntry> hierarchicalEntries;
+		for (std::size_t i = 0; i < entryCount; ++i)
+		{
+			Nz::Boxf box = GenerateBox(randomEngine, worldSize);
+
+			linearEntries.emplace_back(linearList.RegisterBoxTest(&renderables[i]));
+			linearEntries.back().UpdateBox(box);
+
+			hierarchicalEntries.emplace_back(hierarchicalList.RegisterBoxTest(&renderables[i]));
+			hierarchicalEntries.back().UpdateBox(box);
+		}
+
+		Nz::Frustumf frustum;
+		frustum.Build(Nz::FromDegrees(70.f), 16.f / 9.f, 1.f, 1000.f, Nz::Vector3f::Zero(), Nz::Vector3f(100.f, 20.f, -50.f));
+
+		auto CheckSameResults = [&]()
+		{
+			linearList.Cull(frustum);
+			hierarchicalList.Cull(frustum);
+
+			CHECK(SortedResults(linearList.GetFullyVisibleResults()) == SortedResults(hierarchicalList.GetFullyVisibleResults()));
+			CHECK(SortedResults(linearList.GetPartiallyVisibleResults()) == SortedResults(hierarchicalList.GetPartiallyVisibleResults()));
+		};
+
+		WHEN("We cull them")
+		{
+			THEN("Both lists find the same visible entries")
+			{
+				CheckSameResults();
+				CHECK(!linearList.GetFullyVisibleResults().empty());
+				CHECK(!linearList.GetPartiallyVisibleResults().empty());
+			}
+		}
+
+		WHEN("We move and remove some entries")
+		{
+			for (std::size_t i = 0; i < entryCount; i += 3)
+			{
+				Nz::Boxf box = GenerateBox(randomEngine, worldSize);
+				linearEntries[i].UpdateBox(box);
+				hierarchicalEntries[i].UpdateBox(box);
+			}
+
+			for (std::size_t i = 0; i < entryCount / 4; ++i)
+			{
+				linearEntries.erase(linearEntries.begin() + i * 2);
+				hierarchicalEntries.erase(hierarchicalEntries.begin() + i * 2);
+			}
+
+			THEN("Both lists still find the same visible entries")
+			{
+				CheckSameResults();
+			}
+		}
+
+		WHEN("We switch culling modes")
+		{
+			linearList.SetCullingMode(Nz::CullingMode::Hierarchical);
+			hierarchicalList.SetCullingMode(Nz::CullingMode::Linear);
+
+			THEN("Results are unchanged")
+			{
+				CHECK(linearList.GetCullingMode() == Nz::CullingMode::Hierarchical);
+				CHECK(hierarchicalList.GetCullingMode() == Nz::CullingMode::Linear);
+
+				CheckSameResults();
+			}
+		}
+
+		WHEN("Nothing changes between two culls")
+		{
+			std::size_t firstHash = hierarchicalList.Cull(frustum);
+			std::size_t secondHash = hierarchicalList.Cull(frustum);
+
+			THEN("The visibility hash is stable")
+			{
+				CHECK(firstHash == secondHash);
+			}
+		}
+	}
+}
+
+SCENARIO("CullingList SIMD culling", "[GRAPHICS][CULLINGLIST]")
+{
+	GIVEN("A culling list with boxes and spheres")
+	{
+		constexpr std::size_t boxCount = 1003; //< Not a multiple of the SIMD width
+		constexpr std::size_t sphereCount = 517;
+		constexpr float worldSize = 300.f;
+
+		std::mt19937 randomEngine(1337);
+		std::uniform_real_distribution<float> radiusDis(0.5f, 5.f);
+
+		std::vector<int> renderables(boxCount + sphereCount);
+		std::vector<Nz::Boxf> boxes;
+		std::vector<Nz::Spheref> spheres;
+
+		TestCullingList cullingList;
+		std::vector<TestCullingList::BoxEntry> boxEntries;
+		std::vector<TestCullingList::SphereEntry> sphereEntries;
+
+		for (std::size_t i = 0; i < boxCount; ++i)
+		{
+			boxes.push_back(GenerateBox(randomEngine, worldSize));
+
+			boxEntries.emplace_back(cullingList.RegisterBoxTest(&renderables[i]));
+			boxEntries.back().UpdateBox(boxes.back());
+		}
+
+		for (std::size_t i = 0; i < sphereCount; ++i)
+		{
+			spheres.emplace_back(GenerateBox(randomEngine, worldSize).GetCenter(), radiusDis(randomEngine));
+
+			sphereEntries.emplace_back(cullingList.RegisterSphereTest(&renderables[boxCount + i]));
+			sphereEntries.back().UpdateSphere(spheres.back());
+		}
+
+		WHEN("We cull them")
+		{
+			Nz::Frustumf frustum;
+			frustum.Build(Nz::FromDegrees(70.f), 16.f / 9.f, 1.f, 1000.f, Nz::Vector3f::Zero(), Nz::Vector3f(-30.f, 10.f, 80.f));
+
+			std::size_t visibilityHash = cullingList.Cull(frustum);
+
+			THEN("Results and hash are the same as when testing each volume with the frustum")
+			{
+				std::vector<const int*> fullyVisible;
+				std::vector<const int*> partiallyVisible;
+				std::size_t fullyVisibleHash = 5U;
+				std::size_t partiallyVisibleHash = 5U;
+
+				auto AddExpectedResult = [&](const int* renderable, Nz::IntersectionSide side)
+				{
+					if (side == Nz::IntersectionSide_Inside)
+					{
+						fullyVisible.push_back(renderable);
+						fullyVisibleHash = fullyVisibleHash * 23 + std::hash<const int*>()(renderable);
+					}
+					else if (side == Nz::IntersectionSide_Intersecting)
+					{
+						partiallyVisible.push_back(renderable);
+						partiallyVisibleHash = partiallyVisibleHash * 23 + std::hash<const int*>()(renderable);
+					}
+				};
+
+				for (std::size_t i = 0; i < boxCount; ++i)
+					AddExpectedResult(&renderables[i], frustum.Intersect(boxes[i]));
+
+				for (std::size_t i = 0; i < sphereCount; ++i)
+					AddExpectedResult(&renderables[boxCount + i], frustum.Intersect(spheres[i]));
+
+				const TestCullingList::ResultContainer& fullyVisibleResults = cullingList.GetFullyVisibleResults();
+				const TestCullingList::ResultContainer& partiallyVisibleResults = cullingList.GetPartiallyVisibleResults();
+
+				CHECK(std::vector<const int*>(fullyVisibleResults.begin(), fullyVisibleResults.end()) == fullyVisible);
+				CHECK(std::vector<const int*>(partiallyVisibleResults.begin(), partiallyVisibleResults.end()) == partiallyVisible);
+				CHECK(visibilityHash == 5 + partiallyVisibleHash * 17 + fullyVisibleHash);
+			}
+		}
+	}
+}
+
+TEST_CASE("CullingList modes", "[GRAPHICS][CULLINGLIST][.benchmark]")
+{
+	constexpr float density = 1000.f; //< Number of boxes per 100x100x100 cube
+
+	for (std::size_t entryCount : { 1000U, 10000U, 50000U, 200000U })
+	{
+		float worldSize = 50.f * std::cbrt(entryCount / density);
+
+		std::mt19937 randomEngine(42);
+		std::vector<int> renderables(entryCount);
+
+		Nz::Frustumf frustum;
+		frustum.Build(Nz::FromDegrees(70.f), 16.f / 9.f, 1.f, worldSize / 2.f, Nz::Vector3f::Zero(), Nz::Vector3f::UnitX());
+
+		for (Nz::CullingMode mode : { Nz::CullingMode::Linear, Nz::CullingMode::Hierarchical })
+		{
+			TestCullingList cullingList(mode);
+
+			std::vector<TestCullingList::BoxEntry> entries;
+			entries.reserve(entryCount);
+			for (std::size_t i = 0; i < entryCount; ++i)
+			{
+				entries.emplace_back(cullingList.RegisterBoxTest(&renderables[i]));
+				entries.back().UpdateBox(GenerateBox(randomEngine, worldSize));
+			}
+
+			Nz::String modeName = (mode == Nz::CullingMode::Linear) ? "linear" : "hierarchical";
+			BENCHMARK("Cull " + Nz::String::Number(entryCount).ToStdString() + " static boxes (" + modeName.ToStdString() + ")")
+			{
+				for (unsigned int i = 0; i < 100; ++i)
+					cullingList.Cull(frustum);
+			}
+		}
+	}
+}
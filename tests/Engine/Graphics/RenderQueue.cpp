@@ -0,0 +1,224 @@
+#include <Nazara/Graphics/RenderQueue.hpp>
+#include <Nazara/Core/FrameArena.hpp>
+#include <Nazara/Core/String.hpp>
+#include <Catch/catch.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+	struct TestRenderData
+	{
+		Nz::UInt64 key;
+		std::size_t id;
+	};
+
+	std::vector<TestRenderData> GenerateRenderData(std::size_t count, std::mt19937_64& randomEngine)
+	{
+		// Keys look like the BasicRenderQueue ones: a few layers, and a limited number of pipelines/materials/textures
+		std::uniform_int_distribution<Nz::UInt64> layerDis(0, 3);
+		std::uniform_int_distribution<Nz::UInt64> byteDis(0, 40);
+
+		std::vector<TestRenderData> renderData(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			Nz::UInt64 key = layerDis(randomEngine) << 48 |
+			                 byteDis(randomEngine)  << 40 |
+			                 byteDis(randomEngine)  << 32 |
+			                 byteDis(randomEngine)  << 24 |
+			                 byteDis(randomEngine)  << 16 |
+			                 byteDis(randomEngine)  <<  8;
+
+			renderData[i] = TestRenderData{key, i};
+		}
+
+		return renderData;
+	}
+}
+
+SCENARIO("RenderQueue", "[GRAPHICS][RENDERQUEUE]")
+{
+	GIVEN("Render queues of different sizes")
+	{
+		std::mt19937_64 randomEngine(42);
+		Nz::FrameArena scratchArena;
+
+		for (std::size_t count : { 0U, 1U, 10U, 100U, 255U, 10000U })
+		{
+			std::vector<TestRenderData> renderData = GenerateRenderData(count, randomEngine);
+
+			Nz::RenderQueue<TestRenderData> renderQueue;
+			for (TestRenderData data : renderData)
+				renderQueue.Insert(std::move(data));
+
+			WHEN("We sort a queue of " + Nz::String::Number(count).ToStdString() + " elements")
+			{
+				renderQueue.Sort([](const TestRenderData& data) { return data.key; }, scratchArena);
+
+				THEN("Every element is present, sorted by key")
+				{
+					CHECK(renderQueue.size() == count);
+
+					std::vector<bool> found(count, false);
+					bool sorted = true;
+
+					Nz::UInt64 previousKey = 0;
+					for (const TestRenderData& data : renderQueue)
+					{
+						sorted = sorted && (data.key >= previousKey);
+						previousKey = data.key;
+
+						found[data.id] = true;
+					}
+
+					CHECK(sorted);
+					CHECK(std::all_of(found.begin(), found.end(), [](bool value) { return value; }));
+					CHECK(scratchArena.GetUsedSize() == 0); //< Scratch memory is given back once sorted
+				}
+
+				AND_THEN("Sorting it again with other keys works as well")
+				{
+					renderQueue.Sort([](const TestRenderData& data) { return ~data.key; }, scratchArena);
+
+					bool sorted = true;
+
+					Nz::UInt64 previousKey = 0;
+					for (const TestRenderData& data : renderQueue)
+					{
+						sorted = sorted && (~data.key >= previousKey);
+						previousKey = ~data.key;
+					}
+
+					CHECK(sorted);
+					CHECK(renderQueue.size() == count);
+				}
+			}
+
+			WHEN("We sort a queue of " + Nz::String::Number(count).ToStdString() + " elements with many equal keys")
+			{
+				auto LayerKey = [](const TestRenderData& data) { return data.key >> 48; };
+				renderQueue.Sort(LayerKey, scratchArena);
+
+				THEN("Elements with equal keys keep their insertion order")
+				{
+					bool stable = true;
+
+					const TestRenderData* previousData = nullptr;
+					for (const TestRenderData& data : renderQueue)
+					{
+						if (previousData && LayerKey(*previousData) == LayerKey(data))
+							stable = stable && (previousData->id < data.id);
+
+						previousData = &data;
+					}
+
+					CHECK(stable);
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("RenderQueue fragments", "[GRAPHICS][RENDERQUEUE]")
+{
+	GIVEN("A render queue split in fragments")
+	{
+		constexpr std::size_t fragmentCount = 4;
+		constexpr std::size_t fragmentSize = 500;
+
+		std::mt19937_64 randomEngine(1337);
+		std::vector<TestRenderData> renderData = GenerateRenderData(fragmentCount * fragmentSize, randomEngine);
+
+		Nz::FrameArena scratchArena;
+
+		Nz::RenderQueue<TestRenderData> fragments[fragmentCount];
+		for (std::size_t i = 0; i < renderData.size(); ++i)
+			fragments[i / fragmentSize].Insert(TestRenderData(renderData[i]));
+
+		WHEN("We append them to a single queue and sort it")
+		{
+			Nz::RenderQueue<TestRenderData> renderQueue;
+			renderQueue.Append(fragments[0]);
+			for (std::size_t i = 1; i < fragmentCount; ++i)
+			{
+				std::size_t idOffset = i * fragmentSize;
+				renderQueue.Append(fragments[i], [idOffset](TestRenderData& data) { data.id -= idOffset; });
+			}
+
+			renderQueue.Sort([](const TestRenderData& data) { return data.key; }, scratchArena);
+
+			Nz::RenderQueue<TestRenderData> expectedQueue;
+			for (std::size_t i = 0; i < renderData.size(); ++i)
+				expectedQueue.Insert(TestRenderData{renderData[i].key, i % fragmentSize});
+
+			expectedQueue.Sort([](const TestRenderData& data) { return data.key; }, scratchArena);
+
+			THEN("It contains the same elements, in the same order, as a queue filled directly")
+			{
+				REQUIRE(renderQueue.size() == expectedQueue.size());
+
+				bool same = true;
+				auto expectedIt = expectedQueue.begin();
+				for (const TestRenderData& data : renderQueue)
+				{
+					same = same && data.key == (*expectedIt).key && data.id == (*expectedIt).id;
+					++expectedIt;
+				}
+
+				CHECK(same);
+			}
+		}
+	}
+}
+
+TEST_CASE("RenderQueue sorting", "[GRAPHICS][RENDERQUEUE][.benchmark]")
+{
+	std::mt19937_64 randomEngine(42);
+	Nz::FrameArena scratchArena;
+
+	for (std::size_t count : { 10000U, 50000U, 100000U, 500000U })
+	{
+		std::vector<TestRenderData> renderData = GenerateRenderData(count, randomEngine);
+
+		Nz::RenderQueue<TestRenderData> renderQueue;
+		for (TestRenderData data : renderData)
+			renderQueue.Insert(std::move(data));
+
+		auto KeyFunc = [](const TestRenderData& data) { return data.key; };
+
+		// Both paths build their (key, index) pairs from the unsorted data on every sort, in buffers kept between sorts
+		renderQueue.Sort(KeyFunc, scratchArena);
+
+		BENCHMARK("RenderQueue::Sort, " + Nz::String::Number(count).ToStdString() + " elements")
+		{
+			for (unsigned int i = 0; i < 10; ++i)
+				renderQueue.Sort(KeyFunc, scratchArena);
+		}
+
+		std::vector<std::pair<Nz::UInt64, std::size_t>> pairs;
+		pairs.reserve(count);
+
+		auto SortPairs = [&](auto&& sortFunc)
+		{
+			for (unsigned int i = 0; i < 10; ++i)
+			{
+				pairs.clear();
+				for (std::size_t j = 0; j < renderData.size(); ++j)
+					pairs.emplace_back(KeyFunc(renderData[j]), j);
+
+				sortFunc(pairs.begin(), pairs.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+			}
+		};
+
+		BENCHMARK("std::sort, " + Nz::String::Number(count).ToStdString() + " elements")
+		{
+			SortPairs([](auto first, auto last, auto comp) { std::sort(first, last, comp); });
+		}
+
+		BENCHMARK("std::stable_sort, " + Nz::String::Number(count).ToStdString() + " elements")
+		{
+			SortPairs([](auto first, auto last, auto comp) { std::stable_sort(first, last, comp); });
+		}
+	}
+}
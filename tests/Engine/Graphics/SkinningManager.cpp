@@ -0,0 +1,101 @@
+#include <Nazara/Graphics/SkinningManager.hpp>
+#include <Nazara/Math/EulerAngles.hpp>
+#include <Nazara/Utility/Algorithm.hpp>
+#include <Nazara/Utility/BufferMapper.hpp>
+#include <Nazara/Utility/Joint.hpp>
+#include <Nazara/Utility/SkeletalMesh.hpp>
+#include <Nazara/Utility/Skeleton.hpp>
+#include <Nazara/Utility/VertexStruct.hpp>
+#include <Catch/catch.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+	void CreateSkeleton(Nz::Skeleton& skeleton, const Nz::Vector3f& offset)
+	{
+		skeleton.Create(2);
+
+		Nz::Joint* root = skeleton.GetJoint(0);
+		root->SetPosition(offset);
+
+		Nz::Joint* child = skeleton.GetJoint(1);
+		child->SetParent(root);
+		child->SetPosition(Nz::Vector3f::UnitY());
+		child->SetRotation(Nz::EulerAnglesf(0.f, 0.f, 90.f));
+	}
+
+	float GetSkinningError(const Nz::VertexBuffer* buffer, const std::vector<Nz::MeshVertex>& expectedVertices)
+	{
+		Nz::BufferMapper<Nz::VertexBuffer> mapper(buffer, Nz::BufferAccess_ReadOnly);
+		const Nz::MeshVertex* vertices = static_cast<const Nz::MeshVertex*>(mapper.GetPointer());
+
+		float maxError = 0.f;
+		for (std::size_t i = 0; i < expectedVertices.size(); ++i)
+			maxError = std::max(maxError, vertices[i].position.Distance(expectedVertices[i].position));
+
+		return maxError;
+	}
+}
+
+SCENARIO("SkinningManager", "[GRAPHICS][SKINNINGMANAGER]")
+{
+	GIVEN("A skeletal mesh animated by two skeletons")
+	{
+		constexpr unsigned int vertexCount = 3000; //< Skinned by multiple tasks
+
+		std::vector<Nz::SkeletalMeshVertex> inputVertices(vertexCount);
+		for (unsigned int i = 0; i < vertexCount; ++i)
+		{
+			Nz::SkeletalMeshVertex& vertex = inputVertices[i];
+			vertex.position.Set(float(i % 10), float(i / 10), 0.f);
+			vertex.normal = Nz::Vector3f::UnitZ();
+			vertex.tangent = Nz::Vector3f::UnitX();
+			vertex.uv.MakeZero();
+			vertex.weightCount = 2;
+			vertex.jointIndexes.Set(0, 1, 0, 0);
+			vertex.weights.Set(float(i % 4) / 3.f, 1.f - float(i % 4) / 3.f, 0.f, 0.f);
+		}
+
+		// Hardware buffers, as loaded meshes, can't be mapped twice at the same time
+		Nz::VertexBufferRef vertexBuffer = Nz::VertexBuffer::New(Nz::VertexDeclaration::Get(Nz::VertexLayout_XYZ_Normal_UV_Tangent_Skinning), vertexCount, Nz::DataStorage_Hardware, 0);
+		vertexBuffer->Fill(inputVertices.data(), 0, vertexCount);
+
+		Nz::SkeletalMeshRef mesh = Nz::SkeletalMesh::New(vertexBuffer, nullptr);
+
+		Nz::Skeleton firstSkeleton;
+		CreateSkeleton(firstSkeleton, Nz::Vector3f::Zero());
+
+		Nz::Skeleton secondSkeleton;
+		CreateSkeleton(secondSkeleton, Nz::Vector3f(0.f, 0.f, 5.f));
+
+		WHEN("Both instances are skinned in the same frame")
+		{
+			Nz::VertexBuffer* firstBuffer = Nz::SkinningManager::GetBuffer(mesh, &firstSkeleton);
+			Nz::VertexBuffer* secondBuffer = Nz::SkinningManager::GetBuffer(mesh, &secondSkeleton);
+			REQUIRE(firstBuffer != secondBuffer);
+
+			Nz::SkinningManager::Skin();
+
+			THEN("Each of them is skinned by its own skeleton")
+			{
+				auto ComputeExpectedVertices = [&](const Nz::Skeleton& skeleton)
+				{
+					std::vector<Nz::MeshVertex> expectedVertices(vertexCount);
+
+					Nz::SkinningData skinningData;
+					skinningData.inputVertex = inputVertices.data();
+					skinningData.outputVertex = expectedVertices.data();
+					skinningData.joints = skeleton.GetJoints();
+
+					Nz::SkinPositionNormalTangent(skinningData, 0, vertexCount);
+
+					return expectedVertices;
+				};
+
+				CHECK(GetSkinningError(firstBuffer, ComputeExpectedVertices(firstSkeleton)) < 0.001f);
+				CHECK(GetSkinningError(secondBuffer, ComputeExpectedVertices(secondSkeleton)) < 0.001f);
+			}
+		}
+	}
+}
@@ -0,0 +1,399 @@
+#include <Nazara/Utility/Algorithm.hpp>
+#include <Nazara/Core/ParallelAlgorithm.hpp>
+#include <Nazara/Core/String.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Math/EulerAngles.hpp>
+#include <Nazara/Utility/IndexBuffer.hpp>
+#include <Nazara/Utility/IndexMapper.hpp>
+#include <Nazara/Utility/Joint.hpp>
+#include <Nazara/Utility/Skeleton.hpp>
+#include <Nazara/Utility/VertexStruct.hpp>
+#include <Catch/catch.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+	void GenerateSkeleton(std::mt19937& randomEngine, Nz::Skeleton& skeleton, unsigned int jointCount)
+	{
+		std::uniform_real_distribution<float> angleDis(-180.f, 180.f);
+		std::uniform_real_distribution<float> positionDis(-2.f, 2.f);
+
+		skeleton.Create(jointCount);
+		for (unsigned int i = 0; i < jointCount; ++i)
+		{
+			Nz::Joint* joint = skeleton.GetJoint(i);
+			if (i > 0)
+				joint->SetParent(skeleton.GetJoint(i / 2));
+
+			joint->SetPosition(positionDis(randomEngine), positionDis(randomEngine), positionDis(randomEngine));
+			joint->SetRotation(Nz::EulerAnglesf(angleDis(randomEngine), angleDis(randomEngine), angleDis(randomEngine)));
+			joint->SetInverseBindMatrix(Nz::Matrix4f::Translate(Nz::Vector3f(positionDis(randomEngine), positionDis(randomEngine), positionDis(randomEngine))));
+		}
+	}
+
+	std::vector<Nz::SkeletalMeshVertex> GenerateVertices(std::mt19937& randomEngine, unsigned int vertexCount, unsigned int jointCount)
+	{
+		std::uniform_int_distribution<int> weightCountDis(1, 4);
+		std::uniform_int_distribution<int> jointDis(0, jointCount - 1);
+		std::uniform_real_distribution<float> valueDis(-1.f, 1.f);
+		std::uniform_real_distribution<float> weightDis(0.1f, 1.f);
+
+		auto RandomVector = [&]()
+		{
+			return Nz::Vector3f(valueDis(randomEngine), valueDis(randomEngine), valueDis(randomEngine));
+		};
+
+		std::vector<Nz::SkeletalMeshVertex> vertices(vertexCount);
+		for (Nz::SkeletalMeshVertex& vertex : vertices)
+		{
+			vertex.position = RandomVector() * 10.f;
+			vertex.normal = Nz::Vector3f::Normalize(RandomVector() + Nz::Vector3f(0.f, 2.f, 0.f));
+			vertex.tangent = Nz::Vector3f::Normalize(RandomVector() + Nz::Vector3f(2.f, 0.f, 0.f));
+			vertex.uv.Set(valueDis(randomEngine), valueDis(randomEngine));
+			vertex.weightCount = weightCountDis(randomEngine);
+
+			float weightSum = 0.f;
+			for (int i = 0; i < 4; ++i)
+			{
+				vertex.jointIndexes[i] = jointDis(randomEngine);
+				vertex.weights[i] = (i < vertex.weightCount) ? weightDis(randomEngine) : 0.f;
+				weightSum += vertex.weights[i];
+			}
+
+			vertex.weights /= weightSum;
+		}
+
+		return vertices;
+	}
+
+	// A sphere built from a (size x size) grid of vertices, whose triangles are given in a random order
+	void GenerateShuffledSphere(std::mt19937& randomEngine, unsigned int size, std::vector<Nz::Vector3f>& positions, std::vector<Nz::UInt32>& indices)
+	{
+		positions.resize(size * size);
+		for (unsigned int y = 0; y < size; ++y)
+		{
+			float theta = float(M_PI) * y / (size - 1);
+			for (unsigned int x = 0; x < size; ++x)
+			{
+				float phi = 2.f * float(M_PI) * x / (size - 1);
+				positions[y * size + x].Set(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+			}
+		}
+
+		std::vector<std::array<Nz::UInt32, 3>> triangles;
+		triangles.reserve((size - 1) * (size - 1) * 2);
+		for (unsigned int y = 0; y < size - 1; ++y)
+		{
+			for (unsigned int x = 0; x < size - 1; ++x)
+			{
+				Nz::UInt32 topLeft = y * size + x;
+				triangles.push_back({{topLeft, topLeft + size, topLeft + 1}});
+				triangles.push_back({{topLeft + 1, topLeft + size, topLeft + size + 1}});
+			}
+		}
+
+		std::shuffle(triangles.begin(), triangles.end(), randomEngine);
+
+		indices.clear();
+		for (const auto& triangle : triangles)
+			indices.insert(indices.end(), triangle.begin(), triangle.end());
+	}
+
+	std::vector<Nz::UInt32> GetIndices(const Nz::IndexBuffer& indexBuffer)
+	{
+		Nz::IndexMapper mapper(&indexBuffer);
+
+		std::vector<Nz::UInt32> indices(indexBuffer.GetIndexCount());
+		for (std::size_t i = 0; i < indices.size(); ++i)
+			indices[i] = mapper.Get(i);
+
+		return indices;
+	}
+
+	// Triangles as sorted vertex positions, rotated (without changing the winding) to start with their smallest vertex
+	std::vector<std::array<Nz::Vector3f, 3>> GetSortedTriangles(const std::vector<Nz::UInt32>& indices, const std::vector<Nz::Vector3f>& positions)
+	{
+		auto IsLess = [](const Nz::Vector3f& lhs, const Nz::Vector3f& rhs)
+		{
+			return std::tie(lhs.x, lhs.y, lhs.z) < std::tie(rhs.x, rhs.y, rhs.z);
+		};
+
+		std::vector<std::array<Nz::Vector3f, 3>> triangles(indices.size() / 3);
+		for (std::size_t i = 0; i < triangles.size(); ++i)
+		{
+			std::array<Nz::Vector3f, 3>& triangle = triangles[i];
+			for (std::size_t j = 0; j < 3; ++j)
+				triangle[j] = positions[indices[i * 3 + j]];
+
+			std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end(), IsLess), triangle.end());
+		}
+
+		std::sort(triangles.begin(), triangles.end(), [&](const std::array<Nz::Vector3f, 3>& lhs, const std::array<Nz::Vector3f, 3>& rhs)
+		{
+			return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), IsLess);
+		});
+
+		return triangles;
+	}
+}
+
+SCENARIO("Skinning", "[UTILITY][ALGORITHM]")
+{
+	GIVEN("A skeleton and vertices with up to four weights")
+	{
+		constexpr unsigned int jointCount = 40;
+		constexpr unsigned int vertexCount = 1001; //< Not a multiple of the SIMD width
+
+		std::mt19937 randomEngine(42);
+
+		Nz::Skeleton skeleton;
+		GenerateSkeleton(randomEngine, skeleton, jointCount);
+
+		std::vector<Nz::SkeletalMeshVertex> inputVertices = GenerateVertices(randomEngine, vertexCount, jointCount);
+
+		WHEN("We skin them with a joint palette")
+		{
+			std::vector<Nz::Vector4f> palette(jointCount * 3);
+			Nz::ComputeSkinningPalette(skeleton.GetJoints(), jointCount, palette.data());
+
+			std::vector<Nz::MeshVertex> expectedVertices(vertexCount);
+			Nz::SkinningData skinningData;
+			skinningData.inputVertex = inputVertices.data();
+			skinningData.outputVertex = expectedVertices.data();
+			skinningData.joints = skeleton.GetJoints();
+
+			Nz::SkinPositionNormalTangent(skinningData, 0, vertexCount);
+
+			std::vector<Nz::MeshVertex> outputVertices(vertexCount);
+			Nz::SkinningPaletteData paletteData;
+			paletteData.inputVertex = inputVertices.data();
+			paletteData.outputVertex = outputVertices.data();
+			paletteData.palette = palette.data();
+
+			// Uneven ranges, as done by the skinning tasks
+			Nz::SkinPositionNormalTangent(paletteData, 0, 3);
+			Nz::SkinPositionNormalTangent(paletteData, 3, 500);
+			Nz::SkinPositionNormalTangent(paletteData, 503, vertexCount - 503);
+
+			THEN("Results match the joint-based skinning")
+			{
+				float maxPositionError = 0.f;
+				float maxDirectionError = 0.f;
+				bool sameUVs = true;
+				for (unsigned int i = 0; i < vertexCount; ++i)
+				{
+					const Nz::MeshVertex& expected = expectedVertices[i];
+					const Nz::MeshVertex& output = outputVertices[i];
+
+					maxPositionError = std::max(maxPositionError, expected.position.Distance(output.position) / std::max(expected.position.GetLength(), 1.f));
+					maxDirectionError = std::max(maxDirectionError, expected.normal.Distance(output.normal));
+					maxDirectionError = std::max(maxDirectionError, expected.tangent.Distance(output.tangent));
+					sameUVs = sameUVs && expected.uv == output.uv;
+				}
+
+				CHECK(maxPositionError < 0.0001f);
+				CHECK(maxDirectionError < 0.0001f);
+				CHECK(sameUVs);
+			}
+		}
+	}
+}
+
+TEST_CASE("Skinning of animated characters", "[UTILITY][ALGORITHM][.benchmark]")
+{
+	constexpr unsigned int characterCount = 200;
+	constexpr unsigned int jointCount = 60;
+	constexpr unsigned int grainSize = 1024;
+	constexpr unsigned int vertexCount = 5000;
+
+	std::mt19937 randomEngine(42);
+
+	std::vector<Nz::Skeleton> skeletons(characterCount);
+	for (Nz::Skeleton& skeleton : skeletons)
+		GenerateSkeleton(randomEngine, skeleton, jointCount);
+
+	std::vector<Nz::SkeletalMeshVertex> inputVertices = GenerateVertices(randomEngine, vertexCount, jointCount);
+	std::vector<std::vector<Nz::MeshVertex>> outputVertices(characterCount, std::vector<Nz::MeshVertex>(vertexCount));
+	std::vector<Nz::Vector4f> palettes(characterCount * jointCount * 3);
+
+	Nz::TaskScheduler::Initialize();
+
+	BENCHMARK("Skin " + Nz::String::Number(characterCount).ToStdString() + " characters mesh by mesh")
+	{
+		for (unsigned int i = 0; i < characterCount; ++i)
+		{
+			// Skinning matrices are lazily updated, do it before the workers read them concurrently
+			const Nz::Joint* joints = skeletons[i].GetJoints();
+			for (unsigned int j = 0; j < jointCount; ++j)
+				joints[j].EnsureSkinningMatrixUpdate();
+
+			Nz::SkinningData skinningData;
+			skinningData.inputVertex = inputVertices.data();
+			skinningData.outputVertex = outputVertices[i].data();
+			skinningData.joints = skeletons[i].GetJoints();
+
+			Nz::ParallelFor(0U, vertexCount, grainSize, [&](unsigned int firstVertex, unsigned int lastVertex)
+			{
+				Nz::SkinPositionNormalTangent(skinningData, firstVertex, lastVertex - firstVertex);
+			});
+		}
+	}
+
+	BENCHMARK("Skin " + Nz::String::Number(characterCount).ToStdString() + " characters in one batch with joint palettes")
+	{
+		for (unsigned int i = 0; i < characterCount; ++i)
+			Nz::ComputeSkinningPalette(skeletons[i].GetJoints(), jointCount, &palettes[i * jointCount * 3]);
+
+		unsigned int chunkPerCharacter = (vertexCount + grainSize - 1) / grainSize;
+		Nz::ParallelFor(0U, characterCount * chunkPerCharacter, 1, [&](unsigned int firstChunk, unsigned int lastChunk)
+		{
+			for (unsigned int chunk = firstChunk; chunk < lastChunk; ++chunk)
+			{
+				unsigned int character = chunk / chunkPerCharacter;
+				unsigned int firstVertex = (chunk % chunkPerCharacter) * grainSize;
+
+				Nz::SkinningPaletteData paletteData;
+				paletteData.inputVertex = inputVertices.data();
+				paletteData.outputVertex = outputVertices[character].data();
+				paletteData.palette = &palettes[character * jointCount * 3];
+
+				Nz::SkinPositionNormalTangent(paletteData, firstVertex, std::min(grainSize, vertexCount - firstVertex));
+			}
+		});
+	}
+}
+
+SCENARIO("Mesh optimization", "[UTILITY][ALGORITHM]")
+{
+	GIVEN("A sphere with its triangles in a random order")
+	{
+		std::mt19937 randomEngine(42);
+
+		std::vector<Nz::Vector3f> positions;
+		std::vector<Nz::UInt32> sourceIndices;
+		GenerateShuffledSphere(randomEngine, 64, positions, sourceIndices);
+
+		Nz::IndexBuffer indexBuffer(false, Nz::UInt32(sourceIndices.size()), Nz::DataStorage_Software, 0);
+		Nz::IndexMapper indexMapper(&indexBuffer);
+		for (std::size_t i = 0; i < sourceIndices.size(); ++i)
+			indexMapper.Set(i, sourceIndices[i]);
+
+		indexMapper.Unmap();
+
+		unsigned int sourceMissCount = indexBuffer.ComputeCacheMissCount();
+		auto sourceTriangles = GetSortedTriangles(sourceIndices, positions);
+
+		WHEN("We optimize it for the vertex cache")
+		{
+			indexBuffer.Optimize();
+
+			THEN("Triangles are the same, with a much better cache efficiency")
+			{
+				std::vector<Nz::UInt32> indices = GetIndices(indexBuffer);
+				CHECK(GetSortedTriangles(indices, positions) == sourceTriangles);
+
+				float triangleCount = float(indices.size() / 3);
+				float acmr = indexBuffer.ComputeCacheMissCount() / triangleCount;
+				CHECK(sourceMissCount / triangleCount > 2.5f);
+				CHECK(acmr < 0.8f);
+			}
+
+			AND_WHEN("We also optimize it for overdraw")
+			{
+				unsigned int optimizedMissCount = indexBuffer.ComputeCacheMissCount();
+
+				Nz::IndexMapper mapper(&indexBuffer);
+				Nz::OptimizeOverdraw(mapper.begin(), indexBuffer.GetIndexCount(), positions.data());
+				mapper.Unmap();
+
+				THEN("Triangles are the same, without losing much cache efficiency")
+				{
+					CHECK(GetSortedTriangles(GetIndices(indexBuffer), positions) == sourceTriangles);
+					CHECK(indexBuffer.ComputeCacheMissCount() <= optimizedMissCount * 1.1f);
+				}
+			}
+
+			AND_WHEN("We reorder its vertices")
+			{
+				std::vector<Nz::Vector3f> optimizedPositions = positions;
+
+				Nz::IndexMapper mapper(&indexBuffer);
+				Nz::OptimizeVertexFetch(mapper.begin(), indexBuffer.GetIndexCount(), optimizedPositions.data(), sizeof(Nz::Vector3f), Nz::UInt32(optimizedPositions.size()));
+				mapper.Unmap();
+
+				THEN("Triangles are the same, and vertices are stored in the order they are used")
+				{
+					std::vector<Nz::UInt32> indices = GetIndices(indexBuffer);
+					CHECK(GetSortedTriangles(indices, optimizedPositions) == sourceTriangles);
+
+					Nz::UInt32 nextVertex = 0;
+					bool orderedVertices = true;
+					for (Nz::UInt32 index : indices)
+					{
+						if (index == nextVertex)
+							nextVertex++;
+						else if (index > nextVertex)
+							orderedVertices = false;
+					}
+
+					CHECK(orderedVertices);
+					CHECK(nextVertex == positions.size());
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("Mesh optimization of a million triangles", "[UTILITY][ALGORITHM][.benchmark]")
+{
+	constexpr unsigned int gridSize = 708; //< 999 698 triangles
+
+	std::mt19937 randomEngine(42);
+
+	std::vector<Nz::Vector3f> positions;
+	std::vector<Nz::UInt32> sourceIndices;
+	GenerateShuffledSphere(randomEngine, gridSize, positions, sourceIndices);
+
+	Nz::IndexBuffer indexBuffer(true, Nz::UInt32(sourceIndices.size()), Nz::DataStorage_Software, 0);
+	indexBuffer.Fill(sourceIndices.data(), 0, Nz::UInt32(sourceIndices.size()));
+
+	// ACMR: transformed vertices per triangle, ATVR: transformed vertices per vertex (1 being optimal)
+	std::ostringstream report;
+	auto ReportCacheEfficiency = [&](const char* step)
+	{
+		float missCount = float(indexBuffer.ComputeCacheMissCount());
+		report << step << ": ACMR " << missCount / (sourceIndices.size() / 3) << ", ATVR " << missCount / positions.size() << '\n';
+	};
+
+	ReportCacheEfficiency("Shuffled triangles");
+
+	BENCHMARK("Optimize indices for the vertex cache")
+	{
+		indexBuffer.Optimize();
+	}
+
+	ReportCacheEfficiency("Optimized for the vertex cache");
+
+	BENCHMARK("Optimize indices for overdraw")
+	{
+		Nz::IndexMapper mapper(&indexBuffer);
+		Nz::OptimizeOverdraw(mapper.begin(), indexBuffer.GetIndexCount(), positions.data());
+	}
+
+	ReportCacheEfficiency("Optimized for overdraw");
+
+	BENCHMARK("Reorder vertices")
+	{
+		Nz::IndexMapper mapper(&indexBuffer);
+		Nz::OptimizeVertexFetch(mapper.begin(), indexBuffer.GetIndexCount(), positions.data(), sizeof(Nz::Vector3f), Nz::UInt32(positions.size()));
+	}
+
+	std::cout << '\n' << report.str() << std::flush;
+}
@@ -0,0 +1,149 @@
+#include <Nazara/Utility/Image.hpp>
+#include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Catch/catch.hpp>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+SCENARIO("Image mipmaps", "[UTILITY][IMAGE]")
+{
+	GIVEN("An image of a single color")
+	{
+		Nz::Image image(Nz::ImageType_2D, Nz::PixelFormatType_RGBA8, 37, 16);
+		image.Fill(Nz::Color(200, 100, 50, 128));
+
+		WHEN("We generate its mipmaps with every filter")
+		{
+			THEN("The whole chain is created and keeps the same color")
+			{
+				for (Nz::MipmapFilter filter : {Nz::MipmapFilter_Box, Nz::MipmapFilter_Kaiser})
+				{
+					for (bool sRGB : {false, true})
+					{
+						INFO("Filter " << filter << (sRGB ? " in linear space" : " in gamma space"));
+
+						Nz::Image copy(image);
+						REQUIRE(copy.GenerateMipmaps(filter, sRGB));
+						CHECK(copy.GetLevelCount() == copy.GetMaxLevel());
+
+						for (Nz::UInt8 level = 1; level < copy.GetLevelCount(); ++level)
+						{
+							const Nz::UInt8* pixels = copy.GetConstPixels(0, 0, 0, level);
+							unsigned int pixelCount = copy.GetWidth(level) * copy.GetHeight(level);
+
+							bool sameColor = true;
+							for (unsigned int i = 0; i < pixelCount; ++i)
+							{
+								const Nz::UInt8* pixel = &pixels[i * 4];
+								sameColor = sameColor && std::abs(pixel[0] - 200) <= 1 && std::abs(pixel[1] - 100) <= 1 && std::abs(pixel[2] - 50) <= 1 && pixel[3] == 128;
+							}
+
+							CHECK(sameColor);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	GIVEN("A black and white luminance image")
+	{
+		const Nz::UInt8 pixels[] = {0, 255, 255, 0};
+
+		Nz::Image image(Nz::ImageType_1D, Nz::PixelFormatType_L8, 4, 1);
+		image.Update(pixels);
+
+		WHEN("We average it in gamma space")
+		{
+			REQUIRE(image.GenerateMipmaps(Nz::MipmapFilter_Box, false));
+
+			THEN("We get a mid-gray")
+			{
+				REQUIRE(image.GetLevelCount() == 2);
+				CHECK(image.GetConstPixels(0, 0, 0, 1)[0] == 128);
+				CHECK(image.GetConstPixels(0, 0, 0, 1)[1] == 128);
+			}
+		}
+
+		WHEN("We average it in linear space")
+		{
+			REQUIRE(image.GenerateMipmaps(Nz::MipmapFilter_Box, true));
+
+			THEN("We get the sRGB encoding of half the intensity")
+			{
+				REQUIRE(image.GetLevelCount() == 2);
+				CHECK(std::abs(image.GetConstPixels(0, 0, 0, 1)[0] - 188) <= 1);
+				CHECK(std::abs(image.GetConstPixels(0, 0, 0, 1)[1] - 188) <= 1);
+			}
+		}
+	}
+
+	GIVEN("An image with a non-power-of-two width")
+	{
+		const Nz::UInt8 pixels[] = {0, 50, 100, 150, 200};
+
+		Nz::Image image(Nz::ImageType_1D, Nz::PixelFormatType_L8, 5, 1);
+		image.Update(pixels);
+
+		WHEN("We generate its mipmaps")
+		{
+			REQUIRE(image.GenerateMipmaps());
+
+			THEN("The middle pixel is shared between both halves")
+			{
+				REQUIRE(image.GetLevelCount() == 2);
+				CHECK(image.GetConstPixels(0, 0, 0, 1)[0] == 40);
+				CHECK(image.GetConstPixels(0, 0, 0, 1)[1] == 160);
+			}
+		}
+	}
+
+	GIVEN("A compressed image")
+	{
+		Nz::Image image(Nz::ImageType_2D, Nz::PixelFormatType_DXT1, 16, 16);
+
+		THEN("Mipmaps can't be generated")
+		{
+			Nz::ErrorFlags flags(Nz::ErrorFlag_Silent);
+			CHECK_FALSE(image.GenerateMipmaps());
+		}
+	}
+}
+
+TEST_CASE("Mipmap generation", "[UTILITY][IMAGE][.benchmark]")
+{
+	constexpr unsigned int size = 2048;
+
+	std::mt19937 randomEngine(42);
+	std::uniform_int_distribution<int> byteDis(0, 255);
+
+	std::vector<Nz::UInt8> pixels(size * size * 4);
+	for (Nz::UInt8& byte : pixels)
+		byte = static_cast<Nz::UInt8>(byteDis(randomEngine));
+
+	Nz::Image image(Nz::ImageType_2D, Nz::PixelFormatType_RGBA8, size, size);
+	image.Update(pixels.data());
+
+	Nz::TaskScheduler::Initialize();
+
+	std::string suffix = " mipmaps of a 2048x2048 image with " + Nz::String::Number(Nz::TaskScheduler::GetWorkerCount()).ToStdString() + " workers";
+
+	BENCHMARK("Box" + suffix)
+	{
+		Nz::Image copy(image);
+		copy.GenerateMipmaps(Nz::MipmapFilter_Box);
+	}
+
+	BENCHMARK("sRGB box" + suffix)
+	{
+		Nz::Image copy(image);
+		copy.GenerateMipmaps(Nz::MipmapFilter_Box, true);
+	}
+
+	BENCHMARK("Kaiser" + suffix)
+	{
+		Nz::Image copy(image);
+		copy.GenerateMipmaps(Nz::MipmapFilter_Kaiser);
+	}
+}
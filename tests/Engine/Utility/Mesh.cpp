@@ -0,0 +1,256 @@
+#include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/Directory.hpp>
+#include <Nazara/Core/MemoryStream.hpp>
+#include <Nazara/Utility/BufferMapper.hpp>
+#include <Nazara/Utility/IndexBuffer.hpp>
+#include <Nazara/Utility/Joint.hpp>
+#include <Nazara/Utility/SkeletalMesh.hpp>
+#include <Nazara/Utility/StaticMesh.hpp>
+#include <Nazara/Utility/VertexBuffer.hpp>
+#include <Catch/catch.hpp>
+#include <cstring>
+
+namespace
+{
+	const char* s_dragonPath = "resources/Engine/Graphics/dragon_recon/dragon_vrip_res4.obj";
+	const char* s_bobLampPath = "resources/Engine/Graphics/Bob lamp/bob_lamp_update.md5mesh";
+
+	template<typename T>
+	bool HaveSameData(const T* first, const T* second, std::size_t size)
+	{
+		Nz::BufferMapper<T> firstMapper(first, Nz::BufferAccess_ReadOnly);
+		Nz::BufferMapper<T> secondMapper(second, Nz::BufferAccess_ReadOnly);
+
+		return std::memcmp(firstMapper.GetPointer(), secondMapper.GetPointer(), size) == 0;
+	}
+
+	const Nz::VertexBuffer* GetVertexBuffer(const Nz::SubMesh* subMesh)
+	{
+		if (subMesh->GetAnimationType() == Nz::AnimationType_Skeletal)
+			return static_cast<const Nz::SkeletalMesh*>(subMesh)->GetVertexBuffer();
+		else
+			return static_cast<const Nz::StaticMesh*>(subMesh)->GetVertexBuffer();
+	}
+
+	void CheckIdenticalMeshes(const Nz::Mesh& original, const Nz::Mesh& loaded)
+	{
+		REQUIRE(loaded.GetAnimationType() == original.GetAnimationType());
+		CHECK(loaded.GetAABB() == original.GetAABB());
+		CHECK(loaded.GetAnimation() == original.GetAnimation());
+
+		REQUIRE(loaded.GetMaterialCount() == original.GetMaterialCount());
+		for (Nz::UInt32 i = 0; i < original.GetMaterialCount(); ++i)
+		{
+			const Nz::ParameterList& loadedMaterial = loaded.GetMaterialData(i);
+			original.GetMaterialData(i).ForEach([&](const Nz::ParameterList& material, const Nz::String& name)
+			{
+				Nz::ParameterType type;
+				Nz::ParameterType loadedType;
+				REQUIRE(material.GetParameterType(name, &type));
+				REQUIRE(loadedMaterial.GetParameterType(name, &loadedType));
+				CHECK(loadedType == type);
+
+				// Every type a loader may use, which are the ones stored in the file
+				switch (type)
+				{
+					case Nz::ParameterType_Color:
+					{
+						Nz::Color value;
+						Nz::Color loadedValue;
+						material.GetColorParameter(name, &value);
+						loadedMaterial.GetColorParameter(name, &loadedValue);
+						CHECK(loadedValue == value);
+						break;
+					}
+
+					case Nz::ParameterType_Double:
+					{
+						double value;
+						double loadedValue;
+						material.GetDoubleParameter(name, &value);
+						loadedMaterial.GetDoubleParameter(name, &loadedValue);
+						CHECK(loadedValue == value);
+						break;
+					}
+
+					case Nz::ParameterType_String:
+					{
+						Nz::String value;
+						Nz::String loadedValue;
+						material.GetStringParameter(name, &value);
+						loadedMaterial.GetStringParameter(name, &loadedValue);
+						CHECK(loadedValue == value);
+						break;
+					}
+
+					default:
+						CHECK(loadedMaterial.ToString() == material.ToString());
+						break;
+				}
+			});
+		}
+
+		if (original.GetAnimationType() == Nz::AnimationType_Skeletal)
+		{
+			REQUIRE(loaded.GetJointCount() == original.GetJointCount());
+
+			const Nz::Joint* joints = original.GetSkeleton()->GetJoints();
+			const Nz::Joint* loadedJoints = loaded.GetSkeleton()->GetJoints();
+			for (Nz::UInt32 i = 0; i < original.GetJointCount(); ++i)
+			{
+				CHECK(loadedJoints[i].GetName() == joints[i].GetName());
+				CHECK(loadedJoints[i].GetInverseBindMatrix() == joints[i].GetInverseBindMatrix());
+
+				if (joints[i].GetParent())
+					CHECK(static_cast<const Nz::Joint*>(loadedJoints[i].GetParent()) - loadedJoints == static_cast<const Nz::Joint*>(joints[i].GetParent()) - joints);
+				else
+					CHECK(loadedJoints[i].GetParent() == nullptr);
+			}
+		}
+
+		REQUIRE(loaded.GetSubMeshCount() == original.GetSubMeshCount());
+		for (Nz::UInt32 i = 0; i < original.GetSubMeshCount(); ++i)
+		{
+			const Nz::SubMesh* subMesh = original.GetSubMesh(i);
+			const Nz::SubMesh* loadedSubMesh = loaded.GetSubMesh(i);
+
+			CHECK(loaded.GetSubMeshIdentifier(i) == original.GetSubMeshIdentifier(i));
+			CHECK(loadedSubMesh->GetAABB() == subMesh->GetAABB());
+			CHECK(loadedSubMesh->GetMaterialIndex() == subMesh->GetMaterialIndex());
+			CHECK(loadedSubMesh->GetPrimitiveMode() == subMesh->GetPrimitiveMode());
+
+			const Nz::VertexBuffer* vertexBuffer = GetVertexBuffer(subMesh);
+			const Nz::VertexBuffer* loadedVertexBuffer = GetVertexBuffer(loadedSubMesh);
+			CHECK(loadedVertexBuffer->GetVertexDeclaration() == vertexBuffer->GetVertexDeclaration());
+			REQUIRE(loadedVertexBuffer->GetVertexCount() == vertexBuffer->GetVertexCount());
+			CHECK(HaveSameData(loadedVertexBuffer, vertexBuffer, vertexBuffer->GetVertexCount() * vertexBuffer->GetStride()));
+
+			const Nz::IndexBuffer* indexBuffer = subMesh->GetIndexBuffer();
+			const Nz::IndexBuffer* loadedIndexBuffer = loadedSubMesh->GetIndexBuffer();
+			REQUIRE(loadedIndexBuffer->HasLargeIndices() == indexBuffer->HasLargeIndices());
+			REQUIRE(loadedIndexBuffer->GetIndexCount() == indexBuffer->GetIndexCount());
+			CHECK(HaveSameData(loadedIndexBuffer, indexBuffer, indexBuffer->GetIndexCount() * indexBuffer->GetStride()));
+		}
+	}
+
+	unsigned int CountCacheFiles(const Nz::String& cacheDirectory)
+	{
+		Nz::Directory directory(cacheDirectory);
+		directory.SetPattern("*.nmesh");
+		if (!directory.Open())
+			return 0;
+
+		unsigned int fileCount = 0;
+		while (directory.NextResult())
+			fileCount++;
+
+		return fileCount;
+	}
+}
+
+SCENARIO("Mesh binary format", "[UTILITY][MESH]")
+{
+	Nz::MeshParams params;
+	params.optimizeIndexBuffers = false;
+	params.storage = Nz::DataStorage_Software;
+
+	for (const char* path : {s_dragonPath, s_bobLampPath})
+	{
+		GIVEN("The mesh " + Nz::String(path).SubStringFrom('/', -1, true).ToStdString())
+		{
+			Nz::MeshRef mesh = Nz::Mesh::LoadFromFile(path, params);
+			REQUIRE(mesh);
+
+			WHEN("We save it as a .nmesh")
+			{
+				Nz::ByteArray data;
+				Nz::MemoryStream stream(&data);
+				REQUIRE(mesh->SaveToStream(stream, "nmesh", params));
+
+				THEN("We get the same mesh back when loading it")
+				{
+					Nz::MeshRef loadedMesh = Nz::Mesh::LoadFromMemory(data.GetConstBuffer(), data.GetSize(), params);
+					REQUIRE(loadedMesh);
+
+					CheckIdenticalMeshes(*mesh, *loadedMesh);
+				}
+
+				AND_WHEN("The file is truncated")
+				{
+					data.Resize(data.GetSize() / 2);
+
+					THEN("It fails to load")
+					{
+						CHECK_FALSE(Nz::Mesh::LoadFromMemory(data.GetConstBuffer(), data.GetSize(), params));
+					}
+				}
+			}
+		}
+	}
+
+	GIVEN("A cache directory")
+	{
+		Nz::String cacheDirectory = "MeshCacheTest";
+		if (Nz::Directory::Exists(cacheDirectory))
+			Nz::Directory::Remove(cacheDirectory, true);
+
+		params.cacheDirectory = cacheDirectory;
+
+		WHEN("We load a mesh for the first time")
+		{
+			Nz::MeshRef mesh = Nz::Mesh::LoadFromFile(s_dragonPath, params);
+			REQUIRE(mesh);
+
+			THEN("It is added to the cache, and loaded from there the next time")
+			{
+				CHECK(CountCacheFiles(cacheDirectory) == 1);
+
+				Nz::MeshRef cachedMesh = Nz::Mesh::LoadFromFile(s_dragonPath, params);
+				REQUIRE(cachedMesh);
+				CHECK(cachedMesh->GetFilePath() == mesh->GetFilePath());
+				CheckIdenticalMeshes(*mesh, *cachedMesh);
+
+				CHECK(CountCacheFiles(cacheDirectory) == 1);
+			}
+
+			AND_WHEN("We load it with other parameters")
+			{
+				params.center = true;
+
+				Nz::MeshRef centeredMesh = Nz::Mesh::LoadFromFile(s_dragonPath, params);
+				REQUIRE(centeredMesh);
+
+				THEN("Another cache file is used")
+				{
+					CHECK(CountCacheFiles(cacheDirectory) == 2);
+					CHECK(centeredMesh->GetAABB() != mesh->GetAABB());
+				}
+			}
+		}
+
+		Nz::Directory::Remove(cacheDirectory, true);
+	}
+}
+
+TEST_CASE("Mesh loading", "[UTILITY][MESH][.benchmark]")
+{
+	Nz::MeshParams params;
+	params.storage = Nz::DataStorage_Software;
+
+	BENCHMARK("Load the stanford dragon from .obj")
+	{
+		Nz::Mesh::LoadFromFile(s_dragonPath, params);
+	}
+
+	Nz::String cacheDirectory = "MeshCacheBenchmark";
+	params.cacheDirectory = cacheDirectory;
+	Nz::Mesh::LoadFromFile(s_dragonPath, params); //< Fills the cache
+
+	BENCHMARK("Load the stanford dragon from the cache")
+	{
+		Nz::Mesh::LoadFromFile(s_dragonPath, params);
+	}
+
+	Nz::Directory::Remove(cacheDirectory, true);
+}
@@ -0,0 +1,535 @@
+#include <Nazara/Utility/PixelFormat.hpp>
+#include <Nazara/Core/MemoryStream.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Utility/Image.hpp>
+#include <Catch/catch.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	const std::pair<Nz::PixelFormatType, Nz::PixelFormatType> s_conversions[] = {
+		{Nz::PixelFormatType_A8,    Nz::PixelFormatType_BGRA8},
+		{Nz::PixelFormatType_A8,    Nz::PixelFormatType_LA8},
+		{Nz::PixelFormatType_A8,    Nz::PixelFormatType_RGBA8},
+		{Nz::PixelFormatType_BGR8,  Nz::PixelFormatType_BGRA8},
+		{Nz::PixelFormatType_BGR8,  Nz::PixelFormatType_RGBA8},
+		{Nz::PixelFormatType_BGRA8, Nz::PixelFormatType_BGR8},
+		{Nz::PixelFormatType_BGRA8, Nz::PixelFormatType_RGB5A1},
+		{Nz::PixelFormatType_BGRA8, Nz::PixelFormatType_RGB8},
+		{Nz::PixelFormatType_BGRA8, Nz::PixelFormatType_RGBA4},
+		{Nz::PixelFormatType_BGRA8, Nz::PixelFormatType_RGBA8},
+		{Nz::PixelFormatType_L8,    Nz::PixelFormatType_BGRA8},
+		{Nz::PixelFormatType_L8,    Nz::PixelFormatType_LA8},
+		{Nz::PixelFormatType_L8,    Nz::PixelFormatType_RGBA8},
+		{Nz::PixelFormatType_RGB8,  Nz::PixelFormatType_BGRA8},
+		{Nz::PixelFormatType_RGB8,  Nz::PixelFormatType_RGBA8},
+		{Nz::PixelFormatType_RGBA8, Nz::PixelFormatType_BGR8},
+		{Nz::PixelFormatType_RGBA8, Nz::PixelFormatType_BGRA8},
+		{Nz::PixelFormatType_RGBA8, Nz::PixelFormatType_RGB5A1},
+		{Nz::PixelFormatType_RGBA8, Nz::PixelFormatType_RGB8},
+		{Nz::PixelFormatType_RGBA8, Nz::PixelFormatType_RGBA4}
+	};
+
+	std::vector<Nz::UInt8> GenerateRandomPixels(std::size_t size)
+	{
+		std::mt19937 randomEngine(42);
+		std::uniform_int_distribution<int> byteDis(0, 255);
+
+		std::vector<Nz::UInt8> pixels(size);
+		for (Nz::UInt8& byte : pixels)
+			byte = static_cast<Nz::UInt8>(byteDis(randomEngine));
+
+		return pixels;
+	}
+
+	// Diagonal gradient with some noise, its colors are mostly aligned which is what block compression expects
+	std::vector<Nz::UInt8> GenerateGradientPixels(unsigned int width, unsigned int height)
+	{
+		std::mt19937 randomEngine(42);
+		std::uniform_int_distribution<int> noiseDis(-4, 4);
+
+		std::vector<Nz::UInt8> pixels(width * height * 4);
+		for (unsigned int y = 0; y < height; ++y)
+		{
+			for (unsigned int x = 0; x < width; ++x)
+			{
+				int t = int((x + y) * 255 / (width + height));
+
+				Nz::UInt8* pixel = &pixels[(y * width + x) * 4];
+				pixel[0] = static_cast<Nz::UInt8>(Nz::Clamp(t + noiseDis(randomEngine), 0, 255));
+				pixel[1] = static_cast<Nz::UInt8>(Nz::Clamp(255 - t + noiseDis(randomEngine), 0, 255));
+				pixel[2] = static_cast<Nz::UInt8>(Nz::Clamp(64 + t / 2 + noiseDis(randomEngine), 0, 255));
+				pixel[3] = static_cast<Nz::UInt8>(255 - t * 3 / 4);
+			}
+		}
+
+		return pixels;
+	}
+
+	// Reference decoders, writing the RGBA8 pixels of a block (channels not stored by the format are left untouched)
+	void DecodeColorBlock(const Nz::UInt8* block, Nz::UInt8 (*pixels)[4])
+	{
+		unsigned int colors[2] = {unsigned(block[0] | (block[1] << 8)), unsigned(block[2] | (block[3] << 8))};
+
+		int palette[4][3];
+		for (unsigned int i = 0; i < 2; ++i)
+		{
+			unsigned int r = (colors[i] >> 11) & 0x1F;
+			unsigned int g = (colors[i] >> 5) & 0x3F;
+			unsigned int b = colors[i] & 0x1F;
+
+			palette[i][0] = (r << 3) | (r >> 2);
+			palette[i][1] = (g << 2) | (g >> 4);
+			palette[i][2] = (b << 3) | (b >> 2);
+		}
+
+		for (unsigned int c = 0; c < 3; ++c)
+		{
+			palette[2][c] = (colors[0] > colors[1]) ? (2 * palette[0][c] + palette[1][c]) / 3 : (palette[0][c] + palette[1][c]) / 2;
+			palette[3][c] = (colors[0] > colors[1]) ? (palette[0][c] + 2 * palette[1][c]) / 3 : 0;
+		}
+
+		for (unsigned int i = 0; i < 16; ++i)
+		{
+			unsigned int index = (block[4 + i / 4] >> (2 * (i % 4))) & 3;
+			for (unsigned int c = 0; c < 3; ++c)
+				pixels[i][c] = static_cast<Nz::UInt8>(palette[index][c]);
+		}
+	}
+
+	void DecodeSingleChannelBlock(const Nz::UInt8* block, unsigned int channel, Nz::UInt8 (*pixels)[4])
+	{
+		int palette[8];
+		palette[0] = block[0];
+		palette[1] = block[1];
+		if (block[0] > block[1])
+		{
+			for (int i = 1; i < 7; ++i)
+				palette[i + 1] = ((7 - i) * palette[0] + i * palette[1]) / 7;
+		}
+		else
+		{
+			for (int i = 1; i < 5; ++i)
+				palette[i + 1] = ((5 - i) * palette[0] + i * palette[1]) / 5;
+
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+
+		Nz::UInt64 bits = 0;
+		for (unsigned int i = 0; i < 6; ++i)
+			bits |= Nz::UInt64(block[2 + i]) << (8 * i);
+
+		for (unsigned int i = 0; i < 16; ++i)
+			pixels[i][channel] = static_cast<Nz::UInt8>(palette[(bits >> (3 * i)) & 7]);
+	}
+
+	void DecodeBC7Block(const Nz::UInt8* block, Nz::UInt8 (*pixels)[4])
+	{
+		const unsigned int weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+		unsigned int bitOffset = 0;
+		auto ReadBits = [&](unsigned int bitCount)
+		{
+			unsigned int value = 0;
+			for (unsigned int i = 0; i < bitCount; ++i, ++bitOffset)
+				value |= ((block[bitOffset / 8] >> (bitOffset % 8)) & 1U) << i;
+
+			return value;
+		};
+
+		REQUIRE(ReadBits(7) == (1U << 6)); //< Only mode 6 is produced
+
+		unsigned int endpoints[2][4];
+		for (unsigned int c = 0; c < 4; ++c)
+		{
+			endpoints[0][c] = ReadBits(7) << 1;
+			endpoints[1][c] = ReadBits(7) << 1;
+		}
+
+		unsigned int pBit0 = ReadBits(1);
+		unsigned int pBit1 = ReadBits(1);
+		for (unsigned int c = 0; c < 4; ++c)
+		{
+			endpoints[0][c] |= pBit0;
+			endpoints[1][c] |= pBit1;
+		}
+
+		for (unsigned int i = 0; i < 16; ++i)
+		{
+			unsigned int index = ReadBits((i == 0) ? 3 : 4);
+			for (unsigned int c = 0; c < 4; ++c)
+				pixels[i][c] = static_cast<Nz::UInt8>(((64 - weights[index]) * endpoints[0][c] + weights[index] * endpoints[1][c] + 32) >> 6);
+		}
+	}
+
+	// Returns the root mean square error of the compressed pixels on the channels stored by the format
+	float ComputeCompressionError(Nz::PixelFormatType format, const std::vector<Nz::UInt8>& pixels, const Nz::UInt8* blocks, unsigned int width, unsigned int height)
+	{
+		unsigned int channelCount;
+		unsigned int blockSize;
+		switch (format)
+		{
+			case Nz::PixelFormatType_BC4:  channelCount = 1; blockSize = 8;  break;
+			case Nz::PixelFormatType_BC5:  channelCount = 2; blockSize = 16; break;
+			case Nz::PixelFormatType_DXT1: channelCount = 3; blockSize = 8;  break;
+			default:                       channelCount = 4; blockSize = 16; break;
+		}
+
+		double squaredError = 0.0;
+		for (unsigned int y = 0; y < height; y += 4)
+		{
+			for (unsigned int x = 0; x < width; x += 4)
+			{
+				Nz::UInt8 decoded[16][4] = {};
+				switch (format)
+				{
+					case Nz::PixelFormatType_BC4:
+						DecodeSingleChannelBlock(blocks, 0, decoded);
+						break;
+
+					case Nz::PixelFormatType_BC5:
+						DecodeSingleChannelBlock(&blocks[0], 0, decoded);
+						DecodeSingleChannelBlock(&blocks[8], 1, decoded);
+						break;
+
+					case Nz::PixelFormatType_BC7:
+						DecodeBC7Block(blocks, decoded);
+						break;
+
+					case Nz::PixelFormatType_DXT1:
+						DecodeColorBlock(blocks, decoded);
+						break;
+
+					case Nz::PixelFormatType_DXT3:
+						for (unsigned int i = 0; i < 16; ++i)
+							decoded[i][3] = static_cast<Nz::UInt8>(((blocks[i / 2] >> (4 * (i % 2))) & 0xF) * 17);
+
+						DecodeColorBlock(&blocks[8], decoded);
+						break;
+
+					case Nz::PixelFormatType_DXT5:
+						DecodeSingleChannelBlock(&blocks[0], 3, decoded);
+						DecodeColorBlock(&blocks[8], decoded);
+						break;
+
+					default:
+						break;
+				}
+
+				for (unsigned int i = 0; i < 16; ++i)
+				{
+					if (x + i % 4 >= width || y + i / 4 >= height)
+						continue;
+
+					const Nz::UInt8* pixel = &pixels[((y + i / 4) * width + x + i % 4) * 4];
+					for (unsigned int c = 0; c < channelCount; ++c)
+					{
+						double diff = double(decoded[i][c]) - pixel[c];
+						squaredError += diff * diff;
+					}
+				}
+
+				blocks += blockSize;
+			}
+		}
+
+		return float(std::sqrt(squaredError / (width * height * channelCount)));
+	}
+
+	// Compressed formats, with the maximal error expected from the gradient
+	const std::pair<Nz::PixelFormatType, float> s_compressedFormats[] = {
+		{Nz::PixelFormatType_BC4,  2.f},
+		{Nz::PixelFormatType_BC5,  2.f},
+		{Nz::PixelFormatType_BC7,  3.f},
+		{Nz::PixelFormatType_DXT1, 5.f},
+		{Nz::PixelFormatType_DXT3, 5.f},
+		{Nz::PixelFormatType_DXT5, 5.f}
+	};
+}
+
+SCENARIO("PixelFormat", "[UTILITY][PIXELFORMAT]")
+{
+	GIVEN("Random pixels, in a count which isn't a multiple of the SIMD width")
+	{
+		constexpr std::size_t pixelCount = 1003;
+
+		std::vector<Nz::UInt8> source = GenerateRandomPixels(pixelCount * 4);
+
+		WHEN("We convert them all at once and one by one")
+		{
+			THEN("Results are the same for every conversion")
+			{
+				for (const auto& conversion : s_conversions)
+				{
+					INFO("Conversion from " << Nz::PixelFormat::GetName(conversion.first) << " to " << Nz::PixelFormat::GetName(conversion.second));
+
+					unsigned int srcBpp = Nz::PixelFormat::GetBytesPerPixel(conversion.first);
+					unsigned int dstBpp = Nz::PixelFormat::GetBytesPerPixel(conversion.second);
+
+					std::vector<Nz::UInt8> bulk(pixelCount * dstBpp);
+					REQUIRE(Nz::PixelFormat::Convert(conversion.first, conversion.second, &source[0], &source[pixelCount * srcBpp], bulk.data()));
+
+					std::vector<Nz::UInt8> perPixel(pixelCount * dstBpp);
+					bool converted = true;
+					for (std::size_t i = 0; i < pixelCount; ++i)
+						converted = converted && Nz::PixelFormat::Convert(conversion.first, conversion.second, &source[i * srcBpp], &perPixel[i * dstBpp]);
+
+					CHECK(converted);
+					CHECK(bulk == perPixel);
+				}
+			}
+		}
+	}
+
+	GIVEN("Some RGBA8 pixels")
+	{
+		const Nz::UInt8 pixels[] = {
+			0xFF, 0x00, 0x80, 0x7F,
+			0x10, 0x20, 0x30, 0x80,
+			0x08, 0xF7, 0x00, 0xFF,
+			0x00, 0x00, 0x00, 0x00
+		};
+
+		WHEN("We convert them to RGB5A1")
+		{
+			Nz::UInt16 converted[4];
+			REQUIRE(Nz::PixelFormat::Convert(Nz::PixelFormatType_RGBA8, Nz::PixelFormatType_RGB5A1, &pixels[0], &pixels[16], converted));
+
+			THEN("Alpha is only kept for values over 127")
+			{
+				CHECK(converted[0] == ((31 << 11) | (0 << 6) | (15 << 1) | 0));
+				CHECK(converted[1] == ((1 << 11) | (3 << 6) | (5 << 1) | 1));
+				CHECK(converted[2] == ((0 << 11) | (30 << 6) | (0 << 1) | 1));
+				CHECK(converted[3] == 0);
+			}
+		}
+	}
+}
+
+SCENARIO("Image conversion", "[UTILITY][IMAGE]")
+{
+	GIVEN("A big RGBA8 image with mipmaps")
+	{
+		constexpr unsigned int size = 600;
+
+		Nz::Image image(Nz::ImageType_2D, Nz::PixelFormatType_RGBA8, size, size, 1, 3);
+		for (Nz::UInt8 level = 0; level < image.GetLevelCount(); ++level)
+		{
+			unsigned int levelSize = size >> level;
+			REQUIRE(image.Update(GenerateRandomPixels(levelSize * levelSize * 4).data(), 0, 0, level));
+		}
+
+		Nz::Image original(image);
+
+		WHEN("We convert it to BGRA8")
+		{
+			REQUIRE(image.Convert(Nz::PixelFormatType_BGRA8));
+
+			THEN("Every pixel of every level has its red and blue channels swapped")
+			{
+				CHECK(image.GetFormat() == Nz::PixelFormatType_BGRA8);
+				CHECK(image.GetLevelCount() == 3);
+
+				for (Nz::UInt8 level = 0; level < image.GetLevelCount(); ++level)
+				{
+					unsigned int levelSize = size >> level;
+					const Nz::UInt8* srcPixels = original.GetConstPixels(0, 0, 0, level);
+					const Nz::UInt8* dstPixels = image.GetConstPixels(0, 0, 0, level);
+
+					bool swapped = true;
+					for (unsigned int i = 0; i < levelSize * levelSize; ++i)
+					{
+						const Nz::UInt8* src = &srcPixels[i * 4];
+						const Nz::UInt8* dst = &dstPixels[i * 4];
+						swapped = swapped && dst[0] == src[2] && dst[1] == src[1] && dst[2] == src[0] && dst[3] == src[3];
+					}
+
+					CHECK(swapped);
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("Block compression", "[UTILITY][PIXELFORMAT]")
+{
+	GIVEN("A noisy gradient which isn't a multiple of the block size")
+	{
+		constexpr unsigned int width = 37;
+		constexpr unsigned int height = 21;
+
+		std::vector<Nz::UInt8> pixels = GenerateGradientPixels(width, height);
+
+		WHEN("We compress it to every format and quality")
+		{
+			THEN("Decoded pixels stay close to the original, and better qualities don't increase the error")
+			{
+				for (const auto& pair : s_compressedFormats)
+				{
+					Nz::PixelFormatType format = pair.first;
+
+					float previousError = std::numeric_limits<float>::max();
+					for (Nz::CompressionQuality quality : {Nz::CompressionQuality_Fast, Nz::CompressionQuality_Normal, Nz::CompressionQuality_High})
+					{
+						INFO(Nz::PixelFormat::GetName(format) << " with quality " << quality);
+
+						std::vector<Nz::UInt8> blocks(Nz::PixelFormat::ComputeSize(format, width, height, 1));
+						REQUIRE(Nz::PixelFormat::Compress(Nz::PixelFormatType_RGBA8, format, width, height, pixels.data(), blocks.data(), quality));
+
+						float error = ComputeCompressionError(format, pixels, blocks.data(), width, height);
+						CHECK(error < pair.second);
+						CHECK(error <= previousError);
+
+						previousError = error;
+					}
+				}
+			}
+		}
+	}
+
+	GIVEN("Blocks of a single color")
+	{
+		std::vector<Nz::UInt8> pixels;
+		for (unsigned int i = 0; i < 16; ++i)
+		{
+			for (Nz::UInt8 value : {Nz::UInt8(i * 16 + 3), Nz::UInt8(200 - i * 7), Nz::UInt8(i * 13), Nz::UInt8(255 - i)})
+				pixels.push_back(value);
+		}
+
+		// Sixteen 4x4 blocks side by side, each one using a single color
+		std::vector<Nz::UInt8> image(64 * 4 * 4);
+		for (unsigned int y = 0; y < 4; ++y)
+		{
+			for (unsigned int x = 0; x < 64; ++x)
+				std::copy(&pixels[(x / 4) * 4], &pixels[(x / 4) * 4 + 4], &image[(y * 64 + x) * 4]);
+		}
+
+		WHEN("We compress them to DXT5")
+		{
+			std::vector<Nz::UInt8> blocks(Nz::PixelFormat::ComputeSize(Nz::PixelFormatType_DXT5, 64, 4, 1));
+			REQUIRE(Nz::PixelFormat::Compress(Nz::PixelFormatType_RGBA8, Nz::PixelFormatType_DXT5, 64, 4, image.data(), blocks.data(), Nz::CompressionQuality_Fast));
+
+			THEN("The colors are matched within one unit")
+			{
+				CHECK(ComputeCompressionError(Nz::PixelFormatType_DXT5, image, blocks.data(), 64, 4) < 1.f);
+			}
+		}
+	}
+}
+
+SCENARIO("Image compression", "[UTILITY][IMAGE]")
+{
+	GIVEN("An RGB8 image with mipmaps")
+	{
+		constexpr unsigned int size = 70;
+
+		std::vector<Nz::UInt8> pixels = GenerateGradientPixels(size, size);
+
+		Nz::Image image(Nz::ImageType_2D, Nz::PixelFormatType_RGBA8, size, size);
+		image.Update(pixels.data());
+		REQUIRE(image.Convert(Nz::PixelFormatType_RGB8));
+		REQUIRE(image.GenerateMipmaps());
+
+		WHEN("We compress it to BC7")
+		{
+			Nz::Image original(image);
+			REQUIRE(original.Convert(Nz::PixelFormatType_RGBA8));
+			REQUIRE(image.Convert(Nz::PixelFormatType_BC7, Nz::CompressionQuality_High));
+
+			THEN("Every level is compressed")
+			{
+				CHECK(image.GetFormat() == Nz::PixelFormatType_BC7);
+				CHECK(image.GetLevelCount() == original.GetLevelCount());
+
+				for (Nz::UInt8 level = 0; level < image.GetLevelCount(); ++level)
+				{
+					unsigned int levelSize = image.GetWidth(level);
+					CHECK(image.GetMemoryUsage(level) == ((levelSize + 3) / 4) * ((levelSize + 3) / 4) * 16);
+
+					const Nz::UInt8* levelPixels = original.GetConstPixels(0, 0, 0, level);
+					std::vector<Nz::UInt8> expected(levelPixels, levelPixels + levelSize * levelSize * 4);
+					CHECK(ComputeCompressionError(Nz::PixelFormatType_BC7, expected, image.GetConstPixels(0, 0, 0, level), levelSize, levelSize) < 3.f);
+				}
+			}
+
+			AND_THEN("It can be saved as a DDS file and loaded back")
+			{
+				Nz::ByteArray data;
+				Nz::MemoryStream stream(&data);
+				REQUIRE(image.SaveToStream(stream, "dds"));
+
+				Nz::ImageRef loaded = Nz::Image::LoadFromMemory(data.GetConstBuffer(), data.GetSize());
+				REQUIRE(loaded.IsValid());
+				CHECK(loaded->GetFormat() == Nz::PixelFormatType_BC7);
+				CHECK(loaded->GetWidth() == size);
+				CHECK(loaded->GetHeight() == size);
+				REQUIRE(loaded->GetLevelCount() == image.GetLevelCount());
+
+				bool sameBlocks = true;
+				for (Nz::UInt8 level = 0; level < image.GetLevelCount(); ++level)
+					sameBlocks = sameBlocks && std::memcmp(loaded->GetConstPixels(0, 0, 0, level), image.GetConstPixels(0, 0, 0, level), image.GetMemoryUsage(level)) == 0;
+
+				CHECK(sameBlocks);
+			}
+		}
+
+	}
+
+	GIVEN("A compressed format")
+	{
+		THEN("It can't be used as a compression source")
+		{
+			CHECK_FALSE(Nz::PixelFormat::IsCompressionSupported(Nz::PixelFormatType_DXT1, Nz::PixelFormatType_BC7));
+			CHECK(Nz::PixelFormat::IsCompressionSupported(Nz::PixelFormatType_RGB8, Nz::PixelFormatType_BC7));
+		}
+	}
+}
+
+TEST_CASE("Pixel format conversions", "[UTILITY][PIXELFORMAT][.benchmark]")
+{
+	constexpr std::size_t pixelCount = 1024 * 1024;
+
+	std::vector<Nz::UInt8> source = GenerateRandomPixels(pixelCount * 4);
+	std::vector<Nz::UInt8> destination(pixelCount * 4);
+
+	for (const auto& conversion : s_conversions)
+	{
+		const Nz::UInt8* end = &source[pixelCount * Nz::PixelFormat::GetBytesPerPixel(conversion.first)];
+
+		BENCHMARK("Convert 1M pixels from " + Nz::PixelFormat::GetName(conversion.first).ToStdString() + " to " + Nz::PixelFormat::GetName(conversion.second).ToStdString())
+		{
+			Nz::PixelFormat::Convert(conversion.first, conversion.second, source.data(), end, destination.data());
+		}
+	}
+
+	Nz::TaskScheduler::Initialize();
+
+	Nz::Image image(Nz::ImageType_2D, Nz::PixelFormatType_RGB8, 2048, 2048);
+	image.Update(GenerateRandomPixels(2048 * 2048 * 3).data());
+
+	BENCHMARK("Convert a 2048x2048 image from RGB8 to RGBA8 with " + Nz::String::Number(Nz::TaskScheduler::GetWorkerCount()).ToStdString() + " workers")
+	{
+		Nz::Image copy(image);
+		copy.Convert(Nz::PixelFormatType_RGBA8);
+	}
+
+	for (const auto& pair : s_compressedFormats)
+	{
+		Nz::PixelFormatType format = pair.first;
+		for (Nz::CompressionQuality quality : {Nz::CompressionQuality_Fast, Nz::CompressionQuality_Normal, Nz::CompressionQuality_High})
+		{
+			BENCHMARK("Compress a 2048x2048 image to " + Nz::PixelFormat::GetName(format).ToStdString() + " with quality " + Nz::String::Number(quality).ToStdString() + " and " + Nz::String::Number(Nz::TaskScheduler::GetWorkerCount()).ToStdString() + " workers")
+			{
+				Nz::Image copy(image);
+				copy.Convert(format, quality);
+			}
+		}
+	}
+}
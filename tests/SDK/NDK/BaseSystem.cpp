@@ -3,6 +3,8 @@
 #include <NDK/Components/VelocityComponent.hpp>
 #include <NDK/World.hpp>
 #include <Catch/catch.hpp>
+#include <atomic>
+#include <vector>
 
 namespace
 {
@@ -26,6 +28,33 @@ namespace
 	};
 
 	Ndk::SystemIndex TestSystem::systemIndex;
+
+	class ParallelSystem : public Ndk::System<ParallelSystem>
+	{
+		public:
+			ParallelSystem()
+			{
+				Requires<Ndk::VelocityComponent>();
+				SetMaximumUpdateRate(0.f);
+			}
+
+			~ParallelSystem() = default;
+
+			std::vector<std::atomic_int> visitCounts;
+
+			static Ndk::SystemIndex systemIndex;
+
+		private:
+			void OnUpdate(float /*elapsedTime*/) override
+			{
+				ParallelForEachEntity([&](const Ndk::EntityHandle& entity)
+				{
+					visitCounts[entity->GetId()]++;
+				}, 2);
+			}
+	};
+
+	Ndk::SystemIndex ParallelSystem::systemIndex;
 }
 
 SCENARIO("BaseSystem", "[NDK][BASESYSTEM]")
@@ -62,4 +91,35 @@ SCENARIO("BaseSystem", "[NDK][BASESYSTEM]")
 			}
 		}
 	}
-}
\ No newline at end of file
+
+	GIVEN("A system iterating over its entities with multiple threads")
+	{
+		Ndk::World world(false);
+
+		ParallelSystem& system = world.AddSystem<ParallelSystem>();
+
+		constexpr std::size_t entityCount = 1000;
+		system.visitCounts = std::vector<std::atomic_int>(entityCount);
+
+		for (std::size_t i = 0; i < entityCount; ++i)
+		{
+			const Ndk::EntityHandle& entity = world.CreateEntity();
+			if (i % 7 != 0)
+				entity->AddComponent<Ndk::VelocityComponent>();
+		}
+
+		WHEN("We update it")
+		{
+			world.Update(1.f);
+
+			THEN("Each one of its entities has been visited exactly once")
+			{
+				bool visitedOnce = true;
+				for (std::size_t i = 0; i < entityCount; ++i)
+					visitedOnce = visitedOnce && system.visitCounts[i] == ((i % 7 != 0) ? 1 : 0);
+
+				CHECK(visitedOnce);
+			}
+		}
+	}
+}
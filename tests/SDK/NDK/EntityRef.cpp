@@ -0,0 +1,68 @@
+#include <NDK/EntityRef.hpp>
+#include <NDK/World.hpp>
+#include <Catch/catch.hpp>
+#include <unordered_set>
+
+SCENARIO("EntityRef", "[NDK][ENTITYREF]")
+{
+	GIVEN("A world and a reference to one of its entities")
+	{
+		Ndk::World world(false);
+		Ndk::EntityHandle entity = world.CreateEntity();
+		Ndk::EntityRef ref = world.GetEntityRef(entity->GetId());
+
+		THEN("It gives access to the entity")
+		{
+			CHECK(ref.IsValid());
+			CHECK(ref.Get() == entity.GetObject());
+			CHECK(ref->GetId() == entity->GetId());
+			CHECK(ref == world.GetEntityRef(entity));
+			CHECK(!Ndk::EntityRef().IsValid());
+		}
+
+		WHEN("We kill the entity")
+		{
+			entity->Kill();
+
+			THEN("The reference stays valid until the world is refreshed")
+			{
+				CHECK(ref.IsValid());
+
+				world.Refresh();
+				CHECK(!ref.IsValid());
+				CHECK(ref.Get() == nullptr);
+			}
+
+			AND_WHEN("A new entity reuses its identifier")
+			{
+				world.Refresh();
+
+				const Ndk::EntityHandle& newEntity = world.CreateEntity();
+				REQUIRE(newEntity->GetId() == ref.GetId());
+
+				THEN("The old reference is still invalid, unlike a new one")
+				{
+					Ndk::EntityRef newRef = world.GetEntityRef(newEntity->GetId());
+
+					CHECK(!ref.IsValid());
+					CHECK(newRef.IsValid());
+					CHECK(newRef != ref);
+					CHECK(newRef.GetGeneration() == ref.GetGeneration() + 1);
+					CHECK(std::unordered_set<Ndk::EntityRef>({ ref, newRef }).size() == 2);
+				}
+			}
+		}
+
+		WHEN("We clear the world and create an entity again")
+		{
+			world.Clear();
+			const Ndk::EntityHandle& newEntity = world.CreateEntity();
+
+			THEN("The reference is invalid")
+			{
+				CHECK(newEntity->GetId() == ref.GetId());
+				CHECK(!ref.IsValid());
+			}
+		}
+	}
+}
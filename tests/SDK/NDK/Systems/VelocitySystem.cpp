@@ -26,5 +26,58 @@ SCENARIO("VelocitySystem", "[NDK][VELOCITYSYSTEM]")
 				REQUIRE(nodeComponent.GetPosition().SquaredDistance(velocity) < 0.2f);
 			}
 		}
+
+		WHEN("Another moving entity is attached to our entity")
+		{
+			velocityComponent.linearVelocity = Nz::Vector3f::UnitX() * 2.f;
+
+			const Ndk::EntityHandle& child = world.CreateEntity();
+			child->AddComponent<Ndk::VelocityComponent>(Nz::Vector3f::UnitY() * 2.f, Nz::CoordSys_Local);
+			Ndk::NodeComponent& childNode = child->AddComponent<Ndk::NodeComponent>();
+			childNode.SetParent(entity);
+
+			world.Update(1.f);
+
+			THEN("Both have moved, the child following its parent")
+			{
+				CHECK(nodeComponent.GetPosition().SquaredDistance(Nz::Vector3f(2.f, 0.f, 0.f)) < 0.2f);
+				CHECK(childNode.GetPosition(Nz::CoordSys_Global).SquaredDistance(Nz::Vector3f(2.f, 2.f, 0.f)) < 0.2f);
+			}
+		}
+	}
+}
+
+TEST_CASE("VelocitySystem update", "[NDK][VELOCITYSYSTEM][.benchmark]")
+{
+	constexpr unsigned int entityCount = 1000000;
+
+	Ndk::World world(false);
+	Ndk::VelocitySystem& velocitySystem = world.AddSystem<Ndk::VelocitySystem>();
+	velocitySystem.SetMaximumUpdateRate(0.f); //< Update every time
+
+	for (unsigned int i = 0; i < entityCount; ++i)
+	{
+		const Ndk::EntityHandle& entity = world.CreateEntity();
+		entity->AddComponent<Ndk::NodeComponent>();
+		entity->AddComponent<Ndk::VelocityComponent>(Nz::Vector3f::UnitX());
+	}
+	world.Refresh();
+
+	REQUIRE(velocitySystem.GetEntities().size() == entityCount);
+
+	BENCHMARK("Update 1M entities through entity handles")
+	{
+		for (const Ndk::EntityHandle& entity : velocitySystem.GetEntities())
+		{
+			Ndk::NodeComponent& node = entity->GetComponent<Ndk::NodeComponent>();
+			const Ndk::VelocityComponent& velocity = entity->GetComponent<Ndk::VelocityComponent>();
+
+			node.Move(velocity.linearVelocity * 0.01f, velocity.coordSys);
+		}
+	}
+
+	BENCHMARK("Update 1M entities with the system")
+	{
+		velocitySystem.Update(0.01f);
 	}
-}
\ No newline at end of file
+}
@@ -1,6 +1,12 @@
 #include <NDK/World.hpp>
+#include <NDK/EntityCommandBuffer.hpp>
 #include <NDK/Component.hpp>
+#include <NDK/Components/NodeComponent.hpp>
+#include <NDK/Components/VelocityComponent.hpp>
 #include <Catch/catch.hpp>
+#include <algorithm>
+#include <atomic>
+#include <vector>
 
 namespace
 {
@@ -49,6 +55,46 @@ namespace
 	};
 
 	Ndk::SystemIndex UpdateSystem::systemIndex;
+
+	template<int N>
+	class AccessSystem : public Ndk::System<AccessSystem<N>>
+	{
+		public:
+			AccessSystem(std::atomic_int& stepCounter, int updateOrder) :
+			m_stepCounter(stepCounter)
+			{
+				this->SetMaximumUpdateRate(0.f);
+				this->SetUpdateOrder(updateOrder);
+			}
+
+			template<typename ComponentType>
+			void DeclareRead()
+			{
+				this->template Reads<ComponentType>();
+			}
+
+			template<typename ComponentType>
+			void DeclareWrite()
+			{
+				this->template Writes<ComponentType>();
+			}
+
+			int firstStep = -1;
+			int lastStep = -1;
+
+			static Ndk::SystemIndex systemIndex;
+
+		private:
+			void OnUpdate(float /*elapsedTime*/) override
+			{
+				firstStep = m_stepCounter++;
+				lastStep = m_stepCounter++;
+			}
+
+			std::atomic_int& m_stepCounter;
+	};
+
+	template<int N> Ndk::SystemIndex AccessSystem<N>::systemIndex;
 }
 
 SCENARIO("World", "[NDK][WORLD]")
@@ -159,4 +205,280 @@ SCENARIO("World", "[NDK][WORLD]")
 			}
 		}
 	}
+
+	GIVEN("A world with entities having different sets of components")
+	{
+		Ndk::World world(false);
+
+		std::vector<Ndk::EntityHandle> entities;
+		for (unsigned int i = 0; i < 10; ++i)
+		{
+			entities.emplace_back(world.CreateEntity());
+			if (i % 2 == 0)
+				entities.back()->AddComponent<Ndk::NodeComponent>();
+
+			if (i % 3 == 0)
+				entities.back()->AddComponent<Ndk::VelocityComponent>(Nz::Vector3f(float(i), 0.f, 0.f));
+		}
+
+		auto GetIteratedEntities = [&]()
+		{
+			std::vector<Ndk::EntityId> iteratedEntities;
+			world.ForEachComponent<Ndk::NodeComponent, const Ndk::VelocityComponent>([&](Ndk::EntityId id, Ndk::NodeComponent& node, const Ndk::VelocityComponent& velocity)
+			{
+				CHECK(&node == &entities[id]->GetComponent<Ndk::NodeComponent>());
+				CHECK(velocity.linearVelocity.x == float(id));
+				iteratedEntities.push_back(id);
+			});
+
+			std::sort(iteratedEntities.begin(), iteratedEntities.end());
+			return iteratedEntities;
+		};
+
+		THEN("Components are packed in per-type pools")
+		{
+			CHECK(world.GetComponentPool<Ndk::NodeComponent>().GetSize() == 5);
+			CHECK(world.GetComponentPool<Ndk::VelocityComponent>().GetSize() == 4);
+			CHECK(world.GetComponentPool<Ndk::VelocityComponent>().Get(entities[3]->GetId()) == &entities[3]->GetComponent<Ndk::VelocityComponent>());
+			CHECK(world.GetComponentPool<Ndk::VelocityComponent>().Get(entities[4]->GetId()) == nullptr);
+		}
+
+		WHEN("We iterate over entities having both a node and a velocity")
+		{
+			THEN("Only those are visited")
+			{
+				CHECK(GetIteratedEntities() == std::vector<Ndk::EntityId>({ 0, 6 }));
+			}
+		}
+
+		WHEN("We iterate over them with multiple threads, one component per task")
+		{
+			std::vector<std::atomic_int> visitCounts(entities.size());
+			std::atomic_int wrongComponentCount(0);
+
+			world.ParallelForEachComponent<Ndk::NodeComponent, const Ndk::VelocityComponent>([&](Ndk::EntityId id, Ndk::NodeComponent& /*node*/, const Ndk::VelocityComponent& velocity)
+			{
+				if (velocity.linearVelocity.x != float(id))
+					wrongComponentCount++;
+
+				visitCounts[id]++;
+			}, 1);
+
+			THEN("Only those are visited, once")
+			{
+				CHECK(wrongComponentCount == 0);
+				for (std::size_t i = 0; i < visitCounts.size(); ++i)
+					CHECK(visitCounts[i] == ((i == 0 || i == 6) ? 1 : 0));
+			}
+		}
+
+		WHEN("We remove a component, kill an entity and add a component to another one")
+		{
+			entities[0]->RemoveComponent<Ndk::VelocityComponent>();
+			entities[6]->Kill();
+			entities[3]->AddComponent<Ndk::NodeComponent>();
+
+			world.Refresh();
+
+			THEN("Pools are updated")
+			{
+				CHECK(world.GetComponentPool<Ndk::NodeComponent>().GetSize() == 5);
+				CHECK(world.GetComponentPool<Ndk::VelocityComponent>().GetSize() == 2);
+				CHECK(GetIteratedEntities() == std::vector<Ndk::EntityId>({ 3 }));
+			}
+		}
+
+		WHEN("We clear the world")
+		{
+			world.Clear();
+
+			THEN("Pools are empty")
+			{
+				CHECK(world.GetComponentPool<Ndk::NodeComponent>().GetSize() == 0);
+				CHECK(world.GetComponentPool<Ndk::VelocityComponent>().GetSize() == 0);
+			}
+		}
+	}
+
+	GIVEN("A world with systems declaring the components they access")
+	{
+		Ndk::InitializeSystem<AccessSystem<0>>();
+		Ndk::InitializeSystem<AccessSystem<1>>();
+		Ndk::InitializeSystem<AccessSystem<2>>();
+		Ndk::InitializeSystem<AccessSystem<3>>();
+
+		std::atomic_int stepCounter(0);
+
+		Ndk::World world(false);
+		auto& reader = world.AddSystem<AccessSystem<0>>(stepCounter, 0);
+		reader.DeclareRead<Ndk::NodeComponent>();
+
+		auto& writer = world.AddSystem<AccessSystem<1>>(stepCounter, 1);
+		writer.DeclareWrite<Ndk::NodeComponent>();
+
+		auto& independent = world.AddSystem<AccessSystem<2>>(stepCounter, 2);
+		independent.DeclareRead<Ndk::NodeComponent>();
+		independent.DeclareWrite<Ndk::VelocityComponent>();
+
+		auto& undeclared = world.AddSystem<AccessSystem<3>>(stepCounter, 3);
+
+		THEN("Conflicts are deduced from the declared accesses")
+		{
+			CHECK(reader.ConflictsWith(writer));
+			CHECK(writer.ConflictsWith(reader));
+			CHECK_FALSE(reader.ConflictsWith(independent));
+			CHECK(writer.ConflictsWith(independent));
+			CHECK(undeclared.ConflictsWith(reader));
+			CHECK_FALSE(undeclared.HasDeclaredComponentAccess());
+		}
+
+		WHEN("We update the world with the profiler enabled")
+		{
+			world.EnableProfiler();
+			world.Update(1.f);
+
+			THEN("Conflicting systems were updated according to their update order")
+			{
+				CHECK(writer.firstStep > reader.lastStep);
+				CHECK(independent.firstStep > writer.lastStep);
+				CHECK(undeclared.firstStep > std::max({ reader.lastStep, writer.lastStep, independent.lastStep }));
+				CHECK(stepCounter == 8);
+			}
+
+			AND_THEN("The critical path is at most the sum of every update time")
+			{
+				const Ndk::World::ProfilerData& profilerData = world.GetProfilerData();
+
+				Nz::UInt64 totalUpdateTime = 0;
+				for (Nz::UInt64 updateTime : profilerData.updateTime)
+					totalUpdateTime += updateTime;
+
+				CHECK(profilerData.updateCount == 1);
+				CHECK(profilerData.criticalPathTime <= totalUpdateTime);
+			}
+		}
+	}
+
+	GIVEN("A world where many entities are created at once")
+	{
+		Ndk::World world(false);
+		UpdateSystem& system = world.AddSystem<UpdateSystem>();
+
+		Ndk::World::EntityVector entities = world.CreateEntities(100);
+		for (unsigned int i = 0; i < 1000; ++i)
+			entities.emplace_back(world.CreateEntity());
+
+		for (std::size_t i = 0; i < entities.size(); i += 2)
+			entities[i]->AddComponent<UpdatableComponent>();
+
+		world.Refresh();
+
+		THEN("Entities are still valid after being moved to the world storage, and filtered by their components")
+		{
+			bool validEntities = true;
+			bool filteredEntities = true;
+			for (std::size_t i = 0; i < entities.size(); ++i)
+			{
+				validEntities = validEntities && entities[i].IsValid() && entities[i]->GetId() == i;
+				filteredEntities = filteredEntities && system.HasEntity(entities[i]) == (i % 2 == 0);
+			}
+
+			CHECK(validEntities);
+			CHECK(filteredEntities);
+		}
+
+		WHEN("We kill all of them")
+		{
+			world.KillEntities(entities);
+			world.Refresh();
+
+			THEN("They are removed from systems")
+			{
+				CHECK(system.GetEntities().empty());
+				CHECK(world.GetEntities().empty());
+			}
+		}
+	}
+
+	GIVEN("A world and its command buffer")
+	{
+		Ndk::World world(false);
+		Ndk::EntityCommandBuffer& commandBuffer = world.GetCommandBuffer();
+
+		Ndk::EntityHandle first = world.CreateEntity();
+		Ndk::EntityHandle second = world.CreateEntity();
+		second->AddComponent<Ndk::NodeComponent>();
+		world.Refresh();
+
+		WHEN("We record structural changes")
+		{
+			Ndk::EntityHandle created;
+			commandBuffer.CreateEntity([&](const Ndk::EntityHandle& entity)
+			{
+				entity->AddComponent<Ndk::NodeComponent>();
+				created = entity;
+			});
+			commandBuffer.AddComponent<Ndk::VelocityComponent>(first->GetId(), Nz::Vector3f::UnitX());
+			commandBuffer.RemoveComponent<Ndk::NodeComponent>(second->GetId());
+			commandBuffer.KillEntity(second->GetId());
+			commandBuffer.AddComponent<Ndk::NodeComponent>(42);
+
+			THEN("Nothing changes until the next refresh")
+			{
+				CHECK(commandBuffer.GetCommandCount() == 5);
+				CHECK(!created);
+				CHECK(!first->HasComponent<Ndk::VelocityComponent>());
+				CHECK(second->HasComponent<Ndk::NodeComponent>());
+			}
+
+			AND_WHEN("We refresh the world")
+			{
+				world.Refresh();
+
+				THEN("Changes are applied in order and commands targeting invalid entities are ignored")
+				{
+					CHECK(commandBuffer.GetCommandCount() == 0);
+					REQUIRE(created);
+					CHECK(created->HasComponent<Ndk::NodeComponent>());
+					CHECK(first->GetComponent<Ndk::VelocityComponent>().linearVelocity == Nz::Vector3f::UnitX());
+					CHECK(world.GetComponentPool<Ndk::NodeComponent>().GetSize() == 1);
+					CHECK(!second.IsValid());
+				}
+			}
+		}
+
+		WHEN("We clear recorded commands")
+		{
+			commandBuffer.KillEntity(first->GetId());
+			commandBuffer.Clear();
+			world.Refresh();
+
+			THEN("They are not applied")
+			{
+				CHECK(first->IsValid());
+				CHECK(!world.IsEntityDying(first));
+			}
+		}
+	}
+}
+
+TEST_CASE("World refresh", "[NDK][WORLD][.benchmark]")
+{
+	constexpr unsigned int entityCount = 50000;
+
+	Ndk::World world;
+
+	BENCHMARK("Spawn and refresh 50k entities, then kill and refresh them")
+	{
+		Ndk::World::EntityVector entities = world.CreateEntities(entityCount);
+		for (const Ndk::EntityHandle& entity : entities)
+		{
+			entity->AddComponent<Ndk::NodeComponent>();
+			entity->AddComponent<Ndk::VelocityComponent>(Nz::Vector3f::UnitX());
+		}
+		world.Refresh();
+
+		world.KillEntities(entities);
+		world.Refresh();
+	}
 }